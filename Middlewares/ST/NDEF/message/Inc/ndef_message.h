@@ -69,6 +69,10 @@
 #define ndefMessageGetFirstRecord(message)    (((message) == NULL) ? NULL : (message)->record)  /*!< Get first record */
 #define ndefMessageGetNextRecord(record)      (((record)  == NULL) ? NULL : (record)->next)     /*!< Get next record  */
 
+#ifndef NDEF_MESSAGE_STREAM_TYPE_ID_LEN
+#define NDEF_MESSAGE_STREAM_TYPE_ID_LEN       64U    /*!< Max type and ID length of the records decoded by a message stream */
+#endif /* NDEF_MESSAGE_STREAM_TYPE_ID_LEN */
+
 /*
  ******************************************************************************
  * GLOBAL TYPES
@@ -84,14 +88,58 @@ typedef struct
 } ndefMessageInfo;
 
 
+/*! Record arena: caller supplied storage the records of decoded messages are allocated from */
+typedef struct
+{
+    ndefRecord* pool;      /*!< Record storage                                   */
+    uint32_t    capacity;  /*!< Number of records of the storage                 */
+    uint32_t    used;      /*!< Number of records allocated                      */
+    uint32_t    highWater; /*!< Highest number of records allocated at once      */
+} ndefRecordArena;
+
+
 /*! NDEF message */
 struct ndefMessageStruct
 {
-    ndefRecord*     record; /*!< Pointer to a record */
-    ndefMessageInfo info;   /*!< Message information, e.g. length in bytes, record count */
+    ndefRecord*      record; /*!< Pointer to a record */
+    ndefRecord*      last;   /*!< Pointer to the last record, where records are appended */
+    ndefMessageInfo  info;   /*!< Message information, e.g. length in bytes, record count, kept up to date on each change */
+    ndefRecordArena* arena;  /*!< Arena the decoded records are allocated from */
 };
 
 
+/*!
+ * Message stream record callback, called once the header, type and ID of a
+ * record are decoded. The record payload buffer is NULL, its length is the
+ * record payload length. The record is only valid during the call.
+ */
+typedef ReturnCode (* ndefMessageStreamRecordCb)(void* userParam, const ndefRecord* record);
+
+/*!
+ * Message stream payload callback, called for each payload fragment of a
+ * record, in order. offset is the offset of the fragment in the payload,
+ * the last fragment ends at the record payload length.
+ */
+typedef ReturnCode (* ndefMessageStreamPayloadCb)(void* userParam, const ndefRecord* record, const ndefConstBuffer* bufFragment, uint32_t offset);
+
+
+/*! Message stream: incremental decoder of an NDEF message fed by chunks */
+typedef struct
+{
+    ndefMessageStreamRecordCb  recordCb;      /*!< Record callback, NULL if not used                        */
+    ndefMessageStreamPayloadCb payloadCb;     /*!< Payload callback, NULL if not used                       */
+    void*                      userParam;     /*!< Parameter passed to the callbacks                        */
+    ndefRecord                 record;        /*!< Record being decoded, type and ID pointing to buf        */
+    uint8_t                    buf[NDEF_RECORD_HEADER_LEN + NDEF_MESSAGE_STREAM_TYPE_ID_LEN]; /*!< Header, type and ID of the record being decoded */
+    uint32_t                   bufLen;        /*!< Bytes of buf received                                    */
+    uint32_t                   headerLen;     /*!< Header, type and ID length, 0 until the lengths are received */
+    uint32_t                   payloadOffset; /*!< Payload bytes of the record being decoded received       */
+    uint32_t                   recordCount;   /*!< Number of records completely decoded                     */
+    bool                       inPayload;     /*!< Header, type and ID decoded, receiving the payload       */
+    ReturnCode                 status;        /*!< First error met, the next chunks are rejected with it    */
+} ndefMessageStream;
+
+
 /*
  ******************************************************************************
  * GLOBAL FUNCTION PROTOTYPES
@@ -111,11 +159,33 @@ struct ndefMessageStruct
 ReturnCode ndefMessageInit(ndefMessage* message);
 
 
+/*!
+ *****************************************************************************
+ * Initialize an empty NDEF message using a record arena
+ *
+ * The records decoded into the message are allocated from the given arena,
+ * which is not reset: several messages may share an arena, and messages
+ * using different arenas remain valid independently of each other.
+ * ndefMessageInit() uses the default arena (shared by all the messages
+ * initialized with it) and resets it.
+ *
+ * \param[in,out] message to initialize
+ * \param[in]     arena: Record arena, NULL for the default arena
+ *
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefMessageInitWithArena(ndefMessage* message, ndefRecordArena* arena);
+
+
 /*!
  *****************************************************************************
  * Get NDEF message information
  *
- * Return the message information
+ * Return the message information, maintained on each append and on each
+ * change of a record through the record setters (ndefRecordSetType(),
+ * ndefRecordSetId(), ndefRecordSetPayload(), ndefRecordSetNdefType()).
+ * A record appended to a message must not be changed otherwise.
  *
  * \param[in]  message
  * \param[out] info: e.g. message length in bytes, number of records
@@ -140,10 +210,28 @@ ReturnCode ndefMessageGetInfo(const ndefMessage* message, ndefMessageInfo* info)
 uint32_t ndefMessageGetRecordCount(const ndefMessage* message);
 
 
+/*!
+ *****************************************************************************
+ * Update the NDEF message length after a change of one of its records
+ *
+ * Called by the record setters. No effect if the record is not in the
+ * list of its message, e.g. the message has been initialized again since
+ * the record was appended.
+ *
+ * \param[in] record:    Record changed
+ * \param[in] oldLength: Record length before the change
+ *****************************************************************************
+ */
+void ndefMessageUpdateRecordLength(const ndefRecord* record, uint32_t oldLength);
+
+
 /*!
  *****************************************************************************
  * Append a record to an NDEF message
  *
+ * A record can be appended to a single message, and only once. A record
+ * of a message initialized again since is detached and can be appended.
+ *
  * \param[in]     record:  Record to append
  * \param[in,out] message: Message to be appended with the given record
  *
@@ -168,6 +256,129 @@ ReturnCode ndefMessageAppend(ndefMessage* message, ndefRecord* record);
 ReturnCode ndefMessageDecode(const ndefConstBuffer* bufPayload, ndefMessage* message);
 
 
+/*!
+ *****************************************************************************
+ * Decode a raw buffer to an NDEF message using a record arena
+ *
+ * Convert a raw buffer to a message, the records being allocated from the
+ * given arena (see ndefMessageInitWithArena())
+ *
+ * \param[in]  bufPayload: Payload buffer to convert into message
+ * \param[in]  arena:      Record arena, NULL for the default arena
+ * \param[out] message:    Message created from the raw buffer
+ *
+ * \return ERR_NOMEM if the arena is exhausted
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefMessageDecodeWithArena(const ndefConstBuffer* bufPayload, ndefRecordArena* arena, ndefMessage* message);
+
+
+/*!
+ *****************************************************************************
+ * Initialize a record arena
+ *
+ * \param[out] arena:    Arena to initialize
+ * \param[in]  pool:     Record storage
+ * \param[in]  capacity: Number of records of the storage
+ *
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefRecordArenaInit(ndefRecordArena* arena, ndefRecord* pool, uint32_t capacity);
+
+
+/*!
+ *****************************************************************************
+ * Allocate a record from an arena
+ *
+ * \param[in,out] arena: Arena to allocate from
+ *
+ * \return the record allocated, NULL if the arena is exhausted
+ *****************************************************************************
+ */
+ndefRecord* ndefRecordArenaAlloc(ndefRecordArena* arena);
+
+
+/*!
+ *****************************************************************************
+ * Reset a record arena
+ *
+ * Releases all the records of the arena, the messages using them must no
+ * longer be accessed. The high water mark is kept.
+ *
+ * \param[in,out] arena: Arena to reset
+ *
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefRecordArenaReset(ndefRecordArena* arena);
+
+
+/*!
+ *****************************************************************************
+ * Get the high water mark of a record arena
+ *
+ * \param[in] arena
+ *
+ * \return highest number of records allocated at once since initialization
+ *****************************************************************************
+ */
+uint32_t ndefRecordArenaGetHighWaterMark(const ndefRecordArena* arena);
+
+
+/*!
+ *****************************************************************************
+ * Initialize a message stream
+ *
+ * The message is then fed by chunks of any size with ndefMessageStreamFeed(),
+ * as they are read from the tag, without needing the whole raw message in
+ * memory: the records are reported through the callbacks.
+ *
+ * \param[out] stream:    Message stream to initialize
+ * \param[in]  recordCb:  Called for each record header, NULL if not used
+ * \param[in]  payloadCb: Called for each payload fragment, NULL if not used
+ * \param[in]  userParam: Parameter passed to the callbacks
+ *
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefMessageStreamInit(ndefMessageStream* stream, ndefMessageStreamRecordCb recordCb, ndefMessageStreamPayloadCb payloadCb, void* userParam);
+
+
+/*!
+ *****************************************************************************
+ * Feed a chunk of a raw message to a message stream
+ *
+ * Decodes the chunk, calling the record callback for each record header
+ * completed and the payload callback for each payload fragment of the chunk.
+ * An error returned by a callback stops the decoding and is returned.
+ *
+ * \param[in,out] stream:   Message stream
+ * \param[in]     bufChunk: Next bytes of the raw message
+ *
+ * \return ERR_NOMEM if the type and ID of a record exceed NDEF_MESSAGE_STREAM_TYPE_ID_LEN
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefMessageStreamFeed(ndefMessageStream* stream, const ndefConstBuffer* bufChunk);
+
+
+/*!
+ *****************************************************************************
+ * End a message stream
+ *
+ * Checks that the raw message fed does not end in the middle of a record
+ *
+ * \param[in] stream: Message stream
+ *
+ * \return ERR_PROTO if the last record is truncated
+ * \return ERR_NONE if successful or a standard error code
+ *****************************************************************************
+ */
+ReturnCode ndefMessageStreamEnd(const ndefMessageStream* stream);
+
+
 #if NDEF_FEATURE_FULL_API
 /*!
  *****************************************************************************
@@ -139,6 +139,7 @@ typedef struct ndefRecordStruct
     const ndefType* ndeftype;      /*!< Well-known type data */
 
     struct ndefRecordStruct* next; /*!< Pointer to the next record, if any */
+    ndefMessage* message;          /*!< Message the record is appended to, if any */
 } ndefRecord;
 
 
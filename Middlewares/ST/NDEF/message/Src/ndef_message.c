@@ -51,7 +51,7 @@
  ******************************************************************************
  */
 
-#define NDEF_MAX_RECORD          10U    /*!< Maximum number of records */
+#define NDEF_MAX_RECORD          10U    /*!< Maximum number of records of the default arena */
 
 /*
  ******************************************************************************
@@ -65,7 +65,8 @@
  * LOCAL VARIABLES
  ******************************************************************************
  */
-static uint8_t ndefRecordPoolIndex = 0;
+static ndefRecord      ndefRecordPool[NDEF_MAX_RECORD];
+static ndefRecordArena ndefDefaultArena = { ndefRecordPool, NDEF_MAX_RECORD, 0, 0 };
 
 
 /*
@@ -73,19 +74,160 @@ static uint8_t ndefRecordPoolIndex = 0;
  * LOCAL FUNCTION PROTOTYPES
  ******************************************************************************
  */
+static ReturnCode ndefMessageDecodeRecords(const ndefConstBuffer* bufPayload, ndefMessage* message);
+static uint32_t ndefMessageStreamHeaderTarget(ndefMessageStream* stream);
+static ReturnCode ndefMessageStreamDecodeHeader(ndefMessageStream* stream);
+static bool ndefMessageHasRecord(const ndefMessage* message, const ndefRecord* record);
 
 
 /*****************************************************************************/
-static ndefRecord* ndefAllocRecord(void)
+static ReturnCode ndefMessageDecodeRecords(const ndefConstBuffer* bufPayload, ndefMessage* message)
 {
-    static ndefRecord ndefRecordPool[NDEF_MAX_RECORD];
+    ReturnCode err;
+    uint32_t offset;
 
-    if (ndefRecordPoolIndex >= NDEF_MAX_RECORD)
+    offset = 0;
+    while (offset < bufPayload->length)
     {
-        return NULL;
+        ndefConstBuffer bufRecord;
+        ndefRecord* record = ndefRecordArenaAlloc(message->arena);
+        if (record == NULL)
+        {
+            return ERR_NOMEM;
+        }
+        bufRecord.buffer = &bufPayload->buffer[offset];
+        bufRecord.length =  bufPayload->length - offset;
+        err = ndefRecordDecode(&bufRecord, record);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        offset += ndefRecordGetLength(record);
+
+        err = ndefMessageAppend(message, record);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
     }
 
-    return &ndefRecordPool[ndefRecordPoolIndex++];
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+static uint32_t ndefMessageStreamHeaderTarget(ndefMessageStream* stream)
+{
+    uint32_t length;
+
+    if (stream->headerLen != 0U)
+    {
+        return stream->headerLen;
+    }
+
+    if (stream->bufLen == 0U)
+    {
+        return sizeof(uint8_t);
+    }
+
+    /* Header byte received: the Short Record and Id Length bits give the length of the length fields */
+    stream->record.header = stream->buf[0];
+    length  = sizeof(uint8_t) + sizeof(uint8_t);
+    length += ndefHeaderIsSetSR(&stream->record) ? sizeof(uint8_t) : sizeof(uint32_t);
+    length += ndefHeaderIsSetIL(&stream->record) ? sizeof(uint8_t) : 0U;
+
+    return length;
+}
+
+
+/*****************************************************************************/
+static ReturnCode ndefMessageStreamDecodeHeader(ndefMessageStream* stream)
+{
+    ndefRecord* record = &stream->record;
+    uint32_t    offset;
+
+    if (stream->headerLen == 0U)
+    {
+        /* Length fields received */
+        (void)ndefRecordReset(record);
+
+        record->header     = stream->buf[0];
+        record->typeLength = stream->buf[1];
+        offset = sizeof(uint8_t) + sizeof(uint8_t);
+
+        if (ndefHeaderIsSetSR(record))
+        {
+            record->bufPayload.length = stream->buf[offset];
+            offset++;
+        }
+        else
+        {
+            record->bufPayload.length = GETU32(&stream->buf[offset]);
+            offset += sizeof(uint32_t);
+        }
+
+        if (ndefHeaderIsSetIL(record))
+        {
+            record->idLength = stream->buf[offset];
+            offset++;
+        }
+        else
+        {
+            record->idLength = 0;
+        }
+
+        stream->headerLen = offset + record->typeLength + record->idLength;
+        if (stream->headerLen > sizeof(stream->buf))
+        {
+            return ERR_NOMEM;
+        }
+
+        if (stream->bufLen < stream->headerLen)
+        {
+            /* Type and Id follow */
+            return ERR_NONE;
+        }
+    }
+
+    /* Header, type and Id received */
+    offset = stream->headerLen - record->typeLength - record->idLength;
+    record->type = (record->typeLength > 0U) ? &stream->buf[offset] : NULL;
+    record->id   = (record->idLength   > 0U) ? &stream->buf[offset + record->typeLength] : NULL;
+    record->bufPayload.buffer = NULL;
+
+    stream->inPayload     = true;
+    stream->payloadOffset = 0;
+
+    if (stream->recordCb != NULL)
+    {
+        return stream->recordCb(stream->userParam, record);
+    }
+
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+static bool ndefMessageHasRecord(const ndefMessage* message, const ndefRecord* record)
+{
+    const ndefRecord* current;
+
+    if (message == NULL)
+    {
+        return false;
+    }
+
+    current = message->record;
+    while (current != NULL)
+    {
+        if (current == record)
+        {
+            return true;
+        }
+        current = current->next;
+    }
+
+    return false;
 }
 
 
@@ -98,6 +240,21 @@ static ndefRecord* ndefAllocRecord(void)
 
 
 ReturnCode ndefMessageInit(ndefMessage* message)
+{
+    ReturnCode err;
+
+    err = ndefMessageInitWithArena(message, NULL);
+    if (err != ERR_NONE)
+    {
+        return err;
+    }
+
+    return ndefRecordArenaReset(&ndefDefaultArena);
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageInitWithArena(ndefMessage* message, ndefRecordArena* arena)
 {
     if (message == NULL)
     {
@@ -105,10 +262,10 @@ ReturnCode ndefMessageInit(ndefMessage* message)
     }
 
     message->record           = NULL;
+    message->last             = NULL;
     message->info.length      = 0;
     message->info.recordCount = 0;
-
-    ndefRecordPoolIndex = 0;
+    message->arena            = (arena == NULL) ? &ndefDefaultArena : arena;
 
     return ERR_NONE;
 }
@@ -117,27 +274,13 @@ ReturnCode ndefMessageInit(ndefMessage* message)
 /*****************************************************************************/
 ReturnCode ndefMessageGetInfo(const ndefMessage* message, ndefMessageInfo* info)
 {
-    ndefRecord* record;
-    uint32_t    length      = 0;
-    uint32_t    recordCount = 0;
-
     if ( (message == NULL) || (info == NULL) )
     {
         return ERR_PARAM;
     }
 
-    record = message->record;
-
-    while (record != NULL)
-    {
-        length += ndefRecordGetLength(record);
-        recordCount++;
-
-        record = record->next;
-    }
-
-    info->length      = length;
-    info->recordCount = recordCount;
+    info->length      = message->info.length;
+    info->recordCount = message->info.recordCount;
 
     return ERR_NONE;
 }
@@ -157,6 +300,20 @@ uint32_t ndefMessageGetRecordCount(const ndefMessage* message)
 }
 
 
+/*****************************************************************************/
+void ndefMessageUpdateRecordLength(const ndefRecord* record, uint32_t oldLength)
+{
+    /* The record may still point to a message re-initialized since it was appended */
+    if ( (record == NULL) || (ndefMessageHasRecord(record->message, record) == false) )
+    {
+        return;
+    }
+
+    record->message->info.length -= oldLength;
+    record->message->info.length += ndefRecordGetLength(record);
+}
+
+
 /*****************************************************************************/
 ReturnCode ndefMessageAppend(ndefMessage* message, ndefRecord* record)
 {
@@ -165,6 +322,12 @@ ReturnCode ndefMessageAppend(ndefMessage* message, ndefRecord* record)
         return ERR_PARAM;
     }
 
+    /* A record belongs to one message only, and can be appended only once */
+    if (ndefMessageHasRecord(record->message, record) == true)
+    {
+        return ERR_PARAM;
+    }
+
     /* Clear the Message Begin bit */
     ndefHeaderClearMB(record);
 
@@ -182,21 +345,16 @@ ReturnCode ndefMessageAppend(ndefMessage* message, ndefRecord* record)
     }
     else
     {
-        ndefRecord* current = message->record;
-
-        /* Go through the list of records */
-        while (current->next != NULL)
-        {
-            current = current->next;
-        }
-
         /* Clear the Message End bit to the record before the one being appended */
-        ndefHeaderClearME(current);
+        ndefHeaderClearME(message->last);
 
         /* Append to the last record */
-        current->next = record;
+        message->last->next = record;
     }
 
+    message->last   = record;
+    record->message = message;
+
     message->info.length      += ndefRecordGetLength(record);
     message->info.recordCount += 1U;
 
@@ -208,7 +366,6 @@ ReturnCode ndefMessageAppend(ndefMessage* message, ndefRecord* record)
 ReturnCode ndefMessageDecode(const ndefConstBuffer* bufPayload, ndefMessage* message)
 {
     ReturnCode err;
-    uint32_t offset;
 
     if ( (bufPayload == NULL) || (bufPayload->buffer == NULL) )
     {
@@ -221,29 +378,192 @@ ReturnCode ndefMessageDecode(const ndefConstBuffer* bufPayload, ndefMessage* mes
         return err;
     }
 
+    return ndefMessageDecodeRecords(bufPayload, message);
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageDecodeWithArena(const ndefConstBuffer* bufPayload, ndefRecordArena* arena, ndefMessage* message)
+{
+    ReturnCode err;
+
+    if ( (bufPayload == NULL) || (bufPayload->buffer == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    err = ndefMessageInitWithArena(message, arena);
+    if (err != ERR_NONE)
+    {
+        return err;
+    }
+
+    return ndefMessageDecodeRecords(bufPayload, message);
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefRecordArenaInit(ndefRecordArena* arena, ndefRecord* pool, uint32_t capacity)
+{
+    if ( (arena == NULL) || ( (pool == NULL) && (capacity != 0U) ) )
+    {
+        return ERR_PARAM;
+    }
+
+    arena->pool      = pool;
+    arena->capacity  = capacity;
+    arena->used      = 0;
+    arena->highWater = 0;
+
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+ndefRecord* ndefRecordArenaAlloc(ndefRecordArena* arena)
+{
+    if ( (arena == NULL) || (arena->used >= arena->capacity) )
+    {
+        return NULL;
+    }
+
+    arena->used++;
+    if (arena->used > arena->highWater)
+    {
+        arena->highWater = arena->used;
+    }
+
+    return &arena->pool[arena->used - 1U];
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefRecordArenaReset(ndefRecordArena* arena)
+{
+    if (arena == NULL)
+    {
+        return ERR_PARAM;
+    }
+
+    arena->used = 0;
+
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+uint32_t ndefRecordArenaGetHighWaterMark(const ndefRecordArena* arena)
+{
+    if (arena == NULL)
+    {
+        return 0;
+    }
+
+    return arena->highWater;
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageStreamInit(ndefMessageStream* stream, ndefMessageStreamRecordCb recordCb, ndefMessageStreamPayloadCb payloadCb, void* userParam)
+{
+    if (stream == NULL)
+    {
+        return ERR_PARAM;
+    }
+
+    stream->recordCb      = recordCb;
+    stream->payloadCb     = payloadCb;
+    stream->userParam     = userParam;
+    stream->bufLen        = 0;
+    stream->headerLen     = 0;
+    stream->payloadOffset = 0;
+    stream->recordCount   = 0;
+    stream->inPayload     = false;
+    stream->status        = ERR_NONE;
+
+    return ndefRecordReset(&stream->record);
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageStreamFeed(ndefMessageStream* stream, const ndefConstBuffer* bufChunk)
+{
+    ReturnCode err;
+    uint32_t   offset;
+    uint32_t   length;
+
+    if ( (stream == NULL) || (bufChunk == NULL) || ((bufChunk->buffer == NULL) && (bufChunk->length != 0U)) )
+    {
+        return ERR_PARAM;
+    }
+
+    if (stream->status != ERR_NONE)
+    {
+        return stream->status;
+    }
+
     offset = 0;
-    while (offset < bufPayload->length)
+    while (offset < bufChunk->length)
     {
-        ndefConstBuffer bufRecord;
-        ndefRecord* record = ndefAllocRecord();
-        if (record == NULL)
+        if (stream->inPayload)
         {
-            return ERR_NOMEM;
+            ndefConstBuffer bufFragment;
+
+            length = MIN(bufChunk->length - offset, stream->record.bufPayload.length - stream->payloadOffset);
+            bufFragment.buffer = &bufChunk->buffer[offset];
+            bufFragment.length = length;
+
+            err = (stream->payloadCb != NULL) ? stream->payloadCb(stream->userParam, &stream->record, &bufFragment, stream->payloadOffset) : ERR_NONE;
+
+            stream->payloadOffset += length;
         }
-        bufRecord.buffer = &bufPayload->buffer[offset];
-        bufRecord.length =  bufPayload->length - offset;
-        err = ndefRecordDecode(&bufRecord, record);
-        if (err != ERR_NONE)
+        else
         {
-            return err;
+            /* Gather the header, type and Id, their lengths being known as the header is received */
+            length = MIN(bufChunk->length - offset, ndefMessageStreamHeaderTarget(stream) - stream->bufLen);
+            ST_MEMCPY(&stream->buf[stream->bufLen], &bufChunk->buffer[offset], length);
+            stream->bufLen += length;
+
+            err = (stream->bufLen == ndefMessageStreamHeaderTarget(stream)) ? ndefMessageStreamDecodeHeader(stream) : ERR_NONE;
         }
-        offset += ndefRecordGetLength(record);
+        offset += length;
 
-        err = ndefMessageAppend(message, record);
         if (err != ERR_NONE)
         {
+            stream->status = err;
             return err;
         }
+
+        if ( stream->inPayload && (stream->payloadOffset == stream->record.bufPayload.length) )
+        {
+            /* Record complete */
+            stream->recordCount++;
+            stream->bufLen    = 0;
+            stream->headerLen = 0;
+            stream->inPayload = false;
+        }
+    }
+
+    return ERR_NONE;
+}
+
+
+/*****************************************************************************/
+ReturnCode ndefMessageStreamEnd(const ndefMessageStream* stream)
+{
+    if (stream == NULL)
+    {
+        return ERR_PARAM;
+    }
+
+    if (stream->status != ERR_NONE)
+    {
+        return stream->status;
+    }
+
+    if ( (stream->bufLen != 0U) || stream->inPayload )
+    {
+        return ERR_PROTO;
     }
 
     return ERR_NONE;
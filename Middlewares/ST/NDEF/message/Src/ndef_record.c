@@ -88,6 +88,9 @@ ReturnCode ndefRecordReset(ndefRecord* record)
         return ERR_PARAM;
     }
 
+    /* Not appended to any message */
+    record->message = NULL;
+
     /* Set the MB and ME bits */
     record->header = ndefHeader(1U, 1U, 0U, 0U, 0U, NDEF_TNF_EMPTY);
 
@@ -172,17 +175,23 @@ uint32_t ndefRecordGetLength(const ndefRecord* record)
 /*****************************************************************************/
 ReturnCode ndefRecordSetType(ndefRecord* record, uint8_t tnf, const ndefConstBuffer8* bufType)
 {
+    uint32_t oldLength;
+
     if ( (record  == NULL) ||
          (bufType == NULL) || ndefBufferIsInvalid(bufType) )
     {
         return ERR_PARAM;
     }
 
+    oldLength = (record->message != NULL) ? ndefRecordGetLength(record) : 0U;
+
     ndefHeaderSetTNF(record, tnf);
 
     record->typeLength = bufType->length;
     record->type       = bufType->buffer;
 
+    ndefMessageUpdateRecordLength(record, oldLength);
+
     return ERR_NONE;
 }
 
@@ -233,12 +242,16 @@ bool ndefRecordTypeMatch(const ndefRecord* record, uint8_t tnf, const ndefConstB
 /*****************************************************************************/
 ReturnCode ndefRecordSetId(ndefRecord* record, const ndefConstBuffer8* bufId)
 {
+    uint32_t oldLength;
+
     if ( (record == NULL) ||
          (bufId  == NULL) || ndefBufferIsInvalid(bufId) )
     {
         return ERR_PARAM;
     }
 
+    oldLength = (record->message != NULL) ? ndefRecordGetLength(record) : 0U;
+
     if (bufId->buffer != NULL)
     {
         ndefHeaderSetIL(record);
@@ -251,6 +264,8 @@ ReturnCode ndefRecordSetId(ndefRecord* record, const ndefConstBuffer8* bufId)
     record->id       = bufId->buffer;
     record->idLength = bufId->length;
 
+    ndefMessageUpdateRecordLength(record, oldLength);
+
     return ERR_NONE;
 }
 
@@ -273,17 +288,23 @@ ReturnCode ndefRecordGetId(const ndefRecord* record, ndefConstBuffer8* bufId)
 /*****************************************************************************/
 ReturnCode ndefRecordSetPayload(ndefRecord* record, const ndefConstBuffer* bufPayload)
 {
+    uint32_t oldLength;
+
     if ( (record     == NULL) ||
          (bufPayload == NULL) || ndefBufferIsInvalid(bufPayload) )
     {
         return ERR_PARAM;
     }
 
+    oldLength = (record->message != NULL) ? ndefRecordGetLength(record) : 0U;
+
     ndefHeaderSetValueSR(record, (bufPayload->length <= NDEF_SHORT_RECORD_LENGTH_MAX) ? 1 : 0);
 
     record->bufPayload.buffer = bufPayload->buffer;
     record->bufPayload.length = bufPayload->length;
 
+    ndefMessageUpdateRecordLength(record, oldLength);
+
     return ERR_NONE;
 }
 
@@ -40,6 +40,7 @@
  */
 
 #include "ndef_record.h"
+#include "ndef_message.h"
 #include "ndef_types.h"
 #include "st_errno.h"
 #include "utils.h"
@@ -191,6 +192,7 @@ ReturnCode ndefTypeToRecord(const ndefType* type, ndefRecord* record)
 ReturnCode ndefRecordSetNdefType(ndefRecord* record, const ndefType* type)
 {
     uint32_t payloadLength;
+    uint32_t oldLength;
 
     if ( (record == NULL) ||
          (type                   == NULL)               ||
@@ -203,12 +205,16 @@ ReturnCode ndefRecordSetNdefType(ndefRecord* record, const ndefType* type)
         return ERR_PARAM;
     }
 
+    oldLength = (record->message != NULL) ? ndefRecordGetLength(record) : 0U;
+
     record->ndeftype = type;
 
     /* Set Short Record bit accordingly */
     payloadLength = ndefRecordGetPayloadLength(record);
     ndefHeaderSetValueSR(record, (payloadLength <= NDEF_SHORT_RECORD_LENGTH_MAX) ? 1 : 0);
 
+    ndefMessageUpdateRecordLength(record, oldLength);
+
     return ERR_NONE;
 }
 
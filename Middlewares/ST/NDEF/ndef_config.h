@@ -74,6 +74,19 @@
 #define NDEF_FEATURE_FULL_API                  false       /*!< Support Write, Format, Check Presence, set Read-only in addition to the Read feature */
 #endif
 
+#ifndef NDEF_FEATURE_T5T_MULTIPLE_BLOCK_READ
+#define NDEF_FEATURE_T5T_MULTIPLE_BLOCK_READ   false      /* NDEF library configuration missing. Disabled by default */
+#endif
+#ifndef NDEF_FEATURE_T5T_MULTIPLE_BLOCK_WRITE
+#define NDEF_FEATURE_T5T_MULTIPLE_BLOCK_WRITE  false      /* NDEF library configuration missing. Disabled by default */
+#endif
+#ifndef NDEF_FEATURE_T2T_FAST_READ
+#define NDEF_FEATURE_T2T_FAST_READ             false      /* NDEF library configuration missing. Disabled by default */
+#endif
+#ifndef NDEF_FEATURE_T5T_DETECT_CACHE
+#define NDEF_FEATURE_T5T_DETECT_CACHE          false      /* NDEF library configuration missing. Disabled by default */
+#endif
+
 #ifndef NDEF_TYPE_EMPTY_SUPPORT
 #define NDEF_TYPE_EMPTY_SUPPORT                false      /* NDEF library configuration missing. Disabled by default */
 #endif
@@ -111,6 +124,18 @@
 #else
 
 #define NDEF_FEATURE_FULL_API                  true       /*!< Support Write, Format, Check Presence, set Read-only in addition to the Read feature */
+#ifndef NDEF_FEATURE_T5T_MULTIPLE_BLOCK_READ
+#define NDEF_FEATURE_T5T_MULTIPLE_BLOCK_READ   false      /*!< Use Read Multiple Blocks on T5T tags advertising it (CC MBREAD), several blocks per request */
+#endif /* NDEF_FEATURE_T5T_MULTIPLE_BLOCK_READ */
+#ifndef NDEF_FEATURE_T5T_MULTIPLE_BLOCK_WRITE
+#define NDEF_FEATURE_T5T_MULTIPLE_BLOCK_WRITE  false      /*!< Use Write Multiple Blocks on T5T tags advertising it (System Info command list) */
+#endif /* NDEF_FEATURE_T5T_MULTIPLE_BLOCK_WRITE */
+#ifndef NDEF_FEATURE_T2T_FAST_READ
+#define NDEF_FEATURE_T2T_FAST_READ             false      /*!< Use FAST_READ on T2T tags supporting it (NTAG), fall back to READ otherwise */
+#endif /* NDEF_FEATURE_T2T_FAST_READ */
+#ifndef NDEF_FEATURE_T5T_DETECT_CACHE
+#define NDEF_FEATURE_T5T_DETECT_CACHE          false      /*!< Keep the T5T NDEF detection results of the last tags seen to skip the block 0 read, Get System Information and NDEF TLV search on re-tap */
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
 
 #define NDEF_TYPE_EMPTY_SUPPORT                true       /*!< Support Empty type                          */
 #define NDEF_TYPE_FLAT_SUPPORT                 true       /*!< Support Flat type                           */
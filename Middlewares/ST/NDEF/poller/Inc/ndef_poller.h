@@ -94,6 +94,7 @@
 #define NDEF_TERMINATOR_TLV_T     0xFEU                                                /*!< Terminator TLV T=FEh                                         */
 
 #define NDEF_T2T_READ_RESP_SIZE     16U                                                /*!< Size of the READ response i.e. four blocks                   */
+#define NDEF_T2T_BLOCK_SIZE          4U                                                /*!< T2T block size                                               */
 
 #define NDEF_T3T_BLOCK_SIZE         16U                                                /*!< size for a block in t3t                                      */
 #define NDEF_T3T_MAX_NB_BLOCKS       4U                                                /*!< size for a block in t3t                                      */
@@ -109,6 +110,23 @@
           (32U +  NDEF_T5T_TxRx_BUFF_HEADER_SIZE + NDEF_T5T_TxRx_BUFF_FOOTER_SIZE)     /*!< T5T working buffer size                                      */
 
 #define NDEF_T2T_MAX_RSVD_AREAS      3U                                                /*!< Number of reserved areas including 1 Dyn Lock area           */
+
+#ifndef NDEF_T5T_DETECT_CACHE_SIZE
+#define NDEF_T5T_DETECT_CACHE_SIZE   4U                                                /*!< Number of tags kept in the T5T NDEF detection cache          */
+#endif /* NDEF_T5T_DETECT_CACHE_SIZE */
+#define NDEF_T5T_DETECT_CACHE_UID_LEN RFAL_NFCV_UID_LEN                                /*!< UID length of a T5T NDEF detection cache entry               */
+
+#ifndef NDEF_WRITE_GATHER_BUF_LEN
+#define NDEF_WRITE_GATHER_BUF_LEN  256U                                                /*!< ndefPollerWriteMessage() buffer, >= one write unit (T4T MLc) */
+#endif /* NDEF_WRITE_GATHER_BUF_LEN */
+
+#ifndef NDEF_WRITE_DIFF_BUF_LEN
+#define NDEF_WRITE_DIFF_BUF_LEN    128U                                                /*!< ndefPollerWriteRawMessageDiff() tag content buffer, >= one block */
+#endif /* NDEF_WRITE_DIFF_BUF_LEN */
+
+#ifndef NDEF_WRITE_DIFF_GAP_LEN
+#define NDEF_WRITE_DIFF_GAP_LEN    8U                                                  /*!< Max unchanged bytes rewritten to merge two T4T UPDATE BINARY */
+#endif /* NDEF_WRITE_DIFF_GAP_LEN */
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -245,6 +263,7 @@ typedef struct {
     uint8_t                      currentSecNo;                                   /*!< Current sector number                          */
     uint8_t                      cacheBuf[NDEF_T2T_READ_RESP_SIZE];              /*!< Cache buffer                                   */
     uint8_t                      nbrRsvdAreas;                                   /*!< Number of reseved Areas                        */
+    bool                         fastReadSupported;                              /*!< FAST_READ not rejected so far by the tag       */
     uint16_t                     dynLockNbrLockBits;                             /*!< Number of bits inside the DynLock_Area         */
     uint16_t                     dynLockBytesLockedPerBit;                       /*!< Number of bytes locked by one Dynamic Lock bit */
     uint16_t                     dynLockNbrBytes;                                /*!< Number of bytes inside the DynLock_Area        */
@@ -289,6 +308,35 @@ typedef struct {
     bool                         useMultipleBlockRead;         /*!< Access multiple block read                         */
 } ndefT5TContext;
 
+/*! T5T context initialization and NDEF detection results kept in the T5T NDEF detection cache */
+typedef struct {
+    uint32_t                     TlvNDEFOffset;                /*!< NDEF TLV message offset                            */
+    uint8_t                      blockLen;                     /*!< T5T BLEN parameter                                 */
+    ndefSystemInformation        sysInfo;                      /*!< System Information (when supported)                */
+    bool                         sysInfoSupported;             /*!< System Information Supported flag                  */
+    bool                         legacySTHighDensity;          /*!< Legacy ST High Density flag                        */
+} ndefT5TCacheParams;
+
+/*! Tag type parameters kept in the T5T NDEF detection cache */
+typedef union {
+    ndefT5TCacheParams           t5t;                          /*!< T5T parameters                                     */
+} ndefSubCacheParams;
+
+/*! T5T NDEF detection cache entry: results of the last NDEF detection of a tag */
+typedef struct {
+    uint32_t                     lastUse;                      /*!< Least Recently Used stamp, 0: free entry           */
+    ndefDeviceType               type;                         /*!< Device type                                        */
+    uint8_t                      nfcid[NDEF_T5T_DETECT_CACHE_UID_LEN]; /*!< Device's NFCID (UID)                       */
+    uint8_t                      nfcidLen;                     /*!< Device's NFCID length                              */
+    ndefState                    state;                        /*!< Tag state e.g. NDEF_STATE_INITIALIZED              */
+    ndefCapabilityContainer      cc;                           /*!< Capability Container                               */
+    uint32_t                     messageLen;                   /*!< NDEF message length                                */
+    uint32_t                     messageOffset;                /*!< NDEF message offset                                */
+    uint32_t                     areaLen;                      /*!< Area Length for NDEF storage                       */
+    uint8_t                      ccBuf[NDEF_CC_BUF_LEN];       /*!< CC as read from the tag                            */
+    ndefSubCacheParams           subCache;                     /*!< Tag type parameters                                */
+} ndefDetectCacheEntry;
+
 /*! NDEF context structure */
 typedef struct {
     rfalNfcDevice                device;                       /*!< ndef Device                                        */
@@ -309,6 +357,10 @@ typedef struct {
 #endif
         ndefT5TContext t5t;                                    /*!< T5T context                                        */
     } subCtx;                                                  /*!< Sub-context union                                  */
+#if NDEF_FEATURE_FULL_API
+    uint8_t                      gatherBuf[NDEF_WRITE_GATHER_BUF_LEN]; /*!< ndefPollerWriteMessage() write units  */
+    uint8_t                      diffBuf[NDEF_WRITE_DIFF_BUF_LEN];     /*!< Tag content being compared             */
+#endif /* NDEF_FEATURE_FULL_API */
 
 } ndefContext;
 
@@ -445,6 +497,35 @@ ReturnCode ndefPollerWriteBytes(ndefContext *ctx, uint32_t offset, const uint8_t
 ReturnCode ndefPollerReadRawMessage(ndefContext *ctx, uint8_t *buf, uint32_t bufLen, uint32_t *rcvdLen);
 
 
+/*!
+ *****************************************************************************
+ * \brief Read an NDEF message into a message stream
+ *
+ * This method reads the NDEF message by chunks of the given buffer length
+ * and feeds each chunk to the message stream as soon as it is read: the
+ * records are reported through the stream callbacks while the tag is being
+ * read, without the whole raw message in memory.
+ * Prior to NDEF Read procedure, a successful ndefPollerNdefDetect()
+ * has to be performed.
+ *
+ * A buffer length multiple of the tag read unit (e.g. 16 bytes for T2T,
+ * block length for T5T) avoids reading twice the blocks across two chunks.
+ *
+ * \param[in]     ctx    : ndef Context
+ * \param[in,out] stream : message stream initialized with ndefMessageStreamInit()
+ * \param[in]     buf    : working buffer holding one chunk
+ * \param[in]     bufLen : working buffer length
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_REQUEST      : read failed
+ * \return ERR_PARAM        : Invalid parameter
+ * \return ERR_PROTO        : Protocol error
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode ndefPollerReadMessageStream(ndefContext *ctx, ndefMessageStream *stream, uint8_t *buf, uint32_t bufLen);
+
+
 /*!
  *****************************************************************************
  * \brief Write raw NDEF message
@@ -611,6 +692,119 @@ ReturnCode ndefPollerEndWriteMessage(ndefContext *ctx, uint32_t messageLen);
 ReturnCode ndefPollerSetReadOnly(ndefContext *ctx);
 
 
+/*!
+ *****************************************************************************
+ * \brief Get Write Unit Length
+ *
+ * This method returns the length of the unit written at once on the tag:
+ * block length for T2T, T3T and T5T (a partially written block is read
+ * before being written), MLc for T4T (data length of an UPDATE BINARY).
+ *
+ * \param[in]   ctx       : ndef Context
+ *
+ * \return write unit length, 0 if unknown
+ *****************************************************************************
+ */
+uint32_t ndefPollerGetWriteUnitLength(const ndefContext *ctx);
+
+
+/*!
+ *****************************************************************************
+ * \brief Write a raw NDEF message, changed blocks only
+ *
+ * This method writes a raw NDEF message like ndefPollerWriteRawMessage()
+ * but only the blocks (T2T, T3T, T5T) or byte ranges (T4T UPDATE BINARY)
+ * that differ from the tag content are written. The tag content is taken
+ * from image when provided, read from the tag otherwise.
+ * When the message length changes, the L-field/NLEN is reset before and
+ * written after the changed blocks, as for a full write. Nothing is written
+ * when the message is unchanged.
+ * Prior to NDEF Write procedure, a successful ndefPollerNdefDetect()
+ * has to be performed.
+ *
+ * \param[in]   ctx      : ndef Context
+ * \param[in]   buf      : raw message buffer
+ * \param[in]   bufLen   : buffer length
+ * \param[in]   image    : message currently on the tag, e.g. read with
+ *                         ndefPollerReadRawMessage() or previously written,
+ *                         NULL to read it from the tag
+ * \param[in]   imageLen : image length
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_REQUEST      : write failed
+ * \return ERR_PARAM        : Invalid parameter
+ * \return ERR_PROTO        : Protocol error
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode ndefPollerWriteRawMessageDiff(ndefContext *ctx, const uint8_t *buf, uint32_t bufLen, const uint8_t *image, uint32_t imageLen);
+
+
+/*!
+ *****************************************************************************
+ * \brief Clear the T5T NDEF detection cache
+ *
+ * This method forgets all the tags kept in the T5T NDEF detection cache:
+ * the next context initialization and NDEF detection of any tag are fully
+ * performed.
+ * Only available when NDEF_FEATURE_T5T_DETECT_CACHE is enabled
+ *
+ *****************************************************************************
+ */
+void ndefPollerDetectCacheClear(void);
+
+
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+
+/*!
+ *****************************************************************************
+ * \brief Find a tag in the T5T NDEF detection cache
+ *
+ * This method looks up the device of the context in the detection cache
+ * (device type and NFCID) and marks the entry as most recently used.
+ * It is used by the tag type modules to skip the activation and NDEF
+ * detection steps of a tag already seen. The entry must be validated
+ * against the tag content before being used.
+ *
+ * \param[in]   ctx       : ndef Context
+ *
+ * \return entry of the device, NULL if the device is not in the cache
+ *****************************************************************************
+ */
+const ndefDetectCacheEntry* ndefPollerCacheFind(const ndefContext *ctx);
+
+
+/*!
+ *****************************************************************************
+ * \brief Store a tag in the T5T NDEF detection cache
+ *
+ * This method keeps the results of a successful NDEF detection of the
+ * device of the context, replacing its previous entry or else the least
+ * recently used one.
+ *
+ * \param[in]   ctx       : ndef Context
+ * \param[in]   subCache  : tag type parameters to be kept
+ *
+ *****************************************************************************
+ */
+void ndefPollerCacheStore(const ndefContext *ctx, const ndefSubCacheParams *subCache);
+
+
+/*!
+ *****************************************************************************
+ * \brief Remove a tag from the T5T NDEF detection cache
+ *
+ * This method is called when the tag content does not match its entry
+ *
+ * \param[in]   ctx       : ndef Context
+ *
+ *****************************************************************************
+ */
+void ndefPollerCacheInvalidate(const ndefContext *ctx);
+
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+
+
 #endif /* NDEF_POLLER_H */
 
 /**
@@ -66,6 +66,25 @@
  ******************************************************************************
  */
 
+#if NDEF_FEATURE_FULL_API
+
+/*! Compares a raw message with the tag content */
+typedef struct {
+    ndefContext   *ctx;                                        /*!< ndef Context                                       */
+    const uint8_t *buf;                                        /*!< New message                                        */
+    uint32_t       bufLen;                                     /*!< New message length                                 */
+    const uint8_t *image;                                      /*!< Known tag content, NULL if none                    */
+    uint32_t       imageOffset;                                /*!< Tag offset of the first image byte                 */
+    uint32_t       imageLen;                                   /*!< Image length                                       */
+    uint32_t       unitLen;                                    /*!< Length of the units compared                       */
+    uint32_t       gapLen;                                     /*!< Max unchanged bytes merged into a write            */
+    bool           tlv;                                        /*!< Message in an NDEF TLV (T2T, T5T)                  */
+    bool           begun;                                      /*!< L-Field/NLEN field reset                           */
+    bool           rewriteFirst;                               /*!< First unit overwritten by the L-Field reset        */
+} ndefPollerDiff;
+
+#endif /* NDEF_FEATURE_FULL_API */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -78,6 +97,11 @@
  ******************************************************************************
  */
 
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+static ndefDetectCacheEntry ndefDetectCache[NDEF_T5T_DETECT_CACHE_SIZE]; /*!< Recently seen tags      */
+static uint32_t             ndefDetectCacheStamp;                        /*!< Last LRU stamp given     */
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+
 /*
  ******************************************************************************
  * LOCAL FUNCTION PROTOTYPES
@@ -85,6 +109,15 @@
  */
 
 static ndefDeviceType ndefPollerGetDeviceType(const rfalNfcDevice *dev);
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+static ndefDetectCacheEntry* ndefPollerCacheLookup(const ndefContext *ctx);
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+#if NDEF_FEATURE_FULL_API
+static bool ndefPollerIsLinearArea(const ndefContext *ctx, uint32_t end);
+static ReturnCode ndefPollerDiffBegin(ndefPollerDiff *diff);
+static ReturnCode ndefPollerDiffFlush(ndefPollerDiff *diff, uint32_t offset, uint32_t len);
+static ReturnCode ndefPollerDiffWrite(ndefPollerDiff *diff);
+#endif /* NDEF_FEATURE_FULL_API */
 
 /*
  ******************************************************************************
@@ -507,8 +540,402 @@ ReturnCode ndefPollerSetReadOnly(ndefContext *ctx)
     return (ctx->ndefPollWrapper->pollerSetReadOnly)(ctx);
 }
 
+/*******************************************************************************/
+uint32_t ndefPollerGetWriteUnitLength(const ndefContext *ctx)
+{
+    uint32_t unitLen;
+
+    if( ctx == NULL )
+    {
+        return 0U;
+    }
+
+    switch( ndefPollerGetDeviceType(&ctx->device) )
+    {
+        case NDEF_DEV_T2T:
+            unitLen = NDEF_T2T_BLOCK_SIZE;
+            break;
+        case NDEF_DEV_T3T:
+            unitLen = NDEF_T3T_BLOCK_SIZE;
+            break;
+#if RFAL_FEATURE_T4T
+        case NDEF_DEV_T4T:
+            unitLen = ctx->subCtx.t4t.curMLc;
+            break;
+#endif /* RFAL_FEATURE_T4T */
+        case NDEF_DEV_T5T:
+            unitLen = ctx->subCtx.t5t.blockLen;
+            break;
+        default:
+            unitLen = 0U;
+            break;
+    }
+    return unitLen;
+}
+
+/*******************************************************************************/
+static bool ndefPollerIsLinearArea(const ndefContext *ctx, uint32_t end)
+{
+    uint32_t i;
+
+    /* T2T reserved areas are skipped by the T2T message write, not by ndefPollerWriteBytes() */
+    if( ndefPollerGetDeviceType(&ctx->device) == NDEF_DEV_T2T )
+    {
+        for( i = 0; i < ctx->subCtx.t2t.nbrRsvdAreas; i++ )
+        {
+            if( ctx->subCtx.t2t.rsvdAreaFirstByteAddr[i] < end )
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************/
+static ReturnCode ndefPollerDiffBegin(ndefPollerDiff *diff)
+{
+    ReturnCode err;
+
+    /* Reset L-Field/NLEN field */
+    err = ndefPollerBeginWriteMessage(diff->ctx, diff->bufLen);
+    if( err != ERR_NONE )
+    {
+        return err;
+    }
+    diff->begun = true;
+
+    /* T2T and T5T: the 1-byte L-field reset is followed by a Terminator TLV written over the first message byte */
+    diff->rewriteFirst = ( diff->tlv && (diff->bufLen <= NDEF_SHORT_VFIELD_MAX_LEN) );
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode ndefPollerDiffFlush(ndefPollerDiff *diff, uint32_t offset, uint32_t len)
+{
+    ReturnCode err;
+    uint32_t   messageOffset;
+    uint32_t   firstLen;
+
+    messageOffset = diff->ctx->messageOffset;
+    if( !diff->begun )
+    {
+        /* First change: the L-Field/NLEN field is reset before writing it */
+        err = ndefPollerDiffBegin(diff);
+        if( err != ERR_NONE )
+        {
+            return err;
+        }
+        if( (diff->rewriteFirst) && (offset != messageOffset) )
+        {
+            firstLen = MIN(((messageOffset / diff->unitLen) + 1U) * diff->unitLen, messageOffset + diff->bufLen) - messageOffset;
+            err = ndefPollerWriteBytes(diff->ctx, messageOffset, diff->buf, firstLen);
+            if( err != ERR_NONE )
+            {
+                return err;
+            }
+        }
+    }
+
+    return ndefPollerWriteBytes(diff->ctx, offset, &diff->buf[offset - messageOffset], len);
+}
+
+/*******************************************************************************/
+static ReturnCode ndefPollerDiffWrite(ndefPollerDiff *diff)
+{
+    ReturnCode     err;
+    const uint8_t *cur;
+    uint32_t       messageOffset;
+    uint32_t       messageEnd;
+    uint32_t       chunkOffset;
+    uint32_t       chunkEnd;
+    uint32_t       imageEnd;
+    uint32_t       unit;
+    uint32_t       unitEnd;
+    uint32_t       rangeOffset;
+    uint32_t       rangeLen;
+    uint32_t       rcvdLen;
+    bool           changed;
+
+    messageOffset = diff->ctx->messageOffset;
+    messageEnd    = messageOffset + diff->bufLen;
+    rangeOffset   = 0;
+    rangeLen      = 0;
+
+    chunkOffset = messageOffset;
+    while( chunkOffset < messageEnd )
+    {
+        /* Compare whole units, taken from the image as long as it covers them */
+        chunkEnd = MIN(((chunkOffset + sizeof(diff->ctx->diffBuf)) / diff->unitLen) * diff->unitLen, messageEnd);
+        imageEnd = diff->imageOffset + diff->imageLen;
+        if( (diff->image != NULL) && (chunkOffset >= diff->imageOffset) && (chunkEnd > imageEnd) && (((imageEnd / diff->unitLen) * diff->unitLen) > chunkOffset) )
+        {
+            chunkEnd = (imageEnd / diff->unitLen) * diff->unitLen;
+        }
+        if( (diff->image != NULL) && (chunkOffset >= diff->imageOffset) && (chunkEnd <= imageEnd) )
+        {
+            cur = &diff->image[chunkOffset - diff->imageOffset];
+        }
+        else
+        {
+            err = ndefPollerReadBytes(diff->ctx, chunkOffset, chunkEnd - chunkOffset, diff->ctx->diffBuf, &rcvdLen);
+            if( err != ERR_NONE )
+            {
+                return err;
+            }
+            if( rcvdLen != (chunkEnd - chunkOffset) )
+            {
+                return ERR_MEM_CORRUPT;
+            }
+            cur = diff->ctx->diffBuf;
+        }
+
+        for( unit = chunkOffset; unit < chunkEnd; unit = unitEnd )
+        {
+            unitEnd = MIN(((unit / diff->unitLen) + 1U) * diff->unitLen, chunkEnd);
+            changed = (ST_BYTECMP(&cur[unit - chunkOffset], &diff->buf[unit - messageOffset], unitEnd - unit) != 0);
+            if( (unit == messageOffset) && (diff->rewriteFirst) )
+            {
+                changed = true;
+            }
+
+            if( changed )
+            {
+                /* Merge the changed units into as few writes as possible */
+                if( (rangeLen != 0U) && (unit <= (rangeOffset + rangeLen + diff->gapLen)) )
+                {
+                    rangeLen = unitEnd - rangeOffset;
+                }
+                else
+                {
+                    if( rangeLen != 0U )
+                    {
+                        err = ndefPollerDiffFlush(diff, rangeOffset, rangeLen);
+                        if( err != ERR_NONE )
+                        {
+                            return err;
+                        }
+                    }
+                    rangeOffset = unit;
+                    rangeLen    = unitEnd - unit;
+                }
+            }
+        }
+        chunkOffset = chunkEnd;
+    }
+
+    if( rangeLen != 0U )
+    {
+        return ndefPollerDiffFlush(diff, rangeOffset, rangeLen);
+    }
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode ndefPollerWriteRawMessageDiff(ndefContext *ctx, const uint8_t *buf, uint32_t bufLen, const uint8_t *image, uint32_t imageLen)
+{
+    ReturnCode     err;
+    ndefPollerDiff diff;
+    ndefDeviceType type;
+
+    if( (ctx == NULL) || ((buf == NULL) && (bufLen != 0U)) || ((image == NULL) && (imageLen != 0U)) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( (ctx->state != NDEF_STATE_INITIALIZED) && (ctx->state != NDEF_STATE_READWRITE) )
+    {
+        /* Conclude procedure */
+        return ERR_WRONG_STATE;
+    }
+
+    type         = ndefPollerGetDeviceType(&ctx->device);
+    diff.unitLen = MIN(ndefPollerGetWriteUnitLength(ctx), sizeof(ctx->diffBuf));
+    diff.gapLen  = 0U;
+    diff.tlv     = ( (type == NDEF_DEV_T2T) || (type == NDEF_DEV_T5T) );
+    if( type == NDEF_DEV_T4T )
+    {
+        /* UPDATE BINARY writes any byte range: compare bytes, merge the ranges separated by a few unchanged bytes */
+        diff.unitLen = 1U;
+        diff.gapLen  = NDEF_WRITE_DIFF_GAP_LEN;
+    }
+
+    if( (bufLen == 0U) || (diff.unitLen == 0U) || !ndefPollerIsLinearArea(ctx, ctx->messageOffset + bufLen) )
+    {
+        /* Nothing to compare: full write */
+        return ndefPollerWriteRawMessage(ctx, buf, bufLen);
+    }
+
+    /* Verify length of the NDEF message */
+    err = ndefPollerCheckAvailableSpace(ctx, bufLen);
+    if( err != ERR_NONE )
+    {
+        /* Conclude procedure */
+        return ERR_PARAM;
+    }
+
+    diff.ctx          = ctx;
+    diff.buf          = buf;
+    diff.bufLen       = bufLen;
+    diff.image        = image;
+    diff.imageOffset  = ctx->messageOffset;
+    diff.imageLen     = imageLen;
+    diff.begun        = false;
+    diff.rewriteFirst = false;
+
+    if( (ctx->state != NDEF_STATE_READWRITE) || (ctx->messageLen != bufLen) )
+    {
+        /* New length: reset L-Field/NLEN field now, the message moves when the L-field length changes */
+        err = ndefPollerDiffBegin(&diff);
+        if( err != ERR_NONE )
+        {
+            /* Conclude procedure */
+            ctx->state = NDEF_STATE_INVALID;
+            return err;
+        }
+
+        if( ctx->messageOffset != diff.imageOffset )
+        {
+            if( !ndefPollerIsLinearArea(ctx, ctx->messageOffset + bufLen) )
+            {
+                return ndefPollerWriteRawMessage(ctx, buf, bufLen);
+            }
+            diff.image    = NULL;
+            diff.imageLen = 0U;
+        }
+    }
+    /* else: same length, the L-Field/NLEN field is reset on the first change only */
+
+    err = ndefPollerDiffWrite(&diff);
+    if( err != ERR_NONE )
+    {
+        /* Conclude procedure */
+        if( diff.begun )
+        {
+            ctx->state = NDEF_STATE_INVALID;
+        }
+        return err;
+    }
+
+    if( !diff.begun )
+    {
+        /* Message unchanged: nothing written */
+        return ERR_NONE;
+    }
+
+    /* Write L-Field/NLEN field last */
+    err = ndefPollerEndWriteMessage(ctx, bufLen);
+    if( err != ERR_NONE )
+    {
+        /* Conclude procedure */
+        ctx->state = NDEF_STATE_INVALID;
+        return err;
+    }
+
+    return ERR_NONE;
+}
+
 #endif /* NDEF_FEATURE_FULL_API */
 
+/*******************************************************************************/
+void ndefPollerDetectCacheClear(void)
+{
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+    (void)ST_MEMSET(ndefDetectCache, 0x00, sizeof(ndefDetectCache));
+    ndefDetectCacheStamp = 0U;
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+}
+
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+
+/*******************************************************************************/
+const ndefDetectCacheEntry* ndefPollerCacheFind(const ndefContext *ctx)
+{
+    ndefDetectCacheEntry *entry;
+
+    entry = ndefPollerCacheLookup(ctx);
+    if( entry != NULL )
+    {
+        entry->lastUse = ++ndefDetectCacheStamp;
+    }
+    return entry;
+}
+
+/*******************************************************************************/
+void ndefPollerCacheStore(const ndefContext *ctx, const ndefSubCacheParams *subCache)
+{
+    ndefDetectCacheEntry *entry;
+    uint32_t              i;
+
+    if( (ctx == NULL) || (subCache == NULL) || (ctx->device.nfcid == NULL) || (ctx->device.nfcidLen > NDEF_T5T_DETECT_CACHE_UID_LEN) )
+    {
+        return;
+    }
+
+    /* Replace the entry of the device, else a free or the least recently used one */
+    entry = ndefPollerCacheLookup(ctx);
+    if( entry == NULL )
+    {
+        entry = &ndefDetectCache[0];
+        for( i = 1U; i < NDEF_T5T_DETECT_CACHE_SIZE; i++ )
+        {
+            if( ndefDetectCache[i].lastUse < entry->lastUse )
+            {
+                entry = &ndefDetectCache[i];
+            }
+        }
+    }
+
+    entry->lastUse       = ++ndefDetectCacheStamp;
+    entry->type          = ndefPollerGetDeviceType(&ctx->device);
+    entry->nfcidLen      = ctx->device.nfcidLen;
+    (void)ST_MEMCPY(entry->nfcid, ctx->device.nfcid, ctx->device.nfcidLen);
+    entry->state         = ctx->state;
+    entry->cc            = ctx->cc;
+    entry->messageLen    = ctx->messageLen;
+    entry->messageOffset = ctx->messageOffset;
+    entry->areaLen       = ctx->areaLen;
+    (void)ST_MEMCPY(entry->ccBuf, ctx->ccBuf, sizeof(entry->ccBuf));
+    entry->subCache      = *subCache;
+}
+
+/*******************************************************************************/
+void ndefPollerCacheInvalidate(const ndefContext *ctx)
+{
+    ndefDetectCacheEntry *entry;
+
+    entry = ndefPollerCacheLookup(ctx);
+    if( entry != NULL )
+    {
+        (void)ST_MEMSET(entry, 0x00, sizeof(ndefDetectCacheEntry));
+    }
+}
+
+/*******************************************************************************/
+static ndefDetectCacheEntry* ndefPollerCacheLookup(const ndefContext *ctx)
+{
+    ndefDeviceType type;
+    uint32_t       i;
+
+    if( (ctx == NULL) || (ctx->device.nfcid == NULL) )
+    {
+        return NULL;
+    }
+
+    type = ndefPollerGetDeviceType(&ctx->device);
+    for( i = 0U; i < NDEF_T5T_DETECT_CACHE_SIZE; i++ )
+    {
+        if( (ndefDetectCache[i].lastUse != 0U) && (ndefDetectCache[i].type == type) && (ndefDetectCache[i].nfcidLen == ctx->device.nfcidLen) &&
+            (ST_BYTECMP(ndefDetectCache[i].nfcid, ctx->device.nfcid, ctx->device.nfcidLen) == 0) )
+        {
+            return &ndefDetectCache[i];
+        }
+    }
+    return NULL;
+}
+
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+
 /*******************************************************************************/
 static ndefDeviceType ndefPollerGetDeviceType(const rfalNfcDevice *dev)
 {
@@ -42,6 +42,7 @@
  */
 
 #include "ndef_poller.h"
+#include "utils.h"
 
 /*
  ******************************************************************************
@@ -61,6 +62,20 @@
  ******************************************************************************
  */
 
+#if NDEF_FEATURE_FULL_API
+
+/*! Gathers the encoded records into whole write units of the tag */
+typedef struct {
+    ndefContext *ctx;                                          /*!< ndef Context                                       */
+    uint8_t     *buf;                                          /*!< Bytes gathered                                     */
+    uint32_t     unitLen;                                      /*!< Tag write unit length                              */
+    uint32_t     flushLen;                                     /*!< Max bytes written at once, multiple of unitLen     */
+    uint32_t     offset;                                       /*!< Tag offset of the first byte gathered              */
+    uint32_t     len;                                          /*!< Number of bytes gathered                           */
+} ndefPollerGather;
+
+#endif /* NDEF_FEATURE_FULL_API */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -92,60 +107,149 @@
  */
 
 
+/*******************************************************************************/
+ReturnCode ndefPollerReadMessageStream(ndefContext *ctx, ndefMessageStream *stream, uint8_t *buf, uint32_t bufLen)
+{
+    ReturnCode      err;
+    ndefConstBuffer bufChunk;
+    uint32_t        offset;
+    uint32_t        rcvdLen;
+
+    if ( (ctx == NULL) || (stream == NULL) || (buf == NULL) || (bufLen == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    if (ctx->state == NDEF_STATE_INVALID)
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    offset = 0;
+    while (offset < ctx->messageLen)
+    {
+        err = ndefPollerReadBytes(ctx, ctx->messageOffset + offset, MIN(bufLen, ctx->messageLen - offset), buf, &rcvdLen);
+        if ( (err == ERR_NONE) && (rcvdLen == 0U) )
+        {
+            err = ERR_REQUEST;
+        }
+        if (err != ERR_NONE)
+        {
+            /* Conclude procedure */
+            return err;
+        }
+
+        bufChunk.buffer = buf;
+        bufChunk.length = rcvdLen;
+        err = ndefMessageStreamFeed(stream, &bufChunk);
+        if (err != ERR_NONE)
+        {
+            return err;
+        }
+        offset += rcvdLen;
+    }
+
+    return ndefMessageStreamEnd(stream);
+}
+
+
 #if NDEF_FEATURE_FULL_API
 
 /*******************************************************************************/
-static ReturnCode ndefPollerWriteRecord(ndefContext *ctx, const ndefRecord *record, uint32_t* recordOffset)
+static ReturnCode ndefPollerGatherFlush(ndefPollerGather *gather)
+{
+    ReturnCode err;
+
+    if (gather->len == 0U)
+    {
+        return ERR_NONE;
+    }
+
+    err = ndefPollerWriteBytes(gather->ctx, gather->offset, gather->buf, gather->len);
+
+    gather->offset += gather->len;
+    gather->len     = 0;
+
+    return err;
+}
+
+/*******************************************************************************/
+static ReturnCode ndefPollerGatherBytes(ndefPollerGather *gather, const uint8_t *buf, uint32_t len)
+{
+    ReturnCode err;
+    uint32_t   end;
+    uint32_t   length;
+    uint32_t   offset;
+
+    offset = 0;
+    while (offset < len)
+    {
+        /* The write ends on a unit boundary: the units are written once, whatever the record boundaries */
+        end    = ((gather->offset + gather->flushLen) / gather->unitLen) * gather->unitLen;
+        length = MIN(len - offset, end - (gather->offset + gather->len));
+        (void)ST_MEMCPY(&gather->buf[gather->len], &buf[offset], length);
+        gather->len += length;
+        offset      += length;
+
+        if ((gather->offset + gather->len) == end)
+        {
+            err = ndefPollerGatherFlush(gather);
+            if (err != ERR_NONE)
+            {
+                return err;
+            }
+        }
+    }
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode ndefPollerWriteRecord(ndefPollerGather *gather, const ndefRecord *record)
 {
     ReturnCode      err;
     uint8_t         recordHeaderBuf[NDEF_RECORD_HEADER_LEN];
     ndefBuffer      bufHeader;
     ndefConstBuffer bufPayloadItem;
-    uint32_t        offset;
     bool            firstPayloadItem;
 
-    if ( (ctx == NULL) || (record == NULL) || (recordOffset == NULL) )
+    if ( (gather == NULL) || (record == NULL) )
     {
         return ERR_PARAM;
     }
 
-    offset = *recordOffset;
-
     bufHeader.buffer = recordHeaderBuf;
     bufHeader.length = sizeof(recordHeaderBuf);
     (void)ndefRecordEncodeHeader(record, &bufHeader);
-    err = ndefPollerWriteBytes(ctx, offset, bufHeader.buffer, bufHeader.length);
+    err = ndefPollerGatherBytes(gather, bufHeader.buffer, bufHeader.length);
     if (err != ERR_NONE)
     {
         /* Conclude procedure */
         return err;
     }
-    offset += bufHeader.length;
 
     ndefConstBuffer8 bufType;
     ndefRecordGetType(record, NULL, &bufType);
     if (bufType.length != 0U)
     {
-        err = ndefPollerWriteBytes(ctx, offset, bufType.buffer, bufType.length);
+        err = ndefPollerGatherBytes(gather, bufType.buffer, bufType.length);
         if (err != ERR_NONE)
         {
             /* Conclude procedure */
             return err;
         }
-        offset += record->typeLength;
     }
 
     ndefConstBuffer8 bufId;
     ndefRecordGetId(record, &bufId);
     if (bufId.length != 0U)
     {
-        err = ndefPollerWriteBytes(ctx, offset, bufId.buffer, bufId.length);
+        err = ndefPollerGatherBytes(gather, bufId.buffer, bufId.length);
         if (err != ERR_NONE)
         {
             /* Conclude procedure */
             return err;
         }
-        offset += record->idLength;
     }
     if (ndefRecordGetPayloadLength(record) != 0U)
     {
@@ -153,28 +257,26 @@ static ReturnCode ndefPollerWriteRecord(ndefContext *ctx, const ndefRecord *reco
         while (ndefRecordGetPayloadItem(record, &bufPayloadItem, firstPayloadItem) != NULL)
         {
             firstPayloadItem = false;
-            err = ndefPollerWriteBytes(ctx, offset, bufPayloadItem.buffer, bufPayloadItem.length);
+            err = ndefPollerGatherBytes(gather, bufPayloadItem.buffer, bufPayloadItem.length);
             if (err != ERR_NONE)
             {
                 /* Conclude procedure */
                 return err;
             }
-            offset += bufPayloadItem.length;
         }
     }
 
-    *recordOffset = offset;
-
     return ERR_NONE;
 }
 
 /*******************************************************************************/
 ReturnCode ndefPollerWriteMessage(ndefContext *ctx, const ndefMessage *message)
 {
-    ReturnCode      err;
-    ndefMessageInfo info;
-    ndefRecord*     record;
-    uint32_t        offset;
+    ReturnCode       err;
+    ndefMessageInfo  info;
+    ndefRecord*      record;
+    ndefPollerGather gather;
+    uint32_t         unitLen;
 
     if ( (ctx == NULL) || (message == NULL) )
     {
@@ -196,6 +298,13 @@ ReturnCode ndefPollerWriteMessage(ndefContext *ctx, const ndefMessage *message)
         return ERR_PARAM;
     }
 
+    unitLen = MIN(ndefPollerGetWriteUnitLength(ctx), sizeof(ctx->gatherBuf));
+    if (unitLen == 0U)
+    {
+        /* Conclude procedure */
+        return ERR_PARAM;
+    }
+
     /* Reset L-Field/NLEN field */
     err = ndefPollerBeginWriteMessage(ctx, info.length);
     if (err != ERR_NONE)
@@ -207,12 +316,17 @@ ReturnCode ndefPollerWriteMessage(ndefContext *ctx, const ndefMessage *message)
 
     if (info.length != 0U)
     {
-        offset = ctx->messageOffset;
+        gather.ctx      = ctx;
+        gather.buf      = ctx->gatherBuf;
+        gather.unitLen  = unitLen;
+        gather.flushLen = (sizeof(ctx->gatherBuf) / unitLen) * unitLen;
+        gather.offset   = ctx->messageOffset;
+        gather.len      = 0;
 
         record = ndefMessageGetFirstRecord(message);
         while (record != NULL)
         {
-            err = ndefPollerWriteRecord(ctx, record, &offset);
+            err = ndefPollerWriteRecord(&gather, record);
             if (err != ERR_NONE)
             {
                 /* Conclude procedure */
@@ -223,6 +337,14 @@ ReturnCode ndefPollerWriteMessage(ndefContext *ctx, const ndefMessage *message)
             record = ndefMessageGetNextRecord(record);
         }
 
+        err = ndefPollerGatherFlush(&gather);
+        if (err != ERR_NONE)
+        {
+            /* Conclude procedure */
+            ctx->state = NDEF_STATE_INVALID;
+            return err;
+        }
+
         err = ndefPollerEndWriteMessage(ctx, info.length);
         if (err != ERR_NONE)
         {
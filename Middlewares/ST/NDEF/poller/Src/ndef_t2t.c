@@ -67,7 +67,6 @@
  ******************************************************************************
  */
 
-#define NDEF_T2T_BLOCK_SIZE            4U         /*!< block size                                        */
 #define NDEF_T2T_MAX_SECTOR          255U         /*!< Max Number of Sector in Sector Select Command     */ /* 00h -- FEh: 255 sectors */
 #define NDEF_T2T_BLOCKS_PER_SECTOR   256U         /*!< Number of Block per Sector                        */
 #define NDEF_T2T_BYTES_PER_SECTOR (NDEF_T2T_BLOCKS_PER_SECTOR * NDEF_T2T_BLOCK_SIZE) /*!< Number of Bytes per Sector                        */
@@ -114,6 +113,10 @@
 #define NDEF_T2T_N_RETRY_ERROR         1U         /*!< nT2T,RETRY,ERROR DP 2.2  B.7                     */
 #endif /* NDEF_T2T_N_RETRY_ERROR */
 
+#ifndef NDEF_T2T_FAST_READ_MAX_BLOCKS
+#define NDEF_T2T_FAST_READ_MAX_BLOCKS 48U         /*!< Max blocks per FAST_READ: 192 bytes + CRC fit in a single ST25R95 frame */
+#endif /* NDEF_T2T_FAST_READ_MAX_BLOCKS */
+
 #define NDEF_T2T_DYN_LOCK_BYTES_MAX   32U         /*!< Max number of Dyn Lock Bytes                      */
 
 /*
@@ -150,6 +153,9 @@
  ******************************************************************************
  */
 static ReturnCode ndefT2TPollerReadBlock(ndefContext *ctx, uint16_t blockAddr, uint8_t *buf);
+#if NDEF_FEATURE_T2T_FAST_READ
+static ReturnCode ndefT2TPollerFastReadBlocks(ndefContext *ctx, uint16_t blockAddr, uint32_t len, uint8_t *buf, uint32_t *rcvdLen);
+#endif /* NDEF_FEATURE_T2T_FAST_READ */
 
 #if NDEF_FEATURE_FULL_API
 static ReturnCode ndefT2TPollerWriteBlock(ndefContext *ctx, uint16_t blockAddr, const uint8_t *buf);
@@ -205,6 +211,74 @@ static ReturnCode ndefT2TPollerReadBlock(ndefContext *ctx, uint16_t blockAddr, u
     return ret;
 }
 
+#if NDEF_FEATURE_T2T_FAST_READ
+/*******************************************************************************/
+static ReturnCode ndefT2TPollerFastReadBlocks(ndefContext *ctx, uint16_t blockAddr, uint32_t len, uint8_t *buf, uint32_t *rcvdLen)
+{
+    ReturnCode           ret;
+    uint8_t              secNo;
+    uint8_t              blNo;
+    uint16_t             rcvLen;
+    uint32_t             nbBlocks;
+    uint32_t             retry;
+    rfalNfcaSensRes      sensRes;
+    rfalNfcaSelRes       selRes;
+
+    *rcvdLen = 0U;
+
+    /* Read as many full blocks as possible at once, without crossing the sector boundary */
+    secNo    = (uint8_t)(blockAddr >> 8U);
+    blNo     = (uint8_t)blockAddr;
+    nbBlocks = len / NDEF_T2T_BLOCK_SIZE;
+    nbBlocks = MIN(nbBlocks, NDEF_T2T_FAST_READ_MAX_BLOCKS);
+    nbBlocks = MIN(nbBlocks, NDEF_T2T_BLOCKS_PER_SECTOR - blNo);
+    if( !ctx->subCtx.t2t.fastReadSupported || (nbBlocks <= (NDEF_T2T_READ_RESP_SIZE/NDEF_T2T_BLOCK_SIZE)) )
+    {
+        /* Not worth it: a single READ does the job */
+        return ERR_NONE;
+    }
+
+    if( secNo != ctx->subCtx.t2t.currentSecNo )
+    {
+        ret = rfalT2TPollerSectorSelect(secNo);
+        if( ret != ERR_NONE )
+        {
+            return ret;
+        }
+        ctx->subCtx.t2t.currentSecNo = secNo;
+    }
+
+    retry = NDEF_T2T_N_RETRY_ERROR;
+    do
+    {
+        ret = rfalT2TPollerFastRead(blNo, (uint8_t)(blNo + nbBlocks - 1U), buf, (uint16_t)(nbBlocks * NDEF_T2T_BLOCK_SIZE), &rcvLen);
+    }
+    while ( (retry-- != 0U) && ndefT2TIsTransmissionError(ret) );
+
+    if( (ret == ERR_NONE) && (rcvLen == (nbBlocks * NDEF_T2T_BLOCK_SIZE)) )
+    {
+        *rcvdLen = nbBlocks * NDEF_T2T_BLOCK_SIZE;
+        return ERR_NONE;
+    }
+    if( ndefT2TIsTransmissionError(ret) )
+    {
+        return ret;
+    }
+
+    /* FAST_READ rejected (NACK or no answer): the tag may have gone back to IDLE, re-activate it and keep on with READ */
+    ndefT2TLogD("ndefT2TPollerFastReadBlocks not supported (%d)\r\n", ret);
+    ctx->subCtx.t2t.fastReadSupported = false;
+    ret = rfalNfcaPollerCheckPresence(RFAL_14443A_SHORTFRAME_CMD_WUPA, &sensRes);
+    if( ret == ERR_NONE )
+    {
+        ret = rfalNfcaPollerSelect(ctx->device.dev.nfca.nfcId1, ctx->device.dev.nfca.nfcId1Len, &selRes);
+    }
+    ctx->subCtx.t2t.currentSecNo = 0U;
+
+    return ret;
+}
+#endif /* NDEF_FEATURE_T2T_FAST_READ */
+
 /*******************************************************************************/
 ReturnCode ndefT2TPollerReadBytes(ndefContext *ctx, uint32_t offset, uint32_t len, uint8_t *buf, uint32_t *rcvdLen)
 {
@@ -216,6 +290,7 @@ ReturnCode ndefT2TPollerReadBytes(ndefContext *ctx, uint32_t offset, uint32_t le
     uint16_t             blockAddr;
     uint8_t              byteNo;
     uint8_t              numOfValidBlocks;
+    uint32_t             fastLen = 0U;
 
     ndefT2TLogD("ndefT2TPollerReadBytes offset: %d, len %d\r\n", offset, len);
     if( (ctx == NULL) || !ndefT2TisT2TDevice(&ctx->device) || (lvLen == 0U) || (offset > NDEF_T2T_MAX_OFFSET) )
@@ -233,54 +308,81 @@ ReturnCode ndefT2TPollerReadBytes(ndefContext *ctx, uint32_t offset, uint32_t le
         do {
             blockAddr = (uint16_t)(lvOffset / NDEF_T2T_BLOCK_SIZE);
             byteNo    =  (uint8_t)(lvOffset % NDEF_T2T_BLOCK_SIZE);
-            le = (lvLen < NDEF_T2T_READ_RESP_SIZE) ? (uint8_t)lvLen : (uint8_t)NDEF_T2T_READ_RESP_SIZE;
-            if( ((uint32_t)(uint8_t)blockAddr + (NDEF_T2T_READ_RESP_SIZE/NDEF_T2T_BLOCK_SIZE)) > NDEF_T2T_BLOCKS_PER_SECTOR )
-            {
-                numOfValidBlocks = -(uint8_t)blockAddr;
-                le = MIN(le, numOfValidBlocks * NDEF_T2T_BLOCK_SIZE);
-                ndefT2TLogD("ndefT2TPollerReadBytes blockAddr: 0x%4.4x numofValidBlock: %d le: %d \r\n", blockAddr, numOfValidBlocks, le);
-            }
-            else
-            {
-                numOfValidBlocks = NDEF_T2T_READ_RESP_SIZE/NDEF_T2T_BLOCK_SIZE;
-            }
-
-            if( (byteNo != 0U ) || (lvLen < NDEF_T2T_READ_RESP_SIZE) )
+#if NDEF_FEATURE_T2T_FAST_READ
+            if( byteNo == 0U )
             {
-                ret = ndefT2TPollerReadBlock(ctx, blockAddr, ctx->subCtx.t2t.cacheBuf);
+                ret = ndefT2TPollerFastReadBlocks(ctx, blockAddr, lvLen, lvBuf, &fastLen);
                 if( ret != ERR_NONE )
                 {
                     ndefT2TInvalidateCache(ctx);
                     return ret;
                 }
-                ctx->subCtx.t2t.cacheAddr = (uint32_t)blockAddr * NDEF_T2T_BLOCK_SIZE;
-                if( (NDEF_T2T_READ_RESP_SIZE - byteNo) < le )
-                {
-                    le = NDEF_T2T_READ_RESP_SIZE - byteNo;
-                }
-                if( le > 0U)
+            }
+#endif /* NDEF_FEATURE_T2T_FAST_READ */
+            if( fastLen != 0U )
+            {
+                if( (lvLen == fastLen) && (fastLen >= NDEF_T2T_READ_RESP_SIZE) )
                 {
-                    (void)ST_MEMCPY(lvBuf, &ctx->subCtx.t2t.cacheBuf[byteNo], le);
+                    /* cache the last read blocks */
+                    (void)ST_MEMCPY(&ctx->subCtx.t2t.cacheBuf[0], &lvBuf[fastLen - NDEF_T2T_READ_RESP_SIZE], NDEF_T2T_READ_RESP_SIZE);
+                    ctx->subCtx.t2t.cacheAddr = lvOffset + fastLen - NDEF_T2T_READ_RESP_SIZE;
                 }
+                lvBuf     = &lvBuf[fastLen];
+                lvOffset += fastLen;
+                lvLen    -= fastLen;
+                fastLen   = 0U;
             }
             else
             {
-                ret = ndefT2TPollerReadBlock(ctx, blockAddr, lvBuf);
-                if( ret != ERR_NONE )
+                le = (lvLen < NDEF_T2T_READ_RESP_SIZE) ? (uint8_t)lvLen : (uint8_t)NDEF_T2T_READ_RESP_SIZE;
+                if( ((uint32_t)(uint8_t)blockAddr + (NDEF_T2T_READ_RESP_SIZE/NDEF_T2T_BLOCK_SIZE)) > NDEF_T2T_BLOCKS_PER_SECTOR )
                 {
-                    return ret;
+                    numOfValidBlocks = -(uint8_t)blockAddr;
+                    le = MIN(le, numOfValidBlocks * NDEF_T2T_BLOCK_SIZE);
+                    ndefT2TLogD("ndefT2TPollerReadBytes blockAddr: 0x%4.4x numofValidBlock: %d le: %d \r\n", blockAddr, numOfValidBlocks, le);
                 }
-                if( (lvLen == le) && (numOfValidBlocks == (NDEF_T2T_READ_RESP_SIZE/NDEF_T2T_BLOCK_SIZE)) )
+                else
                 {
-                    /* cache the last read block */
-                    (void)ST_MEMCPY(&ctx->subCtx.t2t.cacheBuf[0], lvBuf, NDEF_T2T_READ_RESP_SIZE);
+                    numOfValidBlocks = NDEF_T2T_READ_RESP_SIZE/NDEF_T2T_BLOCK_SIZE;
+                }
+
+                if( (byteNo != 0U ) || (lvLen < NDEF_T2T_READ_RESP_SIZE) )
+                {
+                    ret = ndefT2TPollerReadBlock(ctx, blockAddr, ctx->subCtx.t2t.cacheBuf);
+                    if( ret != ERR_NONE )
+                    {
+                        ndefT2TInvalidateCache(ctx);
+                        return ret;
+                    }
                     ctx->subCtx.t2t.cacheAddr = (uint32_t)blockAddr * NDEF_T2T_BLOCK_SIZE;
+                    if( (NDEF_T2T_READ_RESP_SIZE - byteNo) < le )
+                    {
+                        le = NDEF_T2T_READ_RESP_SIZE - byteNo;
+                    }
+                    if( le > 0U)
+                    {
+                        (void)ST_MEMCPY(lvBuf, &ctx->subCtx.t2t.cacheBuf[byteNo], le);
+                    }
                 }
-            }
-            lvBuf     = &lvBuf[le];
-            lvOffset += le;
-            lvLen    -= le;
+                else
+                {
+                    ret = ndefT2TPollerReadBlock(ctx, blockAddr, lvBuf);
+                    if( ret != ERR_NONE )
+                    {
+                        return ret;
+                    }
+                    if( (lvLen == le) && (numOfValidBlocks == (NDEF_T2T_READ_RESP_SIZE/NDEF_T2T_BLOCK_SIZE)) )
+                    {
+                        /* cache the last read block */
+                        (void)ST_MEMCPY(&ctx->subCtx.t2t.cacheBuf[0], lvBuf, NDEF_T2T_READ_RESP_SIZE);
+                        ctx->subCtx.t2t.cacheAddr = (uint32_t)blockAddr * NDEF_T2T_BLOCK_SIZE;
+                    }
+                }
+                lvBuf     = &lvBuf[le];
+                lvOffset += le;
+                lvLen    -= le;
 
+            }
         } while( lvLen != 0U );
     }
 
@@ -379,6 +481,7 @@ ReturnCode ndefT2TPollerContextInitialization(ndefContext *ctx, const rfalNfcDev
 
     ctx->state                   = NDEF_STATE_INVALID;
     ctx->subCtx.t2t.currentSecNo = 0U;
+    ctx->subCtx.t2t.fastReadSupported = NDEF_FEATURE_T2T_FAST_READ;
     ndefT2TInvalidateCache(ctx);
 
    return ERR_NONE;
@@ -107,6 +107,21 @@
 
 #define NDEF_T5T_FLAG_LEN                     1U     /*!< Flag byte length                                  */
 
+#ifndef NDEF_T5T_MAX_RD_MULTIPLE_BLOCKS
+#define NDEF_T5T_MAX_RD_MULTIPLE_BLOCKS      32U     /*!< Max number of blocks per Read Multiple Blocks     */
+#endif /* NDEF_T5T_MAX_RD_MULTIPLE_BLOCKS */
+
+#ifndef NDEF_T5T_MAX_RD_MULTIPLE_LEN
+#define NDEF_T5T_MAX_RD_MULTIPLE_LEN        256U     /*!< Max data length per Read Multiple Blocks (RF buffer) */
+#endif /* NDEF_T5T_MAX_RD_MULTIPLE_LEN */
+
+#ifndef NDEF_T5T_MAX_WR_MULTIPLE_BLOCKS
+#define NDEF_T5T_MAX_WR_MULTIPLE_BLOCKS       4U     /*!< Max number of blocks per Write Multiple Blocks    */
+#endif /* NDEF_T5T_MAX_WR_MULTIPLE_BLOCKS */
+
+#define NDEF_T5T_MAX_WR_MULTIPLE_LEN    (NDEF_T5T_MAX_WR_MULTIPLE_BLOCKS * RFAL_NFCV_MAX_BLOCK_LEN) /*!< Max data length per Write Multiple Blocks */
+#define NDEF_T5T_WR_MULTIPLE_HEADER_LEN       6U     /*!< Write Multiple header: Flag, Cmd, Ext BNo (2), Ext NB (2) */
+
 #define NDEF_T5T_MAPPING_VERSION_1_0    (1U << 6)    /*!< T5T Version 1.0                                   */
 
 /*
@@ -127,6 +142,7 @@
 #define ndefT5TIsValidCache(ctx, block) ( (ctx)->subCtx.t5t.cacheBlock == (block) )
 
 #define ndefT5TIsTransmissionError(err)      ( ((err) == ERR_FRAMING) || ((err) == ERR_CRC) || ((err) == ERR_PAR) || ((err) == ERR_TIMEOUT) )
+#define ndefT5TUseMultipleBlockRead(ctx)     ( ((ctx)->cc.t5t.multipleBlockRead == true) && ((ctx)->subCtx.t5t.useMultipleBlockRead == true) )
 
 #define ndefT5TMajorVersion(V)               ((uint8_t)((V) >> 6U))    /*!< Get major version */
 
@@ -145,6 +161,13 @@
 
 static ReturnCode ndefT5TPollerReadSingleBlock(ndefContext *ctx, uint16_t blockNum, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
 static ReturnCode ndefT5TPollerReadMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint8_t numOfBlocks, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen);
+static uint16_t ndefT5TPollerReadMultipleBlocksNum(const ndefContext *ctx, uint16_t firstBlockNum, uint32_t len);
+static void ndefT5TPollerGetInfo(const ndefContext *ctx, ndefInfo *info);
+
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+static bool ndefT5TPollerCacheDetect(ndefContext *ctx);
+static void ndefT5TPollerCacheStore(const ndefContext *ctx);
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
 
 #if !defined NDEF_SKIP_T5T_SYS_INFO
 static ReturnCode ndefT5TGetSystemInformation(ndefContext *ctx, bool extended);
@@ -153,6 +176,8 @@ static ReturnCode ndefT5TGetSystemInformation(ndefContext *ctx, bool extended);
 #if NDEF_FEATURE_FULL_API
 static ReturnCode ndefT5TWriteCC(ndefContext *ctx);
 static ReturnCode ndefT5TPollerWriteSingleBlock(ndefContext *ctx, uint16_t blockNum, const uint8_t* wrData);
+static ReturnCode ndefT5TPollerWriteMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint16_t numOfBlocks, const uint8_t* wrData);
+static uint16_t ndefT5TPollerWriteMultipleBlocksNum(const ndefContext *ctx, uint16_t firstBlockNum, uint32_t len);
 static ReturnCode ndefT5TPollerLockSingleBlock(ndefContext *ctx, uint16_t blockNum);
 #endif /* NDEF_FEATURE_FULL_API */
 
@@ -238,6 +263,8 @@ ReturnCode ndefT5TPollerReadBytes(ndefContext *ctx, uint32_t offset, uint32_t le
     uint16_t        blockLen;
     uint16_t        startBlock;
     uint16_t        startAddr;
+    uint16_t        nbBlocks;
+    uint16_t        singleBlocks = 0U;
     uint32_t        currentLen = len;
     uint32_t        lvRcvLen   = 0U;
 
@@ -256,7 +283,7 @@ ReturnCode ndefT5TPollerReadBytes(ndefContext *ctx, uint32_t offset, uint32_t le
         startBlock = (uint16_t) (offset / blockLen);
         startAddr  = (uint16_t) (startBlock * blockLen);
 
-        res = ( (ctx->cc.t5t.multipleBlockRead == true) && (ctx->subCtx.t5t.useMultipleBlockRead == true) ) ?
+        res = ndefT5TUseMultipleBlockRead(ctx) ?
               /* Read a single block using the ReadMultipleBlock command... */
               ndefT5TPollerReadMultipleBlocks(ctx, startBlock, 0U, ctx->subCtx.t5t.txrxBuf, (uint16_t)sizeof(ctx->subCtx.t5t.txrxBuf), &nbRead) :
               ndefT5TPollerReadSingleBlock(ctx, startBlock, ctx->subCtx.t5t.txrxBuf, (uint16_t)sizeof(ctx->subCtx.t5t.txrxBuf), &nbRead);
@@ -284,26 +311,46 @@ ReturnCode ndefT5TPollerReadBytes(ndefContext *ctx, uint32_t offset, uint32_t le
             startBlock++;
             lastVal = buf[lvRcvLen - 1U]; /* Read previous value that is going to be overwritten by status byte (1st byte in response) */
 
-            res = ( (ctx->cc.t5t.multipleBlockRead == true) && (ctx->subCtx.t5t.useMultipleBlockRead == true) ) ?
-                  /* Read a single block using the ReadMultipleBlock command... */
-                  ndefT5TPollerReadMultipleBlocks(ctx, startBlock, 0U, &buf[lvRcvLen - 1U], blockLen + NDEF_T5T_FLAG_LEN + RFAL_CRC_LEN, &nbRead) :
-                  ndefT5TPollerReadSingleBlock(ctx, startBlock, &buf[lvRcvLen - 1U], blockLen + NDEF_T5T_FLAG_LEN + RFAL_CRC_LEN, &nbRead);
-            if (res != ERR_NONE)
+            /* Read as many blocks as possible at once, unless falling back to block per block after a failure */
+            nbBlocks = (singleBlocks == 0U) ? ndefT5TPollerReadMultipleBlocksNum(ctx, startBlock, currentLen) : 1U;
+            if (nbBlocks > 1U)
             {
-                return res;
+                res = ndefT5TPollerReadMultipleBlocks(ctx, startBlock, (uint8_t)(nbBlocks - 1U), &buf[lvRcvLen - 1U], (uint16_t)((nbBlocks * blockLen) + NDEF_T5T_FLAG_LEN + RFAL_CRC_LEN), &nbRead);
+                if ( (res != ERR_NONE) || (nbRead != ((nbBlocks * blockLen) + NDEF_T5T_FLAG_LEN)) )
+                {
+                    /* Tag limit or area boundary crossed: read this chunk block per block */
+                    singleBlocks = nbBlocks;
+                    nbBlocks     = 1U;
+                }
+            }
+            if (nbBlocks == 1U)
+            {
+                if (singleBlocks > 0U)
+                {
+                    singleBlocks--;
+                }
+                res = ndefT5TUseMultipleBlockRead(ctx) ?
+                      /* Read a single block using the ReadMultipleBlock command... */
+                      ndefT5TPollerReadMultipleBlocks(ctx, startBlock, 0U, &buf[lvRcvLen - 1U], blockLen + NDEF_T5T_FLAG_LEN + RFAL_CRC_LEN, &nbRead) :
+                      ndefT5TPollerReadSingleBlock(ctx, startBlock, &buf[lvRcvLen - 1U], blockLen + NDEF_T5T_FLAG_LEN + RFAL_CRC_LEN, &nbRead);
+                if (res != ERR_NONE)
+                {
+                    return res;
+                }
             }
 
             buf[lvRcvLen - 1U] = lastVal; /* Restore previous value */
 
-            lvRcvLen   += blockLen;
-            currentLen -= blockLen;
+            startBlock += (nbBlocks - 1U);
+            lvRcvLen   += ((uint32_t)nbBlocks * blockLen);
+            currentLen -= ((uint32_t)nbBlocks * blockLen);
         }
         if (currentLen > 0U)
         {
             /* Process the last block. Take care of removing status byte and 2 extra CRC bytes that could write after buffer end */
             startBlock++;
 
-            res = ( (ctx->cc.t5t.multipleBlockRead == true) && (ctx->subCtx.t5t.useMultipleBlockRead == true) ) ?
+            res = ndefT5TUseMultipleBlockRead(ctx) ?
                   /* Read a single block using the ReadMultipleBlock command... */
                   ndefT5TPollerReadMultipleBlocks(ctx, startBlock, 0U, ctx->subCtx.t5t.txrxBuf, (uint16_t)sizeof(ctx->subCtx.t5t.txrxBuf), &nbRead) :
                   ndefT5TPollerReadSingleBlock(ctx, startBlock, ctx->subCtx.t5t.txrxBuf, (uint16_t)sizeof(ctx->subCtx.t5t.txrxBuf), &nbRead);
@@ -341,6 +388,9 @@ ReturnCode ndefT5TPollerContextInitialization(ndefContext *ctx, const rfalNfcDev
 {
     ReturnCode    result;
     uint16_t      rcvLen;
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+    const ndefDetectCacheEntry *entry;
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
 
     if( (ctx == NULL) || (dev == NULL) || !ndefT5TisT5TDevice(dev) )
     {
@@ -369,7 +419,7 @@ ReturnCode ndefT5TPollerContextInitialization(ndefContext *ctx, const rfalNfcDev
 
     ctx->subCtx.t5t.blockLen      = 0U;
     ctx->subCtx.t5t.TlvNDEFOffset = 0U; /* Offset for TLV */
-    ctx->subCtx.t5t.useMultipleBlockRead = false;
+    ctx->subCtx.t5t.useMultipleBlockRead = NDEF_FEATURE_T5T_MULTIPLE_BLOCK_READ;
 
 #ifdef TEST_NDEF
     ndefT5TPollerAccessMode(ctx, gAccessMode);
@@ -377,6 +427,19 @@ ReturnCode ndefT5TPollerContextInitialization(ndefContext *ctx, const rfalNfcDev
     ndefT5TPollerAccessMode(ctx, NDEF_T5T_ACCESS_MODE_SELECTED);
 #endif
 
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+    /* Tag already seen: the block length and the system information do not change, skip their retrieval */
+    entry = ndefPollerCacheFind(ctx);
+    if( entry != NULL )
+    {
+        ctx->subCtx.t5t.blockLen            = entry->subCache.t5t.blockLen;
+        ctx->subCtx.t5t.legacySTHighDensity = entry->subCache.t5t.legacySTHighDensity;
+        ctx->subCtx.t5t.sysInfoSupported    = entry->subCache.t5t.sysInfoSupported;
+        ctx->subCtx.t5t.sysInfo             = entry->subCache.t5t.sysInfo;
+        return ERR_NONE;
+    }
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+
     /* T5T v1.1 4.1.1.3 Retrieve the Block Length */
     ctx->subCtx.t5t.legacySTHighDensity = false;
     result = ndefT5TPollerReadSingleBlock(ctx, 0U, ctx->subCtx.t5t.txrxBuf, (uint16_t)sizeof(ctx->subCtx.t5t.txrxBuf), &rcvLen);
@@ -458,6 +521,14 @@ ReturnCode ndefT5TPollerNdefDetect(ndefContext *ctx, ndefInfo *info)
         info->messageLen           = 0U;
     }
 
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+    if( ndefT5TPollerCacheDetect(ctx) )
+    {
+        ndefT5TPollerGetInfo(ctx, info);
+        return ERR_NONE;
+    }
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+
     result = ndefT5TPollerReadBytes(ctx, 0U, 4U, ctx->ccBuf, &rcvLen);
     if ( (result == ERR_NONE) && (rcvLen == 4U) && ( (ctx->ccBuf[0] == (uint8_t)0xE1U) || (ctx->ccBuf[0] == (uint8_t)0xE2U) ) )
     {
@@ -612,15 +683,14 @@ ReturnCode ndefT5TPollerNdefDetect(ndefContext *ctx, ndefInfo *info)
         }
     }
 
-    if( info != NULL )
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+    if( returnCode == ERR_NONE )
     {
-        info->state                = ctx->state;
-        info->majorVersion         = ctx->cc.t5t.majorVersion;
-        info->minorVersion         = ctx->cc.t5t.minorVersion;
-        info->areaLen              = ctx->areaLen;
-        info->areaAvalableSpaceLen = (uint32_t)ctx->cc.t5t.ccLen + ctx->areaLen - ctx->messageOffset;
-        info->messageLen           = ctx->messageLen;
+        ndefT5TPollerCacheStore(ctx);
     }
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+
+    ndefT5TPollerGetInfo(ctx, info);
     return returnCode;
 }
 
@@ -654,6 +724,8 @@ ReturnCode ndefT5TPollerWriteBytes(ndefContext *ctx, uint32_t offset, const uint
     uint16_t        blockLen;
     uint16_t        startBlock;
     uint16_t        startAddr;
+    uint16_t        nbBlocks;
+    uint16_t        singleBlocks = 0U;
     const uint8_t*  wrbuf      = buf;
     uint32_t        currentLen = len;
 
@@ -708,12 +780,32 @@ ReturnCode ndefT5TPollerWriteBytes(ndefContext *ctx, uint32_t offset, const uint
     }
     while (currentLen >= blockLen)
     {
-        res = ndefT5TPollerWriteSingleBlock(ctx, startBlock, wrbuf);
+        /* Write as many blocks as possible at once, unless falling back to block per block after a failure */
+        nbBlocks = (singleBlocks == 0U) ? ndefT5TPollerWriteMultipleBlocksNum(ctx, startBlock, currentLen) : 1U;
+        res      = ERR_NONE;
+        if (nbBlocks > 1U)
+        {
+            res = ndefT5TPollerWriteMultipleBlocks(ctx, startBlock, nbBlocks, wrbuf);
+            if (res != ERR_NONE)
+            {
+                /* Blocks of the chunk may have been partially written: rewrite them one by one */
+                singleBlocks = nbBlocks;
+                nbBlocks     = 1U;
+            }
+        }
+        if (nbBlocks == 1U)
+        {
+            if (singleBlocks > 0U)
+            {
+                singleBlocks--;
+            }
+            res = ndefT5TPollerWriteSingleBlock(ctx, startBlock, wrbuf);
+        }
         if (res == ERR_NONE)
         {
-            currentLen -= blockLen;
-            wrbuf       = &wrbuf[blockLen];
-            startBlock++;
+            currentLen -= ((uint32_t)nbBlocks * blockLen);
+            wrbuf       = &wrbuf[(uint32_t)nbBlocks * blockLen];
+            startBlock += nbBlocks;
         }
         else
         {
@@ -1233,6 +1325,88 @@ static ReturnCode ndefT5TPollerWriteSingleBlock(ndefContext *ctx, uint16_t block
     return ret;
 }
 
+/*******************************************************************************/
+static ReturnCode ndefT5TPollerWriteMultipleBlocks(ndefContext *ctx, uint16_t firstBlockNum, uint16_t numOfBlocks, const uint8_t* wrData)
+{
+    ReturnCode                ret;
+    uint8_t                   txBuf[NDEF_T5T_WR_MULTIPLE_HEADER_LEN + RFAL_NFCV_UID_LEN + NDEF_T5T_MAX_WR_MULTIPLE_LEN];
+    uint8_t                   flags;
+    const uint8_t*            uid;
+    uint32_t                  retry;
+    uint16_t                  wrDataLen;
+    uint8_t                   blockLen;
+
+    if( (ctx == NULL) || !ndefT5TisT5TDevice(&ctx->device) || ctx->subCtx.t5t.legacySTHighDensity || ctx->cc.t5t.specialFrame )
+    {
+        return ERR_PARAM;
+    }
+
+    blockLen  = (uint8_t)ctx->subCtx.t5t.blockLen;
+    wrDataLen = (uint16_t)((uint32_t)numOfBlocks * blockLen);
+    if( (numOfBlocks == 0U) || (wrDataLen > NDEF_T5T_MAX_WR_MULTIPLE_LEN) )
+    {
+        return ERR_PARAM;
+    }
+
+    uid   = ctx->subCtx.t5t.uid;
+    flags = ctx->subCtx.t5t.flags;
+
+    ndefT5TInvalidateCache(ctx);
+
+    retry = NDEF_T5T_N_RETRY_ERROR;
+    do
+    {
+        if( ((uint32_t)firstBlockNum + numOfBlocks) <= NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR )
+        {
+            ret = rfalNfcvPollerWriteMultipleBlocks(flags, uid, (uint8_t)firstBlockNum, (uint8_t)numOfBlocks, txBuf, (uint16_t)sizeof(txBuf), blockLen, wrData, wrDataLen);
+        }
+        else
+        {
+            ret = rfalNfcvPollerExtendedWriteMultipleBlocks(flags, uid, firstBlockNum, numOfBlocks, txBuf, (uint16_t)sizeof(txBuf), blockLen, wrData, wrDataLen);
+        }
+    }
+    while( (retry-- != 0U) && ndefT5TIsTransmissionError(ret) );
+
+    return ret;
+}
+
+/*******************************************************************************/
+static uint16_t ndefT5TPollerWriteMultipleBlocksNum(const ndefContext *ctx, uint16_t firstBlockNum, uint32_t len)
+{
+    uint32_t nbBlocks;
+    uint32_t blockLen;
+    bool     supported;
+
+    blockLen = ctx->subCtx.t5t.blockLen;
+    /* Special frame tags need an EOF to answer a write, not sent by the RFAL Write Multiple Blocks commands: single block writes only */
+    if( !NDEF_FEATURE_T5T_MULTIPLE_BLOCK_WRITE || ctx->subCtx.t5t.legacySTHighDensity || ctx->cc.t5t.specialFrame || (blockLen == 0U) || (len < (2U * blockLen)) ||
+        !ctx->subCtx.t5t.sysInfoSupported || (ndefT5TSysInfoCmdListPresent(ctx->subCtx.t5t.sysInfo.infoFlags) == 0U) )
+    {
+        return 1U;
+    }
+
+    /* Write Multiple Blocks support is only known from the Extended Get System Info command list */
+    supported = (firstBlockNum < NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR) ?
+                (ndefT5TSysInfoWriteMultipleBlocksSupported(ctx->subCtx.t5t.sysInfo.supportedCmd) != 0U) :
+                (ndefT5TSysInfoExtWriteMultipleBlocksSupported(ctx->subCtx.t5t.sysInfo.supportedCmd) != 0U);
+    if( !supported )
+    {
+        return 1U;
+    }
+
+    nbBlocks = len / blockLen;
+    nbBlocks = MIN(nbBlocks, NDEF_T5T_MAX_WR_MULTIPLE_BLOCKS);
+    nbBlocks = MIN(nbBlocks, (NDEF_T5T_MAX_WR_MULTIPLE_LEN / blockLen));
+    if( (firstBlockNum < NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR) &&
+        ((ndefT5TSysInfoExtWriteMultipleBlocksSupported(ctx->subCtx.t5t.sysInfo.supportedCmd) == 0U)) )
+    {
+        /* Do not cross the 1 byte addressing limit with a non extended command */
+        nbBlocks = MIN(nbBlocks, (uint32_t)NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR - firstBlockNum);
+    }
+
+    return (uint16_t)((nbBlocks == 0U) ? 1U : nbBlocks);
+}
+
 /*******************************************************************************/
 static ReturnCode ndefT5TPollerLockSingleBlock(ndefContext *ctx, uint16_t blockNum)
 {
@@ -1272,6 +1446,99 @@ static ReturnCode ndefT5TPollerLockSingleBlock(ndefContext *ctx, uint16_t blockN
 
 #endif /* NDEF_FEATURE_FULL_API */
 
+/*******************************************************************************/
+static void ndefT5TPollerGetInfo(const ndefContext *ctx, ndefInfo *info)
+{
+    if( info != NULL )
+    {
+        info->state                = ctx->state;
+        info->majorVersion         = ctx->cc.t5t.majorVersion;
+        info->minorVersion         = ctx->cc.t5t.minorVersion;
+        info->areaLen              = ctx->areaLen;
+        info->areaAvalableSpaceLen = (uint32_t)ctx->cc.t5t.ccLen + ctx->areaLen - ctx->messageOffset;
+        info->messageLen           = ctx->messageLen;
+    }
+}
+
+#if NDEF_FEATURE_T5T_DETECT_CACHE
+
+/*******************************************************************************/
+static bool ndefT5TPollerCacheDetect(ndefContext *ctx)
+{
+    const ndefDetectCacheEntry *entry;
+    uint8_t                     image[NDEF_CC_BUF_LEN + NDEF_T5T_TL_MAX_SIZE];
+    uint32_t                    ccLen;
+    uint32_t                    length;
+    uint32_t                    rcvLen;
+    ReturnCode                  result;
+
+    entry = ndefPollerCacheFind(ctx);
+    if( (entry == NULL) || (entry->messageOffset > sizeof(image)) )
+    {
+        return false;
+    }
+
+    /* The CC drives the block read mode: restore it before reading the tag */
+    ctx->cc = entry->cc;
+    ccLen   = entry->cc.t5t.ccLen;
+
+    /* Check that the CC and the NDEF TLV header still match the cached ones: read both in one go */
+    result = ndefT5TPollerReadBytes(ctx, 0U, entry->messageOffset, image, &rcvLen);
+    if( (result == ERR_NONE) && (rcvLen == entry->messageOffset) && (ST_BYTECMP(image, entry->ccBuf, ccLen) == 0) &&
+        (image[ccLen] == (uint8_t)NDEF_T5T_TLV_NDEF) )
+    {
+        if( (entry->messageOffset - ccLen) == (NDEF_T5T_TLV_T_LEN + NDEF_T5T_TLV_L_3_BYTES_LEN) )
+        {
+            length = ((uint32_t)image[ccLen + 2U] << 8U) + (uint32_t)image[ccLen + 3U];
+        }
+        else
+        {
+            length = image[ccLen + 1U];
+        }
+
+        if( length == entry->messageLen )
+        {
+            ctx->state                    = entry->state;
+            ctx->messageLen               = entry->messageLen;
+            ctx->messageOffset            = entry->messageOffset;
+            ctx->areaLen                  = entry->areaLen;
+            ctx->subCtx.t5t.TlvNDEFOffset = entry->subCache.t5t.TlvNDEFOffset;
+            (void)ST_MEMCPY(ctx->ccBuf, entry->ccBuf, sizeof(ctx->ccBuf));
+            return true;
+        }
+    }
+
+    /* Tag content changed: forget it and perform the full NDEF detection */
+    ndefPollerCacheInvalidate(ctx);
+    ctx->cc.t5t.ccLen             = 0U;
+    ctx->cc.t5t.memoryLen         = 0U;
+    ctx->cc.t5t.multipleBlockRead = false;
+    ndefT5TInvalidateCache(ctx);
+    return false;
+}
+
+/*******************************************************************************/
+static void ndefT5TPollerCacheStore(const ndefContext *ctx)
+{
+    ndefSubCacheParams subCache;
+
+    /* Only an NDEF TLV right after the CC can be validated by ndefT5TPollerCacheDetect() */
+    if( ctx->subCtx.t5t.TlvNDEFOffset != ctx->cc.t5t.ccLen )
+    {
+        ndefPollerCacheInvalidate(ctx);
+        return;
+    }
+
+    subCache.t5t.TlvNDEFOffset       = ctx->subCtx.t5t.TlvNDEFOffset;
+    subCache.t5t.blockLen            = ctx->subCtx.t5t.blockLen;
+    subCache.t5t.sysInfo             = ctx->subCtx.t5t.sysInfo;
+    subCache.t5t.sysInfoSupported    = ctx->subCtx.t5t.sysInfoSupported;
+    subCache.t5t.legacySTHighDensity = ctx->subCtx.t5t.legacySTHighDensity;
+    ndefPollerCacheStore(ctx, &subCache);
+}
+
+#endif /* NDEF_FEATURE_T5T_DETECT_CACHE */
+
 /*******************************************************************************/
 static ReturnCode ndefT5TPollerReadSingleBlock(ndefContext *ctx, uint16_t blockNum, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvLen)
 {
@@ -1374,6 +1641,32 @@ static ReturnCode ndefT5TPollerReadMultipleBlocks(ndefContext *ctx, uint16_t fir
     return ret;
 }
 
+/*******************************************************************************/
+static uint16_t ndefT5TPollerReadMultipleBlocksNum(const ndefContext *ctx, uint16_t firstBlockNum, uint32_t len)
+{
+    uint32_t nbBlocks;
+    uint32_t blockLen;
+
+    blockLen = ctx->subCtx.t5t.blockLen;
+    if( !ndefT5TUseMultipleBlockRead(ctx) || (blockLen == 0U) || (len <= RFAL_CRC_LEN) )
+    {
+        return 1U;
+    }
+
+    /* Leave room in the buffer for the CRC bytes received after the last block */
+    nbBlocks = (len - RFAL_CRC_LEN) / blockLen;
+    nbBlocks = MIN(nbBlocks, NDEF_T5T_MAX_RD_MULTIPLE_BLOCKS);
+    nbBlocks = MIN(nbBlocks, (NDEF_T5T_MAX_RD_MULTIPLE_LEN / blockLen));
+    nbBlocks = MIN(nbBlocks, NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR);              /* Number of blocks coded on 1 byte (NB + 1)    */
+    if( !ctx->subCtx.t5t.legacySTHighDensity && (firstBlockNum < NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR) )
+    {
+        /* Do not cross the 1 byte addressing limit with a non extended command */
+        nbBlocks = MIN(nbBlocks, (uint32_t)NDEF_T5T_MAX_BLOCK_1_BYTE_ADDR - firstBlockNum);
+    }
+
+    return (uint16_t)((nbBlocks == 0U) ? 1U : nbBlocks);
+}
+
 #if !defined NDEF_SKIP_T5T_SYS_INFO
 /*******************************************************************************/
 static ReturnCode ndefT5TGetSystemInformation(ndefContext *ctx, bool extended)
@@ -285,6 +285,29 @@ ReturnCode rfalChipMeasureCapacitance( uint8_t* result );
 ReturnCode rfalChipMeasurePowerSupply( uint8_t param, uint8_t* result );
 
 
+/*! 
+ *****************************************************************************
+ * \brief  Negotiate the UART baud rate
+ *
+ * Switches the host interface to the fastest UART baud rate supported by 
+ * the RF chip that does not exceed the given limit. Each rate is checked 
+ * with Echo commands; on failure the previous rate is restored and the next
+ * slower one is tried. To be called after rfalInitialize()
+ *
+ * \param[in]  maxBaudRate : highest baud rate (bps) supported by the MCU UART
+ * \param[out] baudRate    : baud rate (bps) in use on return
+ *
+ * \return  ERR_WRONG_STATE  : RFAL not initialized
+ * \return  ERR_REQUEST      : An operation is ongoing
+ * \return  ERR_PARAM        : Invalid parameter
+ * \return  ERR_SYSTEM       : Link lost, the RF chip must be reset
+ * \return  ERR_NOTSUPP      : Feature not supported (SPI interface)
+ * \return  ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalChipNegotiateUartBaudRate( uint32_t maxBaudRate, uint32_t* baudRate );
+
+
 #endif /* RFAL_CHIP_H */
 
 /**
@@ -81,6 +81,10 @@
     #define RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN    (1U)    /*!< ISO-DEP APDU max length, set to "none"    */
 #endif /* !RFAL_FEATURE_NFC_DEP  */
 
+#ifndef RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+    #define RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION  false  /*!< ISO-DEP link adaptation configuration missing. Disabled by default */
+#endif
+
 /*
  ******************************************************************************
  * DEFINES
@@ -895,6 +899,30 @@ ReturnCode rfalIsoDepPollBHandleActivation( rfalIsoDepFSxI FSDI, uint8_t DID, rf
 ReturnCode rfalIsoDepPollHandleSParameters( rfalIsoDepDevice *isoDepDev, rfalBitRate maxTxBR, rfalBitRate maxRxBR );
 
 
+/*! 
+ *****************************************************************************
+ *  \brief  ISO-DEP Poller Reset Link Adaptation
+ *   
+ *  The link adaptation watches the transmission errors (CRC, parity, framing,
+ *  timeout) of every Poller block exchange. After consecutive exchanges with
+ *  errors, or an exchange failing, the bit rate ceiling is lowered one step.
+ *  After consecutive exchanges without error it is raised back one step, the
+ *  number of exchanges required doubling each time a raise had to be undone.
+ *  As PPS is only allowed right after the ATS and the NFC-B bit rate is set
+ *  by ATTRIB, the ceiling applies from the next activation on, where the
+ *  highest bit rate supported by the Poller (maxBR), the Listener and the
+ *  RF chip is otherwise used.
+ *
+ *  This method clears what has been learned, and must be called by the user
+ *  of the ISO-DEP Poller activation methods when a different device is 
+ *  presented. rfalNfc calls it itself on the activation of a device whose
+ *  NFCID differs from the one the link adaptation has learned on.
+ *  No effect unless RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION is enabled
+ *****************************************************************************
+ */
+void rfalIsoDepPollResetLinkAdaptation( void );
+
+
 /*!
  *****************************************************************************
  *  \brief  ISO-DEP Poller Start NFC-A Activation 
@@ -92,6 +92,20 @@
 #define RFAL_NFC_LISTEN_TECH_F           0x4000U  /*!< NFC-V technology Flag     */
 #define RFAL_NFC_LISTEN_TECH_AP2P        0x8000U  /*!< NFC-V technology Flag     */
 
+#define RFAL_NFC_POLL_TECH_NUM           6U       /*!< Number of Poll technologies, index of a technology is its Flag bit position */
+
+#ifndef RFAL_FEATURE_NFC_ADAPTIVE_POLL
+#define RFAL_FEATURE_NFC_ADAPTIVE_POLL   false    /*!< Adaptive technology ordering configuration missing. Disabled by default */
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+
+#ifndef RFAL_NFC_ADAPTIVE_POLL_MAX_SKIP
+#define RFAL_NFC_ADAPTIVE_POLL_MAX_SKIP  3U       /*!< Max consecutive discovery cycles an enabled technology may be left out by the adaptive ordering */
+#endif /* RFAL_NFC_ADAPTIVE_POLL_MAX_SKIP */
+
+#ifndef RFAL_NFC_WORKER_BUDGET
+#define RFAL_NFC_WORKER_BUDGET           0U       /*!< Default discovery time per rfalNfcWorker() call in platformGetWorkerTime() units, 0: a single step per call */
+#endif /* RFAL_NFC_WORKER_BUDGET */
+
 
 /*
 ******************************************************************************
@@ -223,6 +237,17 @@ typedef union{  /*  PRQA S 0750 # MISRA 19.2 - Members of the union will not be
     rfalNfcDepPduBufFormat   nfcDepBuf;                          /*!< NFC-DEP buffer format (with header/prologue) */
 }rfalNfcBuffer;
 
+
+/*! Technology Detection statistics, per technology arrays are indexed by the technology Flag bit position */
+typedef struct{
+    uint32_t           cycles;                               /*!< Technology Detections performed                        */
+    uint32_t           detections;                           /*!< Technology Detections which found a technology         */
+    uint32_t           lastDetectionTime;                    /*!< Time to first detection of the last detection (ms)     */
+    uint32_t           totalDetectionTime;                   /*!< Sum of the times to first detection (ms)               */
+    uint32_t           probes[RFAL_NFC_POLL_TECH_NUM];       /*!< Number of times each technology has been polled        */
+    uint32_t           hits[RFAL_NFC_POLL_TECH_NUM];         /*!< Number of times each technology has been found         */
+}rfalNfcPollStats;
+
 /*******************************************************************************/
 
 /*
@@ -240,6 +265,104 @@ typedef union{  /*  PRQA S 0750 # MISRA 19.2 - Members of the union will not be
  */
 void rfalNfcWorker( void );
 
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Worker max execution time
+ *  
+ * Gets the longest execution time of a single rfalNfcWorker() call (RF 
+ * worker included) since initialization or last rfalNfcResetWorkerMaxTime(),
+ * in platformGetWorkerTime() units
+ * Only available when RFAL_FEATURE_BOUNDED_WORKER is enabled
+ *
+ * \param[out]  maxTime : longest rfalNfcWorker() execution time
+ *
+ * \return ERR_DISABLED : Feature not enabled
+ * \return ERR_PARAM    : Invalid parameter
+ * \return ERR_NONE     : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcGetWorkerMaxTime( uint32_t *maxTime );
+
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Worker max execution time reset
+ *  
+ * Restarts the tracking of the longest rfalNfcWorker() execution time
+ *****************************************************************************
+ */
+void rfalNfcResetWorkerMaxTime( void );
+
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Worker budget
+ *  
+ * Sets the time a single rfalNfcWorker() call may spend on the discovery, 
+ * in platformGetWorkerTime() units. Technology Detection and Collision 
+ * Resolution are performed one step (one technology, one slot) at a time,
+ * and steps are chained within a call while the budget is not exhausted.
+ * A call therefore lasts at most the budget plus one step.
+ * Set to RFAL_NFC_WORKER_BUDGET by rfalNfcInitialize(), 0: one step per call.
+ * Only available when RFAL_FEATURE_BOUNDED_WORKER is enabled
+ *
+ * \param[in]  budget : discovery time per rfalNfcWorker() call
+ *
+ * \return ERR_DISABLED : Feature not enabled
+ * \return ERR_NONE     : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcSetWorkerBudget( uint32_t budget );
+
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Adaptive Polling
+ *  
+ * Enables or disables the adaptive technology ordering of the Technology 
+ * Detection. When enabled the technologies of techs2Find are polled by 
+ * decreasing hit rate, and once a technology has been found the remaining 
+ * ones are left out of the cycle to reach the activation sooner.
+ * A technology is never left out more than RFAL_NFC_ADAPTIVE_POLL_MAX_SKIP 
+ * consecutive cycles, so every enabled technology is still polled at least
+ * once every RFAL_NFC_ADAPTIVE_POLL_MAX_SKIP + 1 cycles.
+ * Enabled by rfalNfcInitialize(), disabled: fixed NFC Forum order.
+ * Only available when RFAL_FEATURE_NFC_ADAPTIVE_POLL is enabled
+ *
+ * \param[in]  enable : true to reorder the technologies by hit rate
+ *
+ * \return ERR_DISABLED : Feature not enabled
+ * \return ERR_NONE     : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcSetAdaptivePolling( bool enable );
+
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Technology Detection statistics
+ *  
+ * Gets the Technology Detection statistics since initialization or last 
+ * rfalNfcResetPollStats(). The time to first detection is measured from the
+ * first technology polled in the cycle until the end of the Technology 
+ * Detection which found at least one technology.
+ * Only available when RFAL_FEATURE_NFC_ADAPTIVE_POLL is enabled
+ *
+ * \param[out]  stats : Technology Detection statistics
+ *
+ * \return ERR_DISABLED : Feature not enabled
+ * \return ERR_PARAM    : Invalid parameter
+ * \return ERR_NONE     : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcGetPollStats( rfalNfcPollStats *stats );
+
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Technology Detection statistics reset
+ *  
+ * Clears the Technology Detection statistics, the hit rates used by the 
+ * adaptive ordering are kept
+ *****************************************************************************
+ */
+void rfalNfcResetPollStats( void );
+
 /*! 
  *****************************************************************************
  * \brief  RFAL NFC Initialize
@@ -95,6 +95,11 @@
  * Relax with 3etu: (3*128)/fc as with multiple NFC-A cards, response may take longer (JCOP cards)
  *                            = (1236 + 384)/fc = 1620 / fc                                      */
 #define RFAL_NFCA_FDTMIN          1620U
+
+#ifndef RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+#define RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION  false  /*!< Fast collision resolution configuration missing. Disabled by default */
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -439,6 +444,64 @@ ReturnCode rfalNfcaPollerStartFullCollisionResolution( rfalComplianceMode compMo
 ReturnCode rfalNfcaPollerGetFullCollisionResolutionStatus( void );
 
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-A Poller Fast Collision Resolution
+ *  
+ * Performs a collision resolution like rfalNfcaPollerFullCollisionResolution
+ * but without restarting the anticollision of each device from scratch.
+ * Every collision detected in cascade level 1 records the NFCID1 prefix of
+ * the other branch. Once a device is selected and put to sleep, the next
+ * anticollision loop starts directly from a recorded prefix, skipping the
+ * SDD_REQs already done. The SENS_REQ (REQA) after each device is kept only
+ * to return the devices that saw a SEL_REQ for another NFCID1 to READY
+ * (ISO14443-3 6.3.3) and none is sent once no branch is left.
+ *
+ * Collisions that cannot be recorded (beyond cascade level 1, branch list 
+ * full or backtracking) fall back to a new anticollision loop from scratch.
+ * The number of SDD_REQs per device is bounded.
+ * Only available when RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION is enabled
+ *
+ * \param[in]  compMode    : compliance mode to be performed
+ * \param[in]  devLimit    : device limit value, and size nfcaDevList
+ * \param[out] nfcaDevList : NFC-A listener device info
+ * \param[out] devCnt      : Devices found counter
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_DISABLED     : Fast collision resolution disabled
+ * \return ERR_PROTO        : Protocol error detected, SDD_REQ bound reached
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcaPollerFastCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcaListenDevice *nfcaDevList, uint8_t *devCnt );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-A Poller Start Fast Collision Resolution
+ *  
+ * This method starts the fast Collision resolution described in
+ * rfalNfcaPollerFastCollisionResolution(). Its status is retrieved with
+ * rfalNfcaPollerGetFullCollisionResolutionStatus()
+ * Only available when RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION is enabled
+ *
+ * \param[in]  compMode    : compliance mode to be performed
+ * \param[in]  devLimit    : device limit value, and size nfcaDevList
+ * \param[out] nfcaDevList : NFC-A listener device info
+ * \param[out] devCnt      : Devices found counter
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_DISABLED     : Fast collision resolution disabled
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcaPollerStartFastCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcaListenDevice *nfcaDevList, uint8_t *devCnt );
+
+
 /*!
  *****************************************************************************
  * \brief NFC-A Listener is SLP_REQ 
@@ -371,6 +371,68 @@ ReturnCode rfalNfcbPollerCollisionResolution( rfalComplianceMode compMode, uint8
  */
 ReturnCode rfalNfcbPollerSlottedCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcbSlots initSlots, rfalNfcbSlots endSlots, rfalNfcbListenDevice *nfcbDevList, uint8_t *devCnt, bool *colPending );
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-B Poller Start Collision Resolution
+ *  
+ * This method starts the Collision resolution described in
+ * rfalNfcbPollerCollisionResolution(). Its status is retrieved with
+ * rfalNfcbPollerGetCollisionResolutionStatus()
+ *
+ * \param[in]  compMode    : compliance mode to be performed
+ * \param[in]  devLimit    : device limit value, and size nfcbDevList
+ * \param[out] nfcbDevList : NFC-B listener device info
+ * \param[out] devCnt      : devices found counter
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_FRAMING      : Transmission error on WUPB (EMVCo)
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcbPollerStartCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcbListenDevice *nfcbDevList, uint8_t *devCnt );
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-B Poller Start Collision Resolution Slotted
+ *  
+ * This method starts the Collision resolution described in
+ * rfalNfcbPollerSlottedCollisionResolution(). Its status is retrieved with
+ * rfalNfcbPollerGetCollisionResolutionStatus()
+ *
+ * \param[in]  compMode    : compliance mode to be performed
+ * \param[in]  devLimit    : device limit value, and size nfcbDevList
+ * \param[in]  initSlots   : number of slots to open initially 
+ * \param[in]  endSlots    : number of slots when to stop collision resolution 
+ * \param[out] nfcbDevList : NFC-B listener device info
+ * \param[out] devCnt      : devices found counter
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_FRAMING      : Transmission error on WUPB (EMVCo)
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcbPollerStartSlottedCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcbSlots initSlots, rfalNfcbSlots endSlots, rfalNfcbListenDevice *nfcbDevList, uint8_t *devCnt );
+
+/*!
+ *****************************************************************************
+ *  \brief  NFC-B Get Collision Resolution Status
+ *
+ *  Runs the Collision Resolution started by rfalNfcbPollerStartCollisionResolution()
+ *  or rfalNfcbPollerStartSlottedCollisionResolution() and returns its status.
+ *  Each call performs a single slot (one SENSB_REQ or Slot Marker)
+ *
+ *  \return ERR_BUSY         : Operation is ongoing
+ *  \return ERR_WRONG_STATE  : No Collision Resolution started
+ *  \return ERR_RF_COLLISION : Collision detected with devLimit set to 0
+ *  \return ERR_IO           : Generic internal error
+ *  \return ERR_PROTO        : Protocol error detected
+ *  \return ERR_NONE         : No error, Collision Resolution done
+ *****************************************************************************
+ */
+ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void );
+
 
 /*! 
  *****************************************************************************
@@ -75,6 +75,10 @@
 #define RFAL_NFCV_BLOCKNUM_LEN            1U              /*!< Block Number length on normal commands: 8 bits               */
 #define RFAL_NFCV_BLOCKNUM_EXTENDED_LEN   2U              /*!< Block Number length on extended commands: 16 bits            */
 #define RFAL_NFCV_PARAM_SKIP              0U              /*!< Skip proprietary Param Request                               */
+
+#ifndef RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+#define RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY  false       /*!< Adaptive inventory configuration missing. Disabled by default */
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
                                                                                                                             
                                                                                                                             
                                                                                                                             
@@ -356,6 +360,98 @@ ReturnCode rfalNfcvPollerCollisionResolution( rfalComplianceMode compMode, uint8
  */
 ReturnCode rfalNfcvPollerSleepCollisionResolution( uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt );
 
+/*!
+ *****************************************************************************
+ * \brief  NFC-V Poller Adaptive Collision Resolution
+ *
+ * Performs a collision resolution whose rounds follow the estimated tag
+ * population instead of always using 16 slots.
+ * The population answering a mask is estimated from the empty, single and
+ * collided slot counts of the previous round. A mask expected to hold few
+ * tags is resolved with 1 slot rounds extending the mask by 1 bit, avoiding
+ * the empty slots of a 16 slots round. A mask expected to hold many tags is
+ * resolved with 16 slots rounds extending the mask by 4 bits.
+ *
+ * In NFC compliance mode the first round is a 1 slot round, as in
+ * Activity 2.1 9.3.7.1. In ISO mode the first round depends on popHint.
+ * Once done, the devCnt will indicate how many (if any) devices have
+ * been identified and their details are contained on nfcvDevList
+ * Only available when RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY is enabled
+ *
+ * \param[in]  compMode     : compliance mode to be performed
+ * \param[in]  devLimit     : device limit value, and size nfcvDevList
+ * \param[in]  popHint      : expected number of devices (e.g. found by the
+ *                            previous inventory), 0 if unknown
+ * \param[out] nfcvDevList  : NFC-V listener devices list
+ * \param[out] devCnt       : Devices found counter
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_DISABLED     : Adaptive inventory disabled
+ * \return ERR_RF_COLLISION : Collision detected with devLimit set to 0
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerAdaptiveCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, uint8_t popHint, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt );
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-V Poller Start Full Collision Resolution
+ *  
+ * This method starts the full Collision resolution described in
+ * rfalNfcvPollerCollisionResolution(). Its status is retrieved with
+ * rfalNfcvPollerGetCollisionResolutionStatus()
+ *
+ * \param[in]  compMode     : compliance mode to be performed
+ * \param[in]  devLimit     : device limit value, and size nfcvDevList
+ * \param[out] nfcvDevList  : NFC-V listener devices list
+ * \param[out] devCnt       : Devices found counter
+ *
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerStartCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt );
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-V Poller Start Adaptive Collision Resolution
+ *  
+ * This method starts the adaptive Collision resolution described in
+ * rfalNfcvPollerAdaptiveCollisionResolution(). Its status is retrieved with
+ * rfalNfcvPollerGetCollisionResolutionStatus()
+ * Only available when RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY is enabled
+ *
+ * \param[in]  compMode     : compliance mode to be performed
+ * \param[in]  devLimit     : device limit value, and size nfcvDevList
+ * \param[in]  popHint      : expected number of devices, 0 if unknown
+ * \param[out] nfcvDevList  : NFC-V listener devices list
+ * \param[out] devCnt       : Devices found counter
+ *
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_DISABLED     : Adaptive inventory disabled
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerStartAdaptiveCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, uint8_t popHint, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt );
+
+/*!
+ *****************************************************************************
+ *  \brief  NFC-V Get Collision Resolution Status
+ *
+ *  Runs the Collision Resolution started by rfalNfcvPollerStartCollisionResolution()
+ *  or rfalNfcvPollerStartAdaptiveCollisionResolution() and returns its status.
+ *  Each call performs a single inventory slot (one INVENTORY_REQ or EOF)
+ *
+ *  \return ERR_BUSY         : Operation is ongoing
+ *  \return ERR_WRONG_STATE  : No Collision Resolution started
+ *  \return ERR_RF_COLLISION : Collision detected with devLimit set to 0
+ *  \return ERR_NONE         : No error, Collision Resolution done
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerGetCollisionResolutionStatus( void );
+
 /*! 
  *****************************************************************************
  * \brief  NFC-V Poller Sleep
@@ -450,6 +546,40 @@ ReturnCode rfalNfcvPollerReadSingleBlock( uint8_t flags, const uint8_t* uid, uin
  */
 ReturnCode rfalNfcvPollerWriteSingleBlock( uint8_t flags, const uint8_t* uid, uint8_t blockNum, const uint8_t* wrData, uint8_t blockLen );
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-V Poller Broadcast Write Single Block
+ *  
+ * Writes the same Single Block on several devices (VICC) at once: a non
+ * addressed Write Single Block is sent once, programming all devices in 
+ * Ready or Selected state simultaneously. 
+ * The devices of the given list in Quiet state (isSleep set, e.g. by 
+ * rfalNfcvPollerSleepCollisionResolution()) are first put back to Ready 
+ * with an addressed Reset To Ready, and their isSleep flag cleared. The 
+ * caller must do the same for devices put to Quiet state otherwise.
+ * Each device of the given list is then verified with an addressed Read 
+ * Single Block, and the devices not holding the expected data are written
+ * in addressed mode, up to RFAL_NFCV_BROADCAST_WR_N_RETRY times
+ *
+ * \param[in]  flags        : Flags to be used: Sub-carrier; Data_rate; Option
+ *                            for NFC-Forum use: RFAL_NFCV_REQ_FLAG_DEFAULT
+ * \param[in]  blockNum     : Number of the block to write
+ * \param[in]  wrData       : data to be written on the given block
+ * \param[in]  blockLen     : number of bytes of a block
+ * \param[in,out] nfcvDevList : devices to be verified (from collision resolution)
+ * \param[in]  devCnt       : number of devices in nfcvDevList
+ * \param[out] failCnt      : number of devices failing verification (optional)
+ *  
+ * \return ERR_WRONG_STATE  : RFAL not initialized or incorrect mode
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_IO           : Generic internal error 
+ * \return ERR_WRITE        : Data read back differs on at least one device
+ * \return ERR_TIMEOUT      : At least one device did not answer
+ * \return ERR_NONE         : Block written and verified on all devices
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerBroadcastWriteSingleBlock( uint8_t flags, uint8_t blockNum, const uint8_t* wrData, uint8_t blockLen, rfalNfcvListenDevice *nfcvDevList, uint8_t devCnt, uint8_t *failCnt );
+
 /*! 
  *****************************************************************************
  * \brief  NFC-V Poller Read Multiple Blocks
@@ -129,6 +129,30 @@
 #define RFAL_NFCID1_DOUBLE_LEN                     7U                                           /*!< NFCID1 length                                     */
 #define RFAL_NFCID1_SINGLE_LEN                     4U                                           /*!< NFCID1 length                                     */
 
+#ifndef RFAL_FEATURE_BOUNDED_WORKER
+#define RFAL_FEATURE_BOUNDED_WORKER                false                                        /*!< Bounded worker configuration missing. Disabled by default */
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+
+#ifndef RFAL_FEATURE_ASYNC_TRANSCEIVE
+#define RFAL_FEATURE_ASYNC_TRANSCEIVE              false                                        /*!< Asynchronous transceive configuration missing. Disabled by default */
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+
+#ifndef RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN
+#define RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN            4U                                           /*!< Number of frames queued behind the ongoing asynchronous transceive */
+#endif /* RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN */
+
+#ifndef platformGetWorkerTime
+#define platformGetWorkerTime()                    platformGetSysTick()                         /*!< Time base of the worker execution time tracking   */
+#endif /* platformGetWorkerTime */
+
+#ifndef RFAL_FEATURE_MAX_INSTANCES
+#define RFAL_FEATURE_MAX_INSTANCES                 1U                                           /*!< Number of RF chip instances configuration missing. Single instance by default */
+#endif /* RFAL_FEATURE_MAX_INSTANCES */
+
+#ifndef RFAL_INSTANCE_STORAGE
+#define RFAL_INSTANCE_STORAGE                                                                   /*!< Storage class of the selected instance, e.g. _Thread_local to select per thread */
+#endif /* RFAL_INSTANCE_STORAGE */
+
 
 /*
 ******************************************************************************
@@ -136,6 +160,12 @@
 ******************************************************************************
 */
 
+#if (RFAL_FEATURE_MAX_INSTANCES > 1U)
+#define rfalInstanceIdx()                    (gRfalInstanceIdx)                                 /*!< Index of the instance the RFAL calls operate on   */
+#else
+#define rfalInstanceIdx()                    (0U)                                               /*!< Index of the instance the RFAL calls operate on   */
+#endif /* RFAL_FEATURE_MAX_INSTANCES */
+
 /*! Returns the maximum supported bit rate for RW mode. Caller must check if mode is supported before, as even if mode is not supported will return the min  */
 #define rfalGetMaxBrRW()                     ( ((RFAL_SUPPORT_BR_RW_6780)  ? RFAL_BR_6780 : ((RFAL_SUPPORT_BR_RW_3390)  ? RFAL_BR_3390 : ((RFAL_SUPPORT_BR_RW_1695)  ? RFAL_BR_1695 : ((RFAL_SUPPORT_BR_RW_848)  ? RFAL_BR_848 : ((RFAL_SUPPORT_BR_RW_424)  ? RFAL_BR_424 : ((RFAL_SUPPORT_BR_RW_212)  ? RFAL_BR_212 : RFAL_BR_106 ) ) ) ) ) ) )
 
@@ -409,6 +439,9 @@ typedef void (* rfalPreTxRxCallback)(void);
 /*! Callback to be executed after a Transceive                               */
 typedef void (* rfalPostTxRxCallback)(void);
 
+/*! Callback executed when an asynchronous Transceive completes: its context, its status (rfalGetTransceiveStatus()) and the user parameter */
+typedef void (* rfalTransceiveCompleteCallback)( const rfalTransceiveContext *ctx, ReturnCode status, void *param );
+
 
 /*******************************************************************************/
 /*  ISO14443A                                                                  */
@@ -606,6 +639,16 @@ typedef struct
 
 /*******************************************************************************/
 
+/*
+******************************************************************************
+* GLOBAL VARIABLES
+******************************************************************************
+*/
+
+#if (RFAL_FEATURE_MAX_INSTANCES > 1U)
+extern RFAL_INSTANCE_STORAGE uint8_t gRfalInstanceIdx;  /*!< Selected instance, internal to RFAL: use rfalSelectInstance() */
+#endif /* RFAL_FEATURE_MAX_INSTANCES */
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTION PROTOTYPES
@@ -1047,6 +1090,68 @@ ReturnCode rfalFieldOff( void );
 ReturnCode rfalStartTransceive( const rfalTransceiveContext *ctx );
 
 
+/*! 
+ *****************************************************************************
+ * \brief  RFAL Start asynchronous transceive
+ *  
+ * Starts a Transceive whose completion is notified through a callback 
+ * executed by rfalWorker(), so that the caller keeps running its own tasks 
+ * (parsing the previous response, logging, I/O) while the frame is on air.
+ * 
+ * When an asynchronous Transceive is already ongoing the frame is queued, 
+ * up to RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN frames, and is started by rfalWorker()
+ * as soon as the previous one completes, before the previous callback is 
+ * executed. A frame that depends on the previous response shall therefore 
+ * be started from the callback of the previous one.
+ * 
+ * As for rfalStartTransceive() the received length is reported in bits and
+ * the context buffers must remain valid until the callback is executed.
+ * A queued frame that cannot be started completes with the error of 
+ * rfalStartTransceive().
+ * 
+ * Only available when RFAL_FEATURE_ASYNC_TRANSCEIVE is enabled
+ * 
+ * \param[in]  ctx   : the context of the Transceive
+ * \param[in]  pFunc : callback executed on completion, NULL for none
+ * \param[in]  param : user parameter passed to the callback
+ * 
+ * \see  rfalWorker
+ * \see  rfalGetAsyncTransceivePending
+ *
+ * \return ERR_DISABLED    : Feature not enabled
+ * \return ERR_PARAM       : Invalid parameter
+ * \return ERR_NOMEM       : Queue full
+ * \return ERR_REQUEST     : A blocking Transceive is ongoing
+ * \return ERR_WRONG_STATE : Not initialized properly 
+ * \return ERR_NONE        : Transceive started or queued
+ *****************************************************************************
+ */
+ReturnCode rfalStartTransceiveAsync( const rfalTransceiveContext *ctx, rfalTransceiveCompleteCallback pFunc, void *param );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  Get pending asynchronous transceives
+ *  
+ * \return number of asynchronous Transceives ongoing or queued, 0 when
+ *         all callbacks have been executed
+ *****************************************************************************
+ */
+uint8_t rfalGetAsyncTransceivePending( void );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  Flush asynchronous transceive queue
+ *  
+ * Drops the queued asynchronous Transceives without executing their 
+ * callbacks. The ongoing one, which the ST25R95 cannot abort, still 
+ * completes and its callback is executed.
+ *****************************************************************************
+ */
+void rfalFlushAsyncTransceive( void );
+
+
 /*! 
  *****************************************************************************
  * \brief  Get Transceive State
@@ -1135,6 +1240,69 @@ ReturnCode rfalGetTransceiveRSSI( uint16_t *rssi );
 void rfalWorker( void );
 
 
+/*! 
+ *****************************************************************************
+ *  \brief RFAL Worker max execution time
+ *  
+ *  Gets the longest execution time of a single rfalWorker() call since 
+ *  initialization or last rfalResetWorkerMaxTime(), in platformGetWorkerTime() 
+ *  units (platformGetSysTick() ms by default)
+ *  Only available when RFAL_FEATURE_BOUNDED_WORKER is enabled
+ *
+ * \param[out]  maxTime : longest rfalWorker() execution time
+ *
+ * \return  ERR_DISABLED : Feature not enabled
+ * \return  ERR_PARAM    : Invalid parameter
+ * \return  ERR_NONE     : No error
+ *****************************************************************************
+ */
+ReturnCode rfalGetWorkerMaxTime( uint32_t *maxTime );
+
+
+/*! 
+ *****************************************************************************
+ *  \brief RFAL Worker max execution time reset
+ *  
+ *  Restarts the tracking of the longest rfalWorker() execution time
+ *
+ *****************************************************************************
+ */
+void rfalResetWorkerMaxTime( void );
+
+
+/*! 
+ *****************************************************************************
+ *  \brief RFAL Select Instance
+ *  
+ *  Selects the RF chip instance the following RFAL calls operate on.
+ *  Transport, RFAL core and NFC discovery states are kept per instance, and
+ *  the platform hooks (chip select, IRQ pins, bus) can use rfalInstanceIdx()
+ *  to address the selected chip.
+ *  Several readers are driven by selecting each one in turn before calling 
+ *  its workers. Calls for different instances must not be interleaved within 
+ *  a single RFAL call, so threads serialize their RFAL calls; with 
+ *  RFAL_INSTANCE_STORAGE defined as _Thread_local each thread keeps its own 
+ *  selection.
+ *
+ * \param[in]  instance : instance index, lower than RFAL_FEATURE_MAX_INSTANCES
+ *
+ * \return  ERR_PARAM : Invalid instance
+ * \return  ERR_NONE  : No error
+ *****************************************************************************
+ */
+ReturnCode rfalSelectInstance( uint8_t instance );
+
+
+/*! 
+ *****************************************************************************
+ *  \brief RFAL Get Instance
+ *  
+ *  \return index of the currently selected RF chip instance
+ *****************************************************************************
+ */
+uint8_t rfalGetInstance( void );
+
+
 /*****************************************************************************
  *  ISO1443A                                                                 *  
  *****************************************************************************/
@@ -162,6 +162,40 @@ ReturnCode rfalSt25tbPollerCheckPresence( uint8_t *chipId );
  */
 ReturnCode rfalSt25tbPollerCollisionResolution( uint8_t devLimit, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt );
 
+/*! 
+ *****************************************************************************
+ * \brief  ST25TB Poller Start Collision Resolution
+ *  
+ * This method starts the ST25TB Collision resolution described in
+ * rfalSt25tbPollerCollisionResolution(): the Initiate is sent and the 
+ * device answering it selected. The Pcall16 slots are performed by
+ * rfalSt25tbPollerGetCollisionResolutionStatus()
+ *   
+ * \param[in]  devLimit      : device limit value, and size st25tbDevList
+ * \param[out] st25tbDevList : ST35TB listener device info
+ * \param[out] devCnt        : Devices found counter
+ * 
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalSt25tbPollerStartCollisionResolution( uint8_t devLimit, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt );
+
+/*! 
+ *****************************************************************************
+ * \brief  ST25TB Poller Get Collision Resolution Status
+ *  
+ * Runs the Collision resolution started by 
+ * rfalSt25tbPollerStartCollisionResolution() and returns its status.
+ * Each call performs a single Pcall16 or Slot Marker slot
+ * 
+ * \return ERR_BUSY         : Operation is ongoing
+ * \return ERR_WRONG_STATE  : No Collision Resolution started
+ * \return ERR_NONE         : No error, Collision Resolution done
+ *****************************************************************************
+ */
+ReturnCode rfalSt25tbPollerGetCollisionResolutionStatus( void );
+
 /*! 
  *****************************************************************************
  * \brief  ST25TB Poller Initiate
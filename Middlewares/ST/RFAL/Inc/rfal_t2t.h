@@ -106,6 +106,32 @@
 ReturnCode rfalT2TPollerRead( uint8_t blockNum, uint8_t* rxBuf, uint16_t rxBufLen, uint16_t *rcvLen );
 
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-A T2T Poller Fast Read
+ *  
+ * This method sends a FAST_READ command to a NFC-A T2T Listener device
+ * (NTAG21x and alike) reading all blocks from startBlockNum to endBlockNum
+ * (both included) of the current sector in one exchange.
+ * FAST_READ is not part of TS T2T: a tag not supporting it answers a NACK
+ * or stays silent, and may need to be re-activated afterwards
+ *
+ *
+ * \param[in]   startBlockNum : Number of the first block to read
+ * \param[in]   endBlockNum   : Number of the last block to read
+ * \param[out]  rxBuf         : pointer to place the read data
+ * \param[in]   rxBufLen      : size of rxBuf ((endBlockNum - startBlockNum + 1) * RFAL_T2T_BLOCK_LEN)
+ * \param[out]  rcvLen        : actual received data
+ * 
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_PARAM        : Invalid parameter
+ * \return ERR_PROTO        : Protocol error (NACK received)
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalT2TPollerFastRead( uint8_t startBlockNum, uint8_t endBlockNum, uint8_t* rxBuf, uint16_t rxBufLen, uint16_t *rcvLen );
+
+
 /*! 
  *****************************************************************************
  * \brief  NFC-A T2T Poller Write
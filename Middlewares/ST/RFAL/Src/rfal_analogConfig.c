@@ -63,6 +63,8 @@
 
 #define RFAL_TEST_REG         0x0080U      /*!< Test Register indicator  */    
 
+#define RFAL_ANALOG_CONFIG_INDEX_KEY_MASK  ((rfalAnalogConfigId)~RFAL_ANALOG_CONFIG_DIRECTION_MASK)  /*!< ID bits a matching Configuration ID shares with the searched one (mode, technology, bit rate) */
+
 /*
  ******************************************************************************
  * MACROS
@@ -80,11 +82,21 @@
 #endif /* RFAL_FEATURE_DYNAMIC_ANALOG_CONFIG */
 
 
+/*! Struct for Analog Config Look Up Table Index entry */
+typedef struct {
+    rfalAnalogConfigId     id;       /*!< Configuration ID                                        */
+    rfalAnalogConfigOffset offset;   /*!< Offset of the first Register-Mask-Value set in Table    */
+    rfalAnalogConfigNum    num;      /*!< Number of Register-Mask-Value sets                      */
+} rfalAnalogConfigIndexEntry;
+
 /*! Struct for Analog Config Look Up Table Update */
 typedef struct {
     const uint8_t *currentAnalogConfigTbl; /*!< Reference to start of current Analog Configuration      */
     uint16_t configTblSize;          /*!< Total size of Analog Configuration                      */
     bool    ready;                  /*!< Indicate if Look Up Table is complete and ready for use */
+    rfalAnalogConfigIndexEntry index[RFAL_ANALOG_CONFIG_LUT_SIZE]; /*!< Configuration IDs of the Table   */
+    uint8_t indexCnt;               /*!< Number of Configuration IDs in index                    */
+    bool    indexSorted;            /*!< Index sorted by mode/technology/bit rate (binary search) */
 } rfalAnalogConfigMgmt;
 
 static rfalAnalogConfigMgmt   gRfalAnalogConfigMgmt;  /*!< Analog Configuration LUT management */
@@ -100,10 +112,11 @@ static rfalAnalogConfigMgmt   gRfalAnalogConfigMgmt;  /*!< Analog Configuration
  * LOCAL FUNCTION PROTOTYPES
  ******************************************************************************
  */
-static rfalAnalogConfigNum rfalAnalogConfigSearch( rfalAnalogConfigId configId, uint16_t *configOffset );
+static rfalAnalogConfigNum rfalAnalogConfigSearch( rfalAnalogConfigId configId, uint8_t *indexPos, uint16_t *configOffset );
+static bool rfalAnalogConfigIndexBuild( void );
 
 #if RFAL_FEATURE_DYNAMIC_ANALOG_CONFIG
-    static void rfalAnalogConfigPtrUpdate( const uint8_t* analogConfigTbl );
+    static ReturnCode rfalAnalogConfigPtrUpdate( const uint8_t* analogConfigTbl );
 #endif /* RFAL_FEATURE_DYNAMIC_ANALOG_CONFIG */
 
 /*
@@ -131,7 +144,7 @@ void rfalAnalogConfigInitialize( void )
     gRfalAnalogConfigMgmt.configTblSize          = sizeof(rfalAnalogConfigDefaultSettings);
 #endif
   
-  gRfalAnalogConfigMgmt.ready = true;
+  gRfalAnalogConfigMgmt.ready = rfalAnalogConfigIndexBuild();
 } /* rfalAnalogConfigInitialize() */
 
 
@@ -163,8 +176,7 @@ ReturnCode rfalAnalogConfigListWriteRaw( const uint8_t *configTbl, uint16_t conf
     /* Update the total size of configuration settings */
     gRfalAnalogConfigMgmt.configTblSize = configTblSize;
         
-    rfalAnalogConfigPtrUpdate(gRfalAnalogConfig);
-    return ERR_NONE;
+    return rfalAnalogConfigPtrUpdate(gRfalAnalogConfig);
     
 #else
     
@@ -221,7 +233,7 @@ ReturnCode rfalAnalogConfigListWrite( uint8_t more, const rfalAnalogConfig *conf
     /* Check if it is the last Analog Configuration to load. */
     if (RFAL_ANALOG_CONFIG_UPDATE_LAST == more)
     {   /* Update the Analog Configuration to the new settings. */
-        rfalAnalogConfigPtrUpdate(gRfalAnalogConfig);
+        return rfalAnalogConfigPtrUpdate(gRfalAnalogConfig);
     }
     
     return ERR_NONE;
@@ -299,6 +311,7 @@ ReturnCode rfalSetAnalogConfig( rfalAnalogConfigId configId )
     const rfalAnalogConfigRegAddrMaskVal *configTbl;
     ReturnCode retCode = ERR_NONE;
     rfalAnalogConfigNum i;
+    uint8_t indexPos = 0;
     
     if (true != gRfalAnalogConfigMgmt.ready)
     {
@@ -308,20 +321,14 @@ ReturnCode rfalSetAnalogConfig( rfalAnalogConfigId configId )
     /* Search LUT for the specific Configuration ID. */
     while(true)
     {
-        numConfigSet = rfalAnalogConfigSearch(configId, &configOffset);
+        numConfigSet = rfalAnalogConfigSearch(configId, &indexPos, &configOffset);
         if( RFAL_ANALOG_CONFIG_LUT_NOT_FOUND == numConfigSet )
         {
             break;
         }
         
-        configTbl = (rfalAnalogConfigRegAddrMaskVal *)( (uint32_t)gRfalAnalogConfigMgmt.currentAnalogConfigTbl + (uint32_t)configOffset); 
-        /* Increment the offset to the next index to search from. */
-        configOffset += (uint16_t)(numConfigSet * sizeof(rfalAnalogConfigRegAddrMaskVal)); 
-        
-        if ((gRfalAnalogConfigMgmt.configTblSize + 1U) < configOffset)
-        {   /* Error check make sure that the we do not access outside the configuration Table Size */
-            return ERR_NOMEM;
-        }
+        /* Offset and number of sets have been checked against the Table Size when building the index */
+        configTbl = (const rfalAnalogConfigRegAddrMaskVal *)&gRfalAnalogConfigMgmt.currentAnalogConfigTbl[configOffset]; 
         
         for ( i = 0; i < numConfigSet; i++)
         {
@@ -413,11 +420,19 @@ uint16_t rfalAnalogConfigGenModeID( rfalMode md, rfalBitRate br, uint16_t dir )
  *****************************************************************************
  */
 #if RFAL_FEATURE_DYNAMIC_ANALOG_CONFIG
-static void rfalAnalogConfigPtrUpdate( const uint8_t* analogConfigTbl )
+static ReturnCode rfalAnalogConfigPtrUpdate( const uint8_t* analogConfigTbl )
 {
 
     gRfalAnalogConfigMgmt.currentAnalogConfigTbl = analogConfigTbl;
+    
+    if( !rfalAnalogConfigIndexBuild() )
+    {
+        rfalAnalogConfigInitialize(); /* Revert to default Analog Configuration */
+        return ERR_NOMEM;
+    }
+    
     gRfalAnalogConfigMgmt.ready = true;
+    return ERR_NONE;
     
 } /* rfalAnalogConfigPtrUpdate() */
 #endif /* RFAL_FEATURE_DYNAMIC_ANALOG_CONFIG */
@@ -425,26 +440,113 @@ static void rfalAnalogConfigPtrUpdate( const uint8_t* analogConfigTbl )
 
 /*! 
  *****************************************************************************
- * \brief  Search the Analog Configuration LUT for a specific Configuration ID.
+ * \brief  Build the index of the Analog Configuration LUT
  *  
- * Search the Analog Configuration LUT for the Configuration ID.
+ * Parse the current Analog Configuration Table once and record, for each
+ * Configuration ID, the offset and number of its Register-Mask-Value sets.
  * 
- * \param[in]  configId: Configuration ID to search for.
- * \param[in]  configOffset: Configuration Offset in Table
+ * When every Configuration ID targets at most one technology, a Configuration
+ * ID can only match IDs sharing its mode, technology and bit rate: the index
+ * is then sorted on these bits (stable, keeping the Table order within a
+ * group) so that the search is a binary search. Otherwise the index is kept
+ * in Table order and scanned.
  * 
- * \return number of Configuration Sets
- * \return #RFAL_ANALOG_CONFIG_LUT_NOT_FOUND in case Configuration ID is not found.
+ * \return true  : index built
+ * \return false : Table malformed or more than RFAL_ANALOG_CONFIG_LUT_SIZE IDs
  *****************************************************************************
  */
-static rfalAnalogConfigNum rfalAnalogConfigSearch( rfalAnalogConfigId configId, uint16_t *configOffset )
+static bool rfalAnalogConfigIndexBuild( void )
 {
-    rfalAnalogConfigId foundConfigId;
-    rfalAnalogConfigId configIdMaskVal;
-    const uint8_t *configTbl;
     const uint8_t *currentConfigTbl;
+    rfalAnalogConfigIndexEntry entry;
+    rfalAnalogConfigId tech;
     uint16_t i;
+    uint8_t  cnt;
+    uint8_t  j;
+    bool     sortable;
     
     currentConfigTbl = gRfalAnalogConfigMgmt.currentAnalogConfigTbl;
+    cnt      = 0;
+    sortable = true;
+    
+    i = 0;
+    while (i < gRfalAnalogConfigMgmt.configTblSize)
+    {
+        if( (cnt >= RFAL_ANALOG_CONFIG_LUT_SIZE) || ((i + sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum)) > gRfalAnalogConfigMgmt.configTblSize) )
+        {
+            gRfalAnalogConfigMgmt.indexCnt = 0;
+            return false;
+        }
+        
+        entry.id     = GETU16(&currentConfigTbl[i]);
+        entry.num    = currentConfigTbl[i + sizeof(rfalAnalogConfigId)];
+        entry.offset = (rfalAnalogConfigOffset)(i + sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum));
+        i = (uint16_t)(entry.offset + (entry.num * sizeof(rfalAnalogConfigRegAddrMaskVal)));
+        
+        if( i > gRfalAnalogConfigMgmt.configTblSize )
+        {   /* Make sure that the we do not access outside the configuration Table Size */
+            gRfalAnalogConfigMgmt.indexCnt = 0;
+            return false;
+        }
+        
+        /* Several technologies in one ID: the ID may match IDs of another group */
+        tech = RFAL_ANALOG_CONFIG_ID_GET_TECH(entry.id);
+        if( (tech & (tech - 1U)) != 0U )
+        {
+            sortable = false;
+        }
+        
+        gRfalAnalogConfigMgmt.index[cnt++] = entry;
+    }
+    
+    if( sortable )
+    {
+        /* Insertion sort: stable and enough for the few IDs of a Table */
+        for( i = 1; i < cnt; i++ )
+        {
+            entry = gRfalAnalogConfigMgmt.index[i];
+            for( j = (uint8_t)i; (j > 0U) && ((gRfalAnalogConfigMgmt.index[j - 1U].id & RFAL_ANALOG_CONFIG_INDEX_KEY_MASK) > (entry.id & RFAL_ANALOG_CONFIG_INDEX_KEY_MASK)); j-- )
+            {
+                gRfalAnalogConfigMgmt.index[j] = gRfalAnalogConfigMgmt.index[j - 1U];
+            }
+            gRfalAnalogConfigMgmt.index[j] = entry;
+        }
+    }
+    
+    gRfalAnalogConfigMgmt.indexCnt    = cnt;
+    gRfalAnalogConfigMgmt.indexSorted = sortable;
+    return true;
+    
+} /* rfalAnalogConfigIndexBuild() */
+
+
+/*! 
+ *****************************************************************************
+ * \brief  Search the Analog Configuration LUT for a specific Configuration ID.
+ *  
+ * Search the Analog Configuration LUT index for the Configuration ID.
+ * 
+ * \param[in]     configId: Configuration ID to search for.
+ * \param[in,out] indexPos: index position to search from (0 for the first
+ *                          search), updated to continue the search
+ * \param[out]    configOffset: Offset of the Configuration Sets in Table
+ * 
+ * \return number of Configuration Sets
+ * \return #RFAL_ANALOG_CONFIG_LUT_NOT_FOUND in case Configuration ID is not found.
+ *****************************************************************************
+ */
+static rfalAnalogConfigNum rfalAnalogConfigSearch( rfalAnalogConfigId configId, uint8_t *indexPos, uint16_t *configOffset )
+{
+    const rfalAnalogConfigIndexEntry *index;
+    rfalAnalogConfigId configIdMaskVal;
+    rfalAnalogConfigId key;
+    uint8_t lo;
+    uint8_t hi;
+    uint8_t mid;
+    uint8_t i;
+    
+    index            = gRfalAnalogConfigMgmt.index;
+    key              = (configId & RFAL_ANALOG_CONFIG_INDEX_KEY_MASK);
     configIdMaskVal  = ((RFAL_ANALOG_CONFIG_POLL_LISTEN_MODE_MASK | RFAL_ANALOG_CONFIG_BITRATE_MASK) 
                        |((RFAL_ANALOG_CONFIG_TECH_CHIP == RFAL_ANALOG_CONFIG_ID_GET_TECH(configId)) ? (RFAL_ANALOG_CONFIG_TECH_MASK | RFAL_ANALOG_CONFIG_CHIP_SPECIFIC_MASK) : configId)
                        |((RFAL_ANALOG_CONFIG_NO_DIRECTION == RFAL_ANALOG_CONFIG_ID_GET_DIRECTION(configId)) ? RFAL_ANALOG_CONFIG_DIRECTION_MASK : configId)
@@ -458,22 +560,42 @@ static rfalAnalogConfigNum rfalAnalogConfigSearch( rfalAnalogConfigId configId,
     }
     
     
-    i = *configOffset;
-    while (i < gRfalAnalogConfigMgmt.configTblSize)
+    i = *indexPos;
+    if( gRfalAnalogConfigMgmt.indexSorted && (i == 0U) )
     {
-        configTbl = &currentConfigTbl[i];
-        foundConfigId = GETU16(configTbl);
-        if (configId == (foundConfigId & configIdMaskVal))
+        /* First search: binary search the first ID of the mode/technology/bit rate group */
+        lo = 0;
+        hi = gRfalAnalogConfigMgmt.indexCnt;
+        while (lo < hi)
         {
-            *configOffset = (uint16_t)(i + sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum));
-            return configTbl[sizeof(rfalAnalogConfigId)];
+            mid = (uint8_t)((lo + hi) / 2U);
+            if( (index[mid].id & RFAL_ANALOG_CONFIG_INDEX_KEY_MASK) < key )
+            {
+                lo = (uint8_t)(mid + 1U);
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        i = lo;
+    }
+    
+    for( ; i < gRfalAnalogConfigMgmt.indexCnt; i++ )
+    {
+        if( gRfalAnalogConfigMgmt.indexSorted && ((index[i].id & RFAL_ANALOG_CONFIG_INDEX_KEY_MASK) != key) )
+        {   /* End of the group: no more matching ID */
+            break;
         }
         
-        /* If Config Id does not match, increment to next Configuration Id */
-        i += (uint16_t)( sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum) 
-                        + (configTbl[sizeof(rfalAnalogConfigId)] * sizeof(rfalAnalogConfigRegAddrMaskVal) )
-                        );
-    } /* for */
+        if (configId == (index[i].id & configIdMaskVal))
+        {
+            *indexPos     = (uint8_t)(i + 1U);
+            *configOffset = index[i].offset;
+            return index[i].num;
+        }
+    }
     
+    *indexPos = i;
     return RFAL_ANALOG_CONFIG_LUT_NOT_FOUND;
 } /* rfalAnalogConfigSearch() */
@@ -119,6 +119,17 @@
 #define ISODEP_SDSL_INF_LEN             (0U)         /*!< INF length of S(DSL)                Digital 1.1 15.1.3 */
 #define ISODEP_SWTX_INF_LEN             (1U)         /*!< INF length of S(WTX)                Digital 1.1 15.2.2 */
 
+
+#ifndef RFAL_SUPPORT_BR_RW_NFCA_848
+    #define RFAL_SUPPORT_BR_RW_NFCA_848     RFAL_SUPPORT_BR_RW_848    /*!< NFC-A 848 support not specified, same as the other technologies */
+#endif
+
+#define ISODEP_NFCA_MAX_BR              ((RFAL_SUPPORT_BR_RW_NFCA_848) ? RFAL_BR_848 : RFAL_BR_424)  /*!< Highest NFC-A bit rate of the RF chip */
+
+#define ISODEP_LINK_DOWN_CNT            (2U)         /*!< Consecutive exchanges with errors lowering the bit rate ceiling     */
+#define ISODEP_LINK_UP_CNT              (16U)        /*!< Consecutive exchanges without error raising the bit rate ceiling    */
+#define ISODEP_LINK_PROBE_MAX           (4U)         /*!< Max backoff (shift of ISODEP_LINK_UP_CNT) after failed raises        */
+
 #define ISODEP_WTXM_MIN                 (1U)         /*!< Minimum allowed value for the WTXM, Digital 1.0 13.2.2 */
 #define ISODEP_WTXM_MAX                 (59U)        /*!< Maximum allowed value for the WTXM, Digital 1.0 13.2.2 */
 
@@ -362,6 +373,20 @@ typedef enum
 
 
 
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+/*! Holds the link adaptation state, kept across activations                    */
+typedef struct{
+  uint8_t         errCnt;        /*!< Transmission errors on current exchange   */
+  uint8_t         badCnt;        /*!< Consecutive exchanges with errors         */
+  uint16_t        goodCnt;       /*!< Consecutive exchanges without error       */
+  uint8_t         maxBR;         /*!< Highest mutual bit rate on activation     */
+  uint8_t         drop;          /*!< Steps below highest mutual bit rate       */
+  uint8_t         probe;         /*!< Backoff of the ceiling raise              */
+  bool            isProbing;     /*!< Ceiling raised, not yet confirmed         */
+}rfalIsoDepLink;
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+
+
 /*! Holds all ISO-DEP data(counters, buffers, ID, timeouts, frame size)         */
 typedef struct{
   rfalIsoDepState state;         /*!< ISO-DEP module state                      */
@@ -436,6 +461,10 @@ typedef struct{
   uint16_t                APDURxPos;        /*!< APDU Rx position               */
   bool                    isAPDURxChaining; /*!< APDU Transceive chaining flag  */
   
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+  rfalIsoDepLink          link;             /*!< Link adaptation state          */
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+  
 }rfalIsoDep;
 
 
@@ -445,7 +474,8 @@ typedef struct{
  ******************************************************************************
  */
 
-static rfalIsoDep gIsoDep;    /*!< ISO-DEP Module instance               */
+static rfalIsoDep gIsoDepInstances[RFAL_FEATURE_MAX_INSTANCES];     /*!< ISO-DEP Module instances             */
+#define gIsoDep   (gIsoDepInstances[rfalInstanceIdx()])             /*!< ISO-DEP Module instance of the selected RF chip */
 
 /*
  ******************************************************************************
@@ -461,6 +491,11 @@ static void rfalIsoDepApdu2IBLockParam( rfalIsoDepApduTxRxParam apduParam, rfalI
     static ReturnCode isoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsChaining );
     static void rfalIsoDepCalcBitRate(rfalBitRate maxAllowedBR, uint8_t piccBRCapability, rfalBitRate *dsi, rfalBitRate *dri);
     static uint32_t rfalIsoDepSFGI2SFGT( uint8_t sfgi );
+    
+    #if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+        static void rfalIsoDepLinkCalcBitRate( rfalBitRate maxAllowedBR, rfalBitRate rfMaxBR, uint8_t piccBRCapability, rfalBitRate *dsi, rfalBitRate *dri );
+        static void rfalIsoDepLinkUpdate( ReturnCode ret );
+    #endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
 
     #if RFAL_FEATURE_NFCA
         static ReturnCode rfalIsoDepStartRATS( rfalIsoDepFSxI FSDI, uint8_t DID, rfalIsoDepAts *ats, uint8_t *atsLen );
@@ -720,6 +755,10 @@ void rfalIsoDepInitialize( void )
     
     isoDepClearCounters();
     
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+    gIsoDep.link.errCnt     = 0U;
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+    
     /* Destroy any ongoing WTX timer */
     isoDepTimerDestroy( gIsoDep.WTXTimer );
     gIsoDep.WTXTimer = 0U;
@@ -808,6 +847,13 @@ static ReturnCode isoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsChain
                 case ERR_FRAMING:          /* added to handle test cases scenario TC_POL_NFCB_T4AT_BI_82_x_y & TC_POL_NFCB_T4BT_BI_82_x_y */
                 case ERR_INCOMPLETE_BYTE:  /* added to handle test cases scenario TC_POL_NFCB_T4AT_BI_82_x_y & TC_POL_NFCB_T4BT_BI_82_x_y */
                     
+                    #if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+                        if( gIsoDep.link.errCnt < UINT8_MAX )
+                        {
+                            gIsoDep.link.errCnt++;
+                        }
+                    #endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+                    
                     if( gIsoDep.isRxChaining )
                     {   /* Rule 5 - In PICC chaining when a invalid/timeout occurs -> R-ACK */                        
                         EXIT_ON_ERR( ret, isoDepHandleControlMsg( ISODEP_R_ACK, RFAL_ISODEP_NO_PARAM ) );
@@ -1534,7 +1580,18 @@ ReturnCode rfalIsoDepGetTransceiveStatus( void )
     else
     {
 #if RFAL_FEATURE_ISO_DEP_POLL
+    #if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+        ReturnCode ret;
+        
+        ret = isoDepDataExchangePCD( gIsoDep.rxLen, gIsoDep.rxChaining );
+        if( ret != ERR_BUSY )
+        {
+            rfalIsoDepLinkUpdate( ret );
+        }
+        return ret;
+    #else
         return isoDepDataExchangePCD( gIsoDep.rxLen, gIsoDep.rxChaining );
+    #endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
 #else
         return ERR_NOTSUPP;
 #endif /* RFAL_FEATURE_ISO_DEP_POLL */
@@ -2222,7 +2279,11 @@ ReturnCode rfalIsoDepPollAGetActivationStatus( void )
                         /* Check if TA is present */
                         if( (gIsoDep.actvDev->activation.A.Listener.ATS.T0 & RFAL_ISODEP_ATS_T0_TA_PRESENCE_MASK) != 0U )
                         {
+                        #if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+                            rfalIsoDepLinkCalcBitRate( maxBR, ISODEP_NFCA_MAX_BR, ((uint8_t*)&gIsoDep.actvDev->activation.A.Listener.ATS)[msgIt++], &gIsoDep.actvDev->info.DSI, &gIsoDep.actvDev->info.DRI );
+                        #else
                             rfalIsoDepCalcBitRate( maxBR, ((uint8_t*)&gIsoDep.actvDev->activation.A.Listener.ATS)[msgIt++], &gIsoDep.actvDev->info.DSI, &gIsoDep.actvDev->info.DRI );
+                        #endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
                         }
                         
                         /* Check if TB is present */
@@ -2365,7 +2426,11 @@ ReturnCode rfalIsoDepPollBStartActivation( rfalIsoDepFSxI FSDI, uint8_t DID, rfa
     
     
     /* Calculate max Bit Rate */
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+    rfalIsoDepLinkCalcBitRate( maxBR, RFAL_BR_848, nfcbDev->sensbRes.protInfo.BRC, &isoDepDev->info.DSI, &isoDepDev->info.DRI );
+#else
     rfalIsoDepCalcBitRate( maxBR, nfcbDev->sensbRes.protInfo.BRC, &isoDepDev->info.DSI, &isoDepDev->info.DRI );
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
     
     /***************************************************************************/
     /* Send ATTRIB Command                                                     */
@@ -2666,7 +2731,109 @@ static uint32_t rfalIsoDepSFGI2SFGT( uint8_t sfgi )
     return (rfalConv1fcToMs(sfgt) + 1U);
 }
 
+
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+/*******************************************************************************/
+static void rfalIsoDepLinkCalcBitRate( rfalBitRate maxAllowedBR, rfalBitRate rfMaxBR, uint8_t piccBRCapability, rfalBitRate *dsi, rfalBitRate *dri )
+{
+    uint8_t mutualBR;
+    
+    /* No bit rate increase allowed, keep the activation bit rate */
+    if( (uint8_t)maxAllowedBR > (uint8_t)RFAL_BR_848 )
+    {
+        rfalIsoDepCalcBitRate( maxAllowedBR, piccBRCapability, dsi, dri );
+        return;
+    }
+    
+    /* Highest bit rate supported by the Poller, the Listener and the RF chip */
+    rfalIsoDepCalcBitRate( (rfalBitRate)MIN( (uint8_t)maxAllowedBR, (uint8_t)rfMaxBR ), piccBRCapability, dsi, dri );  /* PRQA S 4342 # MISRA 10.5 - Both values are valid rfalBitRate */
+    mutualBR = MAX( (uint8_t)(*dsi), (uint8_t)(*dri) );
+    gIsoDep.link.maxBR = mutualBR;
+    
+    /* Apply the ceiling learned on the previous exchanges */
+    gIsoDep.link.drop = MIN( gIsoDep.link.drop, mutualBR );
+    if( gIsoDep.link.drop != 0U )
+    {
+        rfalIsoDepCalcBitRate( (rfalBitRate)(mutualBR - gIsoDep.link.drop), piccBRCapability, dsi, dri );  /* PRQA S 4342 # MISRA 10.5 - drop is bounded by mutualBR, no invalid enum value created */
+    }
+}
+
+
+/*******************************************************************************/
+static void rfalIsoDepLinkUpdate( ReturnCode ret )
+{
+    rfalBitRate txBR;
+    rfalBitRate rxBR;
+    uint8_t     curBR;
+    uint8_t     newDrop;
+    bool        stepDown;
+    
+    stepDown = false;
+    
+    if( gIsoDep.link.errCnt == 0U )
+    {
+        gIsoDep.link.badCnt = 0U;
+        
+        /* Raise the ceiling after enough clean exchanges, waiting longer each time a raise failed */
+        if( (ret == ERR_NONE) || (ret == ERR_AGAIN) )
+        {
+            gIsoDep.link.goodCnt++;
+            if( gIsoDep.link.goodCnt >= (ISODEP_LINK_UP_CNT << gIsoDep.link.probe) )
+            {
+                gIsoDep.link.goodCnt   = 0U;
+                gIsoDep.link.isProbing = false;
+                
+                if( gIsoDep.link.drop != 0U )
+                {
+                    gIsoDep.link.drop--;
+                    gIsoDep.link.isProbing = true;
+                }
+            }
+        }
+    }
+    else
+    {
+        /* Lower the ceiling after consecutive exchanges with errors or once the errors made the exchange fail */
+        gIsoDep.link.goodCnt = 0U;
+        gIsoDep.link.badCnt++;
+        stepDown = ( (gIsoDep.link.badCnt >= ISODEP_LINK_DOWN_CNT) || ((ret != ERR_NONE) && (ret != ERR_AGAIN)) );
+    }
+    
+    if( stepDown )
+    {
+        gIsoDep.link.badCnt = 0U;
+        
+        rfalGetBitRate( &txBR, &rxBR );
+        curBR = MAX( (uint8_t)txBR, (uint8_t)rxBR );
+        
+        /* Ceiling one step below the current bit rate, lowered only once per activation */
+        newDrop = ((MAX( gIsoDep.link.maxBR, curBR ) - curBR) + 1U);
+        if( (curBR > (uint8_t)RFAL_BR_106) && (newDrop > gIsoDep.link.drop) )
+        {
+            gIsoDep.link.drop = newDrop;
+            
+            if( gIsoDep.link.isProbing )
+            {
+                gIsoDep.link.isProbing = false;
+                gIsoDep.link.probe     = MIN( (gIsoDep.link.probe + 1U), ISODEP_LINK_PROBE_MAX );
+            }
+        }
+    }
+    
+    gIsoDep.link.errCnt = 0U;
+}
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+
 #endif  /* RFAL_FEATURE_ISO_DEP_POLL */
+
+
+/*******************************************************************************/
+void rfalIsoDepPollResetLinkAdaptation( void )
+{
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+    ST_MEMSET( &gIsoDep.link, 0x00, sizeof(gIsoDep.link) );
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+}
  
 
  /*******************************************************************************/
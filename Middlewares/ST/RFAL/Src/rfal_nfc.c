@@ -61,6 +61,9 @@
 */
 #define RFAL_NFC_MAX_DEVICES          5U    /* Max number of devices supported */
 
+#define RFAL_NFC_ADAPTIVE_POLL_HIT    256U  /* Hit rate score added when a technology is found */
+#define RFAL_NFC_ADAPTIVE_POLL_DECAY  3U    /* Hit rate score decay on each poll: score/2^3    */
+
 
 /*
 ******************************************************************************
@@ -70,6 +73,8 @@
 
 #define rfalNfcNfcNotify( st )         if( gNfcDev.disc.notifyCb != NULL )  gNfcDev.disc.notifyCb( st )
 
+#define rfalNfcPollTechFlag( idx )     ((uint16_t)(1U << (idx)))          /* Technology Flag from its bit position */
+
 
 /*
 ******************************************************************************
@@ -101,6 +106,42 @@ typedef struct{
     uint32_t                lmMask;             /* Listen Mode mask                                */
     bool                    isTechInit;         /* Flag indicating technology has been set         */
     bool                    isOperOngoing;      /* Flag indicating opration is ongoing             */
+    uint16_t                techCur;            /* Technology being detected                       */
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+    bool                    adaptive;           /* Flag indicating adaptive technology ordering    */
+    uint16_t                techsPolled;        /* Technologies polled on the ongoing detection    */
+    uint32_t                detectStart;        /* Start time of the ongoing detection             */
+    uint16_t                techScore[RFAL_NFC_POLL_TECH_NUM]; /* Hit rate score per technology    */
+    uint8_t                 techSkip[RFAL_NFC_POLL_TECH_NUM];  /* Consecutive cycles left out      */
+    rfalNfcPollStats        pollStats;          /* Technology Detection statistics                 */
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+#if RFAL_FEATURE_BOUNDED_WORKER
+    uint32_t                workerMaxTime;      /* Longest rfalNfcWorker() execution time          */
+    uint32_t                workerBudget;       /* Discovery time per rfalNfcWorker() call         */
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+    uint8_t                 nfcvPop;            /* NFC-V devices found by the last inventory       */
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+    uint8_t                 isoDepNfcid[RFAL_NFCA_CASCADE_3_UID_LEN]; /* NFCID of the device the ISO-DEP link adaptation learned on */
+    uint8_t                 isoDepNfcidLen;     /* Length of the ISO-DEP link adaptation NFCID     */
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+#if RFAL_FEATURE_NFCA
+    rfalNfcaListenDevice    nfcaDevList[RFAL_NFC_MAX_DEVICES]; /* NFC-A devices of the ongoing collision resolution */
+    uint8_t                 nfcaDevCnt;         /* NFC-A devices found by the ongoing collision resolution */
+#endif /* RFAL_FEATURE_NFCA */
+#if RFAL_FEATURE_NFCB
+    rfalNfcbListenDevice    nfcbDevList[RFAL_NFC_MAX_DEVICES]; /* NFC-B devices of the ongoing collision resolution */
+    uint8_t                 nfcbDevCnt;         /* NFC-B devices found by the ongoing collision resolution */
+#endif /* RFAL_FEATURE_NFCB */
+#if RFAL_FEATURE_NFCV
+    rfalNfcvListenDevice    nfcvDevList[RFAL_NFC_MAX_DEVICES]; /* NFC-V devices of the ongoing collision resolution */
+    uint8_t                 nfcvDevCnt;         /* NFC-V devices found by the ongoing collision resolution */
+#endif /* RFAL_FEATURE_NFCV */
+#if RFAL_FEATURE_ST25TB
+    rfalSt25tbListenDevice  st25tbDevList[RFAL_NFC_MAX_DEVICES]; /* ST25TB devices of the ongoing collision resolution */
+    uint8_t                 st25tbDevCnt;       /* ST25TB devices found by the ongoing collision resolution */
+#endif /* RFAL_FEATURE_ST25TB */
     
     rfalNfcBuffer           txBuf;              /* Tx buffer for Data Exchange                     */
     rfalNfcBuffer           rxBuf;              /* Rx buffer for Data Exchange                     */
@@ -119,20 +160,32 @@ typedef struct{
  ******************************************************************************
  */
 #ifdef RFAL_TEST_MODE
-    rfalNfc gNfcDev;
+    rfalNfc gNfcDevInstances[RFAL_FEATURE_MAX_INSTANCES];
 #else /* RFAL_TEST_MODE */
-    static rfalNfc gNfcDev;
+    static rfalNfc gNfcDevInstances[RFAL_FEATURE_MAX_INSTANCES];
 #endif /* RFAL_TEST_MODE */
+#define gNfcDev (gNfcDevInstances[rfalInstanceIdx()])    /* NFC device context of the selected RF chip */
+
+/*! Technology Detection order (NFC Forum Activity): AP2P, A, B, F, V, ST25TB as technology Flag bit positions */
+static const uint8_t gNfcPollTechOrder[RFAL_NFC_POLL_TECH_NUM] = { 4U, 0U, 1U, 2U, 3U, 5U };
 
 /*
 ******************************************************************************
 * LOCAL FUNCTION PROTOTYPES
 ******************************************************************************
 */
+static void rfalNfcWorkerStep( void );
 static ReturnCode rfalNfcPollTechDetetection( void );
+static uint16_t rfalNfcPollTechNext( void );
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+static void rfalNfcPollStatsUpdate( void );
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
 static ReturnCode rfalNfcPollCollResolution( void );
 static ReturnCode rfalNfcPollActivation( uint8_t devIt );
 static ReturnCode rfalNfcDeactivation( void );
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+static void rfalNfcIsoDepLinkSelect( const rfalNfcDevice *device );
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
 
 #if RFAL_FEATURE_NFC_DEP
 static ReturnCode rfalNfcNfcDepActivate( rfalNfcDevice *device, rfalNfcDepCommMode commMode, const uint8_t *atrReq, uint16_t atrReqLen );
@@ -153,6 +206,27 @@ ReturnCode rfalNfcInitialize( void )
     rfalAnalogConfigInitialize();              /* Initialize RFAL's Analog Configs */
     EXIT_ON_ERR( err, rfalInitialize() );      /* Initialize RFAL */
 
+#if RFAL_FEATURE_BOUNDED_WORKER
+    gNfcDev.workerMaxTime = 0U;
+    gNfcDev.workerBudget  = RFAL_NFC_WORKER_BUDGET;
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+    gNfcDev.adaptive = true;
+    ST_MEMSET( gNfcDev.techScore, 0x00, sizeof(gNfcDev.techScore) );
+    ST_MEMSET( gNfcDev.techSkip, 0x00, sizeof(gNfcDev.techSkip) );
+    rfalNfcResetPollStats();
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+    gNfcDev.nfcvPop = 0U;
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+    gNfcDev.isoDepNfcidLen = 0U;
+    rfalIsoDepPollResetLinkAdaptation();
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+
     gNfcDev.state = RFAL_NFC_STATE_IDLE;         /* Go to initialized */
     return ERR_NONE;
 }
@@ -195,6 +269,7 @@ ReturnCode rfalNfcDiscover( const rfalNfcDiscoverParam *disParams )
     gNfcDev.devCnt          = 0;
     gNfcDev.discRestart     = true;
     gNfcDev.isTechInit      = false;
+    gNfcDev.techCur         = RFAL_NFC_TECH_NONE;
     gNfcDev.disc            = *disParams;
     
     
@@ -314,6 +389,41 @@ ReturnCode rfalNfcGetActiveDevice( rfalNfcDevice **dev )
 
 /*******************************************************************************/
 void rfalNfcWorker( void )
+{
+#if RFAL_FEATURE_BOUNDED_WORKER
+    uint32_t   workerStart;
+    uint32_t   workerTime;
+    
+    workerStart = platformGetWorkerTime();
+    
+    /* Discovery runs one step (technology, slot) at a time, chain steps while within budget */
+    do
+    {
+        rfalNfcWorkerStep();
+        workerTime = (platformGetWorkerTime() - workerStart);
+    }
+    while( ((gNfcDev.state == RFAL_NFC_STATE_POLL_TECHDETECT) || (gNfcDev.state == RFAL_NFC_STATE_POLL_COLAVOIDANCE)) && (workerTime < gNfcDev.workerBudget) );
+    
+    if( workerTime > gNfcDev.workerMaxTime )
+    {
+        gNfcDev.workerMaxTime = workerTime;
+    }
+#else
+    rfalNfcWorkerStep();
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief  RFAL NFC Worker step
+ * 
+ * Runs the RF worker and a single step of the internal state machine.
+ * Technology Detection and Collision Resolution perform at most one 
+ * technology or one slot per step.
+ ******************************************************************************
+ */
+static void rfalNfcWorkerStep( void )
 {
     ReturnCode err;
    
@@ -334,7 +444,12 @@ void rfalNfcWorker( void )
             gNfcDev.selDevIdx   = 0;
             gNfcDev.techsFound  = RFAL_NFC_TECH_NONE;
             gNfcDev.techs2do    = gNfcDev.disc.techs2Find;
+            gNfcDev.techCur     = RFAL_NFC_TECH_NONE;
+            gNfcDev.isTechInit  = false;                                      /* Activation may leave it set, field has been turned off */
             gNfcDev.state       = RFAL_NFC_STATE_POLL_TECHDETECT;
+        #if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+            gNfcDev.techsPolled = RFAL_NFC_TECH_NONE;
+        #endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
         
         #if RFAL_FEATURE_WAKEUP_MODE    
             /* Check if Low power Wake-Up is to be performed */
@@ -377,6 +492,10 @@ void rfalNfcWorker( void )
             err = rfalNfcPollTechDetetection();                                       /* Perform Technology Detection                         */
             if( err != ERR_BUSY )                                                     /* Wait until all technologies are performed            */
             {
+            #if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+                rfalNfcPollStatsUpdate();                                             /* Update hit rates and detection statistics            */
+            #endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+                
                 if( ( err != ERR_NONE) || (gNfcDev.techsFound == RFAL_NFC_TECH_NONE) )/* Check if any error occurred or no techs were found   */
                 {
                     rfalFieldOff();
@@ -544,10 +663,84 @@ void rfalNfcWorker( void )
         case RFAL_NFC_STATE_POLL_SELECT:
         case RFAL_NFC_STATE_DATAEXCHANGE_DONE:
         default:
-            return;
+            break;
     }
 }
 
+/*******************************************************************************/
+ReturnCode rfalNfcGetWorkerMaxTime( uint32_t *maxTime )
+{
+#if RFAL_FEATURE_BOUNDED_WORKER
+    if( maxTime == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    *maxTime = gNfcDev.workerMaxTime;
+    return ERR_NONE;
+#else
+    NO_WARNING(maxTime);
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+}
+
+/*******************************************************************************/
+void rfalNfcResetWorkerMaxTime( void )
+{
+#if RFAL_FEATURE_BOUNDED_WORKER
+    gNfcDev.workerMaxTime = 0U;
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcSetWorkerBudget( uint32_t budget )
+{
+#if RFAL_FEATURE_BOUNDED_WORKER
+    gNfcDev.workerBudget = budget;
+    return ERR_NONE;
+#else
+    NO_WARNING(budget);
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcSetAdaptivePolling( bool enable )
+{
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+    gNfcDev.adaptive = enable;
+    return ERR_NONE;
+#else
+    NO_WARNING(enable);
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcGetPollStats( rfalNfcPollStats *stats )
+{
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+    if( stats == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    *stats = gNfcDev.pollStats;
+    return ERR_NONE;
+#else
+    NO_WARNING(stats);
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+}
+
+/*******************************************************************************/
+void rfalNfcResetPollStats( void )
+{
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+    ST_MEMSET( &gNfcDev.pollStats, 0x00, sizeof(gNfcDev.pollStats) );
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+}
+
 
 /*******************************************************************************/
 ReturnCode rfalNfcDataExchangeStart( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt )
@@ -789,11 +982,17 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /* Supress warning when specific RFAL features have been disabled */
     NO_WARNING(err);   
     
+    /* Once the current technology is done pick the next one to be detected */
+    if( (gNfcDev.techs2do & gNfcDev.techCur) == 0U )
+    {
+        gNfcDev.techCur = rfalNfcPollTechNext();
+    }
+    
     
     /*******************************************************************************/
     /* AP2P Technology Detection                                                   */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_AP2P) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_AP2P) != 0U) )
+    if( gNfcDev.techCur == RFAL_NFC_POLL_TECH_AP2P )
     {
         
     #if RFAL_FEATURE_NFC_DEP
@@ -830,6 +1029,11 @@ static ReturnCode rfalNfcPollTechDetetection( void )
         }
         return ERR_BUSY;
         
+    #else
+    
+        gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_AP2P;                     /* Technology not available, skip it */
+        return ERR_BUSY;
+        
     #endif /* RFAL_FEATURE_NFC_DEP */
     }
     
@@ -837,7 +1041,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive NFC-A Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_A) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_A) != 0U) )
+    if( gNfcDev.techCur == RFAL_NFC_POLL_TECH_A )
     {
         
     #if RFAL_FEATURE_NFCA
@@ -865,6 +1069,11 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     
         return ERR_BUSY;
 
+    #else
+    
+        gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_A;                     /* Technology not available, skip it */
+        return ERR_BUSY;
+        
     #endif /* RFAL_FEATURE_NFCA */
     }
     
@@ -872,7 +1081,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive NFC-B Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_B) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_B) != 0U) )
+    if( gNfcDev.techCur == RFAL_NFC_POLL_TECH_B )
     {
     #if RFAL_FEATURE_NFCB
         
@@ -900,13 +1109,18 @@ static ReturnCode rfalNfcPollTechDetetection( void )
         
         return ERR_BUSY;
     
+    #else
+    
+        gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_B;                     /* Technology not available, skip it */
+        return ERR_BUSY;
+        
     #endif /* RFAL_FEATURE_NFCB */
     }
     
     /*******************************************************************************/
     /* Passive NFC-F Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_F) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_F) != 0U) )
+    if( gNfcDev.techCur == RFAL_NFC_POLL_TECH_F )
     {
     #if RFAL_FEATURE_NFCF
      
@@ -931,6 +1145,11 @@ static ReturnCode rfalNfcPollTechDetetection( void )
         
         return ERR_BUSY;
     
+    #else
+    
+        gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_F;                     /* Technology not available, skip it */
+        return ERR_BUSY;
+        
     #endif /* RFAL_FEATURE_NFCF */
     }
     
@@ -938,7 +1157,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive NFC-V Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_V) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_V) != 0U) )
+    if( gNfcDev.techCur == RFAL_NFC_POLL_TECH_V )
     {
     #if RFAL_FEATURE_NFCV
         
@@ -965,6 +1184,11 @@ static ReturnCode rfalNfcPollTechDetetection( void )
         
         return ERR_BUSY;
     
+    #else
+    
+        gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_V;                     /* Technology not available, skip it */
+        return ERR_BUSY;
+        
     #endif /* RFAL_FEATURE_NFCV */
     }
     
@@ -972,7 +1196,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive Proprietary Technology ST25TB                                       */
     /*******************************************************************************/  
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_ST25TB) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_ST25TB) != 0U) )
+    if( gNfcDev.techCur == RFAL_NFC_POLL_TECH_ST25TB )
     {
     #if RFAL_FEATURE_ST25TB
         
@@ -997,12 +1221,151 @@ static ReturnCode rfalNfcPollTechDetetection( void )
         
         return ERR_BUSY;
         
+    #else
+    
+        gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECH_ST25TB;                     /* Technology not available, skip it */
+        return ERR_BUSY;
+        
     #endif /* RFAL_FEATURE_ST25TB */
     }
     
     return ERR_NONE;
 }
 
+/*!
+ ******************************************************************************
+ * \brief Poller Technology Detection next technology
+ * 
+ * This method selects the next technology to be detected among the ones 
+ * still to be performed: the first one in NFC Forum order, or with adaptive
+ * polling the one with the highest hit rate. With adaptive polling, once a 
+ * technology has been found the technologies which have not been left out 
+ * for RFAL_NFC_ADAPTIVE_POLL_MAX_SKIP cycles are not polled on this cycle.
+ * 
+ * \return  RFAL_NFC_TECH_NONE : All technologies have been performed
+ * \return  RFAL_NFC_POLL_TECH_XXXX : Technology to be detected
+ * 
+ ******************************************************************************
+ */
+static uint16_t rfalNfcPollTechNext( void )
+{
+    uint16_t tech;
+    uint8_t  idx;
+    uint8_t  i;
+    
+    tech = RFAL_NFC_TECH_NONE;
+    
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+    if( gNfcDev.adaptive )
+    {
+        uint16_t score;
+        
+        score = 0U;
+        for( i = 0; i < RFAL_NFC_POLL_TECH_NUM; i++ )
+        {
+            idx = gNfcPollTechOrder[i];
+            
+            if( (gNfcDev.techs2do & rfalNfcPollTechFlag( idx )) == 0U )
+            {
+                continue;
+            }
+            
+            if( (gNfcDev.techsFound != RFAL_NFC_TECH_NONE) && (gNfcDev.techSkip[idx] < RFAL_NFC_ADAPTIVE_POLL_MAX_SKIP) )
+            {
+                gNfcDev.techs2do &= ~rfalNfcPollTechFlag( idx );                     /* A device is already found, leave it for a later cycle */
+                continue;
+            }
+            
+            if( (tech == RFAL_NFC_TECH_NONE) || (gNfcDev.techScore[idx] > score) )
+            {
+                tech  = rfalNfcPollTechFlag( idx );
+                score = gNfcDev.techScore[idx];
+            }
+        }
+    }
+    else
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+    {
+        for( i = 0; i < RFAL_NFC_POLL_TECH_NUM; i++ )
+        {
+            idx = gNfcPollTechOrder[i];
+            
+            if( (gNfcDev.techs2do & rfalNfcPollTechFlag( idx )) != 0U )
+            {
+                tech = rfalNfcPollTechFlag( idx );
+                break;
+            }
+        }
+    }
+    
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+    /* Detection time is measured from the first technology polled */
+    if( (gNfcDev.techsPolled == RFAL_NFC_TECH_NONE) && (tech != RFAL_NFC_TECH_NONE) )
+    {
+        gNfcDev.detectStart = platformGetSysTick();
+    }
+    gNfcDev.techsPolled |= tech;
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+    
+    return tech;
+}
+
+#if RFAL_FEATURE_NFC_ADAPTIVE_POLL
+/*!
+ ******************************************************************************
+ * \brief Poller Technology Detection statistics update
+ * 
+ * This method updates the hit rate score of the technologies polled on the 
+ * Technology Detection just completed, counts the cycles the others have been 
+ * left out and records the time to first detection.
+ * 
+ ******************************************************************************
+ */
+static void rfalNfcPollStatsUpdate( void )
+{
+    uint32_t detectTime;
+    uint16_t tech;
+    uint8_t  i;
+    
+    gNfcDev.pollStats.cycles++;
+    
+    for( i = 0; i < RFAL_NFC_POLL_TECH_NUM; i++ )
+    {
+        tech = rfalNfcPollTechFlag( i );
+        
+        if( (gNfcDev.techsPolled & tech) != 0U )
+        {
+            gNfcDev.pollStats.probes[i]++;
+            gNfcDev.techSkip[i]   = 0U;
+            gNfcDev.techScore[i] -= (gNfcDev.techScore[i] >> RFAL_NFC_ADAPTIVE_POLL_DECAY);
+            
+            if( (gNfcDev.techsFound & tech) != 0U )
+            {
+                gNfcDev.pollStats.hits[i]++;
+                gNfcDev.techScore[i] += (uint16_t)RFAL_NFC_ADAPTIVE_POLL_HIT;
+            }
+        }
+        else if( ((gNfcDev.disc.techs2Find & tech) != 0U) && (gNfcDev.techSkip[i] < UINT8_MAX) )
+        {
+            gNfcDev.techSkip[i]++;
+        }
+        else
+        {
+            /* MISRA 15.7 - Empty else */
+        }
+    }
+    
+    if( gNfcDev.techsFound != RFAL_NFC_TECH_NONE )
+    {
+        detectTime = (platformGetSysTick() - gNfcDev.detectStart);
+        
+        gNfcDev.pollStats.detections++;
+        gNfcDev.pollStats.lastDetectionTime   = detectTime;
+        gNfcDev.pollStats.totalDetectionTime += detectTime;
+    }
+}
+#endif /* RFAL_FEATURE_NFC_ADAPTIVE_POLL */
+
 /*!
  ******************************************************************************
  * \brief Poller Collision Resolution
@@ -1019,11 +1382,12 @@ static ReturnCode rfalNfcPollTechDetetection( void )
 static ReturnCode rfalNfcPollCollResolution( void )
 {
     uint8_t    i;
-    static uint8_t    devCnt;
+    uint8_t    devCnt;
     ReturnCode err;
     
     err    = ERR_NONE;
     i      = 0;
+    devCnt = 0;
     
     /* Supress warning when specific RFAL features have been disabled */
     NO_WARNING(err);
@@ -1042,8 +1406,6 @@ static ReturnCode rfalNfcPollCollResolution( void )
 #if RFAL_FEATURE_NFCA
     if( ((gNfcDev.techsFound & RFAL_NFC_POLL_TECH_A) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_A) != 0U) )   /* If a NFC-A device was found/detected, perform Collision Resolution */
     {
-        static rfalNfcaListenDevice nfcaDevList[RFAL_NFC_MAX_DEVICES];
-        
         if( !gNfcDev.isTechInit )
         {
             EXIT_ON_ERR( err, rfalNfcaPollerInitialize() );                            /* Initialize RFAL for NFC-A */
@@ -1060,7 +1422,11 @@ static ReturnCode rfalNfcPollCollResolution( void )
         
         if( !gNfcDev.isOperOngoing )
         {
-            EXIT_ON_ERR( err, rfalNfcaPollerStartFullCollisionResolution( gNfcDev.disc.compMode, (gNfcDev.disc.devLimit - gNfcDev.devCnt), nfcaDevList, &devCnt ) );
+        #if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+            EXIT_ON_ERR( err, rfalNfcaPollerStartFastCollisionResolution( gNfcDev.disc.compMode, (gNfcDev.disc.devLimit - gNfcDev.devCnt), gNfcDev.nfcaDevList, &gNfcDev.nfcaDevCnt ) );
+        #else
+            EXIT_ON_ERR( err, rfalNfcaPollerStartFullCollisionResolution( gNfcDev.disc.compMode, (gNfcDev.disc.devLimit - gNfcDev.devCnt), gNfcDev.nfcaDevList, &gNfcDev.nfcaDevCnt ) );
+        #endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
          
             gNfcDev.isOperOngoing = true;
             return ERR_BUSY;
@@ -1072,12 +1438,12 @@ static ReturnCode rfalNfcPollCollResolution( void )
             gNfcDev.isTechInit = false;
             gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_A;
             
-            if( (err == ERR_NONE) && (devCnt != 0U) )
+            if( (err == ERR_NONE) && (gNfcDev.nfcaDevCnt != 0U) )
             {
-                for( i=0; i<devCnt; i++ )                                                 /* Copy devices found form local Nfca list into global device list */
+                for( i=0; i<gNfcDev.nfcaDevCnt; i++ )                                     /* Copy devices found form local Nfca list into global device list */
                 {
                     gNfcDev.devList[gNfcDev.devCnt].type     = RFAL_NFC_LISTEN_TYPE_NFCA;
-                    gNfcDev.devList[gNfcDev.devCnt].dev.nfca = nfcaDevList[i];
+                    gNfcDev.devList[gNfcDev.devCnt].dev.nfca = gNfcDev.nfcaDevList[i];
                     gNfcDev.devCnt++;
                 }
             }
@@ -1093,13 +1459,12 @@ static ReturnCode rfalNfcPollCollResolution( void )
 #if RFAL_FEATURE_NFCB
     if( ((gNfcDev.techsFound & RFAL_NFC_POLL_TECH_B) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_B) != 0U) )   /* If a NFC-B device was found/detected, perform Collision Resolution */
     {
-        rfalNfcbListenDevice nfcbDevList[RFAL_NFC_MAX_DEVICES];
-        
         if( !gNfcDev.isTechInit )
         {
             EXIT_ON_ERR( err, rfalNfcbPollerInitialize());                            /* Initialize RFAL for NFC-B */
             EXIT_ON_ERR( err, rfalFieldOnAndStartGT() );                              /* Ensure GT again as other technologies have also been polled */
-            gNfcDev.isTechInit = true;
+            gNfcDev.isTechInit    = true;
+            gNfcDev.isOperOngoing = false;                                            /* No operation currently ongoing  */
         }
         
         if( !rfalIsGTExpired() )
@@ -1107,19 +1472,33 @@ static ReturnCode rfalNfcPollCollResolution( void )
             return ERR_BUSY;
         }
         
-        devCnt             = 0;
-        gNfcDev.isTechInit = false;
-        gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_B;
-        
+        if( !gNfcDev.isOperOngoing )
+        {
+            err = rfalNfcbPollerStartCollisionResolution( gNfcDev.disc.compMode, (gNfcDev.disc.devLimit - gNfcDev.devCnt), gNfcDev.nfcbDevList, &gNfcDev.nfcbDevCnt );
+            if( err == ERR_NONE )
+            {
+                gNfcDev.isOperOngoing = true;
+                return ERR_BUSY;
+            }
+        }
+        else
+        {
+            err = rfalNfcbPollerGetCollisionResolutionStatus();                       /* One slot per call */
+        }
         
-        err = rfalNfcbPollerCollisionResolution( gNfcDev.disc.compMode, (gNfcDev.disc.devLimit - gNfcDev.devCnt), nfcbDevList, &devCnt );
-        if( (err == ERR_NONE) && (devCnt != 0U) )
+        if( err != ERR_BUSY )
         {
-            for( i=0; i<devCnt; i++ )                                                 /* Copy devices found form local Nfcb list into global device list */
+            gNfcDev.isTechInit = false;
+            gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_B;
+            
+            if( (err == ERR_NONE) && (gNfcDev.nfcbDevCnt != 0U) )
             {
-                gNfcDev.devList[gNfcDev.devCnt].type     = RFAL_NFC_LISTEN_TYPE_NFCB;
-                gNfcDev.devList[gNfcDev.devCnt].dev.nfcb = nfcbDevList[i];
-                gNfcDev.devCnt++;
+                for( i=0; i<gNfcDev.nfcbDevCnt; i++ )                                 /* Copy devices found form local Nfcb list into global device list */
+                {
+                    gNfcDev.devList[gNfcDev.devCnt].type     = RFAL_NFC_LISTEN_TYPE_NFCB;
+                    gNfcDev.devList[gNfcDev.devCnt].dev.nfcb = gNfcDev.nfcbDevList[i];
+                    gNfcDev.devCnt++;
+                }
             }
         }
         
@@ -1173,13 +1552,12 @@ static ReturnCode rfalNfcPollCollResolution( void )
 #if RFAL_FEATURE_NFCV
     if( ((gNfcDev.techsFound & RFAL_NFC_POLL_TECH_V) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_V) != 0U) )  /* If a NFC-V device was found/detected, perform Collision Resolution */
     {
-        rfalNfcvListenDevice nfcvDevList[RFAL_NFC_MAX_DEVICES];
-        
         if( !gNfcDev.isTechInit )
         {
             EXIT_ON_ERR( err, rfalNfcvPollerInitialize());                            /* Initialize RFAL for NFC-V */
             EXIT_ON_ERR( err, rfalFieldOnAndStartGT() );                              /* Ensure GT again as other technologies have also been polled */
-            gNfcDev.isTechInit = true;
+            gNfcDev.isTechInit    = true;
+            gNfcDev.isOperOngoing = false;                                            /* No operation currently ongoing  */
         }
         
         if( !rfalIsGTExpired() )
@@ -1187,19 +1565,41 @@ static ReturnCode rfalNfcPollCollResolution( void )
             return ERR_BUSY;
         }
         
-        devCnt             = 0;
-        gNfcDev.isTechInit = false;
-        gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_V;
-        
+        if( !gNfcDev.isOperOngoing )
+        {
+        #if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+            /* Size the inventory rounds after the population found by the previous one */
+            err = rfalNfcvPollerStartAdaptiveCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, (gNfcDev.disc.devLimit - gNfcDev.devCnt), gNfcDev.nfcvPop, gNfcDev.nfcvDevList, &gNfcDev.nfcvDevCnt );
+        #else
+            err = rfalNfcvPollerStartCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, (gNfcDev.disc.devLimit - gNfcDev.devCnt), gNfcDev.nfcvDevList, &gNfcDev.nfcvDevCnt );
+        #endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+            if( err == ERR_NONE )
+            {
+                gNfcDev.isOperOngoing = true;
+                return ERR_BUSY;
+            }
+        }
+        else
+        {
+            err = rfalNfcvPollerGetCollisionResolutionStatus();                       /* One slot per call */
+        }
         
-        err = rfalNfcvPollerCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, (gNfcDev.disc.devLimit - gNfcDev.devCnt), nfcvDevList, &devCnt );
-        if( (err == ERR_NONE) && (devCnt != 0U) )
+        if( err != ERR_BUSY )
         {
-            for( i=0; i<devCnt; i++ )                                                 /* Copy devices found form local Nfcf list into global device list */
+            gNfcDev.isTechInit = false;
+            gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_V;
+        #if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+            gNfcDev.nfcvPop    = gNfcDev.nfcvDevCnt;
+        #endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+            
+            if( (err == ERR_NONE) && (gNfcDev.nfcvDevCnt != 0U) )
             {
-                gNfcDev.devList[gNfcDev.devCnt].type     = RFAL_NFC_LISTEN_TYPE_NFCV;
-                gNfcDev.devList[gNfcDev.devCnt].dev.nfcv = nfcvDevList[i];
-                gNfcDev.devCnt++;
+                for( i=0; i<gNfcDev.nfcvDevCnt; i++ )                                 /* Copy devices found form local Nfcv list into global device list */
+                {
+                    gNfcDev.devList[gNfcDev.devCnt].type     = RFAL_NFC_LISTEN_TYPE_NFCV;
+                    gNfcDev.devList[gNfcDev.devCnt].dev.nfcv = gNfcDev.nfcvDevList[i];
+                    gNfcDev.devCnt++;
+                }
             }
         }
         
@@ -1213,13 +1613,12 @@ static ReturnCode rfalNfcPollCollResolution( void )
 #if RFAL_FEATURE_ST25TB
     if( ((gNfcDev.techsFound & RFAL_NFC_POLL_TECH_ST25TB) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_ST25TB) != 0U) ) /* If a ST25TB device was found/detected, perform Collision Resolution */
     {
-        rfalSt25tbListenDevice st25tbDevList[RFAL_NFC_MAX_DEVICES];
-        
         if( !gNfcDev.isTechInit )
         {
             EXIT_ON_ERR( err, rfalSt25tbPollerInitialize() );                         /* Initialize RFAL for ST25TB */
             EXIT_ON_ERR( err, rfalFieldOnAndStartGT() );                              /* Ensure GT again as other technologies have also been polled */
-            gNfcDev.isTechInit = true;
+            gNfcDev.isTechInit    = true;
+            gNfcDev.isOperOngoing = false;                                            /* No operation currently ongoing  */
         }
         
         if( !rfalIsGTExpired() )
@@ -1227,19 +1626,33 @@ static ReturnCode rfalNfcPollCollResolution( void )
             return ERR_BUSY;
         }
         
-        devCnt             = 0;
-        gNfcDev.isTechInit = false;
-        gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_ST25TB;
-        
+        if( !gNfcDev.isOperOngoing )
+        {
+            err = rfalSt25tbPollerStartCollisionResolution( (gNfcDev.disc.devLimit - gNfcDev.devCnt), gNfcDev.st25tbDevList, &gNfcDev.st25tbDevCnt );
+            if( err == ERR_NONE )
+            {
+                gNfcDev.isOperOngoing = true;
+                return ERR_BUSY;
+            }
+        }
+        else
+        {
+            err = rfalSt25tbPollerGetCollisionResolutionStatus();                     /* One slot per call */
+        }
         
-        err = rfalSt25tbPollerCollisionResolution( (gNfcDev.disc.devLimit - gNfcDev.devCnt), st25tbDevList, &devCnt );
-        if( (err == ERR_NONE) && (devCnt != 0U) )
+        if( err != ERR_BUSY )
         {
-            for( i=0; i<devCnt; i++ )                                                 /* Copy devices found form local Nfcf list into global device list */
+            gNfcDev.isTechInit = false;
+            gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_ST25TB;
+            
+            if( (err == ERR_NONE) && (gNfcDev.st25tbDevCnt != 0U) )
             {
-                gNfcDev.devList[gNfcDev.devCnt].type       = RFAL_NFC_LISTEN_TYPE_ST25TB;
-                gNfcDev.devList[gNfcDev.devCnt].dev.st25tb = st25tbDevList[i];
-                gNfcDev.devCnt++;
+                for( i=0; i<gNfcDev.st25tbDevCnt; i++ )                               /* Copy devices found form local ST25TB list into global device list */
+                {
+                    gNfcDev.devList[gNfcDev.devCnt].type       = RFAL_NFC_LISTEN_TYPE_ST25TB;
+                    gNfcDev.devList[gNfcDev.devCnt].dev.st25tb = gNfcDev.st25tbDevList[i];
+                    gNfcDev.devCnt++;
+                }
             }
         }
         
@@ -1251,6 +1664,33 @@ static ReturnCode rfalNfcPollCollResolution( void )
 }
 
 
+#if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+/*!
+ ******************************************************************************
+ * \brief Poller ISO-DEP Link Adaptation device selection
+ * 
+ * This method clears the ISO-DEP link adaptation when the device about to 
+ * be activated is not the one it has learned on, so that the bit rate 
+ * ceiling of a device does not apply to another one. 
+ *  
+ * \param[in]  device : device about to be activated with ISO-DEP
+ * 
+ ******************************************************************************
+ */
+static void rfalNfcIsoDepLinkSelect( const rfalNfcDevice *device )
+{
+    if( (device->nfcidLen != gNfcDev.isoDepNfcidLen) || (device->nfcidLen > sizeof(gNfcDev.isoDepNfcid)) || 
+        (ST_BYTECMP( device->nfcid, gNfcDev.isoDepNfcid, device->nfcidLen ) != 0) )
+    {
+        rfalIsoDepPollResetLinkAdaptation();
+        
+        gNfcDev.isoDepNfcidLen = (uint8_t)MIN( device->nfcidLen, sizeof(gNfcDev.isoDepNfcid) );
+        ST_MEMCPY( gNfcDev.isoDepNfcid, device->nfcid, gNfcDev.isoDepNfcidLen );
+    }
+}
+#endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
+
+
 /*!
  ******************************************************************************
  * \brief Poller Activation
@@ -1366,6 +1806,9 @@ static ReturnCode rfalNfcPollActivation( uint8_t devIt )
                     {
                         /* Perform ISO-DEP (ISO14443-4) activation: RATS and PPS if supported */
                         rfalIsoDepInitialize();                    
+                    #if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+                        rfalNfcIsoDepLinkSelect( &gNfcDev.devList[devIt] );
+                    #endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
                         EXIT_ON_ERR( err, rfalIsoDepPollAStartActivation( (rfalIsoDepFSxI)RFAL_ISODEP_FSDI_DEFAULT, RFAL_ISODEP_NO_DID, gNfcDev.disc.maxBR, &gNfcDev.devList[devIt].proto.isoDep ) );
                         
                         gNfcDev.isOperOngoing = true;
@@ -1445,6 +1888,9 @@ static ReturnCode rfalNfcPollActivation( uint8_t devIt )
                 if( !gNfcDev.isOperOngoing )
                 {
                     rfalIsoDepInitialize();
+                #if RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION
+                    rfalNfcIsoDepLinkSelect( &gNfcDev.devList[devIt] );
+                #endif /* RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION */
                     /* Perform ISO-DEP (ISO14443-4) activation: ATTRIB    */
                     EXIT_ON_ERR( err, rfalIsoDepPollBStartActivation( (rfalIsoDepFSxI)RFAL_ISODEP_FSDI_DEFAULT, RFAL_ISODEP_NO_DID, gNfcDev.disc.maxBR, 0x00, &gNfcDev.devList[devIt].dev.nfcb, NULL, 0, &gNfcDev.devList[devIt].proto.isoDep ) );
                     
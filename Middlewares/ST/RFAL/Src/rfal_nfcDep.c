@@ -367,7 +367,8 @@ typedef struct{
  ******************************************************************************
  */
 
-static rfalNfcDep gNfcip;                    /*!< NFCIP module instance                         */
+static rfalNfcDep gNfcipInstances[RFAL_FEATURE_MAX_INSTANCES];  /*!< NFCIP module instances                     */
+#define gNfcip    (gNfcipInstances[rfalInstanceIdx()])          /*!< NFCIP module instance of the selected RF chip */
 
 
 /*
@@ -87,6 +87,9 @@
 
 #define RFAL_NFCA_T_RETRANS         5U                    /*!< t RETRANSMISSION [3, 33]ms   EMVCo 2.6  A.5      */
 #define RFAL_NFCA_N_RETRANS         2U                    /*!< Number of retries            EMVCo 2.6  9.6.1.3  */
+
+#define RFAL_NFCA_FAST_CR_MAX_BRANCHES  16U               /*!< Max NFCID1 prefixes pending in the fast CR       */
+#define RFAL_NFCA_FAST_CR_MAX_SDD       48U               /*!< Max SDD_REQs per device in the fast CR           */
  
 
 /*! SDD_REQ (Select) Cascade Levels  */
@@ -131,6 +134,18 @@ typedef enum{
 }colResState;
 
 
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+
+/*! NFCID1 prefix of a branch pending in the fast Collision Resolution */
+typedef struct{
+    uint8_t               bytesTxRx;        /*!< SDD_REQ bytes to be sent, SEL_CMD and SEL_PAR included  */
+    uint8_t               bitsTxRx;         /*!< SDD_REQ bits to be sent                                 */
+    uint8_t               nfcid1[RFAL_NFCA_CASCADE_1_UID_LEN]; /*!< NFCID1 prefix                        */
+}rfalNfcaBranch;
+
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+
+
 /*! Colission Resolution context */
 typedef struct{
     uint8_t               devLimit;        /*!< Device limit to be used                                 */
@@ -153,6 +168,14 @@ typedef struct{
     uint8_t               retries;          /*!< Retries to be performed upon a timeout error (Single CR)*/
     uint8_t               backtrackCnt;     /*!< Backtrack retries (Single CR)                           */
     bool                  doBacktrack;      /*!< Backtrack flag (Single CR)                              */
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+    bool                  fast;             /*!< Fast Collision Resolution flag                          */
+    bool                  branchPass;       /*!< Current loop started from a recorded branch (Fast CR)   */
+    bool                  restart;          /*!< Loop from scratch needed once branches are done (Fast CR)*/
+    uint8_t               sddCnt;           /*!< SDD_REQs sent for the current device (Fast CR)          */
+    uint8_t               branchCnt;        /*!< Number of branches pending (Fast CR)                    */
+    rfalNfcaBranch        branch[RFAL_NFCA_FAST_CR_MAX_BRANCHES]; /*!< Branches pending (Fast CR)        */
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
 }colResParams;
 
 
@@ -174,7 +197,8 @@ typedef struct
 * LOCAL VARIABLES
 ******************************************************************************
 */
-static rfalNfca gNfca;  /*!< RFAL NFC-A instance  */
+static rfalNfca gNfcaInstances[RFAL_FEATURE_MAX_INSTANCES];  /*!< RFAL NFC-A instances  */
+#define gNfca     (gNfcaInstances[rfalInstanceIdx()])       /*!< RFAL NFC-A instance of the selected RF chip */
 
 /*
 ******************************************************************************
@@ -184,6 +208,10 @@ static rfalNfca gNfca;  /*!< RFAL NFC-A instance  */
 static uint8_t    rfalNfcaCalculateBcc( const uint8_t* buf, uint8_t bufLen );
 static ReturnCode rfalNfcaPollerStartSingleCollisionResolution( uint8_t devLimit, bool *collPending, rfalNfcaSelRes *selRes, uint8_t *nfcId1, uint8_t *nfcId1Len );
 static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void );
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+static void       rfalNfcaPollerFastPushBranch( uint8_t collBit );
+static ReturnCode rfalNfcaPollerFastNextPass( void );
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
 
 /*
  ******************************************************************************
@@ -238,6 +266,10 @@ static ReturnCode rfalNfcaPollerStartSingleCollisionResolution( uint8_t devLimit
     gNfca.CR.doBacktrack  = false;
     gNfca.CR.backtrackCnt = 3U;
     
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+    gNfca.CR.sddCnt       = 0U;
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+
     return ERR_NONE;
 }
 
@@ -274,6 +306,19 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
             gNfca.CR.bitsTxRx  = 0U;
             gNfca.CR.state     = RFAL_NFCA_CR_SDD;
         
+        #if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+            /* Resume the anticollision from the recorded NFCID1 prefix */
+            if( gNfca.CR.fast && gNfca.CR.branchPass && (gNfca.CR.cascadeLv == (uint8_t)RFAL_NFCA_SEL_CASCADE_L1) )
+            {
+                ST_MEMCPY( gNfca.CR.selReq.nfcid1, gNfca.CR.branch[gNfca.CR.branchCnt].nfcid1, RFAL_NFCA_CASCADE_1_UID_LEN );
+                gNfca.CR.bytesTxRx = gNfca.CR.branch[gNfca.CR.branchCnt].bytesTxRx;
+                gNfca.CR.bitsTxRx  = gNfca.CR.branch[gNfca.CR.branchCnt].bitsTxRx;
+                
+                /* No answer to the prefix means no device left on this branch, not a missed collision */
+                gNfca.CR.doBacktrack = true;
+            }
+        #endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+        
             /* fall through */
         
         /*******************************************************************************/
@@ -283,6 +328,18 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
             gNfca.CR.selReq.selCmd = rfalNfcaCLn2SELCMD( gNfca.CR.cascadeLv );
             gNfca.CR.selReq.selPar = rfalNfcaSelPar(gNfca.CR.bytesTxRx, gNfca.CR.bitsTxRx);
         
+        #if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+            /* Bound the work per device */
+            if( gNfca.CR.fast )
+            {
+                gNfca.CR.sddCnt++;
+                if( gNfca.CR.sddCnt > RFAL_NFCA_FAST_CR_MAX_SDD )
+                {
+                    return ERR_PROTO;
+                }
+            }
+        #endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+        
             /* Send SDD_REQ (Anticollision frame) */
             ret = rfalISO14443ATransceiveAnticollisionFrame( (uint8_t*)&gNfca.CR.selReq, &gNfca.CR.bytesTxRx, &gNfca.CR.bitsTxRx, &gNfca.CR.rxLen, RFAL_NFCA_FDTMIN );
 
@@ -337,6 +394,13 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
                 {
                     return ERR_PROTO;
                 }
+                
+            #if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+                if( gNfca.CR.fast )
+                {
+                    rfalNfcaPollerFastPushBranch( collBit );
+                }
+            #endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
 
                 if( ((gNfca.CR.bytesTxRx + ((gNfca.CR.bitsTxRx != 0U) ? 1U : 0U)) > (RFAL_NFCA_CASCADE_1_UID_LEN + RFAL_NFCA_SDD_REQ_LEN)) && (gNfca.CR.backtrackCnt != 0U) )
                 { /* Collision in BCC: Anticollide only UID part */
@@ -465,6 +529,91 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
     return ERR_BUSY;
 }
 
+
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+
+/*******************************************************************************/
+static void rfalNfcaPollerFastPushBranch( uint8_t collBit )
+{
+    rfalNfcaBranch *branch;
+    uint8_t         idx;
+    
+    /* Only real collisions within the cascade level 1 NFCID1 can be recorded */
+    if( (gNfca.CR.cascadeLv != (uint8_t)RFAL_NFCA_SEL_CASCADE_L1) || (gNfca.CR.doBacktrack) || 
+        (gNfca.CR.bytesTxRx >= (RFAL_NFCA_SDD_REQ_LEN + RFAL_NFCA_CASCADE_1_UID_LEN)) || (gNfca.CR.branchCnt >= RFAL_NFCA_FAST_CR_MAX_BRANCHES) )
+    {
+        /* Other branch unknown, a loop from scratch is needed once the recorded ones are done */
+        gNfca.CR.restart = true;
+        return;
+    }
+    
+    /* Record the prefix with the collision bit set to the other value */
+    branch = &gNfca.CR.branch[gNfca.CR.branchCnt];
+    idx    = (gNfca.CR.bytesTxRx - RFAL_NFCA_SDD_REQ_LEN);
+    
+    ST_MEMCPY( branch->nfcid1, gNfca.CR.selReq.nfcid1, RFAL_NFCA_CASCADE_1_UID_LEN );
+    if( collBit != 0U )
+    {
+        branch->nfcid1[idx] = (uint8_t)(branch->nfcid1[idx] & ~(1U << gNfca.CR.bitsTxRx));  /* MISRA 10.3 */
+    }
+    else
+    {
+        branch->nfcid1[idx] = (uint8_t)(branch->nfcid1[idx] | (1U << gNfca.CR.bitsTxRx));   /* MISRA 10.3 */
+    }
+    
+    branch->bytesTxRx = gNfca.CR.bytesTxRx;
+    branch->bitsTxRx  = (gNfca.CR.bitsTxRx + 1U);
+    if( branch->bitsTxRx == RFAL_BITS_IN_BYTE )
+    {
+        branch->bitsTxRx = 0U;
+        branch->bytesTxRx++;
+    }
+    
+    gNfca.CR.branchCnt++;
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalNfcaPollerFastNextPass( void )
+{
+    ReturnCode ret;
+    
+    /* Check if collision resolution shall continue */
+    if( (*gNfca.CR.devCnt >= gNfca.CR.devLimit) || ((gNfca.CR.branchCnt == 0U) && (!gNfca.CR.restart)) )
+    {
+        return ERR_NONE;
+    }
+    
+    /* SEL_REQ with another NFCID1 sent the other devices back to IDLE, SENS_REQ returns them to READY  ISO14443-3 6.3.3 */
+    ret = rfalNfcaPollerCheckPresence( RFAL_14443A_SHORTFRAME_CMD_REQA, &gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].sensRes );
+    if( ret == ERR_TIMEOUT )
+    {
+        /* No more devices found, exit */
+        return ERR_NONE;
+    }
+    
+    EXIT_ON_ERR( ret, rfalNfcaPollerStartSingleCollisionResolution(  gNfca.CR.devLimit, 
+                                                                     &gNfca.CR.collPending, 
+                                                                     &gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].selRes, 
+                                                                     (uint8_t*)&gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].nfcId1, 
+                                                                     &gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].nfcId1Len ) );
+    
+    /* Resume from the last recorded branch, otherwise loop from scratch */
+    gNfca.CR.branchPass = (gNfca.CR.branchCnt != 0U);
+    if( gNfca.CR.branchPass )
+    {
+        gNfca.CR.branchCnt--;
+    }
+    else
+    {
+        gNfca.CR.restart = false;
+    }
+    
+    return ERR_BUSY;
+}
+
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTIONS
@@ -588,6 +737,9 @@ ReturnCode rfalNfcaPollerStartFullCollisionResolution( rfalComplianceMode compMo
     gNfca.CR.devLimit    = devLimit;
     gNfca.CR.nfcaDevList = nfcaDevList;
     gNfca.CR.compMode    = compMode;
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+    gNfca.CR.fast        = false;
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
     
     
     #if RFAL_FEATURE_T1T
@@ -636,7 +788,20 @@ ReturnCode rfalNfcaPollerGetFullCollisionResolutionStatus( void )
     
     
     /*******************************************************************************/
-    EXIT_ON_ERR( ret, rfalNfcaPollerGetSingleCollisionResolutionStatus() );
+    ret = rfalNfcaPollerGetSingleCollisionResolutionStatus();
+    
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+    if( (ret == ERR_TIMEOUT) && (gNfca.CR.fast) && (gNfca.CR.branchPass) )
+    {
+        /* No device left on this branch, continue with the next one */
+        return rfalNfcaPollerFastNextPass();
+    }
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+    
+    if( ret != ERR_NONE )
+    {
+        return ret;
+    }
 
     /* Assign Listen Device */
     newDevType = ((uint8_t)gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].selRes.sak) & RFAL_NFCA_SEL_RES_CONF_MASK;  /* MISRA 10.8 */
@@ -645,6 +810,19 @@ ReturnCode rfalNfcaPollerGetFullCollisionResolutionStatus( void )
     gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].isSleep = false;
     (*gNfca.CR.devCnt)++;
 
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+    if( gNfca.CR.fast )
+    {
+        /* Put this device to Sleep only if another loop follows */
+        if( (*gNfca.CR.devCnt < gNfca.CR.devLimit) && ((gNfca.CR.branchCnt != 0U) || (gNfca.CR.restart)) )
+        {
+            rfalNfcaPollerSleep();
+            gNfca.CR.nfcaDevList[(*gNfca.CR.devCnt - 1U)].isSleep = true;
+        }
+        
+        return rfalNfcaPollerFastNextPass();
+    }
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
     
     /* If a collision was detected and device counter is lower than limit  Activity 1.1  9.3.4.21 */
     if( (*gNfca.CR.devCnt < gNfca.CR.devLimit) && (gNfca.CR.collPending) )
@@ -702,6 +880,43 @@ ReturnCode rfalNfcaPollerFullCollisionResolution( rfalComplianceMode compMode, u
     return ret;
 }
 
+
+/*******************************************************************************/
+ReturnCode rfalNfcaPollerStartFastCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcaListenDevice *nfcaDevList, uint8_t *devCnt )
+{
+#if RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION
+    ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalNfcaPollerStartFullCollisionResolution( compMode, devLimit, nfcaDevList, devCnt ) );
+    
+    gNfca.CR.fast       = true;
+    gNfca.CR.branchPass = false;
+    gNfca.CR.restart    = false;
+    gNfca.CR.branchCnt  = 0U;
+    
+    return ERR_NONE;
+#else
+    NO_WARNING(compMode);
+    NO_WARNING(devLimit);
+    NO_WARNING(nfcaDevList);
+    NO_WARNING(devCnt);
+    
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION */
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcaPollerFastCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcaListenDevice *nfcaDevList, uint8_t *devCnt )
+{
+    ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalNfcaPollerStartFastCollisionResolution( compMode, devLimit, nfcaDevList, devCnt ) );
+    rfalNfcaRunBlocking( ret, rfalNfcaPollerGetFullCollisionResolutionStatus() );
+    
+    return ret;
+}
+
 ReturnCode rfalNfcaPollerSleepFullCollisionResolution( uint8_t devLimit, rfalNfcaListenDevice *nfcaDevList, uint8_t *devCnt )
 {
     bool       firstRound;
@@ -89,6 +89,7 @@ enum
  */
 
 #define rfalNfcbNI2NumberOfSlots( ni )  (uint8_t)(1U << (ni))  /*!< Converts the Number of slots Identifier to slot number */
+#define rfalNfcbRunBlocking( e, fn )     do{ (e)=(fn); }while( (e) == ERR_BUSY )   /*!< Macro used for the blocking methods */
 
 /*
 ******************************************************************************
@@ -125,11 +126,29 @@ typedef struct
 } rfalNfcbSlpbRes;
 
 
+/*! Collision Resolution context */
+typedef struct
+{
+    rfalComplianceMode    compMode;          /*!< Compliance mode to be used                   */
+    uint8_t               devLimit;          /*!< Device limit to be used                      */
+    rfalNfcbSlots         initSlots;         /*!< Number of slots opened initially             */
+    rfalNfcbSlots         endSlots;          /*!< Number of slots when to stop                 */
+    rfalNfcbListenDevice* nfcbDevList;       /*!< Location of the device list                  */
+    uint8_t*              devCnt;            /*!< Location of the device counter               */
+    bool                  colPending;        /*!< Collision pending flag                       */
+    uint8_t               slotsNum;          /*!< Number of slots of the ongoing round         */
+    uint8_t               slotCode;          /*!< Next slot of the ongoing round               */
+    uint8_t               curDevCnt;         /*!< Devices found on the ongoing round           */
+    ReturnCode            ret;               /*!< ALLB_REQ outcome, used by the first round    */
+} rfalNfcbColResParams;
+
+
 /*! RFAL NFC-B instance */
 typedef struct
 {
     uint8_t  AFI;                            /*!< AFI to be used       */
     uint8_t  PARAM;                          /*!< PARAM to be used     */
+    rfalNfcbColResParams CR;                 /*!< Collision Resolution context */
 } rfalNfcb;
 
 /*
@@ -138,6 +157,7 @@ typedef struct
 ******************************************************************************
 */
 static ReturnCode rfalNfcbCheckSensbRes( const rfalNfcbSensbRes *sensbRes, uint8_t sensbResLen );
+static ReturnCode rfalNfcbPollerCollisionResolutionStep( void );
 
 
 /*
@@ -146,7 +166,8 @@ static ReturnCode rfalNfcbCheckSensbRes( const rfalNfcbSensbRes *sensbRes, uint8
 ******************************************************************************
 */
 
-static rfalNfcb gRfalNfcb; /*!< RFAL NFC-B Instance */
+static rfalNfcb gRfalNfcbInstances[RFAL_FEATURE_MAX_INSTANCES]; /*!< RFAL NFC-B Instances */
+#define gRfalNfcb (gRfalNfcbInstances[rfalInstanceIdx()])          /*!< RFAL NFC-B Instance of the selected RF chip */
 
 
 /*
@@ -172,6 +193,139 @@ static ReturnCode rfalNfcbCheckSensbRes( const rfalNfcbSensbRes *sensbRes, uint8
     return ERR_NONE;
 }
 
+/*******************************************************************************/
+static ReturnCode rfalNfcbPollerCollisionResolutionStep( void )
+{
+    ReturnCode            ret;
+    rfalNfcbColResParams *cr;
+    rfalNfcbListenDevice *devList;
+    
+    cr      = &gRfalNfcb.CR;
+    devList = cr->nfcbDevList;
+    
+    if( cr->slotsNum > (uint8_t)cr->endSlots )
+    {
+        return ERR_NONE;
+    }
+    
+    if( cr->slotCode == 0U )
+    {
+        /* Activity 1.1  9.3.5.23  -  Symbol 22 */
+        if( (cr->compMode == RFAL_COMPLIANCE_MODE_NFC) && (cr->curDevCnt != 0U) )
+        {
+            rfalNfcbPollerSleep( devList[((*cr->devCnt) - (uint8_t)1U)].sensbRes.nfcid0 );
+            devList[((*cr->devCnt) - (uint8_t)1U)].isSleep = true;
+        }
+        
+        /* Send SENSB_REQ with number of slots if not the first Activity 1.1  9.3.5.24  -  Symbol 23 */
+        if( (cr->slotsNum != (uint8_t)cr->initSlots) || cr->colPending )
+        {
+            /* PRQA S 4342 1 # MISRA 10.5 - Layout of rfalNfcbSlots and above loop guarantee that no invalid enum values are created. */
+            cr->ret = rfalNfcbPollerCheckPresence( RFAL_NFCB_SENS_CMD_SENSB_REQ, (rfalNfcbSlots)cr->slotsNum, &devList[*cr->devCnt].sensbRes, &devList[*cr->devCnt].sensbResLen );
+        }
+        
+        /* Activity 1.1  9.3.5.6  -  Symbol 5 */
+        cr->curDevCnt  = 0;
+        cr->colPending = false;
+        
+        ret = cr->ret;
+    }
+    else
+    {
+        /* Activity 1.1  9.3.5.26  -  Symbol 25 */
+        ret = rfalNfcbPollerSlotMarker( cr->slotCode, &devList[*cr->devCnt].sensbRes, &devList[*cr->devCnt].sensbResLen );
+    }
+    
+    /* Activity 1.1  9.3.5.7 and 9.3.5.8  -  Symbol 6 */
+    if( ret != ERR_TIMEOUT )
+    {
+        /* Activity 1.1  9.3.5.8  -  Symbol 7 */
+        if( (rfalNfcbCheckSensbRes( &devList[*cr->devCnt].sensbRes, devList[*cr->devCnt].sensbResLen) == ERR_NONE) && (ret == ERR_NONE) )
+        {
+            devList[*cr->devCnt].isSleep = false;
+            
+            if( cr->compMode == RFAL_COMPLIANCE_MODE_EMV )
+            {
+                (*cr->devCnt)++;
+                return ret;
+            }
+            else if( cr->compMode == RFAL_COMPLIANCE_MODE_ISO )
+            {
+                /* Activity 1.0  9.3.5.8  -  Symbol 7 */
+                (*cr->devCnt)++;
+                cr->curDevCnt++;
+                
+                /* Activity 1.0  9.3.5.10  -  Symbol 9 */
+                if( (*cr->devCnt >= cr->devLimit) || (cr->slotsNum == (uint8_t)RFAL_NFCB_SLOT_NUM_1) )
+                {
+                    return ret;
+                }
+
+                /* Activity 1.0  9.3.5.11  -  Symbol 10 */
+                rfalNfcbPollerSleep( devList[*cr->devCnt-1U].sensbRes.nfcid0 );
+                devList[*cr->devCnt-1U].isSleep =  true;
+            }
+            else if( cr->compMode == RFAL_COMPLIANCE_MODE_NFC )
+            {
+                /* Activity 1.1  9.3.5.10 and 9.3.5.11  -  Symbol 9 and Symbol 11*/
+                if(cr->curDevCnt != 0U)
+                {
+                    rfalNfcbPollerSleep( devList[(*cr->devCnt) - (uint8_t)1U].sensbRes.nfcid0 );
+                    devList[(*cr->devCnt) - (uint8_t)1U].isSleep = true;
+                }
+                
+                /* Activity 1.1  9.3.5.12  -  Symbol 11 */
+                (*cr->devCnt)++;
+                cr->curDevCnt++;
+                
+                /* Activity 1.1  9.3.5.6  -  Symbol 13 */
+                if( (*cr->devCnt >= cr->devLimit) || (cr->slotsNum == (uint8_t)RFAL_NFCB_SLOT_NUM_1) )
+                {
+                    return ret;
+                }
+            }
+            else
+            {
+                /* MISRA 15.7 - Empty else */
+            }
+        }
+        else
+        {
+            /* If deviceLimit is set to 0 the NFC Forum Device is configured to perform collision detection only  Activity 1.0 and 1.1  9.3.5.5  - Symbol 4 */
+            if( (cr->devLimit == 0U) && (cr->slotsNum == (uint8_t)RFAL_NFCB_SLOT_NUM_1) )
+            {
+                return ERR_RF_COLLISION;
+            }
+            
+            /* Activity 1.1  9.3.5.9  -  Symbol 8 */
+            cr->colPending = true;
+        }
+    }
+    
+    /* Activity 1.1  9.3.5.15  -  Symbol 14 */
+    cr->slotCode++;
+    if( cr->slotCode < rfalNfcbNI2NumberOfSlots(cr->slotsNum) )
+    {
+        return ERR_BUSY;
+    }
+    cr->slotCode = 0;
+    
+    /* Activity 1.1  9.3.5.17  -  Symbol 16 */
+    if( !cr->colPending )
+    {
+        return ERR_NONE;
+    }
+    
+    /* Activity 1.1  9.3.5.18  -  Symbol 17 */
+    /* If a collision is detected and card(s) were found on this loop keep the same number of available slots */
+    if( cr->curDevCnt == 0U )
+    {
+        cr->slotsNum++;
+    }
+    
+    return ((cr->slotsNum > (uint8_t)cr->endSlots) ? ERR_NONE : ERR_BUSY);
+}
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTIONS
@@ -338,154 +492,97 @@ ReturnCode rfalNfcbPollerCollisionResolution( rfalComplianceMode compMode, uint8
 /*******************************************************************************/
 ReturnCode rfalNfcbPollerSlottedCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcbSlots initSlots, rfalNfcbSlots endSlots, rfalNfcbListenDevice *nfcbDevList, uint8_t *devCnt, bool *colPending )
 {
-    ReturnCode    ret;
-        uint8_t slotsNum;
-        uint8_t       slotCode;
-        uint8_t       curDevCnt;
-        
-        
-        /* Check parameters. In ISO | Activity 1.0 mode the initial slots must be 1 as continuation of Technology Detection */
-        if( (nfcbDevList == NULL) || (devCnt == NULL)  || (colPending == NULL) || (initSlots > RFAL_NFCB_SLOT_NUM_16) || 
-            (endSlots > RFAL_NFCB_SLOT_NUM_16) || ((compMode == RFAL_COMPLIANCE_MODE_ISO) && (initSlots != RFAL_NFCB_SLOT_NUM_1)) )
-        {
-            return ERR_PARAM;
-        }
-        
-        /* Initialise as no error in case Activity 1.0 where the previous SENSB_RES from technology detection should be used */
-        ret         = ERR_NONE;
-        *devCnt     = 0;
-        curDevCnt   = 0;
-        *colPending = false;
-           
-        
-        /* Send ALLB_REQ   Activity 1.1   9.3.5.2 and 9.3.5.3  (Symbol 1 and 2) */
-        if( compMode != RFAL_COMPLIANCE_MODE_ISO )
-        {
-           ret =  rfalNfcbPollerCheckPresence( RFAL_NFCB_SENS_CMD_ALLB_REQ, initSlots, &nfcbDevList->sensbRes, &nfcbDevList->sensbResLen );
-           if( (ret != ERR_NONE) && (initSlots == RFAL_NFCB_SLOT_NUM_1) )
-           {
-               return ret;
-           }
-        }
+    ReturnCode ret;
+    
+    if( colPending == NULL )
+    {
+        return ERR_PARAM;
+    }
+    *colPending = false;
+    
+    EXIT_ON_ERR( ret, rfalNfcbPollerStartSlottedCollisionResolution( compMode, devLimit, initSlots, endSlots, nfcbDevList, devCnt ) );
+    rfalNfcbRunBlocking( ret, rfalNfcbPollerGetCollisionResolutionStatus() );
+    
+    *colPending = gRfalNfcb.CR.colPending;
+    return ret;
+}
 
-        
-        /* Check if there was a transmission error on WUPB  EMVCo 2.6  9.3.3.1 */
-        if( (compMode == RFAL_COMPLIANCE_MODE_EMV) && (nfcbDevList->sensbResLen == 0U) )
-        {
-            return ERR_FRAMING;
-        }
-        
-        for( slotsNum = (uint8_t)initSlots; slotsNum <= (uint8_t)endSlots; slotsNum++ )
-        {
-            do {
-                /* Activity 1.1  9.3.5.23  -  Symbol 22 */
-                if( (compMode == RFAL_COMPLIANCE_MODE_NFC) && (curDevCnt != 0U) )
-                {
-                    rfalNfcbPollerSleep( nfcbDevList[((*devCnt) - (uint8_t)1U)].sensbRes.nfcid0 );
-                    nfcbDevList[((*devCnt) - (uint8_t)1U)].isSleep = true;
-                }
-                
-                /* Send SENSB_REQ with number of slots if not the first Activity 1.1  9.3.5.24  -  Symbol 23 */
-                if( (slotsNum != (uint8_t)initSlots) || *colPending )
-                {
-                    /* PRQA S 4342 1 # MISRA 10.5 - Layout of rfalNfcbSlots and above loop guarantee that no invalid enum values are created. */
-                    ret = rfalNfcbPollerCheckPresence( RFAL_NFCB_SENS_CMD_SENSB_REQ, (rfalNfcbSlots)slotsNum, &nfcbDevList[*devCnt].sensbRes, &nfcbDevList[*devCnt].sensbResLen );
-                }
-                
-                /* Activity 1.1  9.3.5.6  -  Symbol 5 */
-                slotCode    = 0;
-                curDevCnt   = 0;
-                *colPending = false;
-
-                do{
-                    /* Activity 1.1  9.3.5.26  -  Symbol 25 */
-                    if( slotCode != 0U )
-                    {
-                        ret = rfalNfcbPollerSlotMarker( slotCode, &nfcbDevList[*devCnt].sensbRes, &nfcbDevList[*devCnt].sensbResLen );
-                    }
-                    
-                    /* Activity 1.1  9.3.5.7 and 9.3.5.8  -  Symbol 6 */
-                    if( ret != ERR_TIMEOUT )
-                    {
-                        /* Activity 1.1  9.3.5.8  -  Symbol 7 */
-                        if( (rfalNfcbCheckSensbRes( &nfcbDevList[*devCnt].sensbRes, nfcbDevList[*devCnt].sensbResLen) == ERR_NONE) && (ret == ERR_NONE) )
-                        {
-                            nfcbDevList[*devCnt].isSleep = false;
-                            
-                            if( compMode == RFAL_COMPLIANCE_MODE_EMV )
-                            {
-                                (*devCnt)++;
-                                return ret;
-                            }
-                            else if( compMode == RFAL_COMPLIANCE_MODE_ISO )
-                            {
-                                /* Activity 1.0  9.3.5.8  -  Symbol 7 */
-                                (*devCnt)++;
-                                curDevCnt++;
-                                
-                                /* Activity 1.0  9.3.5.10  -  Symbol 9 */
-                                if( (*devCnt >= devLimit) || (slotsNum == (uint8_t)RFAL_NFCB_SLOT_NUM_1) )
-                                {
-                                    return ret;
-                                }
-
-                                /* Activity 1.0  9.3.5.11  -  Symbol 10 */
-                                rfalNfcbPollerSleep( nfcbDevList[*devCnt-1U].sensbRes.nfcid0 );
-                                nfcbDevList[*devCnt-1U].isSleep =  true;
-                            }
-                            else if( compMode == RFAL_COMPLIANCE_MODE_NFC )
-                            {
-                                /* Activity 1.1  9.3.5.10 and 9.3.5.11  -  Symbol 9 and Symbol 11*/
-                                if(curDevCnt != 0U)
-                                {
-                                    rfalNfcbPollerSleep( nfcbDevList[(*devCnt) - (uint8_t)1U].sensbRes.nfcid0 );
-                                    nfcbDevList[(*devCnt) - (uint8_t)1U].isSleep = true;
-                                }
-                                
-                                /* Activity 1.1  9.3.5.12  -  Symbol 11 */
-                                (*devCnt)++;
-                                curDevCnt++;
-                                
-                                /* Activity 1.1  9.3.5.6  -  Symbol 13 */
-                                if( (*devCnt >= devLimit) || (slotsNum == (uint8_t)RFAL_NFCB_SLOT_NUM_1) )
-                                {
-                                    return ret;
-                                }
-                            }
-                            else
-                            {
-                                /* MISRA 15.7 - Empty else */
-                            }
-                        }
-                        else
-                        {
-                            /* If deviceLimit is set to 0 the NFC Forum Device is configured to perform collision detection only  Activity 1.0 and 1.1  9.3.5.5  - Symbol 4 */
-                            if( (devLimit == 0U) && (slotsNum == (uint8_t)RFAL_NFCB_SLOT_NUM_1) )
-                            {
-                                return ERR_RF_COLLISION;
-                            }
-                            
-                            /* Activity 1.1  9.3.5.9  -  Symbol 8 */
-                            *colPending = true;
-                        }
-                    }
-                    
-                    /* Activity 1.1  9.3.5.15  -  Symbol 14 */
-                    slotCode++;
-                }
-                while( slotCode < rfalNfcbNI2NumberOfSlots(slotsNum) );
-                
-                /* Activity 1.1  9.3.5.17  -  Symbol 16 */
-                if( !(*colPending) )
-                {
-                    return ERR_NONE;
-                }
-            
-            /* Activity 1.1  9.3.5.18  -  Symbol 17 */
-            } while (curDevCnt != 0U);     /* If a collision is detected and card(s) were found on this loop keep the same number of available slots */
-        }
-        
-        return ERR_NONE;
+
+/*******************************************************************************/
+ReturnCode rfalNfcbPollerStartCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcbListenDevice *nfcbDevList, uint8_t *devCnt )
+{
+    return rfalNfcbPollerStartSlottedCollisionResolution( compMode, devLimit, RFAL_NFCB_SLOT_NUM_1, RFAL_NFCB_SLOT_NUM_16, nfcbDevList, devCnt );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcbPollerStartSlottedCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcbSlots initSlots, rfalNfcbSlots endSlots, rfalNfcbListenDevice *nfcbDevList, uint8_t *devCnt )
+{
+    ReturnCode ret;
+    
+    /* Check parameters. In ISO | Activity 1.0 mode the initial slots must be 1 as continuation of Technology Detection */
+    if( (nfcbDevList == NULL) || (devCnt == NULL) || (initSlots > RFAL_NFCB_SLOT_NUM_16) || 
+        (endSlots > RFAL_NFCB_SLOT_NUM_16) || ((compMode == RFAL_COMPLIANCE_MODE_ISO) && (initSlots != RFAL_NFCB_SLOT_NUM_1)) )
+    {
+        return ERR_PARAM;
+    }
+    
+    /* Initialise as no error in case Activity 1.0 where the previous SENSB_RES from technology detection should be used */
+    ret                    = ERR_NONE;
+    *devCnt                = 0;
+    gRfalNfcb.CR.colPending = false;
+    
+    
+    /* Send ALLB_REQ   Activity 1.1   9.3.5.2 and 9.3.5.3  (Symbol 1 and 2) */
+    if( compMode != RFAL_COMPLIANCE_MODE_ISO )
+    {
+       ret =  rfalNfcbPollerCheckPresence( RFAL_NFCB_SENS_CMD_ALLB_REQ, initSlots, &nfcbDevList->sensbRes, &nfcbDevList->sensbResLen );
+       if( (ret != ERR_NONE) && (initSlots == RFAL_NFCB_SLOT_NUM_1) )
+       {
+           return ret;
+       }
+    }
+
+    
+    /* Check if there was a transmission error on WUPB  EMVCo 2.6  9.3.3.1 */
+    if( (compMode == RFAL_COMPLIANCE_MODE_EMV) && (nfcbDevList->sensbResLen == 0U) )
+    {
+        return ERR_FRAMING;
+    }
+    
+    /* Save parameters */
+    gRfalNfcb.CR.compMode    = compMode;
+    gRfalNfcb.CR.devLimit    = devLimit;
+    gRfalNfcb.CR.initSlots   = initSlots;
+    gRfalNfcb.CR.endSlots    = endSlots;
+    gRfalNfcb.CR.nfcbDevList = nfcbDevList;
+    gRfalNfcb.CR.devCnt      = devCnt;
+    gRfalNfcb.CR.slotsNum    = (uint8_t)initSlots;
+    gRfalNfcb.CR.slotCode    = 0;
+    gRfalNfcb.CR.curDevCnt   = 0;
+    gRfalNfcb.CR.ret         = ret;
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void )
+{
+    ReturnCode ret;
+    
+    if( (gRfalNfcb.CR.nfcbDevList == NULL) || (gRfalNfcb.CR.devCnt == NULL) )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    ret = rfalNfcbPollerCollisionResolutionStep();
+    if( ret != ERR_BUSY )
+    {
+        gRfalNfcb.CR.nfcbDevList = NULL;
+    }
+    
+    return ret;
 }
 
 
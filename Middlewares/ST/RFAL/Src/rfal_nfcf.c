@@ -125,7 +125,8 @@ typedef struct
 * LOCAL VARIABLES
 ******************************************************************************
 */
-static rfalNfcfGreedyF gRfalNfcfGreedyF;   /*!< Activity's NFCF Greedy collection */
+static rfalNfcfGreedyF gRfalNfcfGreedyFInstances[RFAL_FEATURE_MAX_INSTANCES];   /*!< Activity's NFCF Greedy collections */
+#define gRfalNfcfGreedyF (gRfalNfcfGreedyFInstances[rfalInstanceIdx()])           /*!< Activity's NFCF Greedy collection of the selected RF chip */
 
 
 /*
@@ -86,6 +86,20 @@
 
 #define RFAL_NFCV_MAX_COLL_SUPPORTED      16U    /*!< Maximum number of collisions supported by the Anticollision loop  */
 
+#define RFAL_NFCV_SLOT_BITS               4U     /*!< Mask bits given by the slot number of a 16 slots round            */
+
+#ifndef RFAL_NFCV_ADAPTIVE_INV_16SLOT_MIN
+#define RFAL_NFCV_ADAPTIVE_INV_16SLOT_MIN 24U    /*!< Estimated population of a mask from which a 16 slots round is used: about 3 empty slots left */
+#endif /* RFAL_NFCV_ADAPTIVE_INV_16SLOT_MIN */
+
+#ifndef RFAL_NFCV_ADAPTIVE_INV_MAX_MASKS
+#define RFAL_NFCV_ADAPTIVE_INV_MAX_MASKS  32U    /*!< Maximum number of masks pending in the adaptive Anticollision loop */
+#endif /* RFAL_NFCV_ADAPTIVE_INV_MAX_MASKS */
+
+#ifndef RFAL_NFCV_BROADCAST_WR_N_RETRY
+#define RFAL_NFCV_BROADCAST_WR_N_RETRY    2U     /*!< Addressed write retries per device after a Broadcast Write        */
+#endif /* RFAL_NFCV_BROADCAST_WR_N_RETRY */
+
 #define RFAL_NFCV_FDT_MAX                 rfalConvMsTo1fc(20) /*!< Maximum Wait time FDTV,EOF and MAX2   Digital 2.1 B.5*/
 #define RFAL_NFCV_FDT_MAX1                4394U  /*!< Read alike command FWT FDTV,LISTEN,MAX1  Digital 2.0 B.5          */
 
@@ -115,6 +129,8 @@
  /*! Checks if a valid INVENTORY_RES is valid    Digital 2.2  9.6.2.1 & 9.6.2.3  */
  #define rfalNfcvCheckInvRes( f, l )     (((l)==rfalConvBytesToBits(RFAL_NFCV_INV_RES_LEN + RFAL_NFCV_CRC_LEN)) && ((f)==RFAL_NFCV_RES_FLAG_NOERROR))
 
+#define rfalNfcvRunBlocking( e, fn )    do{ (e)=(fn); }while( (e) == ERR_BUSY )     /*!< Macro used for the blocking methods  */
+
 
 
 /*
@@ -150,12 +166,84 @@ typedef struct
 }rfalNfcvCollision;
 
 
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+
+/*! Mask pending in the adaptive Anticollision loop */
+typedef struct
+{
+    rfalNfcvCollision  mask;                        /*!< Mask to be inventoried                    */
+    uint8_t            pop;                         /*!< Estimated number of devices matching mask */
+}rfalNfcvInventoryMask;
+
+
+/*! Outcome of an inventory slot */
+typedef enum
+{
+    RFAL_NFCV_SLOT_EMPTY,                           /*!< No device answered                        */
+    RFAL_NFCV_SLOT_SINGLE,                          /*!< One device identified                     */
+    RFAL_NFCV_SLOT_COLLISION,                       /*!< Several devices answered                  */
+    RFAL_NFCV_SLOT_INVALID                          /*!< Invalid INVENTORY_RES, ignored            */
+}rfalNfcvSlotResult;
+
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+
+
+/*! Collision Resolution states */
+typedef enum
+{
+    RFAL_NFCV_CR_IDLE,                              /*!< No Collision Resolution ongoing           */
+    RFAL_NFCV_CR_1SLOT,                             /*!< 1 slot INVENTORY_REQ without mask         */
+    RFAL_NFCV_CR_NEXT,                              /*!< Next pending mask to be inventoried       */
+    RFAL_NFCV_CR_SLOT                               /*!< 16 slots round ongoing                    */
+}rfalNfcvColResState;
+
+
+/*! Collision Resolution context */
+typedef struct
+{
+    rfalNfcvColResState    state;                   /*!< Collision Resolution state                */
+    uint8_t                devLimit;                /*!< Device limit to be used                   */
+    rfalNfcvListenDevice*  nfcvDevList;             /*!< Location of the device list               */
+    uint8_t*               devCnt;                  /*!< Location of the device counter            */
+    uint8_t                slotNum;                 /*!< Next slot of the ongoing 16 slots round   */
+    uint8_t                colIt;                   /*!< Collision being resolved                  */
+    uint8_t                colCnt;                  /*!< Collisions found                          */
+    rfalNfcvCollision      colFound[RFAL_NFCV_MAX_COLL_SUPPORTED]; /*!< Collisions found           */
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+    bool                   adaptive;                /*!< Adaptive Collision Resolution flag        */
+    uint8_t                popHint;                 /*!< Expected number of devices                */
+    uint8_t                empty;                   /*!< Empty slots of the ongoing round          */
+    uint8_t                single;                  /*!< Single slots of the ongoing round         */
+    uint8_t                collided;                /*!< Collided slots of the ongoing round       */
+    uint16_t               colSlots;                /*!< Collided slots bitmask of the ongoing round */
+    uint8_t                maskCnt;                 /*!< Number of masks pending                   */
+    rfalNfcvInventoryMask  cur;                     /*!< Mask being inventoried                    */
+    rfalNfcvInventoryMask  masks[RFAL_NFCV_ADAPTIVE_INV_MAX_MASKS]; /*!< Masks pending              */
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+}rfalNfcvColResParams;
+
+
+/*! RFAL NFC-V instance */
+typedef struct
+{
+    rfalNfcvColResParams   CR;                      /*!< Collision Resolution context              */
+}rfalNfcv;
+
+
 /*
 ******************************************************************************
 * LOCAL FUNCTION PROTOTYPES
 ******************************************************************************
 */
 static ReturnCode rfalNfcvParseError( uint8_t err );
+static ReturnCode rfalNfcvPollerCollisionResolutionStep( void );
+
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+static rfalNfcvSlotResult rfalNfcvPollerSlotResult( ReturnCode ret, uint16_t rcvdLen, const rfalNfcvInventoryRes *invRes );
+static uint8_t rfalNfcvPollerEstimatePop( uint8_t empty, uint8_t single, uint8_t collided );
+static void rfalNfcvPollerPushMask( rfalNfcvInventoryMask *masks, uint8_t *maskCnt, const rfalNfcvCollision *parent, uint8_t bits, uint8_t value, uint8_t pop );
+static ReturnCode rfalNfcvPollerAdaptiveCollisionResolutionStep( void );
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
 
 /*
 ******************************************************************************
@@ -163,6 +251,14 @@ static ReturnCode rfalNfcvParseError( uint8_t err );
 ******************************************************************************
 */
 
+static rfalNfcv gRfalNfcvInstances[RFAL_FEATURE_MAX_INSTANCES];   /*!< RFAL NFC-V instances */
+#define gRfalNfcv (gRfalNfcvInstances[rfalInstanceIdx()])           /*!< RFAL NFC-V instance of the selected RF chip */
+
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+/*! Number of devices answering a 16 slots round given its number of empty slots: ln(E/16)/ln(15/16), E = 0 capped */
+static const uint8_t gRfalNfcvEmptySlotsPop[RFAL_NFCV_MAX_SLOTS + 1U] = { 64, 43, 32, 26, 21, 18, 15, 13, 11, 9, 7, 6, 4, 3, 2, 1, 0 };
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+
 /*
 ******************************************************************************
 * LOCAL FUNCTIONS
@@ -189,6 +285,378 @@ static ReturnCode rfalNfcvParseError( uint8_t err )
     }
 }
 
+/*******************************************************************************/
+static ReturnCode rfalNfcvPollerCollisionResolutionStep( void )
+{
+    ReturnCode            ret;
+    uint16_t              rcvdLen = 0U;
+    uint8_t               colPos;
+    rfalNfcvListenDevice *dev;
+    rfalNfcvColResParams *cr;
+    
+    cr  = &gRfalNfcv.CR;
+    dev = &cr->nfcvDevList[(*cr->devCnt)];
+    
+    if( cr->state == RFAL_NFCV_CR_1SLOT )
+    {
+        /* Send INVENTORY_REQ with one slot   Activity 2.1  9.3.7.1  (Symbol 0)  */
+        ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_1, 0, NULL, &dev->InvRes, NULL );
+
+        if( ret == ERR_TIMEOUT )  /* Exit if no device found     Activity 2.1  9.3.7.2 (Symbol 1)  */
+        {
+            return ERR_NONE;
+        }
+        if( ret == ERR_NONE )     /* Device found without transmission error/collision    Activity 2.1  9.3.7.3 (Symbol 2)  */
+        {
+            dev->isSleep = false;
+            (*cr->devCnt)++;
+            return ERR_NONE;
+        }
+
+        /* A Collision has been identified  Activity 2.1  9.3.7.4  (Symbol 3) */
+        cr->colCnt = 1;
+
+        /* Check if the Collision Resolution is set to perform only Collision detection   Activity 2.1  9.3.7.5 (Symbol 4)*/
+        if( cr->devLimit == 0U )
+        {
+            return ERR_RF_COLLISION;
+        }
+
+        platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
+
+        /*******************************************************************************/
+        /* Collisions pending, Anticollision loop must be executed                     */
+        /*******************************************************************************/
+        cr->state   = RFAL_NFCV_CR_SLOT;
+        cr->slotNum = 0;
+        return ERR_BUSY;
+    }
+    
+    
+    /* One slot of the round of the collision being resolved   Activity 2.1  9.3.7.7  (Symbol 6 / 7) */
+    if( cr->slotNum == 0U )
+    {
+        /* Send INVENTORY_REQ with 16 slots   Activity 2.1  9.3.7.9  (Symbol 8) */
+        ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_16, cr->colFound[cr->colIt].maskLen, cr->colFound[cr->colIt].maskVal, &dev->InvRes, &rcvdLen );
+    }
+    else
+    {
+        ret = rfalISO15693TransceiveEOFAnticollision( (uint8_t*)&dev->InvRes, sizeof(rfalNfcvInventoryRes), &rcvdLen );
+    }
+    cr->slotNum++;
+    
+    /*******************************************************************************/
+    if( ret != ERR_TIMEOUT )
+    {
+        if( rcvdLen < rfalConvBytesToBits(RFAL_NFCV_INV_RES_LEN + RFAL_NFCV_CRC_LEN) )
+        { /* If only a partial frame was received make sure the FDT_V_INVENT_NORES is fulfilled */
+            platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
+        }
+        
+        /* Check if response is a correct frame (no TxRx error)  Activity 2.1  9.3.7.11  (Symbol 10)*/
+        if( (ret == ERR_NONE) || (ret == ERR_PROTO) )
+        {
+            /* Check if the device found is already on the list and its response is a valid INVENTORY_RES */
+            if( rfalNfcvCheckInvRes( dev->InvRes.RES_FLAG, rcvdLen ) )
+            {
+                /* Activity 2.1  9.3.7.12  (Symbol 11) */
+                dev->isSleep = false;
+                (*cr->devCnt)++;
+            }
+        }
+        else /* Treat everything else as collision */
+        {
+            /* Activity 2.1  9.3.7.17  (Symbol 16) */
+            
+            /*******************************************************************************/
+            /* Ensure that this collision still fits on the container */
+            if( cr->colCnt < RFAL_NFCV_MAX_COLL_SUPPORTED )
+            {
+                /* Store this collision on the container to be resolved later */
+                /* Activity 2.1  9.3.7.17  (Symbol 16): add the collision information
+                 * (MASK_VAL + SN) to the list containing the collision information */
+                ST_MEMCPY(cr->colFound[cr->colCnt].maskVal, cr->colFound[cr->colIt].maskVal, RFAL_NFCV_UID_LEN);
+                colPos = cr->colFound[cr->colIt].maskLen;
+                cr->colFound[cr->colCnt].maskVal[(colPos/RFAL_BITS_IN_BYTE)]      &= (uint8_t)((1U << (colPos % RFAL_BITS_IN_BYTE)) - 1U);
+                cr->colFound[cr->colCnt].maskVal[(colPos/RFAL_BITS_IN_BYTE)]      |= (uint8_t)((cr->slotNum-1U) << (colPos % RFAL_BITS_IN_BYTE));
+                cr->colFound[cr->colCnt].maskVal[((colPos/RFAL_BITS_IN_BYTE)+1U)]  = (uint8_t)((cr->slotNum-1U) >> (RFAL_BITS_IN_BYTE - (colPos % RFAL_BITS_IN_BYTE)));
+
+                cr->colFound[cr->colCnt].maskLen = (cr->colFound[cr->colIt].maskLen + 4U);
+
+                cr->colCnt++;
+            }
+        }
+    }
+    else 
+    { 
+        /* Timeout */
+        platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
+    }
+    
+    /* Check if devices found have reached device limit   Activity 2.1  9.3.7.13  (Symbol 12) */
+    if( *cr->devCnt >= cr->devLimit )
+    {
+        return ERR_NONE;
+    }
+    
+    /* Execute until all collisions are resolved Activity 2.1 9.3.7.18  (Symbol 17) */
+    if( cr->slotNum >= RFAL_NFCV_MAX_SLOTS )
+    {
+        cr->slotNum = 0;
+        cr->colIt++;
+        
+        if( cr->colIt >= cr->colCnt )
+        {
+            return ERR_NONE;
+        }
+    }
+    
+    return ERR_BUSY;
+}
+
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+
+/*******************************************************************************/
+static rfalNfcvSlotResult rfalNfcvPollerSlotResult( ReturnCode ret, uint16_t rcvdLen, const rfalNfcvInventoryRes *invRes )
+{
+    if( ret == ERR_TIMEOUT )
+    {
+        platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
+        return RFAL_NFCV_SLOT_EMPTY;
+    }
+
+    if( rcvdLen < rfalConvBytesToBits(RFAL_NFCV_INV_RES_LEN + RFAL_NFCV_CRC_LEN) )
+    { /* If only a partial frame was received make sure the FDT_V_INVENT_NORES is fulfilled */
+        platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
+    }
+
+    if( (ret == ERR_NONE) || (ret == ERR_PROTO) )
+    {
+        return ( rfalNfcvCheckInvRes( invRes->RES_FLAG, rcvdLen ) ? RFAL_NFCV_SLOT_SINGLE : RFAL_NFCV_SLOT_INVALID );
+    }
+
+    /* Treat everything else as collision */
+    return RFAL_NFCV_SLOT_COLLISION;
+}
+
+/*******************************************************************************/
+static uint8_t rfalNfcvPollerEstimatePop( uint8_t empty, uint8_t single, uint8_t collided )
+{
+    uint8_t pop;
+
+    if( collided == 0U )
+    {
+        return 0U;
+    }
+
+    /* Population from the empty slots, at least two devices per collided slot */
+    pop = MAX( gRfalNfcvEmptySlotsPop[empty], (uint8_t)(single + (2U * collided)) );
+
+    /* Devices left to be identified, spread over the collided slots */
+    return (uint8_t)MAX( (((pop - single) + (collided - 1U)) / collided), 2U );
+}
+
+/*******************************************************************************/
+static void rfalNfcvPollerPushMask( rfalNfcvInventoryMask *masks, uint8_t *maskCnt, const rfalNfcvCollision *parent, uint8_t bits, uint8_t value, uint8_t pop )
+{
+    rfalNfcvInventoryMask *child;
+    uint8_t                pos;
+    uint8_t                i;
+
+    /* Without room left, the devices of this mask are left for the next inventory */
+    if( *maskCnt >= RFAL_NFCV_ADAPTIVE_INV_MAX_MASKS )
+    {
+        return;
+    }
+
+    child = &masks[*maskCnt];
+    ST_MEMCPY( &child->mask, parent, sizeof(rfalNfcvCollision) );
+
+    /* Append value to the mask, LSB first */
+    for( i = 0; i < bits; i++ )
+    {
+        pos = (parent->maskLen + i);
+        if( ((value >> i) & 0x01U) != 0U )
+        {
+            child->mask.maskVal[(pos / RFAL_BITS_IN_BYTE)] |= (uint8_t)(1U << (pos % RFAL_BITS_IN_BYTE));
+        }
+        else
+        {
+            child->mask.maskVal[(pos / RFAL_BITS_IN_BYTE)] &= (uint8_t)~(1U << (pos % RFAL_BITS_IN_BYTE));
+        }
+    }
+    child->mask.maskLen = (parent->maskLen + bits);
+    child->pop          = pop;
+    (*maskCnt)++;
+}
+
+/*******************************************************************************/
+static ReturnCode rfalNfcvPollerAdaptiveCollisionResolutionStep( void )
+{
+    ReturnCode            ret;
+    uint16_t              rcvdLen = 0U;
+    uint8_t               pop;
+    uint8_t               slotNum;
+    rfalNfcvSlotResult    res;
+    rfalNfcvListenDevice *dev;
+    rfalNfcvColResParams *cr;
+    
+    cr  = &gRfalNfcv.CR;
+    dev = &cr->nfcvDevList[(*cr->devCnt)];
+    
+    switch( cr->state )
+    {
+        /*******************************************************************************/
+        case RFAL_NFCV_CR_1SLOT:
+            /* Send INVENTORY_REQ with one slot: a lone device is identified at once   Activity 2.1  9.3.7.1 */
+            ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_1, 0, NULL, &dev->InvRes, &rcvdLen );
+            if( ret == ERR_TIMEOUT )
+            {
+                return ERR_NONE;
+            }
+            if( ret == ERR_NONE )
+            {
+                dev->isSleep = false;
+                (*cr->devCnt)++;
+                return ERR_NONE;
+            }
+
+            /* A Collision has been identified, check if only Collision detection is to be performed */
+            if( cr->devLimit == 0U )
+            {
+                return ERR_RF_COLLISION;
+            }
+            platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
+
+            /* At least two devices: go on with 16 slots if many are expected, else split the population in two */
+            cr->cur.pop = MAX( cr->popHint, 2U );
+            if( cr->cur.pop >= RFAL_NFCV_ADAPTIVE_INV_16SLOT_MIN )
+            {
+                rfalNfcvPollerPushMask( cr->masks, &cr->maskCnt, &cr->cur.mask, 0U, 0U, cr->cur.pop );
+            }
+            else
+            {
+                rfalNfcvPollerPushMask( cr->masks, &cr->maskCnt, &cr->cur.mask, 1U, 1U, (cr->cur.pop / 2U) );
+                rfalNfcvPollerPushMask( cr->masks, &cr->maskCnt, &cr->cur.mask, 1U, 0U, (cr->cur.pop / 2U) );
+            }
+            
+            cr->state = RFAL_NFCV_CR_NEXT;
+            return ERR_BUSY;
+            
+        /*******************************************************************************/
+        case RFAL_NFCV_CR_NEXT:
+            /* Resolve the pending masks depth first so that the list of masks stays short */
+            if( (cr->maskCnt == 0U) || (*cr->devCnt >= cr->devLimit) )
+            {
+                return ERR_NONE;
+            }
+            
+            cr->maskCnt--;
+            ST_MEMCPY( &cr->cur, &cr->masks[cr->maskCnt], sizeof(rfalNfcvInventoryMask) );
+            
+            if( (cr->cur.pop < RFAL_NFCV_ADAPTIVE_INV_16SLOT_MIN) || ((cr->cur.mask.maskLen + RFAL_NFCV_SLOT_BITS) > RFAL_NFCV_MASKVAL_MAX_16SLOT_LEN) )
+            {
+                /*******************************************************************************/
+                /* 1 slot round                                                                */
+                ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_1, cr->cur.mask.maskLen, cr->cur.mask.maskVal, &dev->InvRes, &rcvdLen );
+
+                res = rfalNfcvPollerSlotResult( ret, rcvdLen, &dev->InvRes );
+                if( res == RFAL_NFCV_SLOT_SINGLE )
+                {
+                    dev->isSleep = false;
+                    (*cr->devCnt)++;
+                }
+                else if( (res == RFAL_NFCV_SLOT_COLLISION) && (cr->cur.mask.maskLen < RFAL_NFCV_MASKVAL_MAX_1SLOT_LEN) )
+                {
+                    /* Split the population in two with the next UID bit */
+                    pop = (MAX( cr->cur.pop, 2U ) / 2U);
+                    rfalNfcvPollerPushMask( cr->masks, &cr->maskCnt, &cr->cur.mask, 1U, 1U, pop );
+                    rfalNfcvPollerPushMask( cr->masks, &cr->maskCnt, &cr->cur.mask, 1U, 0U, pop );
+                }
+                else
+                {
+                    /* MISRA 15.7 - Empty else */
+                }
+                return ERR_BUSY;
+            }
+            
+            /*******************************************************************************/
+            /* 16 slots round, the slot number extends the mask by 4 bits                  */
+            cr->empty    = 0;
+            cr->single   = 0;
+            cr->collided = 0;
+            cr->colSlots = 0;
+            cr->slotNum  = 0;
+            cr->state    = RFAL_NFCV_CR_SLOT;
+            /* fall through */
+            
+        /*******************************************************************************/
+        case RFAL_NFCV_CR_SLOT:   /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
+            if( cr->slotNum == 0U )
+            {
+                ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_16, cr->cur.mask.maskLen, cr->cur.mask.maskVal, &dev->InvRes, &rcvdLen );
+            }
+            else
+            {
+                ret = rfalISO15693TransceiveEOFAnticollision( (uint8_t*)&dev->InvRes, sizeof(rfalNfcvInventoryRes), &rcvdLen );
+            }
+
+            res = rfalNfcvPollerSlotResult( ret, rcvdLen, &dev->InvRes );
+            switch( res )
+            {
+                case RFAL_NFCV_SLOT_EMPTY:
+                    cr->empty++;
+                    break;
+
+                case RFAL_NFCV_SLOT_SINGLE:
+                    cr->single++;
+                    dev->isSleep = false;
+                    (*cr->devCnt)++;
+                    break;
+
+                case RFAL_NFCV_SLOT_COLLISION:
+                    cr->collided++;
+                    cr->colSlots |= (uint16_t)(1U << cr->slotNum);
+                    break;
+
+                default:
+                    /* MISRA 16.4: no empty default statement (a comment being enough) */
+                    break;
+            }
+
+            /* Check if devices found have reached device limit */
+            if( *cr->devCnt >= cr->devLimit )
+            {
+                return ERR_NONE;
+            }
+            
+            cr->slotNum++;
+            if( cr->slotNum < RFAL_NFCV_MAX_SLOTS )
+            {
+                return ERR_BUSY;
+            }
+
+            /* Collided slots in reverse order so that the lowest slot is resolved first */
+            pop = rfalNfcvPollerEstimatePop( cr->empty, cr->single, cr->collided );
+            for( slotNum = RFAL_NFCV_MAX_SLOTS; slotNum > 0U; slotNum-- )
+            {
+                if( (cr->colSlots & (uint16_t)(1U << (slotNum - 1U))) != 0U )
+                {
+                    rfalNfcvPollerPushMask( cr->masks, &cr->maskCnt, &cr->cur.mask, RFAL_NFCV_SLOT_BITS, (slotNum - 1U), pop );
+                }
+            }
+            
+            cr->state = RFAL_NFCV_CR_NEXT;
+            return ERR_BUSY;
+            
+        /*******************************************************************************/
+        default:
+            return ERR_WRONG_STATE;
+    }
+}
+
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTIONS
@@ -271,16 +739,17 @@ ReturnCode rfalNfcvPollerInventory( rfalNfcvNumSlots nSlots, uint8_t maskLen, co
 /*******************************************************************************/
 ReturnCode rfalNfcvPollerCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt )
 {
-    ReturnCode        ret;
-    uint8_t           slotNum;
-    uint16_t          rcvdLen;
-    uint8_t           colIt;
-    uint8_t           colCnt;
-    uint8_t           colPos;
-    bool              colPending;
-    rfalNfcvCollision colFound[RFAL_NFCV_MAX_COLL_SUPPORTED];
+    ReturnCode ret;
     
+    EXIT_ON_ERR( ret, rfalNfcvPollerStartCollisionResolution( compMode, devLimit, nfcvDevList, devCnt ) );
+    rfalNfcvRunBlocking( ret, rfalNfcvPollerGetCollisionResolutionStatus() );
     
+    return ret;
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerStartCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt )
+{
     if( (nfcvDevList == NULL) || (devCnt == NULL) )
     {
         return ERR_PARAM;
@@ -288,137 +757,58 @@ ReturnCode rfalNfcvPollerCollisionResolution( rfalComplianceMode compMode, uint8
 
     /* Initialize parameters */
     *devCnt = 0;
-    colIt         = 0;
-    colCnt        = 0;
-    colPending    = false;
-    ST_MEMSET(colFound, 0x00, (sizeof(rfalNfcvCollision)*RFAL_NFCV_MAX_COLL_SUPPORTED) );
+    ST_MEMSET( &gRfalNfcv.CR, 0x00, sizeof(rfalNfcvColResParams) );
 
     if( devLimit > 0U )       /* MISRA 21.18 */
     {
         ST_MEMSET(nfcvDevList, 0x00, (sizeof(rfalNfcvListenDevice)*devLimit) );
     }
-
-    NO_WARNING(colPending);   /* colPending is not exposed externally, in future it might become exposed/ouput parameter */
+    
+    gRfalNfcv.CR.devLimit    = devLimit;
+    gRfalNfcv.CR.nfcvDevList = nfcvDevList;
+    gRfalNfcv.CR.devCnt      = devCnt;
 
     if( compMode == RFAL_COMPLIANCE_MODE_NFC )
     {
-        /* Send INVENTORY_REQ with one slot   Activity 2.1  9.3.7.1  (Symbol 0)  */
-        ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_1, 0, NULL, &nfcvDevList->InvRes, NULL );
-
-        if( ret == ERR_TIMEOUT )  /* Exit if no device found     Activity 2.1  9.3.7.2 (Symbol 1)  */
-        {
-            return ERR_NONE;
-        }
-        if( ret == ERR_NONE )     /* Device found without transmission error/collision    Activity 2.1  9.3.7.3 (Symbol 2)  */
-        {
-            (*devCnt)++;
-            return ERR_NONE;
-        }
-
-        /* A Collision has been identified  Activity 2.1  9.3.7.4  (Symbol 3) */
-        colPending = true;
-        colCnt        = 1;
-
-        /* Check if the Collision Resolution is set to perform only Collision detection   Activity 2.1  9.3.7.5 (Symbol 4)*/
-        if( devLimit == 0U )
-        {
-            return ERR_RF_COLLISION;
-        }
-
-        platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
-
-        /*******************************************************************************/
-        /* Collisions pending, Anticollision loop must be executed                     */
-        /*******************************************************************************/
+        gRfalNfcv.CR.state  = RFAL_NFCV_CR_1SLOT;
     }
     else
     { 
         /* Advance to 16 slots below without mask. Will give a good chance to identify multiple cards */
-        colPending = true;
-        colCnt        = 1;
+        gRfalNfcv.CR.colCnt = 1;
+        gRfalNfcv.CR.state  = RFAL_NFCV_CR_SLOT;
     }
     
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerGetCollisionResolutionStatus( void )
+{
+    ReturnCode ret;
     
-    /* Execute until all collisions are resolved Activity 2.1 9.3.7.18  (Symbol 17) */
-    do
+    if( (gRfalNfcv.CR.state == RFAL_NFCV_CR_IDLE) || (gRfalNfcv.CR.nfcvDevList == NULL) || (gRfalNfcv.CR.devCnt == NULL) )
     {
-        /* Activity 2.1  9.3.7.7  (Symbol 6 / 7) */
-        colPending = false;
-        slotNum    = 0;
-        
-        do
-        {
-            if( slotNum == 0U )
-            {
-                /* Send INVENTORY_REQ with 16 slots   Activity 2.1  9.3.7.9  (Symbol 8) */
-                ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_16, colFound[colIt].maskLen, colFound[colIt].maskVal, &nfcvDevList[(*devCnt)].InvRes, &rcvdLen );
-            }
-            else
-            {
-                ret = rfalISO15693TransceiveEOFAnticollision( (uint8_t*)&nfcvDevList[(*devCnt)].InvRes, sizeof(rfalNfcvInventoryRes), &rcvdLen );
-            }
-            slotNum++;
-            
-            /*******************************************************************************/
-            if( ret != ERR_TIMEOUT )
-            {
-                if( rcvdLen < rfalConvBytesToBits(RFAL_NFCV_INV_RES_LEN + RFAL_NFCV_CRC_LEN) )
-                { /* If only a partial frame was received make sure the FDT_V_INVENT_NORES is fulfilled */
-                    platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
-                }
-                
-                /* Check if response is a correct frame (no TxRx error)  Activity 2.1  9.3.7.11  (Symbol 10)*/
-                if( (ret == ERR_NONE) || (ret == ERR_PROTO) )
-                {
-                    /* Check if the device found is already on the list and its response is a valid INVENTORY_RES */
-                    if( rfalNfcvCheckInvRes( nfcvDevList[(*devCnt)].InvRes.RES_FLAG, rcvdLen ) )
-                    {
-                        /* Activity 2.1  9.3.7.12  (Symbol 11) */
-                        (*devCnt)++;
-                    }
-                }
-                else /* Treat everything else as collision */
-                {
-                    /* Activity 2.1  9.3.7.17  (Symbol 16) */
-                    colPending = true;
-                    
-
-                    /*******************************************************************************/
-                    /* Ensure that this collision still fits on the container */
-                    if( colCnt < RFAL_NFCV_MAX_COLL_SUPPORTED )
-                    {
-                        /* Store this collision on the container to be resolved later */
-                        /* Activity 2.1  9.3.7.17  (Symbol 16): add the collision information
-                         * (MASK_VAL + SN) to the list containing the collision information */
-                        ST_MEMCPY(colFound[colCnt].maskVal, colFound[colIt].maskVal, RFAL_NFCV_UID_LEN);
-                        colPos = colFound[colIt].maskLen;
-                        colFound[colCnt].maskVal[(colPos/RFAL_BITS_IN_BYTE)]      &= (uint8_t)((1U << (colPos % RFAL_BITS_IN_BYTE)) - 1U);
-                        colFound[colCnt].maskVal[(colPos/RFAL_BITS_IN_BYTE)]      |= (uint8_t)((slotNum-1U) << (colPos % RFAL_BITS_IN_BYTE));
-                        colFound[colCnt].maskVal[((colPos/RFAL_BITS_IN_BYTE)+1U)]  = (uint8_t)((slotNum-1U) >> (RFAL_BITS_IN_BYTE - (colPos % RFAL_BITS_IN_BYTE)));
-
-                        colFound[colCnt].maskLen = (colFound[colIt].maskLen + 4U);
-
-                        colCnt++;
-                    }
-                }
-            }
-            else 
-            { 
-                /* Timeout */
-                platformDelay(RFAL_NFCV_FDT_V_INVENT_NORES);
-            }
-            
-            /* Check if devices found have reached device limit   Activity 2.1  9.3.7.13  (Symbol 12) */
-            if( *devCnt >= devLimit )
-            {
-                return ERR_NONE;
-            }
-            
-        } while( slotNum < RFAL_NFCV_MAX_SLOTS );  /* Slot loop             */
-        colIt++;
-    } while( colIt < colCnt );                     /* Collisions found loop */
+        return ERR_WRONG_STATE;
+    }
     
-    return ERR_NONE;
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+    if( gRfalNfcv.CR.adaptive )
+    {
+        ret = rfalNfcvPollerAdaptiveCollisionResolutionStep();
+    }
+    else
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+    {
+        ret = rfalNfcvPollerCollisionResolutionStep();
+    }
+    
+    if( ret != ERR_BUSY )
+    {
+        gRfalNfcv.CR.state = RFAL_NFCV_CR_IDLE;
+    }
+    
+    return ret;
 }
 
 /*******************************************************************************/
@@ -452,6 +842,64 @@ ReturnCode rfalNfcvPollerSleepCollisionResolution( uint8_t devLimit, rfalNfcvLis
     return ret;
 }
 
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerAdaptiveCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, uint8_t popHint, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt )
+{
+    ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalNfcvPollerStartAdaptiveCollisionResolution( compMode, devLimit, popHint, nfcvDevList, devCnt ) );
+    rfalNfcvRunBlocking( ret, rfalNfcvPollerGetCollisionResolutionStatus() );
+    
+    return ret;
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerStartAdaptiveCollisionResolution( rfalComplianceMode compMode, uint8_t devLimit, uint8_t popHint, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt )
+{
+#if RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY
+    if( (nfcvDevList == NULL) || (devCnt == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    /* Initialize parameters */
+    *devCnt = 0;
+    ST_MEMSET( &gRfalNfcv.CR, 0x00, sizeof(rfalNfcvColResParams) );
+
+    if( devLimit > 0U )       /* MISRA 21.18 */
+    {
+        ST_MEMSET(nfcvDevList, 0x00, (sizeof(rfalNfcvListenDevice)*devLimit) );
+    }
+    
+    gRfalNfcv.CR.adaptive    = true;
+    gRfalNfcv.CR.popHint     = popHint;
+    gRfalNfcv.CR.devLimit    = devLimit;
+    gRfalNfcv.CR.nfcvDevList = nfcvDevList;
+    gRfalNfcv.CR.devCnt      = devCnt;
+
+    if( (compMode == RFAL_COMPLIANCE_MODE_NFC) || (popHint < RFAL_NFCV_ADAPTIVE_INV_16SLOT_MIN) || (devLimit == 0U) )
+    {
+        gRfalNfcv.CR.state = RFAL_NFCV_CR_1SLOT;
+    }
+    else
+    {
+        /* Many devices expected: start straight with 16 slots */
+        rfalNfcvPollerPushMask( gRfalNfcv.CR.masks, &gRfalNfcv.CR.maskCnt, &gRfalNfcv.CR.cur.mask, 0U, 0U, popHint );
+        gRfalNfcv.CR.state = RFAL_NFCV_CR_NEXT;
+    }
+    
+    return ERR_NONE;
+#else
+    NO_WARNING(compMode);
+    NO_WARNING(devLimit);
+    NO_WARNING(popHint);
+    NO_WARNING(nfcvDevList);
+    NO_WARNING(devCnt);
+
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY */
+}
+
 /*******************************************************************************/
 ReturnCode rfalNfcvPollerSleep( uint8_t flags, const uint8_t* uid )
 {
@@ -527,6 +975,87 @@ ReturnCode rfalNfcvPollerWriteSingleBlock( uint8_t flags, const uint8_t* uid, ui
     return rfalNfcvPollerTransceiveReq( RFAL_NFCV_CMD_WRITE_SINGLE_BLOCK, flags, RFAL_NFCV_PARAM_SKIP, uid, data, dataLen, (uint8_t*)&res, sizeof(rfalNfcvGenericRes), &rcvLen );
 }
 
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerBroadcastWriteSingleBlock( uint8_t flags, uint8_t blockNum, const uint8_t* wrData, uint8_t blockLen, rfalNfcvListenDevice *nfcvDevList, uint8_t devCnt, uint8_t *failCnt )
+{
+    ReturnCode         ret;
+    ReturnCode         devRet;
+    uint16_t           rcvLen;
+    rfalNfcvGenericRes res;
+    uint8_t            i;
+    uint8_t            retry;
+    
+    /* Check for valid parameters */
+    if( (blockLen == 0U) || (blockLen > (uint8_t)RFAL_NFCV_MAX_BLOCK_LEN) || (wrData == NULL) || ((nfcvDevList == NULL) && (devCnt > 0U)) )
+    {
+        return ERR_PARAM;
+    }
+    
+    /* Devices in Quiet state ignore non addressed requests, put them back to Ready */
+    for( i = 0U; i < devCnt; i++ )
+    {
+        if( nfcvDevList[i].isSleep )
+        {
+            ret = rfalNfcvPollerTransceiveReq( RFAL_NFCV_CMD_RESET_TO_READY, (uint8_t)(flags & ~((uint32_t)RFAL_NFCV_REQ_FLAG_SELECT)), RFAL_NFCV_PARAM_SKIP, nfcvDevList[i].InvRes.UID, NULL, 0U, (uint8_t*)&res, sizeof(rfalNfcvGenericRes), &rcvLen );
+            if( ret == ERR_NONE )
+            {
+                nfcvDevList[i].isSleep = false;
+            }
+        }
+    }
+    
+    /* Non addressed Write: all devices in Ready state program the block at once. Their *
+     * responses collide, the outcome is therefore only known from the verification below */
+    ret = rfalNfcvPollerWriteSingleBlock( (uint8_t)(flags & ~((uint32_t)RFAL_NFCV_REQ_FLAG_SELECT)), NULL, blockNum, wrData, blockLen );
+    if( (ret == ERR_PARAM) || (ret == ERR_WRONG_STATE) || (ret == ERR_IO) )
+    {
+        return ret;
+    }
+    
+    ret = ERR_NONE;
+    if( failCnt != NULL )
+    {
+        *failCnt = 0U;
+    }
+    
+    /* Verify each device with an addressed read, rewrite (addressed) only the ones not matching. *
+     * The read is done without Option flag so that no block security status precedes the data  */
+    for( i = 0U; i < devCnt; i++ )
+    {
+        retry = RFAL_NFCV_BROADCAST_WR_N_RETRY;
+        do
+        {
+            devRet = rfalNfcvPollerReadSingleBlock( (uint8_t)(flags & ~((uint32_t)RFAL_NFCV_REQ_FLAG_OPTION)), nfcvDevList[i].InvRes.UID, blockNum, (uint8_t*)&res, sizeof(rfalNfcvGenericRes), &rcvLen );
+            if( devRet == ERR_NONE )
+            {
+                if( (rcvLen == (RFAL_NFCV_FLAG_LEN + blockLen)) && (ST_BYTECMP( res.data, wrData, blockLen ) == 0) )
+                {
+                    break;
+                }
+                devRet = ERR_WRITE;
+            }
+            
+            if( retry == 0U )
+            {
+                break;
+            }
+            (void)rfalNfcvPollerWriteSingleBlock( flags, nfcvDevList[i].InvRes.UID, blockNum, wrData, blockLen );
+        }
+        while( retry-- != 0U );
+        
+        if( devRet != ERR_NONE )
+        {
+            ret = devRet;
+            if( failCnt != NULL )
+            {
+                (*failCnt)++;
+            }
+        }
+    }
+    
+    return ret;
+}
+
 /*******************************************************************************/
 ReturnCode rfalNfcvPollerLockBlock( uint8_t flags, const uint8_t* uid, uint8_t blockNum )
 {
@@ -89,6 +89,8 @@
  ******************************************************************************
  */
 
+#define rfalSt25tbRunBlocking( e, fn )  do{ (e)=(fn); }while( (e) == ERR_BUSY )   /*!< Macro used for the blocking methods */
+
 /*
 ******************************************************************************
 * GLOBAL TYPES
@@ -132,6 +134,22 @@ typedef struct
     rfalSt25tbBlock data;               /*!< Block Data                   */
 } rfalSt25tbWriteBlockReq;
 
+/*! Collision Resolution context */
+typedef struct
+{
+    uint8_t                 devLimit;       /*!< Device limit to be used                 */
+    rfalSt25tbListenDevice* st25tbDevList;  /*!< Location of the device list             */
+    uint8_t*                devCnt;         /*!< Location of the device counter          */
+    uint8_t                 slotNum;        /*!< Next slot of the ongoing Pcall16 round  */
+    bool                    col;            /*!< Collision detected on the ongoing round */
+} rfalSt25tbColResParams;
+
+/*! RFAL ST25TB instance */
+typedef struct
+{
+    rfalSt25tbColResParams  CR;             /*!< Collision Resolution context            */
+} rfalSt25tb;
+
 
 /*
 ******************************************************************************
@@ -142,16 +160,16 @@ typedef struct
  *****************************************************************************
  * \brief  ST25TB Poller Do Collision Resolution
  *  
- * This method performs ST25TB Collision resolution loop for each slot
+ * This method performs one slot of the ST25TB Collision resolution loop
  *   
- * \param[in]  devLimit      : device limit value, and size st25tbDevList
+ * \param[in]  slotNum       : slot to be performed, 0 sends the Pcall16
  * \param[out] st25tbDevList : ST35TB listener device info
  * \param[out] devCnt        : Devices found counter
  * 
  * \return colPending         : true if a collision was detected
  *****************************************************************************
  */
-static bool rfalSt25tbPollerDoCollisionResolution( uint8_t devLimit, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt );
+static bool rfalSt25tbPollerDoCollisionResolution( uint8_t slotNum, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt );
 
 /*
 ******************************************************************************
@@ -160,69 +178,61 @@ static bool rfalSt25tbPollerDoCollisionResolution( uint8_t devLimit, rfalSt25tbL
 */
 
 
-static bool rfalSt25tbPollerDoCollisionResolution( uint8_t devLimit, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt )
+static bool rfalSt25tbPollerDoCollisionResolution( uint8_t slotNum, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt )
 {
-    uint8_t    i;
     uint8_t    chipId;
     ReturnCode ret;
     bool col;
 
     col = false;
     
-    for(i = 0; i < RFAL_ST25TB_SLOTS; i++)
+    platformDelay(1);  /* Wait t2: Answer to new request delay  */
+    
+    if( slotNum==0U )
     {
-        platformDelay(1);  /* Wait t2: Answer to new request delay  */
-        
-        if( i==0U )
-        {
-            /* Step 2: Send Pcall16 */
-            ret = rfalSt25tbPollerPcall( &chipId );
-        }
-        else
-        {
-            /* Step 3-17: Send Pcall16 */
-            ret = rfalSt25tbPollerSlotMarker( i, &chipId );
-        }
+        /* Step 2: Send Pcall16 */
+        ret = rfalSt25tbPollerPcall( &chipId );
+    }
+    else
+    {
+        /* Step 3-17: Send Pcall16 */
+        ret = rfalSt25tbPollerSlotMarker( slotNum, &chipId );
+    }
+    
+    if( ret == ERR_NONE )
+    {
+        /* Found another device */
+        st25tbDevList[*devCnt].chipID       = chipId;
+        st25tbDevList[*devCnt].isDeselected = false;
         
-        if( ret == ERR_NONE )
-        {
-            /* Found another device */
-            st25tbDevList[*devCnt].chipID       = chipId;
-            st25tbDevList[*devCnt].isDeselected = false;
-            
-            /* Select Device, retrieve its UID  */
-            ret = rfalSt25tbPollerSelect( chipId );
-
-            /* By Selecting this device, the previous gets Deselected */
-            if( (*devCnt) > 0U )
-            {
-                st25tbDevList[(*devCnt)-1U].isDeselected = true;
-            }
-
-            if( ERR_NONE == ret )
-            {
-                rfalSt25tbPollerGetUID( &st25tbDevList[*devCnt].UID );
-            }
+        /* Select Device, retrieve its UID  */
+        ret = rfalSt25tbPollerSelect( chipId );
 
-            if( ERR_NONE == ret )
-            {
-                (*devCnt)++;
-            }
-        }
-        else if( (ret == ERR_CRC) || (ret == ERR_FRAMING) )
+        /* By Selecting this device, the previous gets Deselected */
+        if( (*devCnt) > 0U )
         {
-            col = true;
+            st25tbDevList[(*devCnt)-1U].isDeselected = true;
         }
-        else
+
+        if( ERR_NONE == ret )
         {
-            /* MISRA 15.7 - Empty else */
+            rfalSt25tbPollerGetUID( &st25tbDevList[*devCnt].UID );
         }
-        
-        if( *devCnt >= devLimit )
+
+        if( ERR_NONE == ret )
         {
-            break;
+            (*devCnt)++;
         }
     }
+    else if( (ret == ERR_CRC) || (ret == ERR_FRAMING) )
+    {
+        col = true;
+    }
+    else
+    {
+        /* MISRA 15.7 - Empty else */
+    }
+    
     return col;
 }
 
@@ -233,6 +243,9 @@ static bool rfalSt25tbPollerDoCollisionResolution( uint8_t devLimit, rfalSt25tbL
 ******************************************************************************
 */
 
+static rfalSt25tb gRfalSt25tbInstances[RFAL_FEATURE_MAX_INSTANCES]; /*!< RFAL ST25TB instances */
+#define gRfalSt25tb (gRfalSt25tbInstances[rfalInstanceIdx()])          /*!< RFAL ST25TB instance of the selected RF chip */
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTIONS
@@ -408,11 +421,22 @@ ReturnCode rfalSt25tbPollerGetUID( rfalSt25tbUID *UID )
 
 /*******************************************************************************/
 ReturnCode rfalSt25tbPollerCollisionResolution( uint8_t devLimit, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt )
+{
+    ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalSt25tbPollerStartCollisionResolution( devLimit, st25tbDevList, devCnt ) );
+    rfalSt25tbRunBlocking( ret, rfalSt25tbPollerGetCollisionResolutionStatus() );
+    
+    return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalSt25tbPollerStartCollisionResolution( uint8_t devLimit, rfalSt25tbListenDevice *st25tbDevList, uint8_t *devCnt )
 {
     
     uint8_t    chipId;
     ReturnCode ret;
-    bool       detected;  /* collision or device was detected */
     
     if( (st25tbDevList == NULL) || (devCnt == NULL) || (devLimit == 0U) )
     {
@@ -442,17 +466,60 @@ ReturnCode rfalSt25tbPollerCollisionResolution( uint8_t devLimit, rfalSt25tbList
             (*devCnt)++;
         }
     }
+    
     /* Always proceed to Pcall16 anticollision as phase differences of tags can lead to no tag recognized, even if there is one */
-    if( *devCnt < devLimit )
+    gRfalSt25tb.CR.devLimit      = devLimit;
+    gRfalSt25tb.CR.st25tbDevList = st25tbDevList;
+    gRfalSt25tb.CR.devCnt        = devCnt;
+    gRfalSt25tb.CR.slotNum       = 0;
+    gRfalSt25tb.CR.col           = false;
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalSt25tbPollerGetCollisionResolutionStatus( void )
+{
+    rfalSt25tbColResParams *cr;
+    
+    cr = &gRfalSt25tb.CR;
+    
+    if( (cr->st25tbDevList == NULL) || (cr->devCnt == NULL) )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    /* Multiple device responses, one slot per call */
+    if( *cr->devCnt < cr->devLimit )
     {
-        /* Multiple device responses */
-        do
+        if( rfalSt25tbPollerDoCollisionResolution( cr->slotNum, cr->st25tbDevList, cr->devCnt ) )
+        {
+            cr->col = true;
+        }
+        cr->slotNum++;
+        
+        /* Carry on with a new Pcall16 round while collisions are detected */
+        if( cr->slotNum >= RFAL_ST25TB_SLOTS )
         {
-            detected = rfalSt25tbPollerDoCollisionResolution( devLimit, st25tbDevList, devCnt );
+            cr->slotNum = 0;
+            if( cr->col && (*cr->devCnt < cr->devLimit) )
+            {
+                cr->col = false;
+                return ERR_BUSY;
+            }
+        }
+        else if( *cr->devCnt < cr->devLimit )
+        {
+            return ERR_BUSY;
+        }
+        else
+        {
+            /* MISRA 15.7 - Empty else */
         }
-        while( (detected == true) && (*devCnt < devLimit) );
     }
-
+    
+    cr->st25tbDevList = NULL;
     return ERR_NONE;
 }
 
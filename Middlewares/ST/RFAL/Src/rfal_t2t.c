@@ -85,6 +85,7 @@
 typedef enum
 {
     RFAL_T2T_CMD_READ           = 0x30,     /*!< T2T Read                                */
+    RFAL_T2T_CMD_FAST_READ      = 0x3A,     /*!< T2T Fast Read (NTAG, not in TS T2T)     */
     RFAL_T2T_CMD_WRITE          = 0xA2,     /*!< T2T Write                               */
     RFAL_T2T_CMD_SECTOR_SELECT  = 0xC2      /*!< T2T Sector Select                       */
 } rfalT2Tcmds;
@@ -98,6 +99,15 @@ typedef struct
 } rfalT2TReadReq;
 
 
+/*! NFC-A T2T FAST_READ  NTAG21x */
+typedef struct
+{
+    uint8_t code;                           /*!< Command code                            */
+    uint8_t startBlNo;                      /*!< First block number                      */
+    uint8_t endBlNo;                        /*!< Last block number                       */
+} rfalT2TFastReadReq;
+
+
  /*! NFC-A T2T WRITE    T2T 1.0 5.3 and table 12 */
 typedef struct
 {
@@ -155,6 +165,33 @@ typedef struct
  }
  
  
+ /*******************************************************************************/
+ ReturnCode rfalT2TPollerFastRead( uint8_t startBlockNum, uint8_t endBlockNum, uint8_t* rxBuf, uint16_t rxBufLen, uint16_t *rcvLen )
+ {
+    ReturnCode          ret;
+    rfalT2TFastReadReq  req;
+     
+    if( (rxBuf == NULL) || (rcvLen == NULL) || (endBlockNum < startBlockNum) )
+    {
+        return ERR_PARAM;
+    }
+    
+    req.code      = (uint8_t)RFAL_T2T_CMD_FAST_READ;
+    req.startBlNo = startBlockNum;
+    req.endBlNo   = endBlockNum;
+    
+    /* Transceive Command */
+    ret = rfalTransceiveBlockingTxRx( (uint8_t*)&req, sizeof(rfalT2TFastReadReq), rxBuf, rxBufLen, rcvLen, RFAL_TXRX_FLAGS_DEFAULT, RFAL_FDT_POLL_READ_MAX );
+    
+    /* Treat a NACK as on READ: Protocol Error */
+    if( (ret == ERR_INCOMPLETE_BYTE) && (*rcvLen == RFAL_T2T_ACK_NACK_LEN) && ((*rxBuf & RFAL_T2T_ACK_MASK) != RFAL_T2T_ACK) )
+    {
+        return ERR_PROTO;
+    }
+    return ret;
+ }
+ 
+ 
  /*******************************************************************************/
  ReturnCode rfalT2TPollerWrite( uint8_t blockNum, const uint8_t* wrData )
  {
@@ -80,6 +80,7 @@
 #define RFAL_SUPPORT_BR_RW_1695                     false        /*!< RFAL RW 1695 Bit Rate support switch   */
 #define RFAL_SUPPORT_BR_RW_3390                     false        /*!< RFAL RW 3390 Bit Rate support switch   */
 #define RFAL_SUPPORT_BR_RW_6780                     false        /*!< RFAL RW 6780 Bit Rate support switch   */
+#define RFAL_SUPPORT_BR_RW_NFCA_848                 false        /*!< RFAL RW  848 Bit Rate support switch for NFC-A, ISO14443A up to 424 */
 
 
 /*******************************************************************************/
@@ -84,6 +84,37 @@
 #define ST25R95_CONTROL_POLL_TIMEOUT                      100 /*!< Polling timeout             */
 #define ST25R95_CONTROL_POLL_NO_TIMEOUT                     0 /*!< non blocking polling        */
 
+#ifndef ST25R95_SPI_BURST
+    #define ST25R95_SPI_BURST                           false /*!< SPI burst configuration missing. Disabled by default: one SPI transfer per byte */
+#endif /* ST25R95_SPI_BURST */
+
+#ifndef ST25R95_IRQ_OUT_INTERRUPT
+    #define ST25R95_IRQ_OUT_INTERRUPT                   false /*!< nIRQ_OUT interrupt configuration missing. Disabled by default: nIRQ_OUT GPIO is polled */
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
+#define ST25R95_SPI_FLUSH_CHUNK_LEN                       32U /*!< Dummy chunk length used to flush the ST25R95 buffer in burst mode */
+
+#ifndef ST25R95_UART_DMA_RX
+    #define ST25R95_UART_DMA_RX                         false /*!< UART DMA reception configuration missing. Disabled by default: one Rx interrupt per response segment */
+#endif /* ST25R95_UART_DMA_RX */
+
+#if (ST25R95_INTERFACE_UART || ST25R95_IRQ_OUT_INTERRUPT) && (RFAL_FEATURE_MAX_INSTANCES > 1U)
+    #error "Several ST25R95 instances are only supported on SPI with nIRQ_OUT polling"
+#endif
+
+#define ST25R95_UART_DMA_RING_LEN                      1024U /*!< UART circular DMA Rx buffer length. Must hold the longest response */
+#define ST25R95_UART_DMA_RX_TIMEOUT                      50U /*!< UART DMA synchronous read timeout (ms) */
+
+/* See ST95HF DS 5.12 or CR95HF DS 5.12: UART baud rate = 13.56 MHz / (2 * BaudRate + 2) */
+#define ST25R95_UART_BAUDRATE(code)                     (13560000UL / ((2UL * (uint32_t)(code)) + 2UL)) /*!< UART baud rate (bps) of a BaudRate command parameter */
+#define ST25R95_UART_BAUDRATE_CODE_2260K                0x02U /*!< BaudRate command parameter: 2.26 Mbps               */
+#define ST25R95_UART_BAUDRATE_CODE_1130K                0x05U /*!< BaudRate command parameter: 1.13 Mbps               */
+#define ST25R95_UART_BAUDRATE_CODE_484K                 0x0DU /*!< BaudRate command parameter: 484 kbps                */
+#define ST25R95_UART_BAUDRATE_CODE_234K                 0x1CU /*!< BaudRate command parameter: 234 kbps                */
+#define ST25R95_UART_BAUDRATE_CODE_115K                 0x3AU /*!< BaudRate command parameter: 115 kbps                */
+#define ST25R95_UART_BAUDRATE_CODE_DEFAULT              0x75U /*!< BaudRate command parameter at power up: 57.6 kbps   */
+#define ST25R95_UART_BAUDRATE_SWITCH_DELAY                2U /*!< Time given to the ST25R95 to answer and switch its baud rate (ms) */
+
 /* See ST95HF DS 5.2 or CR95HF DS 5.2 */
 #define ST25R95_COMMAND_IDN                              0x01 /*!< Requests short information about the ST25R95 and its revision.                           */
 #define ST25R95_COMMAND_PROTOCOLSELECT                   0x02 /*!< Selects the RF communication protocol and specifies certain protocol-related parameters. */
@@ -158,6 +189,9 @@
 #define ST25R95_ECHO_RESPONSE_BUFLEN                             (3)      /*!< Echo response buffer len */
 #define ST25R95_SEND_RESPONSE_BUFLEN                             (0  + 2) /*!< Send response buffer len */
 
+#define ST25R95_SENDRECV_HEADER_MAXLEN                           (5)      /*!< SendRecv header max len: control + CMD + LEN + NFCIP1 SoD (2) */
+#define ST25R95_SENDRECV_TAIL_MAXLEN                             (2  + 3) /*!< SendRecv response tail max len: CRC (2) + additional bytes (3) */
+
 #define ST25R95_ACSTATE_IDLE                             0x00U /*!< AC Filter state: Idle */
 #define ST25R95_ACSTATE_READYA                           0x01U /*!< AC Filter state: ReadyA */
 #define ST25R95_ACSTATE_ACTIVE                           0x04U /*!< AC Filter state: Active */
@@ -193,6 +227,7 @@
 
 #if !(ST25R95_INTERFACE_UART) /* ST25R95_INTERFACE_SPI */ 
 #define st25r95SendCommandTypeAndLen(cmd, resp, respBuffLen)                                st25r95SPISendCommandTypeAndLen((cmd), (resp), (respBuffLen))                                         /*!< UART/SPI wrapper for st25r95SendCommandTypeAndLen */
+#define st25r95SendCommandBatch(cmds, nbCmds, nbDone)                                       st25r95SPISendCommandBatch((cmds), (nbCmds), (nbDone))                                                /*!< UART/SPI wrapper for st25r95SendCommandBatch      */
 #define st25r95CommandEcho()                                                                st25r95SPICommandEcho()                                                                               /*!< UART/SPI wrapper for st25r95CommandEcho           */
 #define st25r95SendData(buf, bufLen, protocol, flags)                                       st25r95SPISendData((buf), (bufLen), (protocol), (flags))                                              /*!< UART/SPI wrapper for st25r95SendData              */
 #define st25r95SendTransmitFlag(protocol, transmitFlag)                                     st25r95SPISendTransmitFlag((protocol), (transmitFlag))                                                /*!< UART/SPI wrapper for st25r95SendTransmitFlag      */
@@ -208,8 +243,10 @@
 #define st25r95GetIdleResponse()                                                            st25r95SPIGetIdleResponse()                                                                           /*!< UART/SPI wrapper for st25r95GetIdleResponse       */
 #define st25r95KillIdle()                                                                   st25r95SPIKillIdle()                                                                                  /*!< UART/SPI wrapper for st25r95KillIdle              */
 #define st25r95FlushChipSPIBuffer()                                                         st25r95SPIRxTx(NULL, NULL, ST25R95_COMMUNICATION_BUFFER_SIZE)                                         /*!< st25r95FlushChipSPIBuffer defined as a macro for better readibility */
+#define st25r95Isr()                                                                        st25r95SPIIsr()                                                                                       /*!< UART/SPI wrapper for st25r95Isr                   */
 #else /* !ST25R95_INTERFACE_SPI */
 #define st25r95SendCommandTypeAndLen(cmd, resp, respBuffLen)                                st25r95UARTSendCommandTypeAndLen((cmd), (resp), (respBuffLen))                                        /*!< UART/SPI wrapper for st25r95SendCommandTypeAndLen */
+#define st25r95SendCommandBatch(cmds, nbCmds, nbDone)                                       st25r95UARTSendCommandBatch((cmds), (nbCmds), (nbDone))                                               /*!< UART/SPI wrapper for st25r95SendCommandBatch      */
 #define st25r95CommandEcho()                                                                st25r95UARTCommandEcho()                                                                              /*!< UART/SPI wrapper for st25r95CommandEcho           */
 #define st25r95SendData(buf, bufLen, protocol, flags)                                       st25r95UARTSendData((buf), (bufLen), (protocol), (flags))                                             /*!< UART/SPI wrapper for st25r95SendData              */
 #define st25r95SendTransmitFlag(protocol, transmitFlag)                                     st25r95UARTSendTransmitFlag((protocol), (transmitFlag))                                               /*!< UART/SPI wrapper for st25r95SendTransmitFlag      */
@@ -224,6 +261,7 @@
 #define st25r95Idle(DacDataL, DacDataH, WUPeriod)                                           st25r95UARTIdle((DacDataL), (DacDataH), (WUPeriod))                                                   /*!< UART/SPI wrapper for st25r95Idle                  */
 #define st25r95GetIdleResponse()                                                            st25r95UARTGetIdleResponse()                                                                          /*!< UART/SPI wrapper for st25r95GetIdleResponse       */
 #define st25r95KillIdle()                                                                   st25r95UARTKillIdle()                                                                                 /*!< UART/SPI wrapper for st25r95KillIdle              */
+#define st25r95Isr()                                                                                                                                                                              /*!< UART/SPI wrapper for st25r95Isr                   */
 #endif /* ST25R95_INTERFACE_SPI */
 
 /*
@@ -232,6 +270,14 @@
 ******************************************************************************
 */
 
+/*! Command of a st25r95SendCommandBatch() sequence */
+typedef struct
+{
+    uint8_t  *cmd;                       /*!< Command, CMD LEN format         */
+    uint8_t  *resp;                      /*!< Response buffer, NULL when the response is not needed */
+    uint16_t respBuffLen;                /*!< Response buffer length          */
+} st25r95BatchCommand;
+
 #if !(ST25R95_INTERFACE_UART) /* ST25R95_INTERFACE_SPI */ 
 /*! SPI transceive context definition */
 typedef struct
@@ -251,7 +297,8 @@ typedef struct
 
 } st25r95SPIRxContext;
 
-extern st25r95SPIRxContext st25r95SPIRxCtx; /*!< Context for SPI transceive     */
+extern st25r95SPIRxContext st25r95SPIRxCtxInstances[RFAL_FEATURE_MAX_INSTANCES]; /*!< Context for SPI transceive, per RF chip instance */
+#define st25r95SPIRxCtx (st25r95SPIRxCtxInstances[rfalInstanceIdx()])               /*!< Context for SPI transceive of the selected instance */
 #endif /* ST25R95_INTERFACE_SPI */
 
 /*
@@ -307,6 +354,47 @@ extern ReturnCode st25r95SPISendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, u
  */
 extern ReturnCode st25r95UARTSendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_t respBuffLen);
 
+/*! 
+ *****************************************************************************
+ *  \brief  Sends a sequence of commands to ST25R95 (SPI Interface)
+ *
+ *  Executes the \a cmds back to back with a single log per sequence. Only the
+ *  responses of the commands with a \a resp buffer are stored, the others are
+ *  read out and discarded. Execution stops on the first error, including a
+ *  result code other than ST25R95_ERRCODE_NONE, so the sequence is meant for
+ *  configuration commands (ProtocolSelect, WrReg, RdReg, Idle), not SendRecv.
+ *
+ *  \param[in]   cmds: commands and their response buffers
+ *  \param[in]   nbCmds: number of commands
+ *  \param[out]  nbDone: number of commands successfully executed, may be NULL
+ *
+ *  \return ERR_NONE    : All commands executed
+ *  \return ERR_NOMEM   : Response buffer too small
+ *  \return ERR_PARAM   : Command rejected by the ST25R95
+ *  \return ERR_SYSTEM  : No response
+ *
+ *****************************************************************************
+ */
+extern ReturnCode st25r95SPISendCommandBatch(const st25r95BatchCommand *cmds, uint8_t nbCmds, uint8_t *nbDone);
+
+/*! 
+ *****************************************************************************
+ *  \brief  Sends a sequence of commands to ST25R95 (UART Interface)
+ *
+ *  UART counterpart of st25r95SPISendCommandBatch()
+ *
+ *  \param[in]   cmds: commands and their response buffers
+ *  \param[in]   nbCmds: number of commands
+ *  \param[out]  nbDone: number of commands successfully executed, may be NULL
+ *
+ *  \return ERR_NONE    : All commands executed
+ *  \return ERR_NOMEM   : Response buffer too small
+ *  \return ERR_PARAM   : Command rejected by the ST25R95
+ *
+ *****************************************************************************
+ */
+extern ReturnCode st25r95UARTSendCommandBatch(const st25r95BatchCommand *cmds, uint8_t nbCmds, uint8_t *nbDone);
+
 /*! 
  *****************************************************************************
  *  \brief  Sends a echo command to ST25R95 (SPI Interface)
@@ -333,6 +421,46 @@ extern ReturnCode st25r95SPICommandEcho(void);
  */
 extern ReturnCode st25r95UARTCommandEcho(void);
 
+/*! 
+ *****************************************************************************
+ *  \brief  Change the UART baud rate (UART only)
+ *
+ *  Sends the BaudRate command at the current baud rate and then reconfigures
+ *  the MCU UART at ST25R95_UART_BAUDRATE(baudRateCode). The link is not 
+ *  verified: the caller checks it with st25r95CommandEcho()
+ *
+ *  \param[in] baudRateCode : BaudRate command parameter (ST25R95_UART_BAUDRATE_CODE_xxx)
+ *
+ *  \return ERR_NOTSUPP : platform cannot change the MCU UART baud rate
+ *  \return ERR_NONE    : No error
+ *****************************************************************************
+ */
+extern ReturnCode st25r95UARTSetBaudRate(uint8_t baudRateCode);
+
+/*! 
+ *****************************************************************************
+ *  \brief  Reconfigure the MCU UART only (UART only)
+ *
+ *  Sets the MCU UART at ST25R95_UART_BAUDRATE(baudRateCode) without sending
+ *  any command, e.g. to return to the rate the ST25R95 is still using
+ *
+ *  \param[in] baudRateCode : BaudRate command parameter (ST25R95_UART_BAUDRATE_CODE_xxx)
+ *
+ *  \return ERR_NOTSUPP : platform cannot change the MCU UART baud rate
+ *  \return ERR_NONE    : No error
+ *****************************************************************************
+ */
+extern ReturnCode st25r95UARTSyncBaudRate(uint8_t baudRateCode);
+
+/*! 
+ *****************************************************************************
+ *  \brief  Current UART baud rate (UART only)
+ *
+ *  \return BaudRate command parameter currently used on the MCU side
+ *****************************************************************************
+ */
+extern uint8_t st25r95UARTGetBaudRateCode(void);
+
 /*! 
  *****************************************************************************
  *  \brief  Sends one byte over SPI and returns the byte received
@@ -348,11 +476,25 @@ extern ReturnCode st25r95UARTCommandEcho(void);
  */
 extern uint8_t st25r95SPISendReceiveByte(uint8_t data);
 
+/*! 
+ *****************************************************************************
+ *  \brief  nIRQ_OUT interrupt handler (SPI Interface)
+ *
+ *  To be called by the platform on nIRQ_OUT falling edge (e.g. EXTI callback)
+ *  when ST25R95_IRQ_OUT_INTERRUPT is enabled. It latches the data ready event
+ *  which is consumed by st25r95SPIPollRead().
+ *
+ *****************************************************************************
+ */
+extern void st25r95SPIIsr(void);
+
 /*! 
  *****************************************************************************
  *  \brief  Sends ProtocolSelect command
  *
  *  This function is used to send ST25R95 ProtocolSelect command
+ *  The command and the analog register settings following it are skipped
+ *  when the same configuration is already applied (see st25r95ShadowInvalidate)
  *
  *  \param[in]   protocol: value of the protocol
  *
@@ -364,6 +506,20 @@ extern uint8_t st25r95SPISendReceiveByte(uint8_t data);
  */
 extern ReturnCode st25r95ProtocolSelect(uint8_t protocol);
 
+/*! 
+ *****************************************************************************
+ *  \brief  Invalidate the shadow state
+ *
+ *  ProtocolSelect and analog register writes are skipped when the shadow
+ *  state shows the chip is already configured the same way. This function
+ *  forgets that state so that the next configuration is sent to the chip.
+ *  To be called whenever the chip may have lost its configuration
+ *  (reset, Echo, Idle, field off).
+ *
+ *****************************************************************************
+ */
+extern void st25r95ShadowInvalidate(void);
+
 /*! 
  *****************************************************************************
  *  \brief  Set bit rates
@@ -453,6 +609,11 @@ extern void st25r95UARTPrepareRx(uint8_t protocol, uint8_t *rxBuf, uint16_t rxBu
  *  \brief  Polls the ST25R95 for incomming data (SPI Interface)
  *
  *  This function is used to poll the ST25R95 for incomming data
+ *  When ST25R95_IRQ_OUT_INTERRUPT is enabled the nIRQ_OUT edge latched by
+ *  st25r95SPIIsr() is consumed instead of reading the GPIO: a response is
+ *  reported once and a non blocking poll (ST25R95_CONTROL_POLL_NO_TIMEOUT)
+ *  returns at once. With a timeout the CPU sleeps through
+ *  platformWaitForInterrupt() until the edge instead of spinning.
  *  
  *  \param[in]   timeout: timeout value
  *
@@ -620,6 +781,19 @@ extern void st25r95UartRxCpltCallback(void);
  */
 extern void st25r95UartErrorCallback(void);
 
+/*! 
+ *****************************************************************************
+ *  \brief  Uart Rx event Callback (UART DMA mode)
+ *
+ *  Uart circular DMA Rx event handler callback: to be called on idle line,
+ *  half transfer and transfer complete events when ST25R95_UART_DMA_RX is
+ *  enabled. Parses the received bytes straight from the DMA ring into the
+ *  response buffers.
+ *
+ *****************************************************************************
+ */
+extern void st25r95UartRxEventCallback(void);
+
 /*! 
  *****************************************************************************
  *  \brief End of transmit test function (SPI mode)
@@ -837,11 +1011,43 @@ extern void st25r95UARTKillIdle(void);
  */
 extern uint8_t st25r95CalibrateTagDetector(void);
 
+/*! 
+ *****************************************************************************
+ *  \brief Start the Tag Detector calibration
+ *
+ *  This function starts the step-wise Tag Detector calibration, its status
+ *  is retrieved with st25r95CalibrateTagDetectorGetStatus().
+ *
+ *****************************************************************************
+ */
+extern void st25r95CalibrateTagDetectorStart(void);
+
+/*! 
+ *****************************************************************************
+ *  \brief Get the Tag Detector calibration status
+ *
+ *  This function runs the calibration started by 
+ *  st25r95CalibrateTagDetectorStart(), one Idle command per call.
+ *
+ *  \param[out] calibration : calibration value, once done
+ *
+ *  \return ERR_BUSY   : Calibration ongoing
+ *  \return ERR_PARAM  : Invalid parameter
+ *  \return ERR_SYSTEM : Unexpected wake-up source, calibration failed
+ *  \return ERR_NONE   : Calibration done
+ *
+ *****************************************************************************
+ */
+extern ReturnCode st25r95CalibrateTagDetectorGetStatus(uint8_t *calibration);
+
 /*! 
  *****************************************************************************
  *  \brief SPI transceive function
  *
  *  This function is used for SPI communication.
+ *  When ST25R95_SPI_BURST is enabled the whole buffer is exchanged in a single
+ *  platformSpiTxRx()/platformSpiTx() transfer, otherwise one byte at a time.
+ *  A NULL \a txData sends dummy bytes, a NULL \a rxData discards received bytes.
  *
  *  \param[in]   txData: Tx Data
  *  \param[out]  rxData: Rx Data
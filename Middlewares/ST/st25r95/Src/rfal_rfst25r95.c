@@ -96,6 +96,10 @@ typedef struct{
     rfalWumState            state;       /*!< Current Wake-Up Mode state                           */
     rfalWakeUpConfig        cfg;         /*!< Current Wake-Up Mode context                         */
     uint8_t                 CalTagDet;   /*!< Tag Detection calibration value                      */
+#if RFAL_FEATURE_BOUNDED_WORKER
+    bool                    CalPending;  /*!< Tag Detection calibration still to be performed      */
+    bool                    Calibrating; /*!< Tag Detection calibration run by the worker          */
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
 } rfalWum;
 
 typedef struct{
@@ -116,6 +120,24 @@ typedef struct{
     rfalPostTxRxCallback    postTxRx;    /*!< RFAL's Post TxRx callback   */
 } rfalCallbacks;
 
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+/*! Struct that holds an asynchronous Transceive                          */
+typedef struct{
+    rfalTransceiveContext          ctx;      /*!< Transceive context given by the caller      */
+    rfalTransceiveCompleteCallback callback; /*!< Completion callback                         */
+    void*                          param;    /*!< Completion callback user parameter          */
+} rfalAsyncTxRx;
+
+/*! Struct that holds the asynchronous Transceive management              */
+typedef struct{
+    rfalAsyncTxRx           cur;                                     /*!< Ongoing asynchronous Transceive    */
+    bool                    active;                                  /*!< cur is ongoing                     */
+    rfalAsyncTxRx           queue[RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN];  /*!< Queued asynchronous Transceives    */
+    uint8_t                 head;                                    /*!< Index of the oldest queued entry   */
+    uint8_t                 count;                                   /*!< Number of queued entries           */
+} rfalAsync;
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+
 /*! Struct that holds NFC-F data - Used only inside rfalFelicaPoll() (static to avoid adding it into stack) */
 typedef struct{    
     rfalFeliCaPollRes pollResponses[RFAL_FELICA_POLL_MAX_SLOTS];   /* FeliCa Poll response container for 16 slots */
@@ -145,6 +167,12 @@ typedef struct{
 #if RFAL_FEATURE_LISTEN_MODE
     bool                  cardEmulT4AT;
 #endif /* RFAL_FEATURE_LISTEN_MODE */
+#if RFAL_FEATURE_BOUNDED_WORKER
+    uint32_t              workerMaxTime; /*!< Longest rfalWorker() execution time             */
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+    rfalAsync             async;     /*!< RFAL's asynchronous transceive management       */
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
 } rfal;
 
 /*! Felica's command set */
@@ -188,6 +216,8 @@ typedef enum
 
 #define RFAL_ST25R95_IDLE_DEFAULT_WUPERIOD                                           0x24U /*!< Fixed WU Period to reach ~300 ms timeout with Max Sleep = 0 */
 
+#define RFAL_ST25R95_UART_ECHO_CHECKS                                                3U    /*!< Echo commands that must succeed to validate a new UART baud rate */
+
 /*
 ******************************************************************************
 * GLOBAL MACROS
@@ -203,7 +233,18 @@ typedef enum
  ******************************************************************************
  */
 
-static rfal gRFAL;              /*!< RFAL module instance               */
+static rfal gRFALInstances[RFAL_FEATURE_MAX_INSTANCES];  /*!< RFAL module instances        */
+#define gRFAL                   (gRFALInstances[rfalInstanceIdx()])  /*!< RFAL module instance of the selected RF chip */
+
+#if (RFAL_FEATURE_MAX_INSTANCES > 1U)
+RFAL_INSTANCE_STORAGE uint8_t gRfalInstanceIdx;  /*!< Selected RF chip instance */
+#endif /* RFAL_FEATURE_MAX_INSTANCES */
+
+#if ST25R95_INTERFACE_UART
+/*! UART baud rates tried by rfalChipNegotiateUartBaudRate(), fastest first */
+static const uint8_t gRfalUartBaudRateCodes[] = { ST25R95_UART_BAUDRATE_CODE_2260K, ST25R95_UART_BAUDRATE_CODE_1130K, ST25R95_UART_BAUDRATE_CODE_484K,
+                                                  ST25R95_UART_BAUDRATE_CODE_234K,  ST25R95_UART_BAUDRATE_CODE_115K,  ST25R95_UART_BAUDRATE_CODE_DEFAULT };
+#endif /* ST25R95_INTERFACE_UART */
 
 /*
 ******************************************************************************
@@ -215,13 +256,24 @@ static void rfalTransceiveTx(void);
 static void rfalTransceiveRx(void);
 static ReturnCode rfalTransceiveRunBlockingTx(void);
 static bool rfalChipIsBusy(void);
+#if ST25R95_INTERFACE_UART
+static ReturnCode rfalChipCheckUartLink(void);
+static ReturnCode rfalChipRestoreUartBaudRate(uint8_t failedCode, uint8_t prevCode);
+#endif /* ST25R95_INTERFACE_UART */
 
 static ReturnCode rfalRunTransceiveWorker( void );
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+static void rfalRunAsyncTransceiveWorker( void );
+static void rfalStartNextAsyncTransceive( void );
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
 #if RFAL_FEATURE_LISTEN_MODE
 static ReturnCode rfalRunListenModeWorker( void );
 #endif /* RFAL_FEATURE_LISTEN_MODE */
 #if RFAL_FEATURE_WAKEUP_MODE
 static void rfalRunWakeUpModeWorker( void );
+#if RFAL_FEATURE_BOUNDED_WORKER
+static void rfalRunWakeUpModeCalibration( void );
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
 #endif /* RFAL_FEATURE_WAKEUP_MODE */
 
 /*
@@ -274,11 +326,31 @@ ReturnCode rfalInitialize(void)
     
     gRFAL.callbacks.preTxRx  = NULL;
     gRFAL.callbacks.postTxRx = NULL;
+    
+#if RFAL_FEATURE_BOUNDED_WORKER
+    gRFAL.workerMaxTime      = 0U;
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+    gRFAL.async.active       = false;
+    gRFAL.async.head         = 0U;
+    gRFAL.async.count        = 0U;
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
      
     /* Initialize Wake-Up Mode */
     gRFAL.wum.state = RFAL_WUM_STATE_NOT_INIT;
+    #if RFAL_FEATURE_BOUNDED_WORKER
+    gRFAL.wum.CalPending  = false;
+    gRFAL.wum.Calibrating = false;
+    #endif /* RFAL_FEATURE_BOUNDED_WORKER */
     #if ST25R95_TAGDETECT_CALIBRATE || !defined(ST25R95_TAGDETECT_DEF_CALIBRATION)
+    #if RFAL_FEATURE_BOUNDED_WORKER
+    /* Calibration (8 Idle commands) deferred to the Wake-Up mode worker, one Idle command per call */
+    gRFAL.wum.CalTagDet  = 0U;
+    gRFAL.wum.CalPending = true;
+    #else
     gRFAL.wum.CalTagDet = st25r95CalibrateTagDetector();
+    #endif /* RFAL_FEATURE_BOUNDED_WORKER */
     #else
     gRFAL.wum.CalTagDet = ST25R95_TAGDETECT_DEF_CALIBRATION;
     #endif /* ST25R95_TAGDETECT_CAL */
@@ -334,6 +406,11 @@ ReturnCode rfalDeinitialize(void)
     /* Deinitialize chip */
     st25r95Deinitialize();
  
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+    gRFAL.async.active = false;
+    gRFAL.async.count  = 0U;
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+ 
     gRFAL.state = RFAL_STATE_IDLE;
     return ERR_NONE;
 }
@@ -637,6 +714,14 @@ ReturnCode rfalStartTransceive( const rfalTransceiveContext *ctx )
             return ERR_REQUEST;
         }
     
+    #if RFAL_FEATURE_ASYNC_TRANSCEIVE
+        /* An asynchronous Transceive owns the TxRx context until its callback */
+        if( gRFAL.async.active )
+        {
+            return ERR_REQUEST;
+        }
+    #endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+    
         gRFAL.TxRx.ctx = *ctx;
         
         /*******************************************************************************/
@@ -686,6 +771,76 @@ ReturnCode rfalStartTransceive( const rfalTransceiveContext *ctx )
 }
 
 
+/*******************************************************************************/
+ReturnCode rfalStartTransceiveAsync( const rfalTransceiveContext *ctx, rfalTransceiveCompleteCallback pFunc, void *param )
+{
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+    ReturnCode     ret;
+    rfalAsyncTxRx* entry;
+    
+    if( ctx == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    if( gRFAL.state < RFAL_STATE_MODE_SET )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    /* Start right away when no asynchronous Transceive is ongoing, the queue is then empty */
+    if( !gRFAL.async.active )
+    {
+        EXIT_ON_ERR( ret, rfalStartTransceive( ctx ) );
+        
+        gRFAL.async.cur.ctx      = *ctx;
+        gRFAL.async.cur.callback = pFunc;
+        gRFAL.async.cur.param    = param;
+        gRFAL.async.active       = true;
+        return ERR_NONE;
+    }
+    
+    if( gRFAL.async.count >= RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN )
+    {
+        return ERR_NOMEM;
+    }
+    
+    entry           = &gRFAL.async.queue[ ((gRFAL.async.head + gRFAL.async.count) % RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN) ];
+    entry->ctx      = *ctx;
+    entry->callback = pFunc;
+    entry->param    = param;
+    gRFAL.async.count++;
+    
+    return ERR_NONE;
+#else
+    NO_WARNING(ctx);
+    NO_WARNING(pFunc);
+    NO_WARNING(param);
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+}
+
+
+/*******************************************************************************/
+uint8_t rfalGetAsyncTransceivePending( void )
+{
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+    return (gRFAL.async.count + (gRFAL.async.active ? 1U : 0U));
+#else
+    return 0U;
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+}
+
+
+/*******************************************************************************/
+void rfalFlushAsyncTransceive( void )
+{
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+    gRFAL.async.count = 0U;
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+}
+
+
 /*******************************************************************************/
 bool rfalIsTransceiveInTx( void )
 {
@@ -789,6 +944,13 @@ ReturnCode rfalGetTransceiveRSSI(uint16_t *rssi)
 /*******************************************************************************/
 void rfalWorker(void)
 {
+#if RFAL_FEATURE_BOUNDED_WORKER
+    uint32_t workerStart;
+    uint32_t workerTime;
+    
+    workerStart = platformGetWorkerTime();
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+
     platformProtectWorker();               /* Protect RFAL Worker/Task/Process */
     
     switch (gRFAL.state)
@@ -814,7 +976,64 @@ void rfalWorker(void)
             break;
     }
     
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+    rfalRunAsyncTransceiveWorker();
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+    
     platformUnprotectWorker();             /* Unprotect RFAL Worker/Task/Process */
+
+#if RFAL_FEATURE_BOUNDED_WORKER
+    workerTime = (platformGetWorkerTime() - workerStart);
+    if( workerTime > gRFAL.workerMaxTime )
+    {
+        gRFAL.workerMaxTime = workerTime;
+    }
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+}
+
+/*******************************************************************************/
+ReturnCode rfalGetWorkerMaxTime( uint32_t *maxTime )
+{
+#if RFAL_FEATURE_BOUNDED_WORKER
+    if( maxTime == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    *maxTime = gRFAL.workerMaxTime;
+    return ERR_NONE;
+#else
+    NO_WARNING(maxTime);
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+}
+
+/*******************************************************************************/
+void rfalResetWorkerMaxTime( void )
+{
+#if RFAL_FEATURE_BOUNDED_WORKER
+    gRFAL.workerMaxTime = 0U;
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+}
+
+/*******************************************************************************/
+ReturnCode rfalSelectInstance( uint8_t instance )
+{
+    if( instance >= RFAL_FEATURE_MAX_INSTANCES )
+    {
+        return ERR_PARAM;
+    }
+    
+#if (RFAL_FEATURE_MAX_INSTANCES > 1U)
+    gRfalInstanceIdx = instance;
+#endif /* RFAL_FEATURE_MAX_INSTANCES */
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+uint8_t rfalGetInstance( void )
+{
+    return rfalInstanceIdx();
 }
 
 /*******************************************************************************/
@@ -882,7 +1101,7 @@ static void rfalTransceiveTx(void)
             rfalTimerStart( gRFAL.tmr.FDTPoll, (RFAL_ST25R95_SW_TMR_MIN_1MS + rfalConv1fcToMs(gRFAL.timings.FDTPoll)) );
             
             gRFAL.TxRx.state = RFAL_TXRX_STATE_TX_WAIT_TXE;
-            /* fall through */
+            /* fall through */                    /* Data and transmission flag share one nSS assertion, never split them */
 
         /*******************************************************************************/
         case RFAL_TXRX_STATE_TX_WAIT_TXE:
@@ -917,6 +1136,9 @@ static void rfalTransceiveTx(void)
             }
 #endif /* RFAL_FEATURE_LISTEN_MODE */
             gRFAL.TxRx.state = RFAL_TXRX_STATE_TX_DONE;
+        #if RFAL_FEATURE_BOUNDED_WORKER
+            break;                                /* Bounded worker: one chip access per call, resume on next call */
+        #endif /* RFAL_FEATURE_BOUNDED_WORKER */
             /* fall through */
 
         /*******************************************************************************/
@@ -981,6 +1203,9 @@ static void rfalTransceiveRx(void)
                 break;
             }
             gRFAL.TxRx.state = RFAL_TXRX_STATE_RX_READ_DATA;
+        #if RFAL_FEATURE_BOUNDED_WORKER
+            break;                                /* Bounded worker: one chip access per call, resume on next call */
+        #endif /* RFAL_FEATURE_BOUNDED_WORKER */
             /* fall through */
             
         /*******************************************************************************/    
@@ -1066,6 +1291,75 @@ static ReturnCode rfalTransceiveRunBlockingTx(void)
     return ret;
 }
 
+#if RFAL_FEATURE_ASYNC_TRANSCEIVE
+/*******************************************************************************/
+static void rfalRunAsyncTransceiveWorker( void )
+{
+    rfalAsyncTxRx done;
+    ReturnCode    status;
+    
+    if( !gRFAL.async.active )
+    {
+        return;
+    }
+    
+    status = rfalGetTransceiveStatus();
+    if( status == ERR_BUSY )
+    {
+        return;
+    }
+    
+    done               = gRFAL.async.cur;
+    gRFAL.async.active = false;
+    
+    /* Put the next queued frame on air before notifying, the callback then overlaps with its RF exchange */
+    rfalStartNextAsyncTransceive();
+#if !RFAL_FEATURE_BOUNDED_WORKER
+    if( gRFAL.async.active )
+    {
+        rfalRunTransceiveWorker();
+    }
+#endif /* !RFAL_FEATURE_BOUNDED_WORKER */
+    
+    if( done.callback != NULL )
+    {
+        done.callback( &done.ctx, status, done.param );
+    }
+}
+
+
+/*******************************************************************************/
+static void rfalStartNextAsyncTransceive( void )
+{
+    rfalAsyncTxRx next;
+    ReturnCode    ret;
+    
+    while( (!gRFAL.async.active) && (gRFAL.async.count > 0U) )
+    {
+        next             = gRFAL.async.queue[gRFAL.async.head];
+        gRFAL.async.head = (uint8_t)((gRFAL.async.head + 1U) % RFAL_ASYNC_TRANSCEIVE_QUEUE_LEN);
+        gRFAL.async.count--;
+        
+        ret = rfalStartTransceive( &next.ctx );
+        if( ret == ERR_NONE )
+        {
+            gRFAL.async.cur    = next;
+            gRFAL.async.active = true;
+        }
+        else if( next.callback != NULL )
+        {
+            /* Frame cannot be issued (e.g. mode changed meanwhile): complete it with the error */
+            next.callback( &next.ctx, ret, next.param );
+        }
+        else
+        {
+            /* No callback, drop it */
+        }
+    }
+}
+#endif /* RFAL_FEATURE_ASYNC_TRANSCEIVE */
+
+
 /*******************************************************************************/
 static bool rfalChipIsBusy(void)
 {
@@ -1692,6 +1986,17 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
     
     if (gRFAL.wum.cfg.indAmp.reference == RFAL_WUM_REFERENCE_AUTO)
     {
+    #if RFAL_FEATURE_BOUNDED_WORKER
+        if (gRFAL.wum.CalPending)
+        {
+            /* Calibrate first, the worker then enters Idle with the calibrated reference */
+            st25r95CalibrateTagDetectorStart();
+            gRFAL.wum.Calibrating = true;
+            gRFAL.state           = RFAL_STATE_WUM;
+            gRFAL.wum.state       = RFAL_WUM_STATE_ENABLED;
+            return ERR_NONE;
+        }
+    #endif /* RFAL_FEATURE_BOUNDED_WORKER */
         gRFAL.wum.cfg.indAmp.reference = gRFAL.wum.CalTagDet;
     }
     if ((gRFAL.wum.cfg.indAmp.delta > gRFAL.wum.cfg.indAmp.reference) || ((((uint32_t)gRFAL.wum.cfg.indAmp.delta) + ((uint32_t)gRFAL.wum.cfg.indAmp.reference)) > 0xFCUL))
@@ -1727,13 +2032,61 @@ ReturnCode rfalWakeUpModeStop( void )
         return ERR_WRONG_STATE;
     }
     
+#if RFAL_FEATURE_BOUNDED_WORKER
+    if (gRFAL.wum.Calibrating)
+    {
+        /* No Idle ongoing, calibration restarted by the next rfalWakeUpModeStart() */
+        gRFAL.wum.state       = RFAL_WUM_STATE_NOT_INIT;
+        gRFAL.wum.Calibrating = false;
+        return ERR_NONE;
+    }
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+    
+    /* Once woke the Idle response has been read and the chip is back in Ready state: no nIRQ_IN pulse (it would wait for a response that never comes) */
+    if (gRFAL.wum.state != RFAL_WUM_STATE_ENABLED_WOKE)
+    {
+        st25r95KillIdle();
+    }
     gRFAL.wum.state = RFAL_WUM_STATE_NOT_INIT;
-    st25r95KillIdle();
     st25r95CommandEcho();
     return ERR_NONE;
 }
 
 
+#if RFAL_FEATURE_BOUNDED_WORKER
+/*******************************************************************************/
+static void rfalRunWakeUpModeCalibration( void )
+{
+    ReturnCode ret;
+    uint8_t    calibration;
+    
+    ret = st25r95CalibrateTagDetectorGetStatus( &calibration );
+    if( ret == ERR_BUSY )
+    {
+        return;
+    }
+    
+    gRFAL.wum.Calibrating = false;
+    
+    if( ret == ERR_NONE )
+    {
+        gRFAL.wum.CalTagDet            = calibration;
+        gRFAL.wum.CalPending           = false;
+        gRFAL.wum.cfg.indAmp.reference = calibration;
+        
+        if( (gRFAL.wum.cfg.indAmp.delta <= calibration) && ((((uint32_t)gRFAL.wum.cfg.indAmp.delta) + ((uint32_t)calibration)) <= 0xFCUL) )
+        {
+            /* Use a fixed period of ~300 ms */
+            st25r95Idle(calibration - gRFAL.wum.cfg.indAmp.delta, calibration + gRFAL.wum.cfg.indAmp.delta, RFAL_ST25R95_IDLE_DEFAULT_WUPERIOD);
+            return;
+        }
+    }
+    
+    /* No usable reference: report as woke so that the caller does not wait for a wake-up that cannot come */
+    gRFAL.wum.state = RFAL_WUM_STATE_ENABLED_WOKE;
+}
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+
 /*******************************************************************************/
 static void rfalRunWakeUpModeWorker( void )
 {   
@@ -1742,6 +2095,14 @@ static void rfalRunWakeUpModeWorker( void )
         return;
     }
     
+#if RFAL_FEATURE_BOUNDED_WORKER
+    if( gRFAL.wum.Calibrating )
+    {
+        rfalRunWakeUpModeCalibration();
+        return;
+    }
+#endif /* RFAL_FEATURE_BOUNDED_WORKER */
+    
     switch( gRFAL.wum.state )
     {
         case RFAL_WUM_STATE_ENABLED:
@@ -1945,3 +2306,106 @@ ReturnCode rfalChipMeasurePowerSupply( uint8_t param, uint8_t* result )
     
     return ERR_NOTSUPP;
 }
+
+/*******************************************************************************/
+ReturnCode rfalChipNegotiateUartBaudRate( uint32_t maxBaudRate, uint32_t* baudRate )
+{
+#if ST25R95_INTERFACE_UART
+    ReturnCode ret;
+    uint8_t    prevCode;
+    uint8_t    code;
+    uint8_t    i;
+    
+    if( baudRate == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    if( gRFAL.state < RFAL_STATE_INIT )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    /* Ensure that no previous operation is still ongoing */
+    if( rfalChipIsBusy() )
+    {        
+        return ERR_REQUEST;
+    }
+    
+    prevCode = st25r95UARTGetBaudRateCode();
+    
+    for( i = 0; i < SIZEOF_ARRAY(gRfalUartBaudRateCodes); i++ )
+    {
+        code = gRfalUartBaudRateCodes[i];
+        
+        /* Skip the rates above the MCU limit, stop once the current rate is reached */
+        if( ST25R95_UART_BAUDRATE(code) > maxBaudRate )
+        {
+            continue;
+        }
+        if( code >= prevCode )
+        {
+            break;
+        }
+        
+        EXIT_ON_ERR( ret, st25r95UARTSetBaudRate(code) );
+        
+        if( rfalChipCheckUartLink() == ERR_NONE )
+        {
+            break;
+        }
+        
+        /* Link not reliable at this rate: back to the previous one and try the next */
+        EXIT_ON_ERR( ret, rfalChipRestoreUartBaudRate(code, prevCode) );
+    }
+    
+    *baudRate = ST25R95_UART_BAUDRATE(st25r95UARTGetBaudRateCode());
+    return ERR_NONE;
+#else
+    NO_WARNING(maxBaudRate);
+    NO_WARNING(baudRate);
+    
+    return ERR_NOTSUPP;
+#endif /* ST25R95_INTERFACE_UART */
+}
+
+#if ST25R95_INTERFACE_UART
+/*******************************************************************************/
+static ReturnCode rfalChipCheckUartLink(void)
+{
+    uint8_t i;
+    
+    for( i = 0; i < RFAL_ST25R95_UART_ECHO_CHECKS; i++ )
+    {
+        if( st25r95CommandEcho() != ERR_NONE )
+        {
+            return ERR_SYSTEM;
+        }
+    }
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode rfalChipRestoreUartBaudRate(uint8_t failedCode, uint8_t prevCode)
+{
+    ReturnCode ret;
+    
+    /* The ST25R95 may have ignored the BaudRate command: check the previous rate first */
+    EXIT_ON_ERR( ret, st25r95UARTSyncBaudRate(prevCode) );
+    if( rfalChipCheckUartLink() == ERR_NONE )
+    {
+        return ERR_NONE;
+    }
+    
+    /* The ST25R95 switched: send it back to the previous rate from the new one */
+    EXIT_ON_ERR( ret, st25r95UARTSyncBaudRate(failedCode) );
+    EXIT_ON_ERR( ret, st25r95UARTSetBaudRate(prevCode) );
+    if( rfalChipCheckUartLink() == ERR_NONE )
+    {
+        return ERR_NONE;
+    }
+    
+    /* Link lost: the ST25R95 must be reset */
+    return ERR_SYSTEM;
+}
+#endif /* ST25R95_INTERFACE_UART */
@@ -67,6 +67,7 @@ ReturnCode st25r95Initialize(void)
      ReturnCode retCode = ERR_NONE;
         
     /* First perform the startup sequence */
+    st25r95ShadowInvalidate();
     st25r95_nIRQ_IN_Pulse();
     /* Reset ST25R95 */
     st25r95ResetChip();
@@ -91,6 +92,7 @@ void st25r95Deinitialize(void)
 {
     /* Reset ST25R95 */
     st25r95ResetChip();    
+    st25r95ShadowInvalidate();
 }
 
 
@@ -133,6 +135,7 @@ void st25r95SPIResetChip(void)
     st25r95SPISendReceiveByte(ST25R95_CONTROL_RESET);
     platformDelay(1); 
     platformSpiDeselect();
+    st25r95ShadowInvalidate();
     platformDelay(3);
     st25r95_nIRQ_IN_Pulse();
 }
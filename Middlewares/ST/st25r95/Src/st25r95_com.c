@@ -55,6 +55,40 @@
 
 #define ST25R95_DEBUG false
 
+#define ST25R95_PROTOCOLSELECT_CMD_MAXLEN  (13U)  /*!< Longest ProtocolSelect command i.e. ISO14443B (incl. command code and length) */
+#define ST25R95_PROTOCOLSELECT_BATCH_MAXLEN (3U)  /*!< ProtocolSelect followed by at most two WrReg commands */
+#define ST25R95_ANALOGREG_VALUE_OFFSET     (5U)   /*!< Offset of the value in WrReg analog register commands */
+#define ST25R95_ANALOGREG_CMD_LEN          (6U)   /*!< Length of the WrReg analog register commands */
+#define ST25R95_CALIBRATION_STEPS          (8U)   /*!< Idle commands of the Tag Detector calibration dichotomy (AN3433) */
+
+/*
+ ******************************************************************************
+ * LOCAL DATA TYPES
+ ******************************************************************************
+ */
+
+/*! Shadow of the configuration last applied to the ST25R95 (used to elide redundant commands) */
+typedef struct {
+    bool    valid;                                                 /*!< Shadow state matches the chip state   */
+    uint8_t protocol;                                              /*!< Last selected protocol                */
+    uint8_t protocolSelect[ST25R95_PROTOCOLSELECT_CMD_MAXLEN];     /*!< Last ProtocolSelect command sent (bit rates, FWT, ...) */
+    uint8_t analogReg;                                             /*!< Last ARC_B/ACC_A value written        */
+} st25r95ShadowState;
+
+/*! Configuration commands of an RF chip instance, adjusted by st25r95SetBitRate(), st25r95SetFWT(), st25r95SetSlotCounter() and the analog settings */
+typedef struct {
+    bool    init;                                                  /*!< Commands copied from the defaults     */
+    uint8_t protocolSelect[ST25R95_PROTOCOL_MAX + 1U][ST25R95_PROTOCOLSELECT_CMD_MAXLEN]; /*!< ProtocolSelect command per protocol */
+    uint8_t analogReg[ST25R95_PROTOCOL_MAX + 1U][ST25R95_ANALOGREG_CMD_LEN];             /*!< ARC_B/ACC_A WrReg command per protocol */
+} st25r95CommandState;
+
+/*! Tag Detector calibration of an RF chip instance, run by st25r95CalibrateTagDetectorGetStatus() */
+typedef struct {
+    uint8_t step;                                                  /*!< Idle commands already sent            */
+    uint8_t dacDataH;                                              /*!< DacDataH of the last Idle command     */
+    uint8_t wakeUp;                                                /*!< Wake-up source of the last Idle command */
+} st25r95CalibrationState;
+
 /*
  ******************************************************************************
  * LOCAL VARIABLES
@@ -63,14 +97,15 @@
  
 static uint8_t st25r95CommandIDN[] = {ST25R95_COMMAND_IDN, 0x00};
 
-static uint8_t ProtocolSelectCommandFieldOff[]     = {0x02, 0x02, 0x00, 0x00};
-static uint8_t ProtocolSelectCommandISO15693[]     = {0x02, 0x02, 0x01, 0x0D};
-static uint8_t ProtocolSelectCommandISO14443A[]    = {0x02, 0x05, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-static uint8_t ProtocolSelectCommandISO14443B[]    = {0x02, 0x05, 0x03, 0x01, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-static uint8_t ProtocolSelectCommandISO18092[]     = {0x02, 0x05, 0x04, 0x51, 0x1F, 0x06, 0x00, 0x00}; /* WA: keep len=5 & do not use DD */
-static uint8_t ProtocolSelectCommandCEISO14443A[]  = {0x02, 0x02, 0x12, 0x0A};
+static const uint8_t ProtocolSelectCommandFieldOff[]     = {0x02, 0x02, 0x00, 0x00};
+static const uint8_t ProtocolSelectCommandISO15693[]     = {0x02, 0x02, 0x01, 0x0D};
+static const uint8_t ProtocolSelectCommandISO14443A[]    = {0x02, 0x05, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const uint8_t ProtocolSelectCommandISO14443B[]    = {0x02, 0x05, 0x03, 0x01, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const uint8_t ProtocolSelectCommandISO18092[]     = {0x02, 0x05, 0x04, 0x51, 0x1F, 0x06, 0x00, 0x00}; /* WA: keep len=5 & do not use DD */
+static const uint8_t ProtocolSelectCommandCEISO14443A[]  = {0x02, 0x02, 0x12, 0x0A};
 
-static uint8_t *ProtocolSelectCommands[6] =
+/* Default ProtocolSelect commands, copied to each RF chip instance on its first use */
+static const uint8_t *ProtocolSelectCommandDefaults[ST25R95_PROTOCOL_MAX + 1U] =
 {
     ProtocolSelectCommandFieldOff,
     ProtocolSelectCommandISO15693,
@@ -80,12 +115,13 @@ static uint8_t *ProtocolSelectCommands[6] =
     ProtocolSelectCommandCEISO14443A,
 };
 
-static uint8_t WrRegAnalogRegConfigISO15693[]   = {0x09, 0x04, 0x68, 0x01, 0x01, 0x53};
-static uint8_t WrRegAnalogRegConfigISO14443A[]  = {0x09, 0x04, 0x68, 0x01, 0x01, 0xD3};
-static uint8_t WrRegAnalogRegConfigISO14443B[]  = {0x09, 0x04, 0x68, 0x01, 0x01, 0x30};
-static uint8_t WrRegAnalogRegConfigISO18092[]   = {0x09, 0x04, 0x68, 0x01, 0x01, 0x50};
-static uint8_t WrRegAnalogRegConfigCEISO1443A[] = {0x09, 0x04, 0x68, 0x01, 0x04, 0x27};
-static uint8_t *WrRegAnalogRegConfigs[6] =
+static const uint8_t WrRegAnalogRegConfigISO15693[]   = {0x09, 0x04, 0x68, 0x01, 0x01, 0x53};
+static const uint8_t WrRegAnalogRegConfigISO14443A[]  = {0x09, 0x04, 0x68, 0x01, 0x01, 0xD3};
+static const uint8_t WrRegAnalogRegConfigISO14443B[]  = {0x09, 0x04, 0x68, 0x01, 0x01, 0x30};
+static const uint8_t WrRegAnalogRegConfigISO18092[]   = {0x09, 0x04, 0x68, 0x01, 0x01, 0x50};
+static const uint8_t WrRegAnalogRegConfigCEISO1443A[] = {0x09, 0x04, 0x68, 0x01, 0x04, 0x27};
+/* Default analog register settings, copied to each RF chip instance on its first use */
+static const uint8_t *WrRegAnalogRegConfigDefaults[ST25R95_PROTOCOL_MAX + 1U] =
 {
     NULL,
     WrRegAnalogRegConfigISO15693,
@@ -102,6 +138,24 @@ static uint8_t Calibrate[] = {ST25R95_COMMAND_IDLE, 0x0E, 0x03, 0xA1, 0x00, 0xB8
 static uint8_t WrRegAnalogRegConfigIndex[]  = {0x09, 0x03, 0x68, 0x00, 0x01};
 static uint8_t RdRegAnalogRegConfig[]       = {0x08, 0x03, 0x69, 0x01, 0x00};
 
+static st25r95ShadowState st25r95ShadowInstances[RFAL_FEATURE_MAX_INSTANCES];
+#define st25r95Shadow (st25r95ShadowInstances[rfalInstanceIdx()])   /*!< Shadow of the selected RF chip instance */
+
+static st25r95CommandState st25r95CommandInstances[RFAL_FEATURE_MAX_INSTANCES];
+#define st25r95Commands (st25r95CommandInstances[rfalInstanceIdx()])   /*!< Configuration commands of the selected RF chip instance */
+
+static st25r95CalibrationState st25r95CalibrationInstances[RFAL_FEATURE_MAX_INSTANCES];
+#define st25r95Calibration (st25r95CalibrationInstances[rfalInstanceIdx()])   /*!< Tag Detector calibration of the selected RF chip instance */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static ReturnCode st25r95WriteAnalogReg(uint8_t protocol, uint8_t value);
+static st25r95CommandState *st25r95GetCommands(void);
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTIONS
@@ -124,38 +178,63 @@ bool st25r95CheckChipID(void)
     return (retCode);
 }
 
+/*******************************************************************************/
+void st25r95ShadowInvalidate(void)
+{
+    st25r95Shadow.valid = false;
+}
+
 /*******************************************************************************/
 ReturnCode st25r95ProtocolSelect(uint8_t protocol)
 {
     ReturnCode retCode;
-    uint8_t respBuffer[MAX(ST25R95_PROTOCOLSELECT_RESPONSE_BUFLEN, ST25R95_WRREG_RESPONSE_BUFLEN)];
+    st25r95BatchCommand batch[ST25R95_PROTOCOLSELECT_BATCH_MAXLEN];
+    uint8_t nbCmds = 0U;
+    uint8_t *cmd = st25r95GetCommands()->protocolSelect[protocol];
+    uint8_t cmdLen = cmd[ST25R95_CMD_LENGTH_OFFSET] + 2U;
     
-    retCode = st25r95SendCommandTypeAndLen(ProtocolSelectCommands[protocol], respBuffer, ST25R95_PROTOCOLSELECT_RESPONSE_BUFLEN);
-    if ((retCode == ERR_NONE) && (respBuffer[ST25R95_CMD_RESULT_OFFSET] != ST25R95_ERRCODE_NONE))
+    /* Skip the command (and the register settings following it) if the chip is already configured this way */
+    if (st25r95Shadow.valid && (st25r95Shadow.protocol == protocol) && (ST_BYTECMP(st25r95Shadow.protocolSelect, cmd, cmdLen) == 0))
     {
-        retCode = ERR_PARAM;
+        return (ERR_NONE);
     }
+    st25r95ShadowInvalidate();
+    
+    /* ProtocolSelect and the register settings following it are sent as one batch, only their result codes are checked */
+    ST_MEMSET(batch, 0x00, sizeof(batch));
+    batch[nbCmds++].cmd = cmd;
 
     /* Adjust ARC_B or ACC_A register */
     if ((protocol != ST25R95_PROTOCOL_FIELDOFF))
     {
-        st25r95SendCommandTypeAndLen(WrRegAnalogRegConfigs[protocol], respBuffer, ST25R95_WRREG_RESPONSE_BUFLEN);
+        batch[nbCmds++].cmd = st25r95GetCommands()->analogReg[protocol];
     }
 
     if (protocol == ST25R95_PROTOCOL_ISO18092)
     {
-        st25r95SendCommandTypeAndLen(WrRegEnableAutoDetectFilter, respBuffer, ST25R95_WRREG_RESPONSE_BUFLEN);
+        batch[nbCmds++].cmd = WrRegEnableAutoDetectFilter;
     }
     if (protocol == ST25R95_PROTOCOL_ISO14443A)
     {
-        st25r95SendCommandTypeAndLen(WrRegTimerWindowValue, respBuffer, ST25R95_WRREG_RESPONSE_BUFLEN);
+        batch[nbCmds++].cmd = WrRegTimerWindowValue;
     }
+    
+    retCode = st25r95SendCommandBatch(batch, nbCmds, NULL);
     #if RFAL_FEATURE_LISTEN_MODE
     if (protocol == ST25R95_PROTOCOL_CE_ISO14443A) 
     {
         st25r95SPIRxCtx.inListen = false;
     }
     #endif /* RFAL_FEATURE_LISTEN_MODE */
+    
+    /* Record the applied configuration. Field off is recorded as well: it drops any protocol configuration and lets repeated field off be skipped */
+    if ((retCode == ERR_NONE) && (cmdLen <= sizeof(st25r95Shadow.protocolSelect)))
+    {
+        ST_MEMCPY(st25r95Shadow.protocolSelect, cmd, cmdLen);
+        st25r95Shadow.protocol  = protocol;
+        st25r95Shadow.analogReg = (protocol != ST25R95_PROTOCOL_FIELDOFF) ? st25r95GetCommands()->analogReg[protocol][ST25R95_ANALOGREG_VALUE_OFFSET] : 0U;
+        st25r95Shadow.valid     = true;
+    }
     return (retCode);
 }
 
@@ -167,7 +246,7 @@ ReturnCode st25r95SetBitRate(uint8_t protocol, rfalBitRate txBR, rfalBitRate rxB
     {
         return ERR_PARAM;
     }
-    conf = &ProtocolSelectCommands[protocol][ST25R95_PROTOCOLSELECT_BR_OFFSET];
+    conf = &st25r95GetCommands()->protocolSelect[protocol][ST25R95_PROTOCOLSELECT_BR_OFFSET];
     *conf &= 0x0F;
     
     switch (protocol)
@@ -299,6 +378,7 @@ ReturnCode st25r95SetFWT(uint8_t protocol, uint32_t fwt)
     uint32_t MM;
     uint32_t DD;
     uint32_t FWT;
+    uint8_t *cmd;
 
 #if ST25R95_DEBUG
     platformLog("[%10d] Set FWT=%d (protocol=%d)\r\n", platformGetSysTick(), fwt, protocol);
@@ -380,46 +460,31 @@ ReturnCode st25r95SetFWT(uint8_t protocol, uint32_t fwt)
     switch (protocol)
     {
          case ST25R95_PROTOCOL_ISO14443A:
-            if (
-                (ProtocolSelectCommandISO14443A[4] != PP) ||
-                (ProtocolSelectCommandISO14443A[5] != MM) ||
-                (ProtocolSelectCommandISO14443A[6] != DD))
-            {                
-                ProtocolSelectCommandISO14443A[4] = PP;
-                ProtocolSelectCommandISO14443A[5] = (uint8_t)MM;
-                ProtocolSelectCommandISO14443A[6] = (uint8_t)DD;
-                
-                return (st25r95ProtocolSelect(protocol));
-            }
-            break;
+            cmd = st25r95GetCommands()->protocolSelect[protocol];
+            cmd[4] = PP;
+            cmd[5] = (uint8_t)MM;
+            cmd[6] = (uint8_t)DD;
+            
+            /* Sent only if this chip instance is not already configured this way */
+            return (st25r95ProtocolSelect(protocol));
 
         case ST25R95_PROTOCOL_ISO14443B:
-            if (
-                (ProtocolSelectCommandISO14443B[4] != PP) ||
-                (ProtocolSelectCommandISO14443B[5] != MM) ||
-                (ProtocolSelectCommandISO14443B[6] != DD))
-            {                
-                ProtocolSelectCommandISO14443B[4] = PP;
-                ProtocolSelectCommandISO14443B[5] = (uint8_t)MM;
-                ProtocolSelectCommandISO14443B[6] = (uint8_t)DD;
-                
-                return (st25r95ProtocolSelect(protocol));
-            }
-            break;
+            cmd = st25r95GetCommands()->protocolSelect[protocol];
+            cmd[4] = PP;
+            cmd[5] = (uint8_t)MM;
+            cmd[6] = (uint8_t)DD;
+            
+            /* Sent only if this chip instance is not already configured this way */
+            return (st25r95ProtocolSelect(protocol));
             
         case ST25R95_PROTOCOL_ISO18092:
-            if (
-                (ProtocolSelectCommandISO18092[5] != PP) ||
-                (ProtocolSelectCommandISO18092[6] != MM) ||
-                (ProtocolSelectCommandISO18092[7] != DD))
-            {                
-                ProtocolSelectCommandISO18092[5] = PP;
-                ProtocolSelectCommandISO18092[6] = (uint8_t)MM;
-                ProtocolSelectCommandISO18092[7] = (uint8_t)DD;
-                
-                return (st25r95ProtocolSelect(protocol));
-            }
-            break;      
+            cmd = st25r95GetCommands()->protocolSelect[protocol];
+            cmd[5] = PP;
+            cmd[6] = (uint8_t)MM;
+            cmd[7] = (uint8_t)DD;
+            
+            /* Sent only if this chip instance is not already configured this way */
+            return (st25r95ProtocolSelect(protocol));      
         
         default:
             break;
@@ -430,20 +495,19 @@ ReturnCode st25r95SetFWT(uint8_t protocol, uint32_t fwt)
 /*******************************************************************************/
 ReturnCode st25r95SetSlotCounter(uint8_t slots)
 {
-    if ((ProtocolSelectCommandISO18092[4] & 0xF) != slots)
-    {
-        ProtocolSelectCommandISO18092[4] &= 0xF0;
-        ProtocolSelectCommandISO18092[4] |= (slots & 0xF);
-        return (st25r95ProtocolSelect(ST25R95_PROTOCOL_ISO18092));
-    }
-    return (ERR_NONE);
+    uint8_t *cmd = st25r95GetCommands()->protocolSelect[ST25R95_PROTOCOL_ISO18092];
+    
+    cmd[4] &= 0xF0;
+    cmd[4] |= (slots & 0xF);
+    
+    /* Sent only if this chip instance is not already configured this way */
+    return (st25r95ProtocolSelect(ST25R95_PROTOCOL_ISO18092));
 }
 
 /*******************************************************************************/
 ReturnCode st25r95WriteReg(uint8_t protocol, uint16_t reg, uint8_t value)
 {
     ReturnCode retCode;
-    uint8_t respBuffer[ST25R95_WRREG_RESPONSE_BUFLEN];
     
     switch (reg)
     {
@@ -453,9 +517,7 @@ ReturnCode st25r95WriteReg(uint8_t protocol, uint16_t reg, uint8_t value)
                 (protocol == ST25R95_PROTOCOL_ISO14443B) ||
                 (protocol == ST25R95_PROTOCOL_ISO18092))
             {
-                WrRegAnalogRegConfigs[protocol][5] = value;
-                st25r95SendCommandTypeAndLen(WrRegAnalogRegConfigs[protocol], respBuffer, ST25R95_WRREG_RESPONSE_BUFLEN);
-                retCode = (respBuffer[ST25R95_CMD_RESULT_OFFSET] == 0) ? ERR_NONE : ERR_PARAM;
+                retCode = st25r95WriteAnalogReg(protocol, value);
             }
             else
             {
@@ -466,9 +528,7 @@ ReturnCode st25r95WriteReg(uint8_t protocol, uint16_t reg, uint8_t value)
         case (ST25R95_REG_ACC_A):
             if (protocol == ST25R95_PROTOCOL_CE_ISO14443A)
             {
-                WrRegAnalogRegConfigs[protocol][5] = value;
-                st25r95SendCommandTypeAndLen(WrRegAnalogRegConfigs[protocol], respBuffer, ST25R95_WRREG_RESPONSE_BUFLEN);
-                retCode = (respBuffer[ST25R95_CMD_RESULT_OFFSET] == 0) ? ERR_NONE : ERR_PARAM;
+                retCode = st25r95WriteAnalogReg(protocol, value);
             }
             else
             {
@@ -488,50 +548,92 @@ ReturnCode st25r95WriteReg(uint8_t protocol, uint16_t reg, uint8_t value)
 /*******************************************************************************/
 uint8_t st25r95CalibrateTagDetector(void)
 {
-    const uint8_t steps[6] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x4U};
+    ReturnCode retCode;
+    uint8_t    calibration = 0xFFU;
+    
+    st25r95CalibrateTagDetectorStart();
+    do
+    {
+        retCode = st25r95CalibrateTagDetectorGetStatus(&calibration);
+    }
+    while (retCode == ERR_BUSY);
+    
+    return ((retCode == ERR_NONE) ? calibration : 0xFFU);
+}
+
+/*******************************************************************************/
+void st25r95CalibrateTagDetectorStart(void)
+{
+    /* Idle commands leave the chip with the field off and default settings */
+    st25r95ShadowInvalidate();
+    
+    st25r95Calibration.step     = 0U;
+    st25r95Calibration.dacDataH = 0x00U;
+    st25r95Calibration.wakeUp   = 0x00U;
+}
+
+/*******************************************************************************/
+ReturnCode st25r95CalibrateTagDetectorGetStatus(uint8_t *calibration)
+{
+    const uint8_t steps[ST25R95_CALIBRATION_STEPS - 2U] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x4U};
     uint8_t       respBuffer[ST25R95_IDLE_RESPONSE_BUFLEN];
-    uint8_t       i;
     
-    /* 8 steps dichotomy implementation as per AN3433 */
+    if (calibration == NULL)
+    {
+        return (ERR_PARAM);
+    }
     
-    /* Check that wake up detection is tag detect (0x02) when DacDataH is Min Dac value 0x00 */ 
-    Calibrate[ST25R95_IDLE_DACDATAH_OFFSET] = 0x00U; 
-    st25r95SendCommandTypeAndLen(Calibrate, respBuffer, ST25R95_IDLE_RESPONSE_BUFLEN);
-    if ((respBuffer[ST25R95_CMD_RESULT_OFFSET] != ST25R95_ERRCODE_NONE) || (respBuffer[ST25R95_CMD_LENGTH_OFFSET] != 0x01) || (respBuffer[ST25R95_CMD_DATA_OFFSET] != ST25R95_IDLE_WKUP_TAGDETECT))
+    /* 8 steps dichotomy implementation as per AN3433, one Idle command per call */
+    switch (st25r95Calibration.step)
     {
-        return (0xFFU);
+        case 0U:
+            /* Check that wake up detection is tag detect (0x02) when DacDataH is Min Dac value 0x00 */ 
+            st25r95Calibration.dacDataH = 0x00U;
+            break;
+        case 1U:
+            /* Check that wake up detection is timeout (0x01) when DacDataH is Max Dac value 0xFC */ 
+            st25r95Calibration.dacDataH = ST25R95_DACDATA_MAX;
+            break;
+        default:
+            if (st25r95Calibration.wakeUp == ST25R95_IDLE_WKUP_TIMEOUT)
+            {
+                st25r95Calibration.dacDataH -= steps[st25r95Calibration.step - 2U];
+            }
+            else if (st25r95Calibration.wakeUp == ST25R95_IDLE_WKUP_TAGDETECT)
+            {
+                st25r95Calibration.dacDataH += steps[st25r95Calibration.step - 2U];
+            }
+            else
+            {
+                return (ERR_SYSTEM);
+            }
+            break;
     }
-    /* Check that wake up detection is timeout (0x01) when DacDataH is Max Dac value 0xFC */ 
-    Calibrate[ST25R95_IDLE_DACDATAH_OFFSET] = ST25R95_DACDATA_MAX;
+    
+    Calibrate[ST25R95_IDLE_DACDATAH_OFFSET] = st25r95Calibration.dacDataH;
+    respBuffer[ST25R95_CMD_DATA_OFFSET] = 0x00U;
     st25r95SendCommandTypeAndLen(Calibrate, respBuffer, ST25R95_IDLE_RESPONSE_BUFLEN);
-    if ((respBuffer[ST25R95_CMD_RESULT_OFFSET] != ST25R95_ERRCODE_NONE) || (respBuffer[ST25R95_CMD_LENGTH_OFFSET] != 0x01) || (respBuffer[ST25R95_CMD_DATA_OFFSET] != ST25R95_IDLE_WKUP_TIMEOUT))
+    
+    if ((st25r95Calibration.step < 2U) && 
+        ((respBuffer[ST25R95_CMD_RESULT_OFFSET] != ST25R95_ERRCODE_NONE) || (respBuffer[ST25R95_CMD_LENGTH_OFFSET] != 0x01) || 
+         (respBuffer[ST25R95_CMD_DATA_OFFSET] != ((st25r95Calibration.step == 0U) ? ST25R95_IDLE_WKUP_TAGDETECT : ST25R95_IDLE_WKUP_TIMEOUT))))
     {
-        return (0xFFU);
+        return (ERR_SYSTEM);
     }
     
-    for (i = 0; i < 6; i++)
+    st25r95Calibration.wakeUp = respBuffer[ST25R95_CMD_DATA_OFFSET];
+    st25r95Calibration.step++;
+    if (st25r95Calibration.step < ST25R95_CALIBRATION_STEPS)
     {
-        switch (respBuffer[ST25R95_CMD_DATA_OFFSET])
-        {
-            case ST25R95_IDLE_WKUP_TIMEOUT:
-                Calibrate[ST25R95_IDLE_DACDATAH_OFFSET] -= steps[i];
-                break;
-            case ST25R95_IDLE_WKUP_TAGDETECT:
-                Calibrate[ST25R95_IDLE_DACDATAH_OFFSET] += steps[i];
-                break;
-            default:
-                return ERR_SYSTEM;
-                /*NOTREACHED*/
-                break;
-        }
-        respBuffer[ST25R95_CMD_DATA_OFFSET] = 0x00U;
-        st25r95SendCommandTypeAndLen(Calibrate, respBuffer, ST25R95_IDLE_RESPONSE_BUFLEN);  
+        return (ERR_BUSY);
     }
-    if (respBuffer[2U] == ST25R95_IDLE_WKUP_TIMEOUT)
+    
+    if (st25r95Calibration.wakeUp == ST25R95_IDLE_WKUP_TIMEOUT)
     {
-        Calibrate[ST25R95_IDLE_DACDATAH_OFFSET] -= 0x04U;
+        st25r95Calibration.dacDataH -= 0x04U;
     }
-    return (Calibrate[ST25R95_IDLE_DACDATAH_OFFSET]);
+    *calibration = st25r95Calibration.dacDataH;
+    return (ERR_NONE);
 }
 
 /*******************************************************************************/
@@ -539,39 +641,50 @@ ReturnCode st25r95ReadReg(uint16_t reg, uint8_t *value)
 {
     ReturnCode retCode = ERR_NONE;
     uint8_t respBuffer[ST25R95_RDREG_RESPONSE_BUFLEN];
+    st25r95BatchCommand batch[2];
+    uint8_t index = 0U;
     
      switch (reg)
     {
         case (ST25R95_REG_ARC_B):
-            WrRegAnalogRegConfigIndex[4U] = 0x01U;
+            index = 0x01U;
             break;
             
         case (ST25R95_REG_ACC_A):
-            WrRegAnalogRegConfigIndex[4U] = 0x04U;
+            index = 0x04U;
             break;
         
         default:
             retCode = ERR_PARAM;
             break;
     }
+    
+    /* Serve the value from the shadow when the register is the one configured for the selected protocol */
+    if ((retCode == ERR_NONE) && st25r95Shadow.valid && (st25r95Shadow.protocol != ST25R95_PROTOCOL_FIELDOFF) &&
+        (st25r95GetCommands()->analogReg[st25r95Shadow.protocol][ST25R95_ANALOGREG_VALUE_OFFSET - 1U] == index))
+    {
+        *value = st25r95Shadow.analogReg;
+        return (ERR_NONE);
+    }
+    
     if (retCode == ERR_NONE)
     {
-        st25r95SendCommandTypeAndLen(WrRegAnalogRegConfigIndex, respBuffer, ST25R95_RDREG_RESPONSE_BUFLEN);
-        if (respBuffer[ST25R95_CMD_RESULT_OFFSET] == ST25R95_ERRCODE_NONE) 
+        /* Select the register index then read it, only the RdReg response is collected */
+        WrRegAnalogRegConfigIndex[4U] = index;
+        batch[0].cmd         = WrRegAnalogRegConfigIndex;
+        batch[0].resp        = NULL;
+        batch[0].respBuffLen = 0U;
+        batch[1].cmd         = RdRegAnalogRegConfig;
+        batch[1].resp        = respBuffer;
+        batch[1].respBuffLen = ST25R95_RDREG_RESPONSE_BUFLEN;
+        
+        if (st25r95SendCommandBatch(batch, 2U, NULL) == ERR_NONE) 
         {
-            st25r95SendCommandTypeAndLen(RdRegAnalogRegConfig, respBuffer, ST25R95_RDREG_RESPONSE_BUFLEN);
-            if (respBuffer[ST25R95_CMD_RESULT_OFFSET] == ST25R95_ERRCODE_NONE) 
-            {
-                *value = respBuffer[2];
-            }
-            else
-            {
-                retCode = ERR_PARAM;
-            }
+            *value = respBuffer[2];
         }
         else
         {
-            retCode = ERR_PARAM;    
+            retCode = ERR_PARAM;
         }
     }
 
@@ -581,3 +694,60 @@ ReturnCode st25r95ReadReg(uint16_t reg, uint8_t *value)
     return (retCode);
     
 }
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode st25r95WriteAnalogReg(uint8_t protocol, uint8_t value)
+{
+    ReturnCode retCode = ERR_NONE;
+    uint8_t respBuffer[ST25R95_WRREG_RESPONSE_BUFLEN];
+    
+    st25r95GetCommands()->analogReg[protocol][ST25R95_ANALOGREG_VALUE_OFFSET] = value;
+    
+    if (st25r95Shadow.valid)
+    {
+        /* Already applied, or another protocol is selected: value is applied on next ProtocolSelect */
+        if ((st25r95Shadow.protocol != protocol) || (st25r95Shadow.analogReg == value))
+        {
+            return (ERR_NONE);
+        }
+    }
+    
+    st25r95SendCommandTypeAndLen(st25r95GetCommands()->analogReg[protocol], respBuffer, ST25R95_WRREG_RESPONSE_BUFLEN);
+    if (respBuffer[ST25R95_CMD_RESULT_OFFSET] == 0)
+    {
+        st25r95Shadow.analogReg = value;
+    }
+    else
+    {
+        st25r95ShadowInvalidate();
+        retCode = ERR_PARAM;
+    }
+    return (retCode);
+}
+
+/*******************************************************************************/
+static st25r95CommandState *st25r95GetCommands(void)
+{
+    uint8_t protocol;
+    
+    if (!st25r95Commands.init)
+    {
+        ST_MEMSET(&st25r95Commands, 0x00, sizeof(st25r95Commands));
+        for (protocol = 0; protocol <= ST25R95_PROTOCOL_MAX; protocol++)
+        {
+            ST_MEMCPY(st25r95Commands.protocolSelect[protocol], ProtocolSelectCommandDefaults[protocol], (uint32_t)ProtocolSelectCommandDefaults[protocol][ST25R95_CMD_LENGTH_OFFSET] + 2U);
+            if (WrRegAnalogRegConfigDefaults[protocol] != NULL)
+            {
+                ST_MEMCPY(st25r95Commands.analogReg[protocol], WrRegAnalogRegConfigDefaults[protocol], ST25R95_ANALOGREG_CMD_LEN);
+            }
+        }
+        st25r95Commands.init = true;
+    }
+    return (&st25r95Commands);
+}
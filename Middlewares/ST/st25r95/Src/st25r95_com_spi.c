@@ -73,6 +73,16 @@
 
 #define ST25R95_DEBUG false
 
+#ifndef platformWaitForInterrupt
+    #define platformWaitForInterrupt()                   /*!< No low power wait provided by the platform: busy wait */
+#endif /* platformWaitForInterrupt */
+
+#if ST25R95_IRQ_OUT_INTERRUPT
+    #define st25r95SPIIrqOutClear()                      (st25r95SPIIrqOut = false)                                                                  /*!< Clear nIRQ_OUT event before sending a new command */
+#else
+    #define st25r95SPIIrqOutClear()                                                                                                                  /*!< nIRQ_OUT GPIO is polled: nothing to clear */
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
 /*
  ******************************************************************************
  * LOCAL VARIABLES
@@ -81,6 +91,9 @@
 
 static uint8_t EchoCommand[1] = {ST25R95_COMMAND_ECHO};
 static uint8_t Idle[] = {ST25R95_COMMAND_IDLE, 0x0E, 0x0A, 0x21, 0x00, 0x38, 0x01, 0x18, 0x00, 0x20, 0x60, 0x60, 0x74, 0x84, 0x3F, 0x00};
+#if ST25R95_IRQ_OUT_INTERRUPT
+static volatile bool st25r95SPIIrqOut;   /*!< nIRQ_OUT falling edge latched by st25r95SPIIsr() */
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
 
 /*
  ******************************************************************************
@@ -88,7 +101,18 @@ static uint8_t Idle[] = {ST25R95_COMMAND_IDLE, 0x0E, 0x0A, 0x21, 0x00, 0x38, 0x0
  ******************************************************************************
  */
  
-st25r95SPIRxContext st25r95SPIRxCtx;
+st25r95SPIRxContext st25r95SPIRxCtxInstances[RFAL_FEATURE_MAX_INSTANCES];
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static void st25r95SPIReadHeader(uint8_t *header);
+#if ST25R95_IRQ_OUT_INTERRUPT
+static void st25r95SPIWaitIrqOut(uint32_t timeout);
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
 
 /*
 ******************************************************************************
@@ -99,14 +123,50 @@ st25r95SPIRxContext st25r95SPIRxCtx;
 /*******************************************************************************/
 void st25r95SPIRxTx(uint8_t *txData, uint8_t *rxData, uint16_t length)
 {
+#if ST25R95_SPI_BURST
+    uint8_t  dummy[ST25R95_SPI_FLUSH_CHUNK_LEN];
+    uint16_t chunkLen;
+
+    if (length == 0U)
+    {
+        return;
+    }
+
+    if (rxData != NULL)
+    {
+        if (txData == NULL)
+        {
+            /* Clock out dummy bytes from rxData itself: Tx always runs ahead of Rx */
+            ST_MEMSET(rxData, ST25R95_SPI_DUMMY_BYTE, length);
+            txData = rxData;
+        }
+        platformSpiTxRx(txData, rxData, length);
+    }
+    else if (txData != NULL)
+    {
+        platformSpiTx(txData, length);
+    }
+    else
+    {
+        /* Nothing to send nor to keep (flush): send dummy bytes by chunks */
+        ST_MEMSET(dummy, ST25R95_SPI_DUMMY_BYTE, sizeof(dummy));
+        while (length != 0U)
+        {
+            chunkLen = MIN(length, (uint16_t)sizeof(dummy));
+            platformSpiTx(dummy, chunkLen);
+            length -= chunkLen;
+        }
+    }
+#else
     uint8_t txByte = 0;
     uint8_t rxByte;
-    
+
     while (length != 0)
     {
         platformSpiTxRx((txData == NULL) ? &txByte : txData++, (rxData == NULL) ? &rxByte : rxData++, 1);
         length--;
     }
+#endif /* ST25R95_SPI_BURST */
 }
 
 /*******************************************************************************/
@@ -118,9 +178,34 @@ uint8_t st25r95SPISendReceiveByte(uint8_t data)
     return (received_byte);
 }
 
+/*******************************************************************************/
+void st25r95SPIIsr(void)
+{
+#if ST25R95_IRQ_OUT_INTERRUPT
+    st25r95SPIIrqOut = true;
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+}
+
 /*******************************************************************************/
 ReturnCode st25r95SPIPollRead(uint32_t timeout)
 {
+#if ST25R95_IRQ_OUT_INTERRUPT
+    bool irqOut;
+    
+    if (timeout != ST25R95_CONTROL_POLL_NO_TIMEOUT)
+    {
+        /* Synchronous command: sleep until its nIRQ_OUT edge */
+        st25r95SPIWaitIrqOut(timeout);
+    }
+    
+    /* Consume the latched nIRQ_OUT edge: each response is reported once, the worker never waits */
+    platformProtectST25RIrqStatus();
+    irqOut           = st25r95SPIIrqOut;
+    st25r95SPIIrqOut = false;
+    platformUnprotectST25RIrqStatus();
+    
+    return ((irqOut) ? ERR_NONE : ERR_TIMEOUT);
+#else
     uint32_t timer;
     ReturnCode retCode = ERR_NONE;   
     
@@ -135,6 +220,7 @@ ReturnCode st25r95SPIPollRead(uint32_t timeout)
     platformTimerDestroy(timer);
     
     return (retCode);
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
 }
 
 /*******************************************************************************/
@@ -171,6 +257,7 @@ ReturnCode st25r95SPISendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_t
         resp[ST25R95_CMD_LENGTH_OFFSET] = 0x00;
         
         /* 1 - Send the  command */
+        st25r95SPIIrqOutClear();
         platformSpiSelect();
         st25r95SPISendReceiveByte(ST25R95_CONTROL_SEND);
         st25r95SPIRxTx(cmd, NULL, cmd[ST25R95_CMD_LENGTH_OFFSET] + 2);
@@ -185,9 +272,7 @@ ReturnCode st25r95SPISendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_t
         if (retCode == ERR_NONE) 
         {
             platformSpiSelect();
-            st25r95SPISendReceiveByte(ST25R95_CONTROL_READ);    
-            resp[ST25R95_CMD_RESULT_OFFSET] = st25r95SPISendReceiveByte(ST25R95_SPI_DUMMY_BYTE);
-            resp[ST25R95_CMD_LENGTH_OFFSET] = st25r95SPISendReceiveByte(resp[ST25R95_CMD_RESULT_OFFSET]);
+            st25r95SPIReadHeader(resp);
             len = resp[ST25R95_CMD_LENGTH_OFFSET];
             /* compute len according to CR95HF DS � 4.4 */
             if ((resp[ST25R95_CMD_RESULT_OFFSET] & 0x8F) == 0x80)
@@ -223,12 +308,100 @@ ReturnCode st25r95SPISendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_t
     return (retCode);
 }
 
+/*******************************************************************************/
+ReturnCode st25r95SPISendCommandBatch(const st25r95BatchCommand *cmds, uint8_t nbCmds, uint8_t *nbDone)
+{
+    ReturnCode retCode = ERR_NONE;
+    uint8_t    header[ST25R95_CMD_DATA_OFFSET];
+    uint8_t    *resp;
+    uint32_t   len;
+    uint8_t    i;
+    
+    for (i = 0; i < nbCmds; i++)
+    {
+        resp = (cmds[i].resp != NULL) ? cmds[i].resp : header;
+        if ((cmds[i].resp != NULL) && (cmds[i].respBuffLen < ST25R95_CMD_DATA_OFFSET))
+        {
+            retCode = ERR_NOMEM;
+            break;
+        }
+        
+        /* 1 - Send the command */
+        st25r95SPIIrqOutClear();
+        platformSpiSelect();
+        st25r95SPISendReceiveByte(ST25R95_CONTROL_SEND);
+        st25r95SPIRxTx(cmds[i].cmd, NULL, cmds[i].cmd[ST25R95_CMD_LENGTH_OFFSET] + 2);
+        platformSpiDeselect();
+        
+        /* 2 - Poll the ST25R95 until it is ready to transmit */
+        if (st25r95SPIPollRead(ST25R95_CONTROL_POLL_TIMEOUT) != ERR_NONE)
+        {
+            platformSpiSelect();
+            st25r95FlushChipSPIBuffer();
+            platformSpiDeselect();
+            retCode = ERR_SYSTEM;
+            break;
+        }
+        
+        /* 3 - Read the response, only kept when requested */
+        platformSpiSelect();
+        st25r95SPIReadHeader(resp);
+        len = resp[ST25R95_CMD_LENGTH_OFFSET];
+        /* compute len according to CR95HF DS � 4.4 */
+        if ((resp[ST25R95_CMD_RESULT_OFFSET] & 0x8F) == 0x80)
+        {
+            len |= (((uint32_t)resp[ST25R95_CMD_RESULT_OFFSET]) & 0x60U) << 3U;
+        }
+        if (cmds[i].resp == NULL)
+        {
+            if (len != 0)
+            {
+                st25r95SPIRxTx(NULL, NULL, len);
+            }
+        }
+        else if (cmds[i].respBuffLen >= (len + 2))
+        {
+            if (len != 0)
+            {
+                st25r95SPIRxTx(NULL, &resp[ST25R95_CMD_DATA_OFFSET], len);
+            }
+        }
+        else
+        {
+            st25r95FlushChipSPIBuffer();
+            retCode = ERR_NOMEM;
+        }
+        platformSpiDeselect();
+        
+        if ((retCode == ERR_NONE) && (resp[ST25R95_CMD_RESULT_OFFSET] != ST25R95_ERRCODE_NONE))
+        {
+            retCode = ERR_PARAM;
+        }
+        if (retCode != ERR_NONE)
+        {
+            break;
+        }
+    }
+    
+    if (nbDone != NULL)
+    {
+        *nbDone = i;
+    }
+    #if ST25R95_DEBUG
+    platformLog("[%10d] batch %d/%d commands, retCode: %2.2x\r\n", platformGetSysTick(), i, nbCmds, retCode);
+    #endif /* ST25R95_DEBUG */
+    return (retCode);
+}
+
 /*******************************************************************************/
 ReturnCode st25r95SPICommandEcho(void)
 {
     ReturnCode retCode = ERR_NONE;
     uint8_t respBuffer[ST25R95_ECHO_RESPONSE_BUFLEN];
     
+    /* Echo is used after reset or to exit Listen mode: chip configuration is unknown */
+    st25r95ShadowInvalidate();
+    
     /* 0 - Poll the ST25R95 to make sure data can be send */
     /* Used only in cas of ECHO Command as this command is sent just after the ST25R95 reset */
     retCode = st25r95SPIPollSend();
@@ -236,6 +409,7 @@ ReturnCode st25r95SPICommandEcho(void)
     if (retCode == ERR_NONE)
     {
         /* 1 - Send the echo command */
+        st25r95SPIIrqOutClear();
         platformSpiSelect();
         st25r95SPISendReceiveByte(ST25R95_CONTROL_SEND);    
         st25r95SPISendReceiveByte(EchoCommand[0]);    
@@ -252,13 +426,11 @@ ReturnCode st25r95SPICommandEcho(void)
         {
             platformSpiSelect();
             st25r95SPISendReceiveByte(ST25R95_CONTROL_READ);    
-            respBuffer[ST25R95_CMD_RESULT_OFFSET] = st25r95SPISendReceiveByte(ST25R95_SPI_DUMMY_BYTE);
             /* Read 2 additional bytes. See  ST95HF DS �5.7 :
              * The ECHO command (0x55) allows exiting Listening mode. 
              * In response to the ECHO command, the ST25R95 sends 0x55 + 0x8500 (error code of the Listening state cancelled by the MCU).
              */
-            respBuffer[1] = st25r95SPISendReceiveByte(ST25R95_SPI_DUMMY_BYTE);  
-            respBuffer[2] = st25r95SPISendReceiveByte(ST25R95_SPI_DUMMY_BYTE);
+            st25r95SPIRxTx(NULL, respBuffer, ST25R95_ECHO_RESPONSE_BUFLEN);
             platformSpiDeselect();
 #if ST25R95_DEBUG            
             platformLog("[%10d] <<<< %s\r\n", platformGetSysTick(), hex2Str(respBuffer, 3));
@@ -288,32 +460,37 @@ ReturnCode st25r95SPICommandEcho(void)
 void st25r95SPISendData(uint8_t *buf, uint8_t bufLen, uint8_t protocol, uint32_t flags)
 {
     uint8_t len;
+    uint8_t hdrLen;
+    uint8_t header[ST25R95_SENDRECV_HEADER_MAXLEN];
  
 #if ST25R95_DEBUG
     platformLog("[%10d] DATA >>>> %s", platformGetSysTick(), hex2Str(buf, bufLen));  
 #endif /* ST25R95_DEBUG */
 
-    platformSpiSelect();
-    st25r95SPISendReceiveByte(ST25R95_CONTROL_SEND);
+    hdrLen = 0;
+    header[hdrLen++] = ST25R95_CONTROL_SEND;
     if (protocol == ST25R95_PROTOCOL_CE_ISO14443A)
     {
         /* Card Emulation mode */
-        st25r95SPISendReceiveByte(ST25R95_COMMAND_SEND);
+        header[hdrLen++] = ST25R95_COMMAND_SEND;
     }
     else
     {
-        st25r95SPISendReceiveByte(ST25R95_COMMAND_SENDRECV);
+        header[hdrLen++] = ST25R95_COMMAND_SENDRECV;
     }
     /* add transmission Flag Len in case of 14443A */
     len = ((protocol == ST25R95_PROTOCOL_ISO14443A) || (protocol == ST25R95_PROTOCOL_CE_ISO14443A)) ? bufLen + 1: bufLen;
     /* add SoD len in case of ISO14443A + NFCIP1 */
     len += ((protocol == ST25R95_PROTOCOL_ISO14443A) && ((flags & RFAL_TXRX_FLAGS_NFCIP1_ON) == RFAL_TXRX_FLAGS_NFCIP1_ON)) ? 2 : 0;
-    st25r95SPISendReceiveByte(len);
+    header[hdrLen++] = len;
     if ((protocol == ST25R95_PROTOCOL_ISO14443A) && ((flags & RFAL_TXRX_FLAGS_NFCIP1_ON) == RFAL_TXRX_FLAGS_NFCIP1_ON))
     {
-        st25r95SPISendReceiveByte(0xF0U);
-        st25r95SPISendReceiveByte(bufLen + 1); /* DP 2.0 17.4.1.3 The SoD SHALL contain a length byte LEN at the position shown in Figure 43 with a value equal to n+1, where n indicates the number of bytes the payload consists of.*/
+        header[hdrLen++] = 0xF0U;
+        header[hdrLen++] = bufLen + 1; /* DP 2.0 17.4.1.3 The SoD SHALL contain a length byte LEN at the position shown in Figure 43 with a value equal to n+1, where n indicates the number of bytes the payload consists of.*/
     }
+    st25r95SPIIrqOutClear();
+    platformSpiSelect();
+    st25r95SPIRxTx(header, NULL, hdrLen);
     st25r95SPIRxTx(buf, NULL, bufLen);
 
 }
@@ -362,6 +539,9 @@ ReturnCode st25r95SPICompleteRx(void)
     rfalBitRate rxBr;
     ReturnCode retCode = ERR_NONE;
     uint16_t additionalRespBytesNb = 1;
+    uint16_t tailLen;
+    uint8_t  header[ST25R95_CMD_DATA_OFFSET];
+    uint8_t  tail[ST25R95_SENDRECV_TAIL_MAXLEN];
     
     
 #if ST25R95_DEBUG   
@@ -370,9 +550,9 @@ ReturnCode st25r95SPICompleteRx(void)
 #endif /* ST25R95_DEBUG */
     
     platformSpiSelect();
-    st25r95SPISendReceiveByte(ST25R95_CONTROL_READ);    
-    Result = st25r95SPISendReceiveByte(ST25R95_SPI_DUMMY_BYTE);
-    len = st25r95SPISendReceiveByte(ST25R95_SPI_DUMMY_BYTE);
+    st25r95SPIReadHeader(header);
+    Result = header[ST25R95_CMD_RESULT_OFFSET];
+    len = header[ST25R95_CMD_LENGTH_OFFSET];
 #if ST25R95_DEBUG
     initialResult = Result;
     initialLen = len;
@@ -500,11 +680,14 @@ ReturnCode st25r95SPICompleteRx(void)
                 st25r95SPIRxTx(NULL, st25r95SPIRxCtx.rxBuf, len);
             }
         }
-        if ((st25r95SPIRxCtx.rmvCRC) && (st25r95SPIRxCtx.protocol != ST25R95_PROTOCOL_ISO18092))
+        /* Read CRC and additional bytes in a single transfer */
+        tailLen = ((st25r95SPIRxCtx.rmvCRC) && (st25r95SPIRxCtx.protocol != ST25R95_PROTOCOL_ISO18092)) ? 2U : 0U;
+        st25r95SPIRxTx(NULL, tail, (tailLen + additionalRespBytesNb));
+        if (tailLen != 0U)
         {
-            st25r95SPIRxTx(NULL, st25r95SPIRxCtx.BufCRC, 2);
+            ST_MEMCPY(st25r95SPIRxCtx.BufCRC, tail, tailLen);
         }
-        st25r95SPIRxTx(NULL, st25r95SPIRxCtx.additionalRespBytes, additionalRespBytesNb);
+        ST_MEMCPY(st25r95SPIRxCtx.additionalRespBytes, &tail[tailLen], additionalRespBytesNb);
      
         /* check collision and CRC error */
         switch (st25r95SPIRxCtx.protocol)
@@ -595,6 +778,8 @@ void st25r95SPIIdle(uint8_t dacDataL, uint8_t dacDataH, uint8_t WUPeriod)
     Idle[ST25R95_IDLE_WUPERIOD_OFFSET] = WUPeriod;
     Idle[ST25R95_IDLE_DACDATAL_OFFSET] = dacDataL;
     Idle[ST25R95_IDLE_DACDATAH_OFFSET] = dacDataH;
+    st25r95ShadowInvalidate();
+    st25r95SPIIrqOutClear();
     platformSpiSelect();
     st25r95SPISendReceiveByte(ST25R95_CONTROL_SEND);
     st25r95SPIRxTx(Idle, NULL, Idle[ST25R95_CMD_LENGTH_OFFSET] + 2);
@@ -610,9 +795,7 @@ void st25r95SPIGetIdleResponse(void)
     uint8_t respBuffer[ST25R95_IDLE_RESPONSE_BUFLEN];
     
     platformSpiSelect();
-    st25r95SPISendReceiveByte(ST25R95_CONTROL_READ);    
-    respBuffer[ST25R95_CMD_RESULT_OFFSET] = st25r95SPISendReceiveByte(ST25R95_SPI_DUMMY_BYTE);
-    respBuffer[ST25R95_CMD_LENGTH_OFFSET] = st25r95SPISendReceiveByte(respBuffer[ST25R95_CMD_RESULT_OFFSET]);
+    st25r95SPIReadHeader(respBuffer);
     if ((sizeof(respBuffer)) >= (respBuffer[ST25R95_CMD_LENGTH_OFFSET] + 2U))
     {
         if (respBuffer[ST25R95_CMD_LENGTH_OFFSET] != 0)
@@ -636,6 +819,7 @@ void st25r95SPIKillIdle(void)
 {
     ReturnCode retCode = ERR_NONE;
     
+    /* nIRQ_OUT edge not cleared: the chip may have woken up on its own, its pending response is then read */
     st25r95SPI_nIRQ_IN_Pulse();
     /* Poll the ST25R95 until it is ready to transmit */
     retCode = st25r95SPIPollRead(ST25R95_CONTROL_POLL_TIMEOUT);
@@ -646,4 +830,37 @@ void st25r95SPIKillIdle(void)
     }
     
 }
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+#if ST25R95_IRQ_OUT_INTERRUPT
+/*******************************************************************************/
+static void st25r95SPIWaitIrqOut(uint32_t timeout)
+{
+    uint32_t timer;
+    
+    timer = platformTimerCreate(timeout);
+    /* Sleep until nIRQ_OUT edge (or the tick interrupt used to check the timer) */
+    while (!st25r95SPIIrqOut && !platformTimerIsExpired(timer))
+    {
+        platformWaitForInterrupt();
+    }
+    platformTimerDestroy(timer);
+}
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
+/*******************************************************************************/
+static void st25r95SPIReadHeader(uint8_t *header)
+{
+    uint8_t buf[ST25R95_CMD_DATA_OFFSET + 1U] = {ST25R95_CONTROL_READ, ST25R95_SPI_DUMMY_BYTE, ST25R95_SPI_DUMMY_BYTE};
+    
+    /* READ control byte followed by result code and length in a single transfer */
+    st25r95SPIRxTx(buf, buf, sizeof(buf));
+    header[ST25R95_CMD_RESULT_OFFSET] = buf[ST25R95_CMD_RESULT_OFFSET + 1U];
+    header[ST25R95_CMD_LENGTH_OFFSET] = buf[ST25R95_CMD_LENGTH_OFFSET + 1U];
+}
 #endif /* ST25R95_INTERFACE_SPI */
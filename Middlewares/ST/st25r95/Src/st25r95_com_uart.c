@@ -95,6 +95,20 @@ typedef struct
     uint16_t PayloadLen;    
 } st25r95UARTRxContext;
 
+#if ST25R95_UART_DMA_RX
+/*
+ * Circular DMA Rx context: response segments are copied straight from the ring
+ */
+typedef struct
+{
+    uint8_t *SegBuf;        /* Destination of the expected segment, NULL: discard */
+    uint16_t SegLen;        /* Bytes still expected in the segment */
+    bool SegPending;        /* A segment is expected */
+    uint16_t RdIdx;         /* Ring read index */
+    bool Started;           /* Circular DMA reception running */
+} st25r95UARTRxDmaContext;
+#endif /* ST25R95_UART_DMA_RX */
+
 /*
 ******************************************************************************
 * GLOBAL MACROS
@@ -103,6 +117,8 @@ typedef struct
 
 #define ST25R95_DEBUG false
 
+#define ST25R95_UART_BATCH_SCRATCH_LEN                   16U    /*!< Buffer used to read out the responses not requested in a batch */
+
 /*
  ******************************************************************************
  * LOCAL VARIABLES
@@ -110,6 +126,10 @@ typedef struct
  */
 
 static uint8_t EchoCommand[1] = {ST25R95_COMMAND_ECHO};
+#ifdef platformUartSetBaudRate
+static uint8_t BaudRateCommand[3] = {ST25R95_COMMAND_BAUDRATE, 0x01, ST25R95_UART_BAUDRATE_CODE_DEFAULT};
+#endif /* platformUartSetBaudRate */
+static uint8_t st25r95UARTBaudRateCode = ST25R95_UART_BAUDRATE_CODE_DEFAULT;
 
 static uint32_t st25r95UARTRwdogTimer;
 static bool st25r95TransmitRxCompleted = true;
@@ -118,6 +138,10 @@ static st25r95UARTRxContext st25r95UARTRxCtx;
 
 static uint8_t Idle[] = {ST25R95_COMMAND_IDLE, 0x0E, 0x12, 0x21, 0x00, 0x38, 0x01, 0x18, 0x00, 0x20, 0x60, 0x60, 0x74, 0x84, 0x3F, 0x00};
 static uint8_t IdleRespBuffer[ST25R95_IDLE_RESPONSE_BUFLEN];
+#if ST25R95_UART_DMA_RX
+static uint8_t st25r95UARTRxRing[ST25R95_UART_DMA_RING_LEN];
+static st25r95UARTRxDmaContext st25r95UARTRxDma;
+#endif /* ST25R95_UART_DMA_RX */
 /*
 ******************************************************************************
 * LOCAL FUNCTION PROTOTYPES
@@ -125,6 +149,13 @@ static uint8_t IdleRespBuffer[ST25R95_IDLE_RESPONSE_BUFLEN];
 */
 
 static void st25r95UartFlush(void);
+static void st25r95UartRxReset(void);
+static void st25r95UartRx(uint8_t *buf, uint16_t len);
+static void st25r95UartRxSegment(uint8_t *buf, uint16_t len);
+#if ST25R95_UART_DMA_RX
+static uint16_t st25r95UartRxDmaAvailable(void);
+static void st25r95UartRxDmaCopy(uint8_t *dst, uint16_t len);
+#endif /* ST25R95_UART_DMA_RX */
 
 /*
 ******************************************************************************
@@ -138,7 +169,7 @@ ReturnCode st25r95UARTSendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_
     ReturnCode retCode = ERR_NONE;
     uint32_t len;
     
-    platformUartReset();
+    st25r95UartRxReset();
     if (respBuffLen < 2)
     {
         retCode = ERR_NOMEM;
@@ -151,7 +182,7 @@ ReturnCode st25r95UARTSendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_
         resp[ST25R95_CMD_RESULT_OFFSET] = ST25R95_ERRCODE_COMERROR;
         resp[ST25R95_CMD_LENGTH_OFFSET] = 0x00;
         platformUartTx(cmd, cmd[ST25R95_CMD_LENGTH_OFFSET] + 2);
-        platformUartRx(resp, 2);
+        st25r95UartRx(resp, 2);
         len = resp[ST25R95_CMD_LENGTH_OFFSET];
         /* compute len according to CR95HF DS  4.4 */
         if ((resp[ST25R95_CMD_RESULT_OFFSET] & 0x8F) == 0x80)
@@ -163,7 +194,7 @@ ReturnCode st25r95UARTSendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_
         {
             if (len != 0)
             {
-                platformUartRx(&resp[ST25R95_CMD_DATA_OFFSET], len);
+                st25r95UartRx(&resp[ST25R95_CMD_DATA_OFFSET], len);
             }
         }
         else
@@ -182,15 +213,96 @@ ReturnCode st25r95UARTSendCommandTypeAndLen(uint8_t *cmd, uint8_t *resp, uint16_
     return (retCode);
 }
 
+/*******************************************************************************/
+ReturnCode st25r95UARTSendCommandBatch(const st25r95BatchCommand *cmds, uint8_t nbCmds, uint8_t *nbDone)
+{
+    ReturnCode retCode = ERR_NONE;
+    uint8_t    scratch[ST25R95_UART_BATCH_SCRATCH_LEN];
+    uint8_t    *resp;
+    uint32_t   len;
+    uint16_t   chunk;
+    uint8_t    i;
+    
+    for (i = 0; i < nbCmds; i++)
+    {
+        resp = (cmds[i].resp != NULL) ? cmds[i].resp : scratch;
+        if ((cmds[i].resp != NULL) && (cmds[i].respBuffLen < ST25R95_CMD_DATA_OFFSET))
+        {
+            retCode = ERR_NOMEM;
+            break;
+        }
+        
+        st25r95UartRxReset();
+        resp[ST25R95_CMD_RESULT_OFFSET] = ST25R95_ERRCODE_COMERROR;
+        resp[ST25R95_CMD_LENGTH_OFFSET] = 0x00;
+        platformUartTx(cmds[i].cmd, cmds[i].cmd[ST25R95_CMD_LENGTH_OFFSET] + 2);
+        st25r95UartRx(resp, 2);
+        if ((resp[ST25R95_CMD_RESULT_OFFSET] == ST25R95_ERRCODE_COMERROR) && (resp[ST25R95_CMD_LENGTH_OFFSET] == 0x00))
+        {
+            /* No response: nothing to drain, the link is resynchronized by the next st25r95UartRxReset() */
+            retCode = ERR_SYSTEM;
+            break;
+        }
+        len = resp[ST25R95_CMD_LENGTH_OFFSET];
+        /* compute len according to CR95HF DS  4.4 */
+        if ((resp[ST25R95_CMD_RESULT_OFFSET] & 0x8F) == 0x80)
+        {
+            len |= (((uint32_t)resp[ST25R95_CMD_RESULT_OFFSET]) & 0x60U) << 3U;
+        }
+        if ((cmds[i].resp != NULL) && (cmds[i].respBuffLen >= (len + 2)))
+        {
+            if (len != 0)
+            {
+                st25r95UartRx(&resp[ST25R95_CMD_DATA_OFFSET], len);
+            }
+        }
+        else
+        {
+            /* Response not requested or not fitting: drain it to keep the link in sync */
+            if (cmds[i].resp != NULL)
+            {
+                retCode = ERR_NOMEM;
+            }
+            while (len != 0)
+            {
+                chunk = (uint16_t)MIN(len, (sizeof(scratch) - ST25R95_CMD_DATA_OFFSET));
+                st25r95UartRx(&scratch[ST25R95_CMD_DATA_OFFSET], chunk);
+                len -= chunk;
+            }
+        }
+        
+        if ((retCode == ERR_NONE) && (resp[ST25R95_CMD_RESULT_OFFSET] != ST25R95_ERRCODE_NONE))
+        {
+            retCode = ERR_PARAM;
+        }
+        if (retCode != ERR_NONE)
+        {
+            break;
+        }
+    }
+    
+    if (nbDone != NULL)
+    {
+        *nbDone = i;
+    }
+#if ST25R95_DEBUG
+    platformLog("[%10d] batch %d/%d commands, retCode: %2.2x\r\n", platformGetSysTick(), i, nbCmds, retCode);
+#endif /* ST25R95_DEBUG */
+    return (retCode);
+}
+
 /*******************************************************************************/
 ReturnCode st25r95UARTCommandEcho(void)
 {
     ReturnCode retCode = ERR_NONE;
     uint8_t respBuffer[1] = {0};
     
-    platformUartReset();
+    /* Echo is used after reset or to exit Listen mode: chip configuration is unknown */
+    st25r95ShadowInvalidate();
+    
+    st25r95UartRxReset();
     platformUartTx(EchoCommand, 1);
-    platformUartRx(respBuffer, 1);
+    st25r95UartRx(respBuffer, 1);
     
     if (respBuffer[0] != EchoCommand[0])
     {
@@ -205,6 +317,53 @@ ReturnCode st25r95UARTCommandEcho(void)
     return (retCode);
 }
 
+/*******************************************************************************/
+ReturnCode st25r95UARTSetBaudRate(uint8_t baudRateCode)
+{
+#ifdef platformUartSetBaudRate
+    BaudRateCommand[ST25R95_CMD_DATA_OFFSET] = baudRateCode;
+    
+    st25r95UartRxReset();
+    platformUartTx(BaudRateCommand, BaudRateCommand[ST25R95_CMD_LENGTH_OFFSET] + 2);
+#if ST25R95_DEBUG
+    platformLog("[%10d] >>>> %s\r\n", platformGetSysTick(), hex2Str(BaudRateCommand, BaudRateCommand[ST25R95_CMD_LENGTH_OFFSET] + 2));
+#endif /* ST25R95_DEBUG */
+    
+    /* The 0x55 answer is discarded: it may be sent at either rate */
+    platformDelay(ST25R95_UART_BAUDRATE_SWITCH_DELAY);
+    return (st25r95UARTSyncBaudRate(baudRateCode));
+#else
+    NO_WARNING(baudRateCode);
+    return (ERR_NOTSUPP);
+#endif /* platformUartSetBaudRate */
+}
+
+/*******************************************************************************/
+ReturnCode st25r95UARTSyncBaudRate(uint8_t baudRateCode)
+{
+#ifdef platformUartSetBaudRate
+    platformUartReset();
+    platformUartSetBaudRate(ST25R95_UART_BAUDRATE(baudRateCode));
+    st25r95UARTBaudRateCode = baudRateCode;
+#if ST25R95_UART_DMA_RX
+    /* Reconfiguring the UART stops the circular DMA: restarted by the next reception */
+    st25r95UARTRxDma.Started    = false;
+    st25r95UARTRxDma.SegPending = false;
+#endif /* ST25R95_UART_DMA_RX */
+    st25r95UartRxReset();
+    return (ERR_NONE);
+#else
+    NO_WARNING(baudRateCode);
+    return (ERR_NOTSUPP);
+#endif /* platformUartSetBaudRate */
+}
+
+/*******************************************************************************/
+uint8_t st25r95UARTGetBaudRateCode(void)
+{
+    return (st25r95UARTBaudRateCode);
+}
+
 /*******************************************************************************/
 void st25r95UARTSendData(uint8_t *buf, uint8_t bufLen, uint8_t protocol, uint32_t flags)
 {
@@ -260,7 +419,7 @@ void st25r95UARTSendTransmitFlag(uint8_t protocol, uint8_t transmitFlag)
 /*******************************************************************************/
 void st25r95UARTPrepareRx(uint8_t protocol, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxRcvdLen, uint32_t flags, uint8_t *additionalRespBytes)
 {
-    platformUartReset();
+    st25r95UartRxReset();
     st25r95UARTRwdogTimer = platformTimerCreate(ST25R95_COMMUNICATION_UART_WDOGTIMER);
     st25r95UARTRxCtx.ResultAndLen[ST25R95_CMD_RESULT_OFFSET] = ST25R95_ERRCODE_COMERROR;
     st25r95UARTRxCtx.ResultAndLen[ST25R95_CMD_LENGTH_OFFSET] = 0x00U;
@@ -274,7 +433,7 @@ void st25r95UARTPrepareRx(uint8_t protocol, uint8_t *rxBuf, uint16_t rxBufLen, u
     st25r95UARTRxCtx.additionalRespBytes = additionalRespBytes;
     st25r95UARTRxCtx.RxState             = ST25R95_CB_RESLEN;
     st25r95UARTRxCtx.InIdle              = false;
-    platformUartRxIT(st25r95UARTRxCtx.ResultAndLen, 2);
+    st25r95UartRxSegment(st25r95UARTRxCtx.ResultAndLen, 2);
 }
 
 /*******************************************************************************/
@@ -282,9 +441,15 @@ static void st25r95UartFlush(void)
 {
     if (st25r95UARTRxCtx.DataLen != 0)
     {
-        st25r95UARTRxCtx.DataLen--;
         st25r95UARTRxCtx.RxState = ST25R95_CB_FLUSHUART;
-        platformUartRxIT(&st25r95UARTRxCtx.flushBuf, 1);
+#if ST25R95_UART_DMA_RX
+        /* Discard the remaining bytes at once */
+        st25r95UartRxSegment(NULL, st25r95UARTRxCtx.DataLen);
+        st25r95UARTRxCtx.DataLen = 0;
+#else
+        st25r95UARTRxCtx.DataLen--;
+        st25r95UartRxSegment(&st25r95UARTRxCtx.flushBuf, 1);
+#endif /* ST25R95_UART_DMA_RX */
     }
     else
     {
@@ -435,7 +600,7 @@ void st25r95UartRxCpltCallback(void)
                 if (st25r95UARTRxCtx.protocol == ST25R95_PROTOCOL_ISO18092)
                 {
                     /* Len is not part of the payload in ST25R95 ISO18092: keep room for 1 byte and read the payload */
-                    platformUartRxIT(&st25r95UARTRxCtx.rxBuf[RFAL_NFCF_LENGTH_LEN], len);
+                    st25r95UartRxSegment(&st25r95UARTRxCtx.rxBuf[RFAL_NFCF_LENGTH_LEN], len);
                     len += RFAL_NFCF_LENGTH_LEN;
                     /* Prepend Len in the rxbuf*/
                     st25r95UARTRxCtx.rxBuf[0] = (uint8_t)(len & 0xFFU);
@@ -460,7 +625,7 @@ void st25r95UartRxCpltCallback(void)
                             st25r95UARTRxCtx.RxState = ST25R95_CB_SOD;
                             len -= 1;
                             st25r95UARTRxCtx.PayloadLen = len;
-                            platformUartRxIT(st25r95UARTRxCtx.NFCIP1_SoD, 1);   
+                            st25r95UartRxSegment(st25r95UARTRxCtx.NFCIP1_SoD, 1);   
                         }
                         else
                         {
@@ -472,7 +637,7 @@ void st25r95UartRxCpltCallback(void)
                     else
                     {
                         /* Read data payload */
-                        platformUartRxIT(st25r95UARTRxCtx.rxBuf, len);
+                        st25r95UartRxSegment(st25r95UARTRxCtx.rxBuf, len);
                     }
                 }
                 break;
@@ -483,7 +648,7 @@ void st25r95UartRxCpltCallback(void)
             {
                 /* Read the CRC*/
                 st25r95UARTRxCtx.RxState = ST25R95_CB_CRC;
-                platformUartRxIT(st25r95UARTRxCtx.BufCRC, 2);
+                st25r95UartRxSegment(st25r95UARTRxCtx.BufCRC, 2);
                 break;
             }
             if ((!st25r95UARTRxCtx.rmvCRC) && (st25r95UARTRxCtx.protocol == ST25R95_PROTOCOL_ISO18092) && ((st25r95UARTRxCtx.rxRcvdLen != NULL)))
@@ -495,7 +660,7 @@ void st25r95UartRxCpltCallback(void)
         case ST25R95_CB_CRC: /*  CRC received*/
             /* Read the Rx Flag additional bytes */
             st25r95UARTRxCtx.RxState = ST25R95_CB_ADDITIONALBYTES;
-            platformUartRxIT(st25r95UARTRxCtx.additionalRespBytes, additionalRespBytesNb);
+            st25r95UartRxSegment(st25r95UARTRxCtx.additionalRespBytes, additionalRespBytesNb);
             break;
         case ST25R95_CB_ADDITIONALBYTES: /* Rx flags received */
             /* check collision and CRC error */
@@ -530,7 +695,7 @@ void st25r95UartRxCpltCallback(void)
             break;   
         case ST25R95_CB_SOD: /* SoD_SB received */
             st25r95UARTRxCtx.RxState = ST25R95_CB_DATA;
-            platformUartRxIT(st25r95UARTRxCtx.rxBuf, st25r95UARTRxCtx.PayloadLen);
+            st25r95UartRxSegment(st25r95UARTRxCtx.rxBuf, st25r95UARTRxCtx.PayloadLen);
             break;
         default:
             st25r95UARTRxCtx.retCode = ERR_SYSTEM;
@@ -546,6 +711,38 @@ void st25r95UartErrorCallback(void)
     st25r95UARTRxCtx.retCode = ERR_SYSTEM;
     st25r95TransmitRxCompleted = true;
     st25r95TransmitTxCompleted = true;
+#if ST25R95_UART_DMA_RX
+    /* Reception is aborted on errors: restart it on next command */
+    st25r95UARTRxDma.SegPending = false;
+    st25r95UARTRxDma.Started    = false;
+#endif /* ST25R95_UART_DMA_RX */
+}
+
+/*******************************************************************************/
+void st25r95UartRxEventCallback(void)
+{
+#if ST25R95_UART_DMA_RX
+    uint16_t len;
+    
+    /* Copy what is available for the expected segment, and chain the next segments */
+    while (st25r95UARTRxDma.SegPending)
+    {
+        len = MIN(st25r95UartRxDmaAvailable(), st25r95UARTRxDma.SegLen);
+        st25r95UartRxDmaCopy(st25r95UARTRxDma.SegBuf, len);
+        if (st25r95UARTRxDma.SegBuf != NULL)
+        {
+            st25r95UARTRxDma.SegBuf += len;
+        }
+        st25r95UARTRxDma.SegLen -= len;
+        if (st25r95UARTRxDma.SegLen != 0U)
+        {
+            /* Wait for more bytes */
+            break;
+        }
+        st25r95UARTRxDma.SegPending = false;
+        st25r95UartRxCpltCallback();
+    }
+#endif /* ST25R95_UART_DMA_RX */
 }
 
 /*******************************************************************************/
@@ -605,13 +802,14 @@ void st25r95UARTIdle(uint8_t dacDataL, uint8_t dacDataH, uint8_t WUPeriod)
     Idle[ST25R95_IDLE_WUPERIOD_OFFSET] = WUPeriod;
     Idle[ST25R95_IDLE_DACDATAL_OFFSET] = dacDataL;
     Idle[ST25R95_IDLE_DACDATAH_OFFSET] = dacDataH;
+    st25r95ShadowInvalidate();
     
     IdleRespBuffer[ST25R95_CMD_RESULT_OFFSET] = ST25R95_ERRCODE_COMERROR;
     IdleRespBuffer[ST25R95_CMD_LENGTH_OFFSET] = 0x00;
     st25r95UARTRxCtx.InIdle    = true;
     st25r95TransmitRxCompleted = false;
+    st25r95UartRxSegment(IdleRespBuffer, 3);
     platformUartTx(Idle, Idle[ST25R95_CMD_LENGTH_OFFSET] + 2);
-    platformUartRxIT(IdleRespBuffer, 3);
     
     #if ST25R95_DEBUG
     platformLog("[%10d] >>>> %s\r\n", platformGetSysTick(), hex2Str(Idle, Idle[ST25R95_CMD_LENGTH_OFFSET] + 2));
@@ -642,5 +840,92 @@ void st25r95UARTKillIdle(void)
     }
     st25r95UARTGetIdleResponse();
 }
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static void st25r95UartRxReset(void)
+{
+#if ST25R95_UART_DMA_RX
+    /* Keep the circular reception running: drop the pending bytes and segment */
+    st25r95UARTRxDma.SegPending = false;
+    if (!st25r95UARTRxDma.Started)
+    {
+        platformUartReset();
+        platformUartRxDmaStart(st25r95UARTRxRing, ST25R95_UART_DMA_RING_LEN);
+        st25r95UARTRxDma.Started = true;
+    }
+    st25r95UARTRxDma.RdIdx = (uint16_t)((ST25R95_UART_DMA_RING_LEN - platformUartRxDmaRemaining()) % ST25R95_UART_DMA_RING_LEN);
+#else
+    platformUartReset();
+#endif /* ST25R95_UART_DMA_RX */
+}
+
+/*******************************************************************************/
+static void st25r95UartRx(uint8_t *buf, uint16_t len)
+{
+#if ST25R95_UART_DMA_RX
+    uint32_t timer;
+    
+    timer = platformTimerCreate(ST25R95_UART_DMA_RX_TIMEOUT);
+    while ((st25r95UartRxDmaAvailable() < len) && !platformTimerIsExpired(timer)) {;}
+    platformTimerDestroy(timer);
+    
+    /* On timeout the caller detects the missing bytes from its preset response */
+    if (st25r95UartRxDmaAvailable() >= len)
+    {
+        st25r95UartRxDmaCopy(buf, len);
+    }
+#else
+    platformUartRx(buf, len);
+#endif /* ST25R95_UART_DMA_RX */
+}
+
+/*******************************************************************************/
+static void st25r95UartRxSegment(uint8_t *buf, uint16_t len)
+{
+#if ST25R95_UART_DMA_RX
+    /* Only record the segment: st25r95UartRxEventCallback() fills it from the ring */
+    st25r95UARTRxDma.SegBuf     = buf;
+    st25r95UARTRxDma.SegLen     = len;
+    st25r95UARTRxDma.SegPending = true;
+#else
+    platformUartRxIT(buf, len);
+#endif /* ST25R95_UART_DMA_RX */
+}
+
+#if ST25R95_UART_DMA_RX
+/*******************************************************************************/
+static uint16_t st25r95UartRxDmaAvailable(void)
+{
+    uint16_t wrIdx;
+    
+    wrIdx = (uint16_t)((ST25R95_UART_DMA_RING_LEN - platformUartRxDmaRemaining()) % ST25R95_UART_DMA_RING_LEN);
+    return ((uint16_t)((wrIdx + ST25R95_UART_DMA_RING_LEN - st25r95UARTRxDma.RdIdx) % ST25R95_UART_DMA_RING_LEN));
+}
+
+/*******************************************************************************/
+static void st25r95UartRxDmaCopy(uint8_t *dst, uint16_t len)
+{
+    uint16_t chunkLen;
+    
+    /* At most two chunks: up to the end of the ring, then from its start */
+    while (len != 0U)
+    {
+        chunkLen = MIN(len, (uint16_t)(ST25R95_UART_DMA_RING_LEN - st25r95UARTRxDma.RdIdx));
+        if (dst != NULL)
+        {
+            ST_MEMCPY(dst, &st25r95UARTRxRing[st25r95UARTRxDma.RdIdx], chunkLen);
+            dst += chunkLen;
+        }
+        st25r95UARTRxDma.RdIdx = (uint16_t)((st25r95UARTRxDma.RdIdx + chunkLen) % ST25R95_UART_DMA_RING_LEN);
+        len -= chunkLen;
+    }
+}
+#endif /* ST25R95_UART_DMA_RX */
 #endif /* ST25R95_INTERFACE_UART */
 
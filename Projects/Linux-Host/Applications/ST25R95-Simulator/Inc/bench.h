@@ -0,0 +1,491 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench.h
+ *
+ *  \author
+ *
+ *  \brief Benchmarks of the ST25R95 simulator
+ *
+ *  The benchmarks are run by main.c in place of the polling demo, selected
+ *  by the second command line argument. They are split per area:
+ *   - bench_rf.c: discovery, anticollision, ISO-DEP and ST25R95 interface
+ *   - bench_ndef_message.c: NDEF message decoding and encoding
+ *   - bench_ndef_poller.c: NDEF detection, read and write on the simulated tags
+ *
+ *  and share the simulated tags of bench_tags.c.
+ *
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "platform.h"
+#include "rfal_nfc.h"
+#include "ndef_poller.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define BENCH_NFCV_BLOCK_LEN             4U      /*!< Simulated tag block length           */
+#define BENCH_NFCV_BLOCK_NUM             256U    /*!< Simulated tag number of blocks       */
+#define BENCH_NFCV_UID_LEN               8U      /*!< UID length                           */
+
+#define BENCH_NFCV_FLAG_INVENTORY        0x04U   /*!< Request flag: inventory              */
+#define BENCH_NFCV_FLAG_ADDRESS          0x20U   /*!< Request flag: addressed (non inventory requests) */
+#define BENCH_NFCV_CMD_INVENTORY         0x01U   /*!< Inventory command                    */
+#define BENCH_NFCV_CMD_READ_SINGLE_BLOCK 0x20U   /*!< Read Single Block command            */
+#define BENCH_NFCV_CMD_WRITE_SINGLE_BLOCK 0x21U  /*!< Write Single Block command           */
+
+#define BENCH_NFCA_UID_LEN               4U      /*!< Simulated NFC-A tag UID length (single size) */
+#define BENCH_NFCA_SEL_CL1               0x93U   /*!< SDD_REQ/SEL_REQ cascade level 1      */
+#define BENCH_NFCA_NVB_SEL               0x70U   /*!< NVB of SEL_REQ: full UID sent        */
+#define BENCH_NFCA_SHORT_FRAME_BITS      0x07U   /*!< Transmission flag bits of a short frame */
+#define BENCH_T2T_PAGE_LEN               4U      /*!< Simulated T2T page length            */
+#define BENCH_T2T_PAGE_NUM               512U    /*!< Simulated T2T number of pages: 2 sectors */
+
+#define BENCH_STREAM_MSG_BUF_LEN         1024U   /*!< Stream benchmark NDEF message buffer                   */
+
+#define BENCH_NFCV_CMD_READ_MULTIPLE_BLOCKS 0x23U /*!< Read Multiple Blocks command                          */
+
+/*
+******************************************************************************
+* GLOBAL VARIABLES
+******************************************************************************
+*/
+
+extern const uint8_t benchNfcvUID[BENCH_NFCV_UID_LEN]; /*!< LSB first */
+extern uint8_t benchNfcvMem[BENCH_NFCV_BLOCK_NUM][BENCH_NFCV_BLOCK_LEN];
+extern uint16_t benchNfcvWriteCnt[BENCH_NFCV_BLOCK_NUM]; /*!< Writes of each block of the simulated tag */
+extern uint32_t benchNfcvReadCnt;                        /*!< Blocks read from the simulated tag        */
+extern uint8_t  benchNfcvChunkFail;                      /*!< Multiple blocks requests until the one rejected, 0: none */
+extern bool     benchNfcvWrMultiple;                     /*!< (Extended) Write Multiple Blocks supported by the simulated tag */
+
+extern const uint8_t benchNfcaUID[BENCH_NFCA_UID_LEN];
+extern uint8_t  benchNfcaMem[BENCH_T2T_PAGE_NUM][BENCH_T2T_PAGE_LEN];
+extern bool     benchNfcaFastRead;                       /*!< FAST_READ supported by the simulated NFC-A tag     */
+extern uint32_t benchNfcaReadCnt;                        /*!< READ commands answered                             */
+extern uint32_t benchNfcaFastReadCnt;                    /*!< FAST_READ commands answered                        */
+extern uint32_t benchNfcaNakCnt;                         /*!< NAKs sent                                          */
+extern uint32_t benchNfcaSelCnt;                         /*!< Selections (SEL_REQ answered)                      */
+extern uint32_t benchNfcaSectorCnt;                      /*!< Sectors selected                                   */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Set the discovery parameters of the benchmarks
+ *
+ * All technologies, single device, BENCH_DISC_DURATION discovery duration.
+ *
+ * \param[out] disc : discovery parameters
+ *
+ *****************************************************************************
+ */
+void benchDiscParam( rfalNfcDiscoverParam *disc );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Activate a simulated tag and detect its NDEF
+ *
+ * Places the tag of the given handler in the field of the first reader, runs
+ * the discovery until it is activated and initializes the NDEF context.
+ *
+ * \param[out] ctx     : NDEF context of the activated tag
+ * \param[in]  handler : tag handler of the simulated tag
+ *
+ * \return ERR_TIMEOUT : tag not activated within BENCH_DISC_DURATION
+ * \return ERR_NONE    : NDEF detected, otherwise the RFAL or NDEF error
+ *
+ *****************************************************************************
+ */
+ReturnCode benchNdefDetect( ndefContext *ctx, st25r95SimTagHandler handler );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Simulated NFC-A tag: single size UID, T2T READ, FAST_READ and SECTOR SELECT
+ *
+ * Tag handler, see st25r95SimTagHandler.
+ *
+ *****************************************************************************
+ */
+void benchNfcaTag( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Simulated NFC-B tag without ISO-DEP
+ *
+ * Tag handler, see st25r95SimTagHandler.
+ *
+ *****************************************************************************
+ */
+void benchNfcbTag( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Simulated NFC-V tag holding benchNfcvMem
+ *
+ * Tag handler, see st25r95SimTagHandler.
+ *
+ *****************************************************************************
+ */
+void benchNfcvTag( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the multiple readers benchmark
+ *
+ * \param[in] duration : simulated duration (ms)
+ * \param[in] readers  : number of simulated readers, 1..RFAL_FEATURE_MAX_INSTANCES
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchReaderBenchmark( uint32_t duration, uint8_t readers );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the tag mix benchmark
+ *
+ * \param[in] duration : simulated duration (ms) of each polling mode
+ * \param[in] mixStr   : NFC-A, NFC-B and NFC-V percentages, comma separated
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchMixBenchmark( uint32_t duration, const char *mixStr );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the inventory benchmark
+ *
+ * \param[in] duration : simulated duration (ms) per population
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchInventoryBenchmark( uint32_t duration );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the broadcast write benchmark
+ *
+ * \param[in] duration : simulated duration (ms) per population
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchBroadcastBenchmark( uint32_t duration );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the anticollision benchmark
+ *
+ * \param[in] duration : simulated duration (ms) per stack
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchAnticollBenchmark( uint32_t duration );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the ISO-DEP benchmark
+ *
+ * \param[in] duration : simulated duration (ms) per card
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchIsoDepBenchmark( uint32_t duration );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the worker benchmark
+ *
+ * \param[in] duration : simulated duration (ms) per worker budget
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchWorkerBenchmark( uint32_t duration );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the nIRQ_OUT interrupt test
+ *
+ * \param[in] duration : simulated duration (ms) per SendRecv latency
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchIrqBenchmark( uint32_t duration );
+
+
+#if ST25R95_IRQ_OUT_INTERRUPT
+/*!
+ *****************************************************************************
+ * \brief  nIRQ_OUT interrupt handler: counts the edge and calls st25r95Isr()
+ *
+ * \param[in] chip : simulated chip whose response became available
+ *
+ *****************************************************************************
+ */
+void benchIrqOutIsr( uint8_t chip );
+
+
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the UART test
+ *
+ * \param[in] duration : simulated duration (ms) per largest fragment length
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchUartBenchmark( uint32_t duration );
+
+
+#if ST25R95_INTERFACE_UART
+/*!
+ *****************************************************************************
+ * \brief  UART reception event handler: counts the event and calls
+ *         st25r95UartRxEventCallback()
+ *
+ *****************************************************************************
+ */
+void benchUartRxEvent( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  UART transmission complete handler: counts the event and calls
+ *         st25r95UartTxCpltCallback()
+ *
+ *****************************************************************************
+ */
+void benchUartTxCplt( void );
+
+
+#endif /* ST25R95_INTERFACE_UART */
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the SPI transfer count
+ *
+ * \param[in] exchanges : exchanges per Read Multiple Blocks length
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchSpiBenchmark( uint32_t exchanges );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the analog configuration benchmark
+ *
+ * \param[in] rounds : lookup rounds
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchAnalogBenchmark( uint32_t rounds );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the arena benchmark
+ *
+ * \param[in] count : number of messages decoded
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchArenaBenchmark( uint32_t count );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the append benchmark
+ *
+ * \param[in] count : records appended per message size
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchAppendBenchmark( uint32_t count );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the stream benchmark
+ *
+ * \param[in] chunkLen : length of the chunks fed to the message stream
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchStreamBenchmark( uint32_t chunkLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the re-tap benchmark
+ *
+ * \param[in] duration : simulated duration (ms) with and without cache
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchRetapBenchmark( uint32_t duration );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the read benchmark
+ *
+ * \param[in] msgLen : NDEF message length
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchReadBenchmark( uint32_t msgLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the multiple blocks write benchmark
+ *
+ * \param[in] msgLen : NDEF message length
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchMultiWriteBenchmark( uint32_t msgLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the T2T read benchmark
+ *
+ * \param[in] msgLen : NDEF message length
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchT2TReadBenchmark( uint32_t msgLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the write benchmark
+ *
+ * \param[in] payloadLen : media record payload length
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchWriteBenchmark( uint32_t payloadLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Run the rewrite benchmark
+ *
+ * \param[in] payloadLen : media record payload length
+ *
+ * \return EXIT_SUCCESS : benchmark run
+ * \return EXIT_FAILURE : invalid parameter, error or verification failed
+ *
+ *****************************************************************************
+ */
+int benchRewriteBenchmark( uint32_t payloadLen );
+
+
+#endif /* BENCH_H */
@@ -0,0 +1,215 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file platform.h
+ *
+ *  \author
+ *
+ *  \brief Platform specific definition layer for Linux host builds
+ *
+ *  Maps the platform abstraction used by the ST25R95 driver, RFAL and NDEF
+ *  layers onto the ST25R95 simulator (see st25r95_sim.h):
+ *   - SPI transfers and the nSS/nIRQ_IN/nIRQ_OUT lines are handled by the
+ *     simulated chip
+ *   - timers, delays and the system tick run on the simulated clock so that
+ *     the RF stack timings are reproducible and independent of the host load
+ *
+ *  The SPI interface is simulated by default. With ST25R95_INTERFACE_UART
+ *  set to true the simulated chip is reached through a UART link instead,
+ *  whose reception runs on a simulated circular DMA buffer
+ *  (ST25R95_UART_DMA_RX).
+ *
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "st_errno.h"
+#include "st25r95_sim.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+/* One simulated chip per RFAL instance: its pins are on port ST25R95_SIM_PORT + instance */
+#define ST25R95_N_SS_PIN             ST25R95_SIM_PIN_N_SS      /*!< GPIO pin used for ST25R95 SPI SS              */
+#define ST25R95_N_SS_PORT            (ST25R95_SIM_PORT + rfalInstanceIdx())  /*!< GPIO port used for ST25R95 SPI SS port */
+
+#define ST25R95_N_IRQ_OUT_PIN        ST25R95_SIM_PIN_N_IRQ_OUT /*!< GPIO pin used for ST25R95 nIRQ_OUT            */
+#define ST25R95_N_IRQ_OUT_PORT       (ST25R95_SIM_PORT + rfalInstanceIdx())  /*!< GPIO port used for ST25R95 nIRQ_OUT */
+#define ST25R95_N_IRQ_IN_PIN         ST25R95_SIM_PIN_N_IRQ_IN  /*!< GPIO pin used for ST25R95 nIRQ_OIN            */
+#define ST25R95_N_IRQ_IN_PORT        (ST25R95_SIM_PORT + rfalInstanceIdx())  /*!< GPIO port used for ST25R95 nIRQ_OUT */
+
+#define PLATFORM_LED_A_PIN           ST25R95_SIM_PIN_LED       /*!< LED A is not used (dummy)     */
+#define PLATFORM_LED_A_PORT          ST25R95_SIM_PORT_NONE     /*!< LED A is not used (dummy)     */
+#define PLATFORM_LED_B_PIN           ST25R95_SIM_PIN_LED       /*!< LED B is not used (dummy)     */
+#define PLATFORM_LED_B_PORT          ST25R95_SIM_PORT_NONE     /*!< LED B is not used (dummy)     */
+#define PLATFORM_LED_F_PIN           ST25R95_SIM_PIN_LED       /*!< LED F is not used (dummy)     */
+#define PLATFORM_LED_F_PORT          ST25R95_SIM_PORT_NONE     /*!< LED F is not used (dummy)     */
+#define PLATFORM_LED_V_PIN           ST25R95_SIM_PIN_LED       /*!< LED V is not used (dummy)     */
+#define PLATFORM_LED_V_PORT          ST25R95_SIM_PORT_NONE     /*!< LED V is not used (dummy)     */
+#define PLATFORM_LED_AP2P_PIN        ST25R95_SIM_PIN_LED       /*!< LED AP2P is not used (dummy)  */
+#define PLATFORM_LED_AP2P_PORT       ST25R95_SIM_PORT_NONE     /*!< LED AP2P is not used (dummy)  */
+#define PLATFORM_LED_FIELD_PIN       ST25R95_SIM_PIN_LED       /*!< LED Field is not used (dummy) */
+#define PLATFORM_LED_FIELD_PORT      ST25R95_SIM_PORT_NONE     /*!< LED Field is not used (dummy) */
+
+#define ST25R95_TAGDETECT_DEF_CALIBRATION 0x7C             /*!< Tag Detection Calibration default value                    */
+#define ST25R95_TAGDETECT_CALIBRATE       true             /*!< False: use default value, True: call calibration procedure */
+#ifndef ST25R95_SPI_BURST
+#define ST25R95_SPI_BURST                 true             /*!< False: one SPI transfer per byte, True: multi-byte SPI transfers   */
+#endif /* ST25R95_SPI_BURST */
+#ifndef ST25R95_IRQ_OUT_INTERRUPT
+#define ST25R95_IRQ_OUT_INTERRUPT         false            /*!< False: nIRQ_OUT GPIO polled, True: simulated nIRQ_OUT edges routed to st25r95Isr() (single reader) */
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+#ifndef ST25R95_INTERFACE_UART
+#define ST25R95_INTERFACE_UART            false            /*!< False: SPI link, True: simulated UART link (single reader)                   */
+#endif /* ST25R95_INTERFACE_UART */
+#define ST25R95_UART_DMA_RX               true             /*!< False: UART Rx interrupt per response segment, True: UART circular DMA Rx with idle line events routed to st25r95UartRxEventCallback() */
+
+/*
+******************************************************************************
+* GLOBAL MACROS
+******************************************************************************
+*/
+#define platformProtectST25RComm()                         /* Single threaded host: nothing to protect */
+#define platformUnprotectST25RComm()                       /* Single threaded host: nothing to protect */
+
+#define platformProtectST25RIrqStatus()                    /* Single threaded host: nothing to protect */
+#define platformUnprotectST25RIrqStatus()                  /* Single threaded host: nothing to protect */
+
+#define platformProtectWorker()                            /* Protect RFAL Worker/Task/Process from concurrent execution on multi thread platforms   */
+#define platformUnprotectWorker()                          /* Unprotect RFAL Worker/Task/Process from concurrent execution on multi thread platforms */
+
+#define platformLedsInitialize()                                                                                         /*!< Initializes the pins used as LEDs to outputs*/
+
+#define platformLedOff( port, pin )                   platformGpioClear(port, pin)                                       /*!< Turns the given LED Off                     */
+#define platformLedOn( port, pin )                    platformGpioSet(port, pin)                                         /*!< Turns the given LED On                      */
+#define platformLedToogle( port, pin )                platformGpioToogle(port, pin)                                      /*!< Toogle the given LED                        */
+
+#define platformGpioSet(port, pin)                    st25r95SimGpioWrite((port), (pin), true)                           /*!< Turns the given GPIO High                   */
+#define platformGpioClear(port, pin)                  st25r95SimGpioWrite((port), (pin), false)                          /*!< Turns the given GPIO Low                    */
+#define platformGpioToogle(port, pin)                 st25r95SimGpioWrite((port), (pin), !st25r95SimGpioRead((port), (pin))) /*!< Toogles the given GPIO                  */
+#define platformGpioIsHigh(port, pin)                 st25r95SimGpioRead((port), (pin))                                  /*!< Checks if the given LED is High             */
+#define platformGpioIsLow(port, pin)                  (!platformGpioIsHigh((port), (pin)))                               /*!< Checks if the given LED is Low              */
+
+#define platformTimerCreate(t)                        st25r95SimTimerCreate(t)                                           /*!< Create a timer with the given time (ms)     */
+#define platformTimerIsExpired(timer)                 st25r95SimTimerIsExpired(timer)                                    /*!< Checks if the given timer is expired        */
+#define platformTimerDestroy( timer )                                                               /*!< Stop and release the given timer            */
+#define platformDelay(t)                              st25r95SimDelay(t)                                                 /*!< Performs a delay for the given time (ms)    */
+#define platformWaitForInterrupt()                    st25r95SimWaitForInterrupt()                                       /*!< Wait (sleep) until next interrupt           */
+
+#define platformGetSysTick()                          st25r95SimGetTick()                                                /*!< Get System Tick ( 1 tick = 1 ms)            */
+#if ST25R95_IRQ_OUT_INTERRUPT
+#define platformGetWorkerTime()                       st25r95SimGetWorkerTime()                                          /*!< Get worker time base (1 unit = 1 us), spending a polling step: advances the clock of the loops spinning on rfalWorker() */
+#else
+#define platformGetWorkerTime()                       st25r95SimGetTimeUs()                                              /*!< Get worker time base (1 unit = 1 us)        */
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
+#define platformErrorHandle()                         abort()                                                            /*!< Global error handler or trap                 */
+
+#define platformSpiSelect()                           platformGpioClear(ST25R95_N_SS_PORT, ST25R95_N_SS_PIN)             /*!< SPI SS\CS: Chip|Slave Select                */
+#define platformSpiDeselect()                         platformGpioSet(ST25R95_N_SS_PORT, ST25R95_N_SS_PIN)               /*!< SPI SS\CS: Chip|Slave Deselect              */
+#define platformSpiTxRx(txBuf, rxBuf, len)            st25r95SimSpiTxRx((txBuf), (rxBuf), (len))                         /*!< SPI transceive                              */
+#define platformSpiTx(txBuf, len)                     st25r95SimSpiTxRx((txBuf), NULL, (len))                            /*!< SPI transmit only, received bytes discarded */
+#define platformUartTx(TxBuf, len)                    st25r95SimUartTx((TxBuf), (len))                                   /*!< UART transceive                             */
+#define platformUartTxIT(TxBuf, len)                  st25r95SimUartTxIT((TxBuf), (len))                                 /*!< UART transceive                             */
+#define platformUartReset()                           st25r95SimUartReset()                                              /*!< UART abort Tx/Rx and reset uart             */
+#define platformUartRxDmaStart(RxBuf, len)            st25r95SimUartRxDmaStart((RxBuf), (len))                           /*!< UART circular DMA reception start           */
+#define platformUartRxDmaRemaining()                  st25r95SimUartRxDmaRemaining()                                     /*!< UART DMA reception remaining count          */
+
+#define platformLog(...)                              printf(__VA_ARGS__)                                                /*!< Log  method                                 */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+extern char* hex2Str(unsigned char * data, size_t dataLen);  /* Hex dump helper provided per platform - instantiated in main.c */
+
+/*
+******************************************************************************
+* RFAL FEATURES CONFIGURATION
+******************************************************************************
+*/
+
+#define RFAL_FEATURE_LISTEN_MODE               false      /*!< Enable/Disable RFAL support for Listen Mode                               */
+#define RFAL_FEATURE_WAKEUP_MODE               true       /*!< Enable/Disable RFAL support for the Wake-Up mode                          */
+#define RFAL_FEATURE_LOWPOWER_MODE             false      /*!< Enable/Disable RFAL support for the Low Power mode                        */
+#define RFAL_FEATURE_BOUNDED_WORKER            true       /*!< Enable/Disable one chip access per rfalWorker() call and worker time stats */
+#define RFAL_FEATURE_ASYNC_TRANSCEIVE          true       /*!< Enable/Disable RFAL support for asynchronous/queued transceives           */
+#define RFAL_FEATURE_NFC_ADAPTIVE_POLL         true       /*!< Enable/Disable adaptive technology ordering of the NFC discovery loop     */
+#define RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY   true       /*!< Enable/Disable adaptive slot count of the NFC-V inventory                 */
+#define RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION true  /*!< Enable/Disable NFC-A collision resolution resuming from recorded NFCID1 prefixes */
+#define RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION        true  /*!< Enable/Disable ISO-DEP bit rate selection from the errors seen on previous exchanges */
+#if ST25R95_IRQ_OUT_INTERRUPT || ST25R95_INTERFACE_UART
+#define RFAL_FEATURE_MAX_INSTANCES             1U         /*!< nIRQ_OUT interrupt and UART link are supported on a single ST25R95        */
+#else
+#define RFAL_FEATURE_MAX_INSTANCES             ST25R95_SIM_MAX_CHIPS /*!< Number of ST25R95 driven by RFAL, selected with rfalSelectInstance() */
+#endif /* ST25R95_IRQ_OUT_INTERRUPT || ST25R95_INTERFACE_UART */
+#define RFAL_FEATURE_NFCA                      true       /*!< Enable/Disable RFAL support for NFC-A (ISO14443A)                         */
+#define RFAL_FEATURE_NFCB                      true       /*!< Enable/Disable RFAL support for NFC-B (ISO14443B)                         */
+#define RFAL_FEATURE_NFCF                      true       /*!< Enable/Disable RFAL support for NFC-F (FeliCa)                            */
+#define RFAL_FEATURE_NFCV                      true       /*!< Enable/Disable RFAL support for NFC-V (ISO15693)                          */
+#define RFAL_FEATURE_T1T                       true       /*!< Enable/Disable RFAL support for T1T (Topaz)                               */
+#define RFAL_FEATURE_T2T                       true       /*!< Enable/Disable RFAL support for T2T                                       */
+#define RFAL_FEATURE_T4T                       true       /*!< Enable/Disable RFAL support for T4T                                       */
+#define RFAL_FEATURE_ST25TB                    true       /*!< Enable/Disable RFAL support for ST25TB                                    */
+#define RFAL_FEATURE_ST25xV                    true       /*!< Enable/Disable RFAL support for ST25TV/ST25DV                             */
+#define RFAL_FEATURE_DYNAMIC_ANALOG_CONFIG     true       /*!< Enable/Disable Analog Configs to be dynamically updated (RAM)             */
+#define RFAL_FEATURE_DPO                       false      /*!< Enable/Disable RFAL Dynamic Power Output support                          */
+#define RFAL_FEATURE_ISO_DEP                   true       /*!< Enable/Disable RFAL support for ISO-DEP (ISO14443-4)                      */
+#define RFAL_FEATURE_ISO_DEP_POLL              true       /*!< Enable/Disable RFAL support for Poller mode (PCD) ISO-DEP (ISO14443-4)    */
+#define RFAL_FEATURE_ISO_DEP_LISTEN            false      /*!< Enable/Disable RFAL support for Listen mode (PICC) ISO-DEP (ISO14443-4)   */
+#define RFAL_FEATURE_NFC_DEP                   true       /*!< Enable/Disable RFAL support for NFC-DEP (NFCIP1/P2P)                      */
+
+#define RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN    256U       /*!< ISO-DEP I-Block max length. Please use values as defined by rfalIsoDepFSx */
+#define RFAL_FEATURE_NFC_DEP_BLOCK_MAX_LEN     254U       /*!< NFC-DEP Block/Payload length. Allowed values: 64, 128, 192, 254           */
+#define RFAL_FEATURE_NFC_RF_BUF_LEN            258U       /*!< RF buffer length used by RFAL NFC layer                                   */
+
+#define RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN      512U       /*!< ISO-DEP APDU max length. Please use multiples of I-Block max length       */
+#define RFAL_FEATURE_NFC_DEP_PDU_MAX_LEN       512U       /*!< NFC-DEP PDU max length.                                                   */
+
+/*
+******************************************************************************
+* NDEF FEATURES CONFIGURATION
+******************************************************************************
+*/
+
+#define NDEF_FEATURE_T5T_MULTIPLE_BLOCK_READ   true       /*!< Enable/Disable Read Multiple Blocks on T5T tags, measured by the read benchmark */
+#define NDEF_FEATURE_T5T_MULTIPLE_BLOCK_WRITE  true       /*!< Enable/Disable Write Multiple Blocks on T5T tags, measured by the multiwrite benchmark */
+#define NDEF_FEATURE_T2T_FAST_READ             true       /*!< Enable/Disable FAST_READ on T2T tags, measured by the t2tread benchmark */
+#define NDEF_FEATURE_T5T_DETECT_CACHE          true       /*!< Enable/Disable the T5T NDEF detection cache, measured by the retap benchmark */
+
+#endif /* PLATFORM_H */
@@ -0,0 +1,480 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file st25r95_sim.h
+ *
+ *  \author
+ *
+ *  \brief ST25R95 host simulator
+ *
+ *  Simulates an ST25R95 behind the SPI interface so that the ST25R95 driver,
+ *  RFAL and NDEF layers can be run on a Linux host without hardware.
+ *
+ *  The simulator implements:
+ *   - the SPI control bytes SEND, RESET, READ and POLL (CR95HF DS 4.2)
+ *   - the IDN, ProtocolSelect, SendRecv, Idle, RdReg, WrReg, ACFilter,
+ *     PollField and Echo commands
+ *   - the result code/length encoding of responses longer than 255 bytes
+ *     and the SendRecv trailer (CRC and additional bytes) as parsed by
+ *     st25r95SPICompleteRx()
+ *   - the nIRQ_OUT line, asserted once the response latency has elapsed,
+ *     and the nIRQ_IN pulse used to wake up the chip
+ *
+ *  Tag responses are provided by a user handler called for each SendRecv
+ *  command. Every command has a programmable latency on a simulated clock
+ *  (1 us resolution) which also drives the platform timers, delays and
+ *  system tick.
+ *
+ *  Up to ST25R95_SIM_MAX_CHIPS chips share the SPI bus and the simulated
+ *  clock: GPIO port ST25R95_SIM_PORT + n addresses the pins of chip n and
+ *  the SPI bytes go to the chip whose nSS is low.
+ *
+ */
+
+#ifndef ST25R95_SIM_H
+#define ST25R95_SIM_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define ST25R95_SIM_PORT_NONE                 0U      /*!< Dummy GPIO port (LEDs...)            */
+#define ST25R95_SIM_PORT                      1U      /*!< GPIO port of the first simulated ST25R95, next ones follow */
+#define ST25R95_SIM_MAX_CHIPS                 8U      /*!< Number of simulated ST25R95          */
+
+#define ST25R95_SIM_PIN_LED                   0U      /*!< Dummy GPIO pin                       */
+#define ST25R95_SIM_PIN_N_SS                  1U      /*!< SPI nSS pin                          */
+#define ST25R95_SIM_PIN_N_IRQ_IN              2U      /*!< nIRQ_IN pin                          */
+#define ST25R95_SIM_PIN_N_IRQ_OUT             3U      /*!< nIRQ_OUT pin                         */
+
+#define ST25R95_SIM_FRAME_MAX_LEN             528U    /*!< Max SendRecv response data length    */
+
+#define ST25R95_SIM_DEFAULT_CMD_LATENCY       100U    /*!< Default command latency (us)         */
+#define ST25R95_SIM_DEFAULT_RF_LATENCY        500U    /*!< Default SendRecv latency (us)        */
+#define ST25R95_SIM_DEFAULT_TIMEOUT_LATENCY   5000U   /*!< Default SendRecv latency when no tag answers (us) */
+#define ST25R95_SIM_DEFAULT_IDLE_LATENCY      1000U   /*!< Default Idle wake up latency (us)    */
+#define ST25R95_SIM_DEFAULT_DAC_LEVEL         0x7CU   /*!< Default tag detector measurement     */
+#define ST25R95_SIM_TAG_DAC_DROP              0x10U   /*!< Tag detector measurement drop when a tag is in the field */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! Simulated SendRecv response, filled by the tag handler */
+typedef struct
+{
+    uint8_t  result;                           /*!< ST25R95 result code, ST25R95_ERRCODE_FRAMEWAITTIMEOUT when no tag answers */
+    uint8_t  status;                           /*!< First additional byte: error flags, residual bits for ST25R95_ERRCODE_RESULTSRESIDUAL */
+    uint8_t  colByte;                          /*!< ISO14443A 106kbps: index of the byte of the first collision */
+    uint8_t  colBit;                           /*!< ISO14443A 106kbps: index of the bit of the first collision  */
+    uint32_t latency;                          /*!< Response latency (us)                                       */
+    uint16_t len;                              /*!< Response data length, CRC included                          */
+    uint8_t  data[ST25R95_SIM_FRAME_MAX_LEN];  /*!< Response data, CRC included                                 */
+} st25r95SimFrame;
+
+
+/*!
+ * Tag handler called for every SendRecv command
+ *
+ * protocol : ST25R95 protocol currently selected (ST25R95_PROTOCOL_xxx)
+ * txBuf    : frame sent by the reader, without CRC
+ * txLen    : length of the frame sent by the reader
+ * txFlag   : ISO14443A transmission flag byte (0 for other protocols)
+ * rx       : response to fill, preset to a timeout after the default RF latency
+ */
+typedef void (*st25r95SimTagHandler)( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+
+
+/*!
+ * nIRQ_OUT interrupt handler called on every nIRQ_OUT falling edge
+ *
+ * chip : simulated chip whose response became available
+ */
+typedef void (*st25r95SimIrqOutHandler)( uint8_t chip );
+
+
+/*!
+ * UART interrupt handler: reception event or transmission complete
+ */
+typedef void (*st25r95SimUartHandler)( void );
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Initialize the simulator
+ *
+ * Resets the simulated chip, the simulated clock and restores the default
+ * latencies. No tag is in the field.
+ *
+ *****************************************************************************
+ */
+void st25r95SimInitialize( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Set the tag handler
+ *
+ * \param[in] chip    : simulated chip
+ * \param[in] handler : handler called for each SendRecv, NULL: no tag answers
+ *
+ *****************************************************************************
+ */
+void st25r95SimSetTagHandler( uint8_t chip, st25r95SimTagHandler handler );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Place or remove a tag from the field
+ *
+ * Changes the tag detector measurement used by the Idle command so that the
+ * Wake-Up mode detects the tag.
+ *
+ * \param[in] chip    : simulated chip
+ * \param[in] present : true when a tag is in the field
+ *
+ *****************************************************************************
+ */
+void st25r95SimSetTagPresent( uint8_t chip, bool present );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Set the latencies of all chips
+ *
+ * \param[in] cmdLatency     : latency of the non RF commands (us)
+ * \param[in] rfLatency      : default latency of the SendRecv responses (us)
+ * \param[in] timeoutLatency : latency of the SendRecv without response (us)
+ *
+ *****************************************************************************
+ */
+void st25r95SimSetLatency( uint32_t cmdLatency, uint32_t rfLatency, uint32_t timeoutLatency );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Set the nIRQ_OUT interrupt handler
+ *
+ * Models nIRQ_OUT routed to an EXTI line: the handler is called once per
+ * response, at the first simulated clock advance (SPI transfer, timer
+ * check, delay or st25r95SimWaitForInterrupt()) after the response became
+ * available. The handler is kept by st25r95SimInitialize().
+ *
+ * \param[in] handler : handler called on nIRQ_OUT falling edges, NULL: nIRQ_OUT is polled
+ *
+ *****************************************************************************
+ */
+void st25r95SimSetIrqOutHandler( st25r95SimIrqOutHandler handler );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Fill a response frame
+ *
+ * Copies the response data and appends the CRC of the currently selected
+ * protocol (CRC_A, CRC_B or ISO15693 CRC) when requested.
+ *
+ * \param[out] rx        : response to fill
+ * \param[in]  data      : response data, without CRC
+ * \param[in]  len       : response data length
+ * \param[in]  appendCrc : true to append the CRC
+ *
+ *****************************************************************************
+ */
+void st25r95SimSetFrame( st25r95SimFrame *rx, const uint8_t *data, uint16_t len, bool appendCrc );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Number of commands processed by the simulated chip
+ *
+ * \return number of commands received by all chips since st25r95SimInitialize()
+ *
+ *****************************************************************************
+ */
+uint32_t st25r95SimGetCommandCount( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Number of SPI transfers
+ *
+ * \return number of st25r95SimSpiTxRx() calls on all chips since st25r95SimInitialize()
+ *
+ *****************************************************************************
+ */
+uint32_t st25r95SimGetSpiTransferCount( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Number of bytes exchanged over SPI
+ *
+ * \return number of bytes exchanged with all chips since st25r95SimInitialize()
+ *
+ *****************************************************************************
+ */
+uint32_t st25r95SimGetSpiByteCount( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  SPI transceive on the simulated chip whose nSS is low
+ *
+ * \param[in]  txBuf : bytes sent to the chip
+ * \param[out] rxBuf : bytes received from the chip, NULL to discard
+ * \param[in]  len   : number of bytes
+ *
+ *****************************************************************************
+ */
+void st25r95SimSpiTxRx( const uint8_t *txBuf, uint8_t *rxBuf, uint16_t len );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Drive a GPIO
+ *
+ * \param[in] port  : GPIO port
+ * \param[in] pin   : GPIO pin
+ * \param[in] level : true: high, false: low
+ *
+ *****************************************************************************
+ */
+void st25r95SimGpioWrite( uint32_t port, uint32_t pin, bool level );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Read a GPIO
+ *
+ * \param[in] port  : GPIO port
+ * \param[in] pin   : GPIO pin
+ *
+ * \return true: high, false: low
+ *
+ *****************************************************************************
+ */
+bool st25r95SimGpioRead( uint32_t port, uint32_t pin );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Simulated clock (us)
+ *
+ * \return simulated time elapsed since st25r95SimInitialize() (us)
+ *
+ *****************************************************************************
+ */
+uint32_t st25r95SimGetTimeUs( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Simulated system tick (ms)
+ *
+ * \return simulated time elapsed since st25r95SimInitialize() (ms)
+ *
+ *****************************************************************************
+ */
+uint32_t st25r95SimGetTick( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Delay on the simulated clock
+ *
+ * \param[in] ms : delay (ms)
+ *
+ *****************************************************************************
+ */
+void st25r95SimDelay( uint32_t ms );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Sleep until the next interrupt on the simulated clock
+ *
+ * Advances the simulated clock to the next nIRQ_OUT falling edge or to the
+ * next system tick, whichever comes first, and raises the pending edges.
+ *
+ *****************************************************************************
+ */
+void st25r95SimWaitForInterrupt( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Get the worker time base, spending a polling step
+ *
+ * Accounts a polling step on the simulated clock, as done for the nIRQ_OUT
+ * GPIO reads, and raises the pending nIRQ_OUT edges. With the nIRQ_OUT
+ * interrupt, this lets the loops calling rfalWorker() until a response
+ * edge has been latched terminate.
+ *
+ * \return the current simulated time (us)
+ *****************************************************************************
+ */
+uint32_t st25r95SimGetWorkerTime( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Set the UART interrupt handlers
+ *
+ * Models the UART link of chip 0 with a circular DMA reception: the
+ * reception event handler is called, as on an idle line or DMA transfer
+ * event, each time a fragment of the response has been written to the ring.
+ * The handlers are kept by st25r95SimInitialize().
+ *
+ * \param[in] rxEvent : handler called on reception events, NULL: none
+ * \param[in] txCplt  : handler called when an interrupt transmission completes, NULL: none
+ *
+ *****************************************************************************
+ */
+void st25r95SimSetUartHandlers( st25r95SimUartHandler rxEvent, st25r95SimUartHandler txCplt );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Set the UART response fragmentation
+ *
+ * Responses are written to the ring in fragments of pseudo random length
+ * between 1 and fragMax bytes, one fragment per reception event.
+ *
+ * \param[in] fragMax : largest fragment length, 0: whole response at once
+ * \param[in] seed    : fragment length pseudo random generator seed
+ *
+ *****************************************************************************
+ */
+void st25r95SimSetUartFragment( uint16_t fragMax, uint32_t seed );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Transmit on the simulated UART link
+ *
+ * A null character outside a command is a nIRQ_IN low pulse (UART_RX is
+ * nIRQ_IN): it starts the chip up or wakes it up from Idle.
+ *
+ * \param[in] txBuf : bytes to transmit
+ * \param[in] len   : number of bytes to transmit
+ *
+ *****************************************************************************
+ */
+void st25r95SimUartTx( const uint8_t *txBuf, uint16_t len );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Transmit on the simulated UART link with interrupt
+ *
+ * As st25r95SimUartTx(), then calls the transmission complete handler.
+ *
+ * \param[in] txBuf : bytes to transmit
+ * \param[in] len   : number of bytes to transmit
+ *
+ *****************************************************************************
+ */
+void st25r95SimUartTxIT( const uint8_t *txBuf, uint16_t len );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Abort the simulated UART reception
+ *
+ * Stops the circular DMA: the bytes sent by the chip are lost until
+ * st25r95SimUartRxDmaStart() is called.
+ *
+ *****************************************************************************
+ */
+void st25r95SimUartReset( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Start the simulated UART circular DMA reception
+ *
+ * \param[in] ring : circular buffer
+ * \param[in] len  : circular buffer length
+ *
+ *****************************************************************************
+ */
+void st25r95SimUartRxDmaStart( uint8_t *ring, uint16_t len );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Get the simulated UART DMA remaining count
+ *
+ * \return number of bytes before the DMA wraps around the ring
+ *
+ *****************************************************************************
+ */
+uint16_t st25r95SimUartRxDmaRemaining( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Create a timer on the simulated clock
+ *
+ * \param[in] ms : timer duration (ms)
+ *
+ * \return timer
+ *
+ *****************************************************************************
+ */
+uint32_t st25r95SimTimerCreate( uint32_t ms );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Check a timer on the simulated clock
+ *
+ * Each check advances the simulated clock by a polling step so that busy
+ * loops waiting on a timer terminate.
+ *
+ * \param[in] timer : timer created by st25r95SimTimerCreate()
+ *
+ * \return true if the timer is expired
+ *
+ *****************************************************************************
+ */
+bool st25r95SimTimerIsExpired( uint32_t timer );
+
+#endif /* ST25R95_SIM_H */
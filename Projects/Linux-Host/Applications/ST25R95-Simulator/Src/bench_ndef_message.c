@@ -0,0 +1,391 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_ndef_message.c
+ *
+ *  \author
+ *
+ *  \brief NDEF message benchmarks of the ST25R95 simulator
+ *
+ *  The arena benchmark decodes the given number of 3-record NDEF messages
+ *  back-to-back, keeping all of them:
+ *
+ *      st25r95_sim [messages] arena
+ *
+ *  The host time per message, number of messages still intact at the end and
+ *  records high water mark are reported with the default record arena, with
+ *  one arena per message and with one arena shared by all the messages.
+ *
+ *  The append benchmark builds NDEF messages of 1 to 1000 records, appending
+ *  about the given number of records in total per message size, then gets
+ *  the message length and encodes it:
+ *
+ *      st25r95_sim [records] append
+ *
+ *  The host time per record is reported for each message size.
+ *
+ *  The stream benchmark places an NFC-V tag holding a 1 kB media record in
+ *  the field and reads its NDEF message, once into a buffer decoded at the
+ *  end and once into a message stream fed by chunks of the given length:
+ *
+ *      st25r95_sim [chunk bytes] stream
+ *
+ *  The RAM needed, the time to the first payload byte and to the whole
+ *  payload (simulated) and the payload hash are reported.
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#define _POSIX_C_SOURCE 199309L  /* clock_gettime() of the host time benchmarks */
+
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define BENCH_ARENA_MAX_MESSAGES         16384U  /*!< Largest number of messages of the arena benchmark */
+#define BENCH_ARENA_RECORDS              3U      /*!< Records of each message of the arena benchmark    */
+#define BENCH_ARENA_MODE_NUM             3U      /*!< Arena modes: default, per message, shared         */
+#define BENCH_ARENA_NUM_POS              7U      /*!< Position of the message number in the raw message */
+
+#define BENCH_APPEND_MAX_RECORDS         1000U   /*!< Records of the largest message of the append benchmark */
+#define BENCH_APPEND_SIZE_NUM            4U      /*!< Message sizes of the append benchmark                  */
+#define BENCH_APPEND_RECORD_LEN          8U      /*!< Encoded length of each record of the append benchmark  */
+
+#define BENCH_STREAM_PAYLOAD_LEN         980U    /*!< Media record payload length of the stream benchmark    */
+#define BENCH_STREAM_FNV_OFFSET          2166136261U /*!< FNV-1a hash offset basis                           */
+#define BENCH_STREAM_FNV_PRIME           16777619U   /*!< FNV-1a hash prime                                  */
+
+/*
+******************************************************************************
+* LOCAL TYPES
+******************************************************************************
+*/
+
+/*! Payload reception of the stream benchmark */
+typedef struct
+{
+    uint32_t    start;                           /*!< Read start (simulated us)            */
+    uint32_t    firstPayload;                    /*!< First payload byte received (simulated us) */
+    uint32_t    payloadLen;                      /*!< Payload bytes received               */
+    uint32_t    hash;                            /*!< FNV-1a hash of the payload           */
+} benchStreamStat;
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static ReturnCode benchStreamPayload( void *userParam, const ndefRecord *record, const ndefConstBuffer *bufFragment, uint32_t offset );
+static uint32_t benchStreamHash( uint32_t hash, const uint8_t *buf, uint32_t len );
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+int benchArenaBenchmark( uint32_t count )
+{
+    /* Text "Hi", URI "st.com/ab" and Text "Ok" records, the Text "Hi" payload ends with the message number */
+    static const uint8_t msgTemplate[] = { 0x91U, 0x01U, 0x05U, 0x54U, 0x02U, 0x65U, 0x6EU, 0x48U, 0x69U,
+                                           0x11U, 0x01U, 0x0AU, 0x55U, 0x04U, 0x73U, 0x74U, 0x2EU, 0x63U, 0x6FU, 0x6DU, 0x2FU, 0x61U, 0x62U,
+                                           0x51U, 0x01U, 0x05U, 0x54U, 0x02U, 0x65U, 0x6EU, 0x4FU, 0x6BU };
+    static const char * const modeName[BENCH_ARENA_MODE_NUM] = { "default", "per message", "shared" };
+    static uint8_t         raw[BENCH_ARENA_MAX_MESSAGES][sizeof(msgTemplate)];
+    static ndefMessage     messages[BENCH_ARENA_MAX_MESSAGES];
+    static ndefRecordArena arenas[BENCH_ARENA_MAX_MESSAGES];
+    static ndefRecord      records[BENCH_ARENA_MAX_MESSAGES * BENCH_ARENA_RECORDS];
+    ndefRecordArena shared;
+    ndefConstBuffer bufRaw;
+    ndefConstBuffer bufPayload;
+    struct timespec start;
+    struct timespec end;
+    uint64_t        ns;
+    uint32_t        intact;
+    uint32_t        highWater;
+    uint32_t        i;
+    ReturnCode      err;
+    uint8_t         mode;
+
+    count = MIN( MAX( count, 1U ), BENCH_ARENA_MAX_MESSAGES );
+    for( i = 0; i < count; i++ )
+    {
+        ST_MEMCPY( raw[i], msgTemplate, sizeof(msgTemplate) );
+        raw[i][BENCH_ARENA_NUM_POS]     = (uint8_t)(i >> 8U);
+        raw[i][BENCH_ARENA_NUM_POS + 1U] = (uint8_t)i;
+        (void)ndefRecordArenaInit( &arenas[i], &records[i * BENCH_ARENA_RECORDS], BENCH_ARENA_RECORDS );
+    }
+    (void)ndefRecordArenaInit( &shared, records, (count * BENCH_ARENA_RECORDS) );
+
+    for( mode = 0; mode < BENCH_ARENA_MODE_NUM; mode++ )
+    {
+        (void)clock_gettime( CLOCK_MONOTONIC, &start );
+        for( i = 0; i < count; i++ )
+        {
+            bufRaw.buffer = raw[i];
+            bufRaw.length = sizeof(msgTemplate);
+            if( mode == 0U )
+            {
+                err = ndefMessageDecode( &bufRaw, &messages[i] );
+            }
+            else
+            {
+                err = ndefMessageDecodeWithArena( &bufRaw, ((mode == 1U) ? &arenas[i] : &shared), &messages[i] );
+            }
+            if( err != ERR_NONE )
+            {
+                platformLog("Message %u cannot be decoded: %d\r\n", (unsigned)i, err);
+                return EXIT_FAILURE;
+            }
+        }
+        (void)clock_gettime( CLOCK_MONOTONIC, &end );
+        ns = ((uint64_t)(end.tv_sec - start.tv_sec) * 1000000000U) + (uint64_t)end.tv_nsec - (uint64_t)start.tv_nsec;
+
+        /* A message is intact while its records still hold its own payload */
+        intact = 0U;
+        for( i = 0; i < count; i++ )
+        {
+            if( (ndefMessageGetRecordCount( &messages[i] ) == BENCH_ARENA_RECORDS) &&
+                (ndefRecordGetPayload( ndefMessageGetFirstRecord( &messages[i] ), &bufPayload ) == ERR_NONE) &&
+                (bufPayload.buffer == &raw[i][BENCH_ARENA_NUM_POS - 3U]) )
+            {
+                intact++;
+            }
+        }
+
+        highWater = 0U;
+        for( i = 0; i < count; i++ )
+        {
+            highWater = MAX( highWater, ndefRecordArenaGetHighWaterMark( messages[i].arena ) );
+            if( mode != 1U )
+            {
+                break;   /* Single arena */
+            }
+        }
+
+        platformLog("%-11s arena: %u messages, %4u ns/message, %5u intact, records high water mark: %5u%s\r\n", modeName[mode], (unsigned)count,
+                    (unsigned)(ns / count), (unsigned)intact, (unsigned)highWater, ((mode == 1U) ? " per arena" : ""));
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchAppendBenchmark( uint32_t count )
+{
+    static const uint32_t sizes[BENCH_APPEND_SIZE_NUM] = { 1U, 10U, 100U, BENCH_APPEND_MAX_RECORDS };
+    static const uint8_t  type[]    = { 0x54U };                      /* Text, single byte type: 3 bytes header */
+    static const uint8_t  payload[] = { 0x02U, 0x65U, 0x6EU, 0x2AU }; /* "en" "*" */
+    static ndefRecord     records[BENCH_APPEND_MAX_RECORDS];
+    static uint8_t        raw[BENCH_APPEND_MAX_RECORDS * BENCH_APPEND_RECORD_LEN];
+    ndefMessage      message;
+    ndefMessageInfo  info;
+    ndefConstBuffer8 bufType;
+    ndefConstBuffer8 bufId;
+    ndefConstBuffer  bufPayload;
+    ndefBuffer       bufRaw;
+    struct timespec  start;
+    struct timespec  end;
+    uint64_t         ns;
+    uint32_t         reps;
+    uint32_t         rep;
+    uint32_t         i;
+    uint8_t          s;
+
+    bufType.buffer    = type;
+    bufType.length    = sizeof(type);
+    bufId.buffer      = NULL;
+    bufId.length      = 0U;
+    bufPayload.buffer = payload;
+    bufPayload.length = sizeof(payload);
+
+    count = MAX( count, 1U );
+    for( s = 0; s < BENCH_APPEND_SIZE_NUM; s++ )
+    {
+        reps = MAX( (count / sizes[s]), 1U );
+
+        (void)clock_gettime( CLOCK_MONOTONIC, &start );
+        for( rep = 0; rep < reps; rep++ )
+        {
+            (void)ndefMessageInit( &message );
+            for( i = 0; i < sizes[s]; i++ )
+            {
+                (void)ndefRecordInit( &records[i], NDEF_TNF_RTD_WELL_KNOWN_TYPE, &bufType, &bufId, &bufPayload );
+                (void)ndefMessageAppend( &message, &records[i] );
+            }
+
+            bufRaw.buffer = raw;
+            bufRaw.length = sizeof(raw);
+            if( (ndefMessageGetInfo( &message, &info ) != ERR_NONE) || (ndefMessageEncode( &message, &bufRaw ) != ERR_NONE) ||
+                (info.length != bufRaw.length) || (info.length != (sizes[s] * BENCH_APPEND_RECORD_LEN)) )
+            {
+                platformLog("Message of %u records cannot be encoded\r\n", (unsigned)sizes[s]);
+                return EXIT_FAILURE;
+            }
+        }
+        (void)clock_gettime( CLOCK_MONOTONIC, &end );
+        ns = ((uint64_t)(end.tv_sec - start.tv_sec) * 1000000000U) + (uint64_t)end.tv_nsec - (uint64_t)start.tv_nsec;
+
+        platformLog("%4u records: %6u messages, %4u ns/record\r\n", (unsigned)sizes[s], (unsigned)reps,
+                    (unsigned)(ns / ((uint64_t)reps * sizes[s])));
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchStreamBenchmark( uint32_t chunkLen )
+{
+    /* Type 5 Tag image: 4-byte CC (MLEN 1 kB), NDEF TLV with a 3-byte L field, Media record, Terminator TLV */
+    static const uint8_t cc[]     = { 0xE1U, 0x40U, 0x80U, 0x00U };
+    static const uint8_t header[] = { 0xC2U, 0x09U, 0x00U, 0x00U, (uint8_t)(BENCH_STREAM_PAYLOAD_LEN >> 8U), (uint8_t)BENCH_STREAM_PAYLOAD_LEN,
+                                      0x69U, 0x6DU, 0x61U, 0x67U, 0x65U, 0x2FU, 0x70U, 0x6EU, 0x67U };  /* "image/png" */
+    static uint8_t       msg[BENCH_STREAM_MSG_BUF_LEN];
+    static uint8_t       chunk[BENCH_STREAM_MSG_BUF_LEN];
+    uint8_t             *mem = &benchNfcvMem[0][0];
+    ndefContext          ctx;
+    ndefMessage          message;
+    ndefMessageStream    stream;
+    ndefConstBuffer      bufRaw;
+    ndefConstBuffer      bufPayload;
+    benchStreamStat      stat;
+    ReturnCode           err;
+    uint32_t             msgLen;
+    uint32_t             pos;
+    uint32_t             i;
+
+    chunkLen = MIN( MAX( chunkLen, 1U ), BENCH_STREAM_MSG_BUF_LEN );
+    msgLen   = sizeof(header) + BENCH_STREAM_PAYLOAD_LEN;
+
+    ST_MEMSET( benchNfcvMem, 0x00, sizeof(benchNfcvMem) );
+    ST_MEMCPY( mem, cc, sizeof(cc) );
+    pos = sizeof(cc);
+    mem[pos++] = 0x03U;   /* NDEF TLV */
+    mem[pos++] = 0xFFU;
+    mem[pos++] = (uint8_t)(msgLen >> 8U);
+    mem[pos++] = (uint8_t)msgLen;
+    ST_MEMCPY( &mem[pos], header, sizeof(header) );
+    pos += sizeof(header);
+    for( i = 0; i < BENCH_STREAM_PAYLOAD_LEN; i++ )
+    {
+        mem[pos++] = (uint8_t)((i * 7U) + (i >> 8U));
+    }
+    mem[pos] = 0xFEU;     /* Terminator TLV */
+
+    err = benchNdefDetect( &ctx, benchNfcvTag );
+    if( (err != ERR_NONE) || (ctx.messageLen != msgLen) )
+    {
+        platformLog("NDEF detection failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    /* Whole message read, then decoded */
+    stat.start = st25r95SimGetTimeUs();
+    err = ndefPollerReadRawMessage( &ctx, msg, sizeof(msg), &msgLen );
+    if( err == ERR_NONE )
+    {
+        bufRaw.buffer = msg;
+        bufRaw.length = msgLen;
+        err = ndefMessageDecode( &bufRaw, &message );
+    }
+    if( err == ERR_NONE )
+    {
+        err = ndefRecordGetPayload( ndefMessageGetFirstRecord( &message ), &bufPayload );
+    }
+    if( err != ERR_NONE )
+    {
+        platformLog("NDEF message read failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+    stat.firstPayload = (st25r95SimGetTimeUs() - stat.start);
+    stat.hash         = benchStreamHash( BENCH_STREAM_FNV_OFFSET, bufPayload.buffer, bufPayload.length );
+    platformLog("Buffer read: RAM %4u bytes, first payload byte after %6u us, whole payload after %6u us, %u bytes, hash %08X\r\n",
+                (unsigned)sizeof(msg), (unsigned)stat.firstPayload, (unsigned)stat.firstPayload, (unsigned)bufPayload.length, (unsigned)stat.hash);
+
+    /* Message fed to the stream by chunks while it is read */
+    (void)ndefMessageStreamInit( &stream, NULL, benchStreamPayload, &stat );
+    stat.payloadLen   = 0U;
+    stat.hash         = BENCH_STREAM_FNV_OFFSET;
+    stat.start        = st25r95SimGetTimeUs();
+    err = ndefPollerReadMessageStream( &ctx, &stream, chunk, chunkLen );
+    if( err != ERR_NONE )
+    {
+        platformLog("NDEF message stream read failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+    platformLog("Stream read: RAM %4u bytes, first payload byte after %6u us, whole payload after %6u us, %u bytes, hash %08X\r\n",
+                (unsigned)(chunkLen + sizeof(stream)), (unsigned)stat.firstPayload, (unsigned)(st25r95SimGetTimeUs() - stat.start),
+                (unsigned)stat.payloadLen, (unsigned)stat.hash);
+    return EXIT_SUCCESS;
+}
+
+
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode benchStreamPayload( void *userParam, const ndefRecord *record, const ndefConstBuffer *bufFragment, uint32_t offset )
+{
+    benchStreamStat *stat = (benchStreamStat*)userParam;
+
+    NO_WARNING(record);
+
+    if( offset == 0U )
+    {
+        stat->firstPayload = (st25r95SimGetTimeUs() - stat->start);
+    }
+    stat->hash        = benchStreamHash( stat->hash, bufFragment->buffer, bufFragment->length );
+    stat->payloadLen += bufFragment->length;
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+static uint32_t benchStreamHash( uint32_t hash, const uint8_t *buf, uint32_t len )
+{
+    uint32_t i;
+
+    for( i = 0; i < len; i++ )
+    {
+        hash = ((hash ^ buf[i]) * BENCH_STREAM_FNV_PRIME);
+    }
+    return hash;
+}
@@ -0,0 +1,778 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_ndef_poller.c
+ *
+ *  \author
+ *
+ *  \brief NDEF poller benchmarks of the ST25R95 simulator
+ *
+ *  The re-tap benchmark places an NDEF formatted NFC-V tag in the field and
+ *  reads its NDEF message after each activation, once with the T5T NDEF
+ *  detection cache cleared before every tap and once with the cache kept:
+ *
+ *      st25r95_sim [duration ms] retap
+ *
+ *  The mean time from activation to NDEF message read is reported.
+ *
+ *  The read benchmark places an NFC-V tag holding an NDEF message of the
+ *  given length in the field and reads it with ndefPollerReadRawMessage(),
+ *  once with MBREAD clear in the CC (Read Single Block), once with MBREAD
+ *  set (Read Multiple Blocks) and once with MBREAD set and the first Read
+ *  Multiple Blocks chunk of several blocks rejected by the tag:
+ *
+ *      st25r95_sim [message bytes] read
+ *
+ *  The read time (simulated), throughput and number of ST25R95 commands are
+ *  reported, the run fails when the message read differs or when the
+ *  rejected chunk is not read block per block.
+ *
+ *  The multiple blocks write benchmark writes an NDEF message of the given
+ *  length to an NFC-V tag with ndefPollerWriteRawMessage(), once with Write
+ *  Multiple Blocks missing from the Extended Get System Information command
+ *  list (Write Single Block), once with it listed and once with the first
+ *  Write Multiple Blocks chunk rejected by the tag. The same NDEF TLV is then
+ *  written with rfalNfcvPollerExtendedWriteMultipleBlocks():
+ *
+ *      st25r95_sim [message bytes] multiwrite
+ *
+ *  The write time (simulated, tag programming time not modelled), throughput,
+ *  number of blocks written and of ST25R95 commands are reported, the run
+ *  fails when the message read back after a new NDEF detection differs or
+ *  when the rejected chunk is not written block per block.
+ *
+ *  The T2T read benchmark places an NFC-A Type 2 Tag of two sectors holding
+ *  an NDEF message of the given length in the field and reads it with
+ *  ndefPollerReadRawMessage(), once with READ only, once with FAST_READ and
+ *  once with FAST_READ answered by a NAK, the tag then re-activated and
+ *  read with READ:
+ *
+ *      st25r95_sim [message bytes] t2tread
+ *
+ *  The read time (simulated), throughput and number of READ, FAST_READ, NAK,
+ *  SECTOR SELECT and ST25R95 commands are reported, the run fails when the
+ *  message read differs, when FAST_READ is answered in another mode than the
+ *  FAST_READ one or when the rejected FAST_READ is not followed by a single
+ *  re-activation.
+ *
+ *  The write benchmark writes an NDEF message made of a Text, a URI and a
+ *  media record of the given payload length to an NFC-V tag with
+ *  ndefPollerWriteMessage():
+ *
+ *      st25r95_sim [media payload bytes] write
+ *
+ *  The write time (simulated), the number of blocks read and written and the
+ *  largest number of writes of a block inside the message are reported.
+ *
+ *  The rewrite benchmark writes the same message to an NFC-V tag, then
+ *  replaces it by the message with its Text record edited, once with
+ *  ndefPollerWriteRawMessage() and with ndefPollerWriteRawMessageDiff()
+ *  reading the tag content, given the previous message and given the
+ *  edited message itself:
+ *
+ *      st25r95_sim [media payload bytes] rewrite
+ *
+ *  The rewrite time (simulated) and the number of blocks read and written
+ *  are reported.
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <string.h>
+#include "bench.h"
+#include "utils.h"
+#include "st25r95_com.h"
+#include "rfal_nfcv.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define BENCH_RETAP_MSG_BUF_LEN          64U     /*!< Re-tap benchmark NDEF message buffer */
+
+#define BENCH_STREAM_TLV_LEN             4U      /*!< NDEF TLV T and 3-byte L fields                         */
+
+#define BENCH_READ_MIN_LEN               16U     /*!< Smallest NDEF message of the read benchmark: one Read Multiple Blocks chunk */
+#define BENCH_READ_MAX_LEN               1000U   /*!< Largest NDEF message of the read benchmark             */
+#define BENCH_READ_MODE_NUM              3U      /*!< Read modes: single block, multiple blocks, rejected chunk */
+#define BENCH_READ_FAIL_CHUNK            1U      /*!< Multiple blocks request rejected by the tag            */
+
+#define BENCH_MWRITE_MIN_LEN             16U     /*!< Smallest NDEF message of the multiple blocks write benchmark: one Write Multiple Blocks chunk */
+#define BENCH_MWRITE_MAX_LEN             1000U   /*!< Largest NDEF message of the multiple blocks write benchmark */
+#define BENCH_MWRITE_MODE_NUM            4U      /*!< Write modes: single block, multiple blocks, rejected chunk, extended */
+#define BENCH_MWRITE_FAIL_CHUNK          1U      /*!< Multiple blocks request rejected by the tag            */
+#define BENCH_MWRITE_EXT_BLOCKS          4U      /*!< Blocks per Extended Write Multiple Blocks request      */
+#define BENCH_MWRITE_EXT_HEADER_LEN      6U      /*!< Extended Write Multiple Blocks header: flags, command, first block (2), blocks (2) */
+
+#define BENCH_T2T_READ_MIN_LEN           64U     /*!< Smallest NDEF message of the T2T read benchmark: FAST_READ used */
+#define BENCH_T2T_READ_MAX_LEN           2000U   /*!< Largest NDEF message of the T2T read benchmark         */
+#define BENCH_T2T_READ_MODE_NUM          3U      /*!< Read modes: READ, FAST_READ, rejected FAST_READ        */
+
+#define BENCH_WRITE_MAX_PAYLOAD          900U    /*!< Largest media payload of the write benchmark           */
+#define BENCH_WRITE_RECORD_NUM           3U      /*!< Text, URI and media records of the write benchmark     */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+
+/* Type 5 Tag image of the re-tap benchmark: 4-byte CC, NDEF TLV with a "Hi" text record, Terminator TLV */
+static const uint8_t benchNfcvNdef[] = {0xE1, 0x40, 0x08, 0x00, 0x03, 0x09, 0xD1, 0x01, 0x05, 0x54, 0x02, 0x65, 0x6E, 0x48, 0x69, 0xFE};
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static int benchRetapRun( uint32_t duration, bool cache );
+static ReturnCode benchMultiWriteExt( const uint8_t *msg, uint32_t msgLen );
+static void benchWriteMessageInit( ndefMessage *message, ndefRecord *records, uint32_t payloadLen );
+static ReturnCode benchRewrite( ndefContext *ctx, const uint8_t *buf, uint32_t bufLen, bool diff, const uint8_t *image, uint32_t imageLen, const char *name );
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+int benchRetapBenchmark( uint32_t duration )
+{
+    ST_MEMCPY( benchNfcvMem, benchNfcvNdef, sizeof(benchNfcvNdef) );
+
+    if( (benchRetapRun( duration, false ) != EXIT_SUCCESS) || (benchRetapRun( duration, true ) != EXIT_SUCCESS) )
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchReadBenchmark( uint32_t msgLen )
+{
+    static const char * const modeName[BENCH_READ_MODE_NUM] = { "single block", "multiple blocks", "rejected chunk" };
+    static uint8_t       msg[BENCH_READ_MAX_LEN];
+    static uint8_t       readBack[BENCH_READ_MAX_LEN];
+    uint8_t             *mem = (uint8_t*)benchNfcvMem;
+    ndefContext          ctx;
+    ReturnCode           err;
+    uint32_t             start;
+    uint32_t             cmds;
+    uint32_t             readLen;
+    uint32_t             pos;
+    uint32_t             i;
+    uint8_t              mode;
+
+    msgLen = MIN( MAX( msgLen, BENCH_READ_MIN_LEN ), BENCH_READ_MAX_LEN );
+    for( i = 0; i < msgLen; i++ )
+    {
+        msg[i] = (uint8_t)((i * 11U) + (i >> 8U));
+    }
+
+    for( mode = 0; mode < BENCH_READ_MODE_NUM; mode++ )
+    {
+        /* Type 5 Tag image: 4-byte CC (MLEN 1 kB, MBREAD except in single block mode), NDEF TLV with a 3-byte L field, Terminator TLV */
+        ST_MEMSET( benchNfcvMem, 0x00, sizeof(benchNfcvMem) );
+        pos = 0U;
+        mem[pos++] = 0xE1U;
+        mem[pos++] = 0x40U;
+        mem[pos++] = 0x80U;
+        mem[pos++] = ((mode == 0U) ? 0x00U : 0x01U);
+        mem[pos++] = 0x03U;
+        mem[pos++] = 0xFFU;
+        mem[pos++] = (uint8_t)(msgLen >> 8U);
+        mem[pos++] = (uint8_t)msgLen;
+        ST_MEMCPY( &mem[pos], msg, msgLen );
+        mem[pos + msgLen] = 0xFEU;
+
+        st25r95SimInitialize();
+        benchNfcvChunkFail = 0U;
+        err = benchNdefDetect( &ctx, benchNfcvTag );
+        if( (err != ERR_NONE) || (ctx.messageLen != msgLen) )
+        {
+            platformLog("NDEF detection failed: %d\r\n", err);
+            return EXIT_FAILURE;
+        }
+
+        benchNfcvChunkFail = ((mode == 2U) ? BENCH_READ_FAIL_CHUNK : 0U);
+        benchNfcvReadCnt  = 0U;
+        cmds  = st25r95SimGetCommandCount();
+        start = st25r95SimGetTimeUs();
+        err   = ndefPollerReadRawMessage( &ctx, readBack, sizeof(readBack), &readLen );
+        start = (st25r95SimGetTimeUs() - start);
+        cmds  = (st25r95SimGetCommandCount() - cmds);
+        if( (err != ERR_NONE) || (readLen != msgLen) || (memcmp( readBack, msg, msgLen ) != 0) )
+        {
+            platformLog("NDEF message read failed (%s): %d\r\n", modeName[mode], err);
+            return EXIT_FAILURE;
+        }
+        if( benchNfcvChunkFail != 0U )
+        {
+            platformLog("Read Multiple Blocks chunk %u not requested\r\n", (unsigned)BENCH_READ_FAIL_CHUNK);
+            return EXIT_FAILURE;
+        }
+
+        platformLog("%-15s: %4u bytes message read in %6u us, %5u bytes/s, blocks read: %3u, ST25R95 commands: %3u\r\n", modeName[mode],
+                    (unsigned)msgLen, (unsigned)start, (unsigned)(((uint64_t)msgLen * 1000000U) / start), (unsigned)benchNfcvReadCnt, (unsigned)cmds);
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchMultiWriteBenchmark( uint32_t msgLen )
+{
+    /* Type 5 Tag image: 4-byte CC (MLEN 1 kB), empty NDEF TLV, Terminator TLV */
+    static const uint8_t tagInit[] = { 0xE1U, 0x40U, 0x80U, 0x00U, 0x03U, 0x00U, 0xFEU };
+    static const char * const modeName[BENCH_MWRITE_MODE_NUM] = { "single block", "multiple blocks", "rejected chunk", "extended" };
+    static uint8_t       msg[BENCH_MWRITE_MAX_LEN];
+    static uint8_t       readBack[BENCH_MWRITE_MAX_LEN];
+    ndefContext          ctx;
+    ReturnCode           err;
+    uint32_t             start;
+    uint32_t             cmds;
+    uint32_t             writes;
+    uint32_t             readLen;
+    uint32_t             i;
+    uint8_t              mode;
+
+    msgLen = MIN( MAX( msgLen, BENCH_MWRITE_MIN_LEN ), BENCH_MWRITE_MAX_LEN );
+    for( i = 0; i < msgLen; i++ )
+    {
+        msg[i] = (uint8_t)((i * 7U) + (i >> 8U) + 1U);
+    }
+
+    for( mode = 0; mode < BENCH_MWRITE_MODE_NUM; mode++ )
+    {
+        ST_MEMSET( benchNfcvMem, 0x00, sizeof(benchNfcvMem) );
+        ST_MEMCPY( (uint8_t*)benchNfcvMem, tagInit, sizeof(tagInit) );
+
+        /* The command list of the previous mode must not be taken from the detection cache */
+        st25r95SimInitialize();
+        ndefPollerDetectCacheClear();
+        benchNfcvChunkFail = 0U;
+        benchNfcvWrMultiple = (mode != 0U);
+        err = benchNdefDetect( &ctx, benchNfcvTag );
+        if( err != ERR_NONE )
+        {
+            platformLog("NDEF detection failed: %d\r\n", err);
+            return EXIT_FAILURE;
+        }
+
+        ST_MEMSET( benchNfcvWriteCnt, 0x00, sizeof(benchNfcvWriteCnt) );
+        benchNfcvChunkFail = ((mode == 2U) ? BENCH_MWRITE_FAIL_CHUNK : 0U);
+        cmds  = st25r95SimGetCommandCount();
+        start = st25r95SimGetTimeUs();
+        if( mode == 3U )
+        {
+            err = benchMultiWriteExt( msg, msgLen );
+        }
+        else
+        {
+            err = ndefPollerWriteRawMessage( &ctx, msg, msgLen );
+        }
+        start = (st25r95SimGetTimeUs() - start);
+        cmds  = (st25r95SimGetCommandCount() - cmds);
+        if( err != ERR_NONE )
+        {
+            platformLog("NDEF message write failed (%s): %d\r\n", modeName[mode], err);
+            return EXIT_FAILURE;
+        }
+        if( benchNfcvChunkFail != 0U )
+        {
+            platformLog("Write Multiple Blocks chunk %u not requested\r\n", (unsigned)BENCH_MWRITE_FAIL_CHUNK);
+            return EXIT_FAILURE;
+        }
+
+        writes = 0U;
+        for( i = 0; i < BENCH_NFCV_BLOCK_NUM; i++ )
+        {
+            writes += benchNfcvWriteCnt[i];
+        }
+
+        /* The message is read back from a new NDEF detection, not from the context used to write it */
+        st25r95SimInitialize();
+        ndefPollerDetectCacheClear();
+        err = benchNdefDetect( &ctx, benchNfcvTag );
+        if( err == ERR_NONE )
+        {
+            err = ndefPollerReadRawMessage( &ctx, readBack, sizeof(readBack), &readLen );
+        }
+        if( (err != ERR_NONE) || (readLen != msgLen) || (memcmp( readBack, msg, msgLen ) != 0) )
+        {
+            platformLog("NDEF message read back failed (%s): %d\r\n", modeName[mode], err);
+            return EXIT_FAILURE;
+        }
+
+        platformLog("%-15s: %4u bytes message written in %6u us, %5u bytes/s, blocks written: %3u, ST25R95 commands: %3u\r\n", modeName[mode],
+                    (unsigned)msgLen, (unsigned)start, (unsigned)(((uint64_t)msgLen * 1000000U) / start), (unsigned)writes, (unsigned)cmds);
+    }
+    benchNfcvWrMultiple = true;
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchT2TReadBenchmark( uint32_t msgLen )
+{
+    static const char * const modeName[BENCH_T2T_READ_MODE_NUM] = { "READ", "FAST_READ", "rejected FAST_READ" };
+    static uint8_t       msg[BENCH_T2T_READ_MAX_LEN];
+    static uint8_t       readBack[BENCH_T2T_READ_MAX_LEN];
+    uint8_t             *mem = (uint8_t*)benchNfcaMem;
+    ndefContext          ctx;
+    ReturnCode           err;
+    uint32_t             start;
+    uint32_t             cmds;
+    uint32_t             readLen;
+    uint32_t             pos;
+    uint32_t             i;
+    uint8_t              mode;
+
+    msgLen = MIN( MAX( msgLen, BENCH_T2T_READ_MIN_LEN ), BENCH_T2T_READ_MAX_LEN );
+    for( i = 0; i < msgLen; i++ )
+    {
+        msg[i] = (uint8_t)((i * 13U) + (i >> 8U) + 5U);
+    }
+
+    for( mode = 0; mode < BENCH_T2T_READ_MODE_NUM; mode++ )
+    {
+        /* Type 2 Tag image: UID pages, CC (data area 2032 bytes), NDEF TLV with a 3-byte L field, Terminator TLV */
+        ST_MEMSET( benchNfcaMem, 0x00, sizeof(benchNfcaMem) );
+        ST_MEMCPY( mem, benchNfcaUID, BENCH_NFCA_UID_LEN );
+        pos = (3U * BENCH_T2T_PAGE_LEN);
+        mem[pos++] = 0xE1U;
+        mem[pos++] = 0x10U;
+        mem[pos++] = 0xFEU;
+        mem[pos++] = 0x00U;
+        mem[pos++] = 0x03U;
+        mem[pos++] = 0xFFU;
+        mem[pos++] = (uint8_t)(msgLen >> 8U);
+        mem[pos++] = (uint8_t)msgLen;
+        ST_MEMCPY( &mem[pos], msg, msgLen );
+        mem[pos + msgLen] = 0xFEU;
+
+        st25r95SimInitialize();
+        benchNfcaFastRead = (mode != 2U);
+        err = benchNdefDetect( &ctx, benchNfcaTag );
+        if( (err != ERR_NONE) || (ctx.messageLen != msgLen) )
+        {
+            platformLog("NDEF detection failed: %d\r\n", err);
+            return EXIT_FAILURE;
+        }
+        if( mode == 0U )
+        {
+            /* READ only, as with NDEF_FEATURE_T2T_FAST_READ disabled */
+            ctx.subCtx.t2t.fastReadSupported = false;
+        }
+
+        benchNfcaReadCnt    = 0U;
+        benchNfcaFastReadCnt = 0U;
+        benchNfcaNakCnt     = 0U;
+        benchNfcaSelCnt     = 0U;
+        benchNfcaSectorCnt  = 0U;
+        cmds  = st25r95SimGetCommandCount();
+        start = st25r95SimGetTimeUs();
+        err   = ndefPollerReadRawMessage( &ctx, readBack, sizeof(readBack), &readLen );
+        start = (st25r95SimGetTimeUs() - start);
+        cmds  = (st25r95SimGetCommandCount() - cmds);
+        if( (err != ERR_NONE) || (readLen != msgLen) || (memcmp( readBack, msg, msgLen ) != 0) )
+        {
+            platformLog("NDEF message read failed (%s): %d\r\n", modeName[mode], err);
+            return EXIT_FAILURE;
+        }
+        /* FAST_READ answered in FAST_READ mode only, a single NAK and re-activation in rejected FAST_READ mode */
+        if( ((benchNfcaFastReadCnt != 0U) != (mode == 1U)) || (benchNfcaNakCnt != ((mode == 2U) ? 1U : 0U)) || (benchNfcaSelCnt != benchNfcaNakCnt) )
+        {
+            platformLog("FAST_READ not used as expected (%s): %u answered, %u NAK, %u re-activations\r\n", modeName[mode],
+                        (unsigned)benchNfcaFastReadCnt, (unsigned)benchNfcaNakCnt, (unsigned)benchNfcaSelCnt);
+            return EXIT_FAILURE;
+        }
+
+        platformLog("%-18s: %4u bytes message read in %6u us, %5u bytes/s, READ: %3u, FAST_READ: %2u, NAK: %u, SECTOR SELECT: %u, ST25R95 commands: %3u\r\n", modeName[mode],
+                    (unsigned)msgLen, (unsigned)start, (unsigned)(((uint64_t)msgLen * 1000000U) / start), (unsigned)benchNfcaReadCnt,
+                    (unsigned)benchNfcaFastReadCnt, (unsigned)benchNfcaNakCnt, (unsigned)benchNfcaSectorCnt, (unsigned)cmds);
+    }
+    benchNfcaFastRead = true;
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchWriteBenchmark( uint32_t payloadLen )
+{
+    static uint8_t       encoded[BENCH_STREAM_MSG_BUF_LEN];
+    static uint8_t       readBack[BENCH_STREAM_MSG_BUF_LEN];
+    ndefContext          ctx;
+    ndefMessage          message;
+    ndefRecord           records[BENCH_WRITE_RECORD_NUM];
+    ndefBuffer           bufEncoded;
+    ReturnCode           err;
+    uint32_t             start;
+    uint32_t             reads;
+    uint32_t             writes;
+    uint32_t             maxWrites;
+    uint32_t             readLen;
+    uint32_t             i;
+
+    benchWriteMessageInit( &message, records, payloadLen );
+    bufEncoded.buffer = encoded;
+    bufEncoded.length = sizeof(encoded);
+    (void)ndefMessageEncode( &message, &bufEncoded );
+
+    err = benchNdefDetect( &ctx, benchNfcvTag );
+    if( err != ERR_NONE )
+    {
+        platformLog("NDEF detection failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    ST_MEMSET( benchNfcvWriteCnt, 0x00, sizeof(benchNfcvWriteCnt) );
+    benchNfcvReadCnt = 0U;
+    start = st25r95SimGetTimeUs();
+    err   = ndefPollerWriteMessage( &ctx, &message );
+    start = (st25r95SimGetTimeUs() - start);
+    reads = benchNfcvReadCnt;
+    if( err == ERR_NONE )
+    {
+        err = ndefPollerReadRawMessage( &ctx, readBack, sizeof(readBack), &readLen );
+    }
+    if( (err != ERR_NONE) || (readLen != bufEncoded.length) || (memcmp( readBack, encoded, readLen ) != 0) )
+    {
+        platformLog("NDEF message write failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    /* The blocks shared with the TLV are also written by the L-field and Terminator TLV updates: only the blocks inside the message are checked */
+    writes    = 0U;
+    maxWrites = 0U;
+    for( i = 0; i < BENCH_NFCV_BLOCK_NUM; i++ )
+    {
+        writes += benchNfcvWriteCnt[i];
+        if( (i >= ((ctx.messageOffset + BENCH_NFCV_BLOCK_LEN - 1U) / BENCH_NFCV_BLOCK_LEN)) && (i < ((ctx.messageOffset + readLen) / BENCH_NFCV_BLOCK_LEN)) )
+        {
+            maxWrites = MAX( maxWrites, benchNfcvWriteCnt[i] );
+        }
+    }
+    platformLog("%3u bytes message written in %6u us, blocks read: %2u, blocks written: %3u, max writes of a message block: %u\r\n",
+                (unsigned)bufEncoded.length, (unsigned)start, (unsigned)reads, (unsigned)writes, (unsigned)maxWrites);
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchRewriteBenchmark( uint32_t payloadLen )
+{
+    static const uint8_t textEdit[] = { 0x02U, 0x65U, 0x6EU, 0x57U, 0x6FU, 0x72U, 0x6CU, 0x64U };      /* "en" "World" */
+    static uint8_t       encoded[BENCH_STREAM_MSG_BUF_LEN];
+    static uint8_t       edited[BENCH_STREAM_MSG_BUF_LEN];
+    ndefContext          ctx;
+    ndefMessage          message;
+    ndefRecord           records[BENCH_WRITE_RECORD_NUM];
+    ndefConstBuffer      bufPayload;
+    ndefBuffer           bufEncoded;
+    ndefBuffer           bufEdited;
+    ReturnCode           err;
+
+    /* Field device update: the text record of an otherwise unchanged message is edited */
+    benchWriteMessageInit( &message, records, payloadLen );
+    bufEncoded.buffer = encoded;
+    bufEncoded.length = sizeof(encoded);
+    (void)ndefMessageEncode( &message, &bufEncoded );
+    bufPayload.buffer = textEdit;
+    bufPayload.length = sizeof(textEdit);
+    (void)ndefRecordSetPayload( &records[0], &bufPayload );
+    bufEdited.buffer = edited;
+    bufEdited.length = sizeof(edited);
+    (void)ndefMessageEncode( &message, &bufEdited );
+
+    err = benchNdefDetect( &ctx, benchNfcvTag );
+    if( err == ERR_NONE )
+    {
+        err = ndefPollerWriteRawMessage( &ctx, bufEncoded.buffer, bufEncoded.length );
+    }
+    if( err == ERR_NONE )
+    {
+        err = benchRewrite( &ctx, bufEdited.buffer, bufEdited.length, false, NULL, 0U, "full rewrite" );
+    }
+    if( err == ERR_NONE )
+    {
+        err = ndefPollerWriteRawMessage( &ctx, bufEncoded.buffer, bufEncoded.length );
+    }
+    if( err == ERR_NONE )
+    {
+        err = benchRewrite( &ctx, bufEdited.buffer, bufEdited.length, true, NULL, 0U, "differential, tag read" );
+    }
+    if( err == ERR_NONE )
+    {
+        err = ndefPollerWriteRawMessage( &ctx, bufEncoded.buffer, bufEncoded.length );
+    }
+    if( err == ERR_NONE )
+    {
+        err = benchRewrite( &ctx, bufEdited.buffer, bufEdited.length, true, bufEncoded.buffer, bufEncoded.length, "differential, cached image" );
+    }
+    if( err == ERR_NONE )
+    {
+        err = benchRewrite( &ctx, bufEdited.buffer, bufEdited.length, true, bufEdited.buffer, bufEdited.length, "differential, unchanged" );
+    }
+    if( err != ERR_NONE )
+    {
+        platformLog("NDEF message rewrite failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static int benchRetapRun( uint32_t duration, bool cache )
+{
+    rfalNfcDiscoverParam disc;
+    rfalNfcDevice       *dev;
+    ndefContext          ctx;
+    ndefInfo             info;
+    ReturnCode           err;
+    uint8_t              msg[BENCH_RETAP_MSG_BUF_LEN];
+    uint32_t             msgLen;
+    uint32_t             taps;
+    uint32_t             errors;
+    uint32_t             start;
+    uint32_t             latency;
+
+    st25r95SimInitialize();
+    ndefPollerDetectCacheClear();
+    taps    = 0;
+    errors  = 0;
+    latency = 0;
+
+    st25r95SimSetTagHandler( 0, benchNfcvTag );
+    st25r95SimSetTagPresent( 0, true );
+
+    benchDiscParam( &disc );
+    rfalSelectInstance( 0 );
+    err = rfalNfcInitialize();
+    if( err == ERR_NONE )
+    {
+        err = rfalNfcDiscover( &disc );
+    }
+    if( err != ERR_NONE )
+    {
+        platformLog("Reader initialization failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    /* Each activated tag is read and released: the next activation is a re-tap of the same tag */
+    while( platformGetSysTick() < duration )
+    {
+        rfalNfcWorker();
+
+        if( rfalNfcIsDevActivated( rfalNfcGetState() ) )
+        {
+            if( !cache )
+            {
+                ndefPollerDetectCacheClear();
+            }
+
+            start = st25r95SimGetTimeUs();
+            err   = rfalNfcGetActiveDevice( &dev );
+            if( err == ERR_NONE )
+            {
+                err = ndefPollerContextInitialization( &ctx, dev );
+            }
+            if( err == ERR_NONE )
+            {
+                err = ndefPollerNdefDetect( &ctx, &info );
+            }
+            if( err == ERR_NONE )
+            {
+                err = ndefPollerReadRawMessage( &ctx, msg, sizeof(msg), &msgLen );
+            }
+            latency += (st25r95SimGetTimeUs() - start);
+
+            if( (err != ERR_NONE) || (msgLen != benchNfcvNdef[5]) || (memcmp( msg, &benchNfcvNdef[6], msgLen ) != 0) )
+            {
+                errors++;
+            }
+            taps++;
+            rfalNfcDeactivate( true );
+        }
+    }
+
+    platformLog("%s cache, %u ms simulated, taps: %u, read errors: %u, mean activation to NDEF message read: %u us, ST25R95 commands: %u\r\n",
+                (cache ? "With   " : "Without"), (unsigned)platformGetSysTick(), (unsigned)taps, (unsigned)errors,
+                (unsigned)((taps != 0U) ? (latency / taps) : 0U), (unsigned)st25r95SimGetCommandCount());
+    return ((errors == 0U) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*******************************************************************************/
+static ReturnCode benchMultiWriteExt( const uint8_t *msg, uint32_t msgLen )
+{
+    static uint8_t tlv[BENCH_MWRITE_MAX_LEN + BENCH_STREAM_TLV_LEN + 1U + BENCH_NFCV_BLOCK_LEN];
+    uint8_t        txBuf[BENCH_MWRITE_EXT_HEADER_LEN + BENCH_NFCV_UID_LEN + (BENCH_MWRITE_EXT_BLOCKS * BENCH_NFCV_BLOCK_LEN)];
+    ReturnCode     err;
+    uint32_t       len;
+    uint32_t       pos;
+    uint16_t       blockCnt;
+
+    /* NDEF TLV (1 or 3-byte L field) and Terminator TLV written from block 1, after the CC, padded to whole blocks */
+    ST_MEMSET( tlv, 0x00, sizeof(tlv) );
+    len        = 0U;
+    tlv[len++] = 0x03U;
+    if( msgLen < 0xFFU )
+    {
+        tlv[len++] = (uint8_t)msgLen;
+    }
+    else
+    {
+        tlv[len++] = 0xFFU;
+        tlv[len++] = (uint8_t)(msgLen >> 8U);
+        tlv[len++] = (uint8_t)msgLen;
+    }
+    ST_MEMCPY( &tlv[len], msg, msgLen );
+    len       += msgLen;
+    tlv[len++] = 0xFEU;
+    len        = (((len + BENCH_NFCV_BLOCK_LEN) - 1U) / BENCH_NFCV_BLOCK_LEN);
+
+    err = ERR_NONE;
+    for( pos = 0; (pos < len) && (err == ERR_NONE); pos += blockCnt )
+    {
+        blockCnt = (uint16_t)MIN( (len - pos), BENCH_MWRITE_EXT_BLOCKS );
+        err      = rfalNfcvPollerExtendedWriteMultipleBlocks( RFAL_NFCV_REQ_FLAG_DEFAULT, benchNfcvUID, (uint16_t)(1U + pos), blockCnt, txBuf, (uint16_t)sizeof(txBuf),
+                                                              BENCH_NFCV_BLOCK_LEN, &tlv[pos * BENCH_NFCV_BLOCK_LEN], (uint16_t)(blockCnt * BENCH_NFCV_BLOCK_LEN) );
+    }
+    return err;
+}
+
+
+/*******************************************************************************/
+static void benchWriteMessageInit( ndefMessage *message, ndefRecord *records, uint32_t payloadLen )
+{
+    /* Type 5 Tag image: 4-byte CC (MLEN 1 kB), empty NDEF TLV, Terminator TLV */
+    static const uint8_t tagInit[]     = { 0xE1U, 0x40U, 0x80U, 0x00U, 0x03U, 0x00U, 0xFEU };
+    static const uint8_t textType[]    = { 0x54U };                                                    /* "T"          */
+    static const uint8_t textPayload[] = { 0x02U, 0x65U, 0x6EU, 0x48U, 0x65U, 0x6CU, 0x6CU, 0x6FU };   /* "en" "Hello" */
+    static const uint8_t uriType[]     = { 0x55U };                                                    /* "U"          */
+    static const uint8_t uriPayload[]  = { 0x04U, 0x73U, 0x74U, 0x2EU, 0x63U, 0x6FU, 0x6DU, 0x2FU, 0x73U, 0x74U, 0x32U, 0x35U }; /* "https://" "st.com/st25" */
+    static const uint8_t mediaType[]   = { 0x69U, 0x6DU, 0x61U, 0x67U, 0x65U, 0x2FU, 0x70U, 0x6EU, 0x67U };  /* "image/png" */
+    static uint8_t       mediaPayload[BENCH_WRITE_MAX_PAYLOAD];
+    ndefConstBuffer8     bufType;
+    ndefConstBuffer8     bufId;
+    ndefConstBuffer      bufPayload;
+    uint32_t             i;
+
+    payloadLen = MIN( payloadLen, BENCH_WRITE_MAX_PAYLOAD );
+    for( i = 0; i < payloadLen; i++ )
+    {
+        mediaPayload[i] = (uint8_t)((i * 13U) + 1U);
+    }
+
+    ST_MEMSET( benchNfcvMem, 0x00, sizeof(benchNfcvMem) );
+    ST_MEMCPY( &benchNfcvMem[0][0], tagInit, sizeof(tagInit) );
+
+    bufId.buffer = NULL;
+    bufId.length = 0U;
+    (void)ndefMessageInit( message );
+    bufType.buffer    = textType;
+    bufType.length    = sizeof(textType);
+    bufPayload.buffer = textPayload;
+    bufPayload.length = sizeof(textPayload);
+    (void)ndefRecordInit( &records[0], NDEF_TNF_RTD_WELL_KNOWN_TYPE, &bufType, &bufId, &bufPayload );
+    bufType.buffer    = uriType;
+    bufType.length    = sizeof(uriType);
+    bufPayload.buffer = uriPayload;
+    bufPayload.length = sizeof(uriPayload);
+    (void)ndefRecordInit( &records[1], NDEF_TNF_RTD_WELL_KNOWN_TYPE, &bufType, &bufId, &bufPayload );
+    bufType.buffer    = mediaType;
+    bufType.length    = sizeof(mediaType);
+    bufPayload.buffer = mediaPayload;
+    bufPayload.length = payloadLen;
+    (void)ndefRecordInit( &records[2], NDEF_TNF_MEDIA_TYPE, &bufType, &bufId, &bufPayload );
+    for( i = 0; i < BENCH_WRITE_RECORD_NUM; i++ )
+    {
+        (void)ndefMessageAppend( message, &records[i] );
+    }
+}
+
+
+/*******************************************************************************/
+static ReturnCode benchRewrite( ndefContext *ctx, const uint8_t *buf, uint32_t bufLen, bool diff, const uint8_t *image, uint32_t imageLen, const char *name )
+{
+    static uint8_t readBack[BENCH_STREAM_MSG_BUF_LEN];
+    ReturnCode     err;
+    uint32_t       start;
+    uint32_t       reads;
+    uint32_t       writes;
+    uint32_t       readLen;
+    uint32_t       i;
+
+    ST_MEMSET( benchNfcvWriteCnt, 0x00, sizeof(benchNfcvWriteCnt) );
+    benchNfcvReadCnt = 0U;
+    start = st25r95SimGetTimeUs();
+    if( diff )
+    {
+        err = ndefPollerWriteRawMessageDiff( ctx, buf, bufLen, image, imageLen );
+    }
+    else
+    {
+        err = ndefPollerWriteRawMessage( ctx, buf, bufLen );
+    }
+    start = (st25r95SimGetTimeUs() - start);
+    reads = benchNfcvReadCnt;
+    if( err == ERR_NONE )
+    {
+        err = ndefPollerReadRawMessage( ctx, readBack, sizeof(readBack), &readLen );
+    }
+    if( err != ERR_NONE )
+    {
+        return err;
+    }
+    if( (readLen != bufLen) || (memcmp( readBack, buf, readLen ) != 0) )
+    {
+        return ERR_MEM_CORRUPT;
+    }
+
+    writes = 0U;
+    for( i = 0; i < BENCH_NFCV_BLOCK_NUM; i++ )
+    {
+        writes += benchNfcvWriteCnt[i];
+    }
+    platformLog("%-27s: %3u bytes message in %6u us, blocks read: %2u, blocks written: %3u\r\n",
+                name, (unsigned)bufLen, (unsigned)start, (unsigned)reads, (unsigned)writes);
+    return ERR_NONE;
+}
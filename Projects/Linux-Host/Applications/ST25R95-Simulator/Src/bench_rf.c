@@ -0,0 +1,2140 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_rf.c
+ *
+ *  \author
+ *
+ *  \brief RF and ST25R95 interface benchmarks of the ST25R95 simulator
+ *
+ *  When a number of readers is given, the readers benchmark is run:
+ *  one simulated ST25R95 per reader, each with a tag in its field, are
+ *  polled round-robin through rfalSelectInstance() and the aggregate number
+ *  of tag activations per second of simulated time is reported.
+ *
+ *  When a tag mix is given (single reader), the tag placed in the field
+ *  after each activation is an NFC-A, NFC-B or NFC-V tag drawn with the
+ *  given percentages:
+ *
+ *      st25r95_sim [duration ms] 1 [NFC-A %],[NFC-B %],[NFC-V %]
+ *
+ *  The discovery loop is run once in NFC Forum order and once with adaptive
+ *  polling, and the tags/s and mean time to first detection are reported.
+ *
+ *  The inventory benchmark places populations of 1 to 64 NFC-V tags with
+ *  random UIDs in the field and repeats ISO15693 inventories for the given
+ *  simulated duration per population:
+ *
+ *      st25r95_sim [duration ms] inventory
+ *
+ *  The mean inventory time and number of tags found are reported for the
+ *  fixed 16 slots collision resolution and for the adaptive one, without and
+ *  with the population of the previous inventory as hint.
+ *
+ *  The anticollision benchmark places stacks of 1 to 20 NFC-A cards with
+ *  random single size UIDs in the field and repeats the ISO14443-3
+ *  collision resolution for the given simulated duration per stack:
+ *
+ *      st25r95_sim [duration ms] anticoll
+ *
+ *  The mean resolution time, number of RF frames and number of cards found
+ *  are reported for the full and the fast collision resolution.
+ *
+ *  The broadcast write benchmark places populations of 1 to 32 NFC-V tags
+ *  with random UIDs in the field, one tag out of 8 missing the non addressed
+ *  requests. The tags are inventoried and put to Quiet state, then the same
+ *  block is written to all of them, repeatedly for the given simulated
+ *  duration per population:
+ *
+ *      st25r95_sim [duration ms] broadcast
+ *
+ *  The tags written per second, the mean write time and the number of Write
+ *  Single Block requests sent are reported for addressed writes and for
+ *  rfalNfcvPollerBroadcastWriteSingleBlock(). A last broadcast write with the
+ *  Option flag set, whose Read Single Block responses then carry the block
+ *  security status, must be verified on all tags.
+ *
+ *  The ISO-DEP benchmark places ISO14443-4 NFC-A cards in the field, one
+ *  reliable up to 424 kbps, one getting transmission errors above 212 kbps
+ *  and one supporting 106 kbps only, and repeats sessions (activation, APDU
+ *  exchanges, deselection) for the given simulated duration per card:
+ *
+ *      st25r95_sim [duration ms] isodep
+ *
+ *  The throughput, mean session time, failed sessions and negotiated bit rate
+ *  are reported at 106 kbps, at the highest bit rate and with link adaptation.
+ *
+ *  The worker benchmark runs the discovery loop, Wake-Up mode included, on
+ *  populations of NFC-V tags with random UIDs for the given simulated
+ *  duration per worker budget (see rfalNfcSetWorkerBudget()):
+ *
+ *      st25r95_sim [duration ms] worker
+ *
+ *  The activations per second and the longest rfalNfcWorker() call are
+ *  reported per budget, the run fails when a call exceeds the budget plus
+ *  the longest single step measured with a budget of 0.
+ *
+ *  The nIRQ_OUT interrupt test needs the simulator built with
+ *  ST25R95_IRQ_OUT_INTERRUPT set to true (-DST25R95_IRQ_OUT_INTERRUPT=true):
+ *  the simulated nIRQ_OUT falling edges are then routed to st25r95Isr() and
+ *  every mode runs on the latched edges instead of GPIO polling. The test
+ *  repeats ISO15693 Read Single Block exchanges for the given simulated
+ *  duration per SendRecv latency, running rfalWorker() and sleeping in
+ *  platformWaitForInterrupt() while the exchange is ongoing:
+ *
+ *      st25r95_sim [duration ms] irq
+ *
+ *  The exchanges, nIRQ_OUT edges and longest rfalWorker() call are reported
+ *  per latency, the run fails when a response is read before its edge, when
+ *  an edge is reported twice or when a rfalWorker() call waits.
+ *
+ *  The UART test needs the simulator built with ST25R95_INTERFACE_UART set
+ *  to true (-DST25R95_INTERFACE_UART=true): the ST25R95 is then driven over
+ *  a simulated UART link, its responses written to the circular DMA ring in
+ *  fragments routed to st25r95UartRxEventCallback(). The test repeats
+ *  ISO15693 Read Multiple Blocks exchanges of 1 to 128 blocks, some of them
+ *  timing out or with a CRC error, for the given simulated duration per
+ *  largest fragment length:
+ *
+ *      st25r95_sim [duration ms] uart
+ *
+ *  The exchanges, bytes and reception events are reported per fragment
+ *  length, the run fails on any return code, length or data mismatch.
+ *
+ *  The SPI transfer count repeats ISO15693 Read Multiple Blocks exchanges of
+ *  1 to 128 blocks the given number of times per length and counts the SPI
+ *  transfers of each rfalTransceiveBlockingTxRx() call:
+ *
+ *      st25r95_sim [exchanges] spi
+ *
+ *  The SPI transfers and bytes per transceive are reported per length. With
+ *  ST25R95_SPI_BURST (default true, -DST25R95_SPI_BURST=false for one
+ *  transfer per byte) the run fails when the transfer count depends on the
+ *  frame length.
+ *
+ *  The analog configuration benchmark looks up every Configuration ID (chip
+ *  events and mode/technology, bit rate and direction combinations) the
+ *  given number of rounds, in the default table and in a table of
+ *  RFAL_ANALOG_CONFIG_LUT_SIZE IDs loaded with rfalAnalogConfigListWriteRaw():
+ *
+ *      st25r95_sim [rounds] analog
+ *
+ *  The host time per rfalSetAnalogConfig() lookup, the tables holding no
+ *  register setting, is reported next to the one of a linear scan of the
+ *  table. The run fails when both searches do not find the same IDs.
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#define _POSIX_C_SOURCE 199309L  /* clock_gettime() of the host time benchmarks */
+
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "utils.h"
+#include "st25r95_com.h"
+#include "rfal_nfca.h"
+#include "rfal_nfcv.h"
+#include "rfal_analogConfig.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define BENCH_NFCV_FLAG_OPTION           0x40U   /*!< Request flag: option (non inventory requests) */
+
+#define BENCH_MIX_TECH_NUM               3U      /*!< Tag technologies of the mix: NFC-A, NFC-B, NFC-V */
+#define BENCH_MIX_PERCENT                100U    /*!< Tag mix total                        */
+
+#define BENCH_INV_MAX_TAGS               64U     /*!< Largest population of the inventory benchmark */
+#define BENCH_INV_MODE_NUM               3U      /*!< Inventory modes: fixed, adaptive, adaptive with hint */
+#define BENCH_INV_FLAG_1_SLOT            0x20U   /*!< Inventory flag: 1 slot               */
+#define BENCH_INV_SLOT_BITS              4U      /*!< Mask bits given by the slot number   */
+#define BENCH_INV_NO_SLOT                0xFFU   /*!< No inventory in progress             */
+#define BENCH_NFCV_RES_FLAG_COLLISION    0x01U   /*!< ST25R95 ISO15693 status: collision   */
+
+#define BENCH_BW_MAX_TAGS                32U     /*!< Largest population of the broadcast write benchmark */
+#define BENCH_BW_MODE_NUM                2U      /*!< Broadcast write modes: addressed, broadcast          */
+#define BENCH_BW_BLOCK_NUM               5U      /*!< Block written by the broadcast write benchmark       */
+#define BENCH_BW_WRITE_LATENCY           5000U   /*!< Write Single Block programming time (us)             */
+#define BENCH_BW_MISS_MODULO             8U      /*!< One tag out of BENCH_BW_MISS_MODULO misses the non addressed writes */
+#define BENCH_NFCV_CMD_STAY_QUIET        0x02U   /*!< Stay Quiet command                   */
+#define BENCH_NFCV_CMD_RESET_TO_READY    0x26U   /*!< Reset To Ready command               */
+
+#define BENCH_AC_MAX_TAGS                20U     /*!< Largest stack of the anticollision benchmark */
+#define BENCH_AC_MODE_NUM                2U      /*!< Anticollision modes: full, fast      */
+#define BENCH_AC_TIMEOUT_LATENCY         1000U   /*!< SendRecv latency without response: SLP_REQ FWT (us) */
+#define BENCH_AC_SDD_RES_LEN             (BENCH_NFCA_UID_LEN + 1U) /*!< SDD_RES length: UID and BCC */
+#define BENCH_AC_SDD_REQ_LEN             2U      /*!< SDD_REQ length: SEL_CMD and SEL_PAR  */
+#define BENCH_NFCA_CMD_SLP               0x50U   /*!< SLP_REQ (HLTA) command               */
+#define BENCH_NFCA_RES_FLAG_COLLISION    0x80U   /*!< ST25R95 ISO14443A status: collision  */
+#define BENCH_NFCA_RES_FLAG_CRC          0x20U   /*!< ST25R95 ISO14443A status: CRC error  */
+#define BENCH_NFCA_SEL_RES_ISODEP        0x20U   /*!< SEL_RES: UID complete, ISO14443-4 compliant */
+
+#define BENCH_ID_CARD_NUM                3U      /*!< Cards of the ISO-DEP benchmark       */
+#define BENCH_ID_MODE_NUM                3U      /*!< ISO-DEP modes: 106 kbps, highest bit rate, link adaptation */
+#define BENCH_ID_EXCHANGES               8U      /*!< APDU exchanges per session           */
+#define BENCH_ID_RES_DATA_LEN            200U    /*!< Data bytes of each R-APDU            */
+#define BENCH_ID_RES_MAX_LEN             (1U + BENCH_ID_RES_DATA_LEN + 2U) /*!< Largest block sent by the card: PCB, data and SW */
+#define BENCH_ID_BLOCK_LATENCY           300U    /*!< Card processing time of a block (us) */
+#define BENCH_ID_BYTE_TIME_106           85U     /*!< Air time of a byte at 106 kbps (us), halved at each higher bit rate */
+#define BENCH_ID_ERR_PERCENT             35U     /*!< Corrupted blocks per bit rate step above the reliable one (%) */
+#define BENCH_ID_CMD_RATS                0xE0U   /*!< RATS command                         */
+#define BENCH_ID_CMD_PPS                 0xD0U   /*!< PPS command, CID in the low nibble   */
+#define BENCH_ID_PCB_IBLOCK_MASK         0xE2U   /*!< PCB bits identifying an I-block      */
+#define BENCH_ID_PCB_IBLOCK              0x02U   /*!< PCB of an I-block                    */
+#define BENCH_ID_PCB_RNAK_MASK           0xF6U   /*!< PCB bits identifying an R(NAK)       */
+#define BENCH_ID_PCB_RNAK                0xB2U   /*!< PCB of an R(NAK)                     */
+#define BENCH_ID_PCB_SDSL_MASK           0xF7U   /*!< PCB bits identifying an S(DESELECT)  */
+#define BENCH_ID_PCB_SDSL                0xC2U   /*!< PCB of an S(DESELECT)                */
+
+#define BENCH_WORKER_BUDGET_NUM          4U      /*!< Worker budgets of the worker benchmark                 */
+#define BENCH_WORKER_POP_NUM             3U      /*!< NFC-V populations of the worker benchmark              */
+#define BENCH_WORKER_DEV_LIMIT           5U      /*!< Discovery device limit of the worker benchmark         */
+#define BENCH_WORKER_ARRIVAL             50U     /*!< Time before the tags enter the field (ms)              */
+
+#define BENCH_IRQ_LATENCY_NUM            4U      /*!< SendRecv latencies of the nIRQ_OUT interrupt test      */
+#define BENCH_IRQ_CALL_BOUND             100U    /*!< Longest rfalWorker() call without waiting (us)         */
+#define BENCH_IRQ_FWT                    20U     /*!< Read Single Block frame waiting time (ms)              */
+
+#define BENCH_UART_FRAG_NUM              7U      /*!< Largest fragment lengths of the UART test              */
+#define BENCH_UART_ERR_MODULO            7U      /*!< One exchange out of BENCH_UART_ERR_MODULO times out, the next one gets a CRC error */
+#define BENCH_RMB_MAX_BLOCKS             128U    /*!< Largest Read Multiple Blocks of the UART and SPI tests */
+#define BENCH_RMB_FWT                    20U     /*!< Read Multiple Blocks frame waiting time (ms)           */
+#define BENCH_RMB_FAULT_NONE             0U      /*!< Read Multiple Blocks answered                          */
+#define BENCH_RMB_FAULT_TIMEOUT          1U      /*!< Read Multiple Blocks not answered                      */
+#define BENCH_RMB_FAULT_CRC              2U      /*!< Read Multiple Blocks answered with a CRC error         */
+#define BENCH_NFCV_RES_FLAG_CRC          0x02U   /*!< ST25R95 ISO15693 status: CRC error   */
+
+#define BENCH_SPI_LEN_NUM                5U      /*!< Read Multiple Blocks lengths of the SPI transfer count */
+
+#define BENCH_ANALOG_CHIP_ID_NUM         12U     /*!< Chip specific events: Init to Low Power Off           */
+#define BENCH_ANALOG_TECH_NUM            5U      /*!< Technologies: NFC-A, NFC-B, NFC-F, AP2P, NFC-V         */
+#define BENCH_ANALOG_BR_NUM              10U     /*!< Bit rates: common, 106 to 6780, 1 out of 4 and of 256  */
+#define BENCH_ANALOG_DIR_NUM             4U      /*!< Directions: TX, RX, anticollision, DPO                 */
+#define BENCH_ANALOG_ID_NUM              (BENCH_ANALOG_CHIP_ID_NUM + (2U * BENCH_ANALOG_TECH_NUM * BENCH_ANALOG_BR_NUM * BENCH_ANALOG_DIR_NUM)) /*!< Configuration IDs looked up */
+#define BENCH_ANALOG_TBL_NUM             2U      /*!< Tables: default, RFAL_ANALOG_CONFIG_LUT_SIZE IDs       */
+#define BENCH_ANALOG_SET_LEN             4U      /*!< Register-Mask-Value set: 16-bit address, mask, value   */
+#define BENCH_ANALOG_ENTRY_LEN           3U      /*!< Configuration ID and number of sets                    */
+
+/*
+******************************************************************************
+* LOCAL TYPES
+******************************************************************************
+*/
+
+/*! Tag handlers of the tag mix, in mix order */
+typedef enum
+{
+    BENCH_MIX_TAG_NFCA = 0,                      /*!< NFC-A (T2T) tag                      */
+    BENCH_MIX_TAG_NFCB = 1,                      /*!< NFC-B tag without ISO-DEP            */
+    BENCH_MIX_TAG_NFCV = 2                       /*!< NFC-V tag                            */
+} benchMixTag;
+
+/*! ISO14443-3 PICC states of the anticollision benchmark cards */
+typedef enum
+{
+    BENCH_AC_IDLE,                               /*!< IDLE: answers SENS_REQ and ALL_REQ   */
+    BENCH_AC_READY,                              /*!< READY: answers matching SDD_REQ and SEL_REQ */
+    BENCH_AC_ACTIVE,                             /*!< ACTIVE: selected                     */
+    BENCH_AC_HALT                                /*!< HALT: answers ALL_REQ only           */
+} benchAcState;
+
+/*! ISO14443-4 card of the ISO-DEP benchmark */
+typedef struct
+{
+    const char  *name;                           /*!< Card description                     */
+    uint8_t     ta;                              /*!< ATS TA: supported bit rates          */
+    rfalBitRate reliableBR;                      /*!< Highest bit rate without transmission errors */
+} benchIdCard;
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+
+static uint8_t  benchInvUID[BENCH_INV_MAX_TAGS][BENCH_NFCV_UID_LEN]; /* UIDs of the inventory benchmark population, LSB first */
+static uint8_t  benchInvTagNum;              /* Tags in the field of the inventory benchmark       */
+static uint8_t  benchInvMask[BENCH_NFCV_UID_LEN]; /* Mask of the inventory in progress             */
+static uint8_t  benchInvMaskLen;             /* Mask length of the inventory in progress (bits)    */
+static uint8_t  benchInvSlot;                /* Current slot of a 16 slots inventory, BENCH_INV_NO_SLOT: 1 slot */
+static bool     benchInvQuiet[BENCH_INV_MAX_TAGS]; /* Tags in Quiet state, not answering inventories   */
+static uint8_t  benchBwMem[BENCH_INV_MAX_TAGS][BENCH_NFCV_BLOCK_LEN]; /* Block written by the broadcast write benchmark */
+static uint32_t benchBwWrites;               /* Write Single Block requests sent by the reader     */
+
+static uint8_t     benchAcUID[BENCH_AC_MAX_TAGS][BENCH_AC_SDD_RES_LEN]; /* UIDs and BCC of the anticollision benchmark stack */
+static benchAcState benchAcTagState[BENCH_AC_MAX_TAGS]; /* ISO14443-3 state of each card             */
+static uint8_t     benchAcTagNum;            /* Cards in the field of the anticollision benchmark  */
+static uint32_t    benchAcFrames;            /* RF frames sent by the reader                       */
+
+static const benchIdCard *benchIdCur;        /* Card in the field of the ISO-DEP benchmark         */
+static rfalBitRate benchIdTxBR;              /* Card to reader bit rate (DSI)                      */
+static rfalBitRate benchIdRxBR;              /* Reader to card bit rate (DRI)                      */
+static uint8_t     benchIdLastRes[BENCH_ID_RES_MAX_LEN]; /* Last block sent, repeated upon R(NAK)  */
+static uint16_t    benchIdLastResLen;        /* Length of the last block sent                      */
+static uint32_t    benchIdSeed;              /* Transmission error pseudo random generator state   */
+
+#if ST25R95_IRQ_OUT_INTERRUPT
+static uint32_t      benchIrqEdges;              /* nIRQ_OUT edges routed to st25r95Isr()           */
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
+#if ST25R95_INTERFACE_UART
+static uint32_t      benchUartRxEvents;          /* Reception events routed to st25r95UartRxEventCallback() */
+static uint32_t      benchUartTxCplts;           /* Transmissions complete routed to st25r95UartTxCpltCallback() */
+#endif /* ST25R95_INTERFACE_UART */
+static uint8_t       benchRmbFault;              /* Fault of the next Read Multiple Blocks (BENCH_RMB_FAULT_xxx) */
+
+static benchMixTag   benchMixCurTag;             /* Tag currently in the field of the mix benchmark */
+static uint32_t      benchMixSeed;               /* Tag mix pseudo random generator state           */
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static int benchMixRun( uint32_t duration, const uint8_t *mix, bool adaptive );
+static benchMixTag benchMixNextTag( const uint8_t *mix );
+static ReturnCode benchInventoryRun( uint8_t mode, uint8_t popHint, uint8_t *devCnt );
+static void benchInvTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+static bool benchInvBitsMatch( const uint8_t *uid, const uint8_t *mask, uint8_t start, uint8_t len );
+static void benchBwTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+static void benchAcTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+static void benchAcSdd( const uint8_t *txBuf, uint16_t txLen, st25r95SimFrame *rx );
+static ReturnCode benchIsoDepSession( rfalBitRate maxBR, rfalBitRate *br );
+static void benchIdTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+static void benchIdRespond( st25r95SimFrame *rx, uint16_t txLen, const uint8_t *data, uint16_t len );
+static ReturnCode benchWorkerRun( uint32_t duration, uint32_t budget, uint32_t *activations, uint32_t *maxTime );
+#if ST25R95_IRQ_OUT_INTERRUPT
+static ReturnCode benchIrqRun( uint32_t duration, uint32_t *exchanges, uint32_t *edges, uint32_t *maxCall );
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+#if ST25R95_INTERFACE_UART
+static ReturnCode benchUartRun( uint32_t duration, uint32_t *exchanges, uint32_t *bytes );
+#endif /* ST25R95_INTERFACE_UART */
+static uint16_t benchAnalogTable( const uint16_t *ids, uint8_t idNum, bool testReg, uint8_t *tbl );
+static uint8_t benchAnalogScan( const uint8_t *tbl, uint16_t tblSize, uint16_t configId, uint16_t *configOffset );
+static void benchRmbTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+static void benchMixTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx );
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+int benchReaderBenchmark( uint32_t duration, uint8_t readers )
+{
+    rfalNfcDiscoverParam disc;
+    ReturnCode           err;
+    uint32_t             tags;
+    uint8_t              i;
+
+    if( (readers == 0U) || (readers > RFAL_FEATURE_MAX_INSTANCES) )
+    {
+        platformLog("Number of readers must be 1..%u\r\n", (unsigned)RFAL_FEATURE_MAX_INSTANCES);
+        return EXIT_FAILURE;
+    }
+
+    benchDiscParam( &disc );
+
+    for( i = 0; i < readers; i++ )
+    {
+        st25r95SimSetTagHandler( i, benchNfcvTag );
+        st25r95SimSetTagPresent( i, true );
+
+        rfalSelectInstance( i );
+        err = rfalNfcInitialize();
+        if( err == ERR_NONE )
+        {
+            err = rfalNfcDiscover( &disc );
+        }
+        if( err != ERR_NONE )
+        {
+            platformLog("Reader %u initialization failed: %d\r\n", (unsigned)i, err);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Round-robin: each reader runs one worker step, activated tags are released and polled again */
+    tags = 0;
+    while( platformGetSysTick() < duration )
+    {
+        for( i = 0; i < readers; i++ )
+        {
+            rfalSelectInstance( i );
+            rfalNfcWorker();
+
+            if( rfalNfcIsDevActivated( rfalNfcGetState() ) )
+            {
+                tags++;
+                rfalNfcDeactivate( true );
+            }
+        }
+    }
+
+    platformLog("%u readers, %u ms simulated, tags activated: %u, aggregate tags/s: %u, ST25R95 commands: %u\r\n", (unsigned)readers, (unsigned)platformGetSysTick(),
+                (unsigned)tags, (unsigned)((tags * 1000U) / platformGetSysTick()), (unsigned)st25r95SimGetCommandCount());
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchMixBenchmark( uint32_t duration, const char *mixStr )
+{
+    uint8_t  mix[BENCH_MIX_TECH_NUM];
+    uint32_t total;
+    char    *end;
+    uint8_t  i;
+
+    /* Parse "A,B,V" percentages */
+    total = 0;
+    for( i = 0; i < BENCH_MIX_TECH_NUM; i++ )
+    {
+        mix[i] = (uint8_t)MIN( strtoul( mixStr, &end, 0 ), BENCH_MIX_PERCENT );
+        total += mix[i];
+        mixStr = ((*end == ',') ? (end + 1) : end);
+    }
+
+    if( total != BENCH_MIX_PERCENT )
+    {
+        platformLog("Tag mix must be NFC-A %%,NFC-B %%,NFC-V %% with a total of 100\r\n");
+        return EXIT_FAILURE;
+    }
+
+    if( (benchMixRun( duration, mix, false ) != EXIT_SUCCESS) || (benchMixRun( duration, mix, true ) != EXIT_SUCCESS) )
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchInventoryBenchmark( uint32_t duration )
+{
+    static const char * const modeName[BENCH_INV_MODE_NUM] = { "fixed", "adaptive", "adaptive+hint" };
+    uint32_t   time[BENCH_INV_MODE_NUM];
+    uint32_t   found[BENCH_INV_MODE_NUM];
+    uint32_t   runs[BENCH_INV_MODE_NUM];
+    uint32_t   start;
+    uint32_t   invStart;
+    uint32_t   seed;
+    ReturnCode err;
+    uint8_t    devCnt;
+    uint8_t    popHint;
+    uint8_t    mode;
+    uint8_t    i;
+    uint8_t    j;
+
+    st25r95SimInitialize();
+    st25r95SimSetTagHandler( 0, benchInvTagHandler );
+    st25r95SimSetTagPresent( 0, true );
+
+    rfalSelectInstance( 0 );
+    err = rfalNfcInitialize();
+    if( err == ERR_NONE )
+    {
+        err = rfalNfcvPollerInitialize();
+    }
+    if( err == ERR_NONE )
+    {
+        err = rfalFieldOnAndStartGT();
+    }
+    if( err != ERR_NONE )
+    {
+        platformLog("Reader initialization failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    for( benchInvTagNum = 1U; benchInvTagNum <= BENCH_INV_MAX_TAGS; benchInvTagNum *= 2U )
+    {
+        for( mode = 0; mode < BENCH_INV_MODE_NUM; mode++ )
+        {
+            /* Same populations for every mode */
+            seed    = benchInvTagNum;
+            popHint = 0U;
+            time[mode]  = 0U;
+            found[mode] = 0U;
+            runs[mode]  = 0U;
+
+            start = platformGetSysTick();
+            while( (platformGetSysTick() - start) < duration )
+            {
+                for( i = 0; i < benchInvTagNum; i++ )
+                {
+                    for( j = 0; j < (BENCH_NFCV_UID_LEN - 1U); j++ )
+                    {
+                        seed = ((seed * 1103515245U) + 12345U);
+                        benchInvUID[i][j] = (uint8_t)(seed >> 16U);
+                    }
+                    benchInvUID[i][BENCH_NFCV_UID_LEN - 1U] = 0xE0U;
+                }
+
+                invStart     = st25r95SimGetTimeUs();
+                err          = benchInventoryRun( mode, popHint, &devCnt );
+                time[mode]  += (st25r95SimGetTimeUs() - invStart);
+                if( err != ERR_NONE )
+                {
+                    platformLog("Inventory failed: %d\r\n", err);
+                    return EXIT_FAILURE;
+                }
+                found[mode] += devCnt;
+                runs[mode]++;
+                popHint = devCnt;
+            }
+        }
+
+        platformLog("%2u tags", (unsigned)benchInvTagNum);
+        for( mode = 0; mode < BENCH_INV_MODE_NUM; mode++ )
+        {
+            platformLog(" | %s: %4u ms, %2u found", modeName[mode], (unsigned)(time[mode] / (runs[mode] * 1000U)), (unsigned)(found[mode] / runs[mode]));
+        }
+        platformLog("\r\n");
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchBroadcastBenchmark( uint32_t duration )
+{
+    static const char * const modeName[BENCH_BW_MODE_NUM] = { "addressed", "broadcast" };
+    static rfalNfcvListenDevice devList[BENCH_BW_MAX_TAGS];
+    uint8_t    wrData[BENCH_NFCV_BLOCK_LEN];
+    uint32_t   time[BENCH_BW_MODE_NUM];
+    uint32_t   written[BENCH_BW_MODE_NUM];
+    uint32_t   writes[BENCH_BW_MODE_NUM];
+    uint32_t   runs[BENCH_BW_MODE_NUM];
+    uint32_t   start;
+    uint32_t   wrStart;
+    uint32_t   seed;
+    ReturnCode err;
+    uint8_t    devCnt;
+    uint8_t    mode;
+    uint8_t    i;
+    uint8_t    j;
+
+    st25r95SimInitialize();
+    st25r95SimSetTagHandler( 0, benchBwTagHandler );
+    st25r95SimSetTagPresent( 0, true );
+
+    rfalSelectInstance( 0 );
+    err = rfalNfcInitialize();
+    if( err == ERR_NONE )
+    {
+        err = rfalNfcvPollerInitialize();
+    }
+    if( err == ERR_NONE )
+    {
+        err = rfalFieldOnAndStartGT();
+    }
+    if( err != ERR_NONE )
+    {
+        platformLog("Reader initialization failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    for( benchInvTagNum = 1U; benchInvTagNum <= BENCH_BW_MAX_TAGS; benchInvTagNum *= 2U )
+    {
+        for( mode = 0; mode < BENCH_BW_MODE_NUM; mode++ )
+        {
+            /* Same populations and data for every mode */
+            seed          = benchInvTagNum;
+            time[mode]    = 0U;
+            written[mode] = 0U;
+            writes[mode]  = 0U;
+            runs[mode]    = 0U;
+
+            start = platformGetSysTick();
+            while( (platformGetSysTick() - start) < duration )
+            {
+                for( i = 0; i < benchInvTagNum; i++ )
+                {
+                    for( j = 0; j < (BENCH_NFCV_UID_LEN - 1U); j++ )
+                    {
+                        seed = ((seed * 1103515245U) + 12345U);
+                        benchInvUID[i][j] = (uint8_t)(seed >> 16U);
+                    }
+                    benchInvUID[i][BENCH_NFCV_UID_LEN - 1U] = 0xE0U;
+                    benchInvQuiet[i] = false;
+                    ST_MEMSET( benchBwMem[i], 0x00, BENCH_NFCV_BLOCK_LEN );
+                }
+                for( j = 0; j < BENCH_NFCV_BLOCK_LEN; j++ )
+                {
+                    seed = ((seed * 1103515245U) + 12345U);
+                    wrData[j] = (uint8_t)((seed >> 16U) | 0x01U);
+                }
+
+                /* Tags inventoried and put to Quiet state */
+                err = rfalNfcvPollerSleepCollisionResolution( BENCH_BW_MAX_TAGS, devList, &devCnt );
+                if( (err != ERR_NONE) || (devCnt != benchInvTagNum) )
+                {
+                    platformLog("Inventory failed: %d, %u tags found\r\n", err, (unsigned)devCnt);
+                    return EXIT_FAILURE;
+                }
+
+                benchBwWrites = 0U;
+                wrStart      = st25r95SimGetTimeUs();
+                if( mode == 0U )
+                {
+                    for( i = 0; i < devCnt; i++ )
+                    {
+                        (void)rfalNfcvPollerWriteSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, devList[i].InvRes.UID, BENCH_BW_BLOCK_NUM, wrData, BENCH_NFCV_BLOCK_LEN );
+                    }
+                }
+                else
+                {
+                    (void)rfalNfcvPollerBroadcastWriteSingleBlock( RFAL_NFCV_REQ_FLAG_DEFAULT, BENCH_BW_BLOCK_NUM, wrData, BENCH_NFCV_BLOCK_LEN, devList, devCnt, NULL );
+                }
+                time[mode]   += (st25r95SimGetTimeUs() - wrStart);
+                writes[mode] += benchBwWrites;
+                runs[mode]++;
+
+                for( i = 0; i < benchInvTagNum; i++ )
+                {
+                    if( memcmp( benchBwMem[i], wrData, BENCH_NFCV_BLOCK_LEN ) == 0 )
+                    {
+                        written[mode]++;
+                    }
+                }
+            }
+        }
+
+        platformLog("%2u tags", (unsigned)benchInvTagNum);
+        for( mode = 0; mode < BENCH_BW_MODE_NUM; mode++ )
+        {
+            platformLog(" | %s: %4u tags/s, %6u us, %2u writes", modeName[mode],
+                        (unsigned)(((uint64_t)written[mode] * 1000000U) / time[mode]),
+                        (unsigned)(time[mode] / runs[mode]), (unsigned)(writes[mode] / runs[mode]));
+        }
+        platformLog("\r\n");
+    }
+
+    /* Option flag: the verification must not take the block security status for data */
+    for( j = 0; j < BENCH_NFCV_BLOCK_LEN; j++ )
+    {
+        wrData[j] = (uint8_t)~wrData[j];
+    }
+    err = rfalNfcvPollerBroadcastWriteSingleBlock( ((uint8_t)RFAL_NFCV_REQ_FLAG_DEFAULT | (uint8_t)RFAL_NFCV_REQ_FLAG_OPTION), BENCH_BW_BLOCK_NUM, wrData, BENCH_NFCV_BLOCK_LEN, devList, devCnt, &i );
+    if( err != ERR_NONE )
+    {
+        platformLog("Broadcast write with Option flag failed: %d, %u tags not verified\r\n", err, (unsigned)i);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchAnticollBenchmark( uint32_t duration )
+{
+    static const char * const modeName[BENCH_AC_MODE_NUM] = { "full", "fast" };
+    static const uint8_t stacks[] = { 1U, 2U, 4U, 8U, 12U, 16U, 20U };
+    static rfalNfcaListenDevice devList[BENCH_AC_MAX_TAGS];
+    uint32_t   time[BENCH_AC_MODE_NUM];
+    uint32_t   frames[BENCH_AC_MODE_NUM];
+    uint32_t   found[BENCH_AC_MODE_NUM];
+    uint32_t   runs[BENCH_AC_MODE_NUM];
+    uint32_t   start;
+    uint32_t   acStart;
+    uint32_t   seed;
+    ReturnCode err;
+    uint8_t    devCnt;
+    uint8_t    mode;
+    uint8_t    s;
+    uint8_t    i;
+    uint8_t    j;
+
+    st25r95SimInitialize();
+    st25r95SimSetLatency( ST25R95_SIM_DEFAULT_CMD_LATENCY, ST25R95_SIM_DEFAULT_RF_LATENCY, BENCH_AC_TIMEOUT_LATENCY );
+    st25r95SimSetTagHandler( 0, benchAcTagHandler );
+    st25r95SimSetTagPresent( 0, true );
+
+    rfalSelectInstance( 0 );
+    err = rfalNfcInitialize();
+    if( err == ERR_NONE )
+    {
+        err = rfalNfcaPollerInitialize();
+    }
+    if( err == ERR_NONE )
+    {
+        err = rfalFieldOnAndStartGT();
+    }
+    if( err != ERR_NONE )
+    {
+        platformLog("Reader initialization failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    for( s = 0; s < SIZEOF_ARRAY(stacks); s++ )
+    {
+        benchAcTagNum = stacks[s];
+
+        for( mode = 0; mode < BENCH_AC_MODE_NUM; mode++ )
+        {
+            /* Same stacks for every mode */
+            seed   = benchAcTagNum;
+            time[mode]   = 0U;
+            frames[mode] = 0U;
+            found[mode]  = 0U;
+            runs[mode]   = 0U;
+
+            start = platformGetSysTick();
+            while( (platformGetSysTick() - start) < duration )
+            {
+                /* New stack placed in the field: random single size UIDs, cascade tag excluded */
+                for( i = 0; i < benchAcTagNum; i++ )
+                {
+                    benchAcUID[i][BENCH_NFCA_UID_LEN] = 0U;
+                    for( j = 0; j < BENCH_NFCA_UID_LEN; j++ )
+                    {
+                        seed = ((seed * 1103515245U) + 12345U);
+                        benchAcUID[i][j] = (uint8_t)(seed >> 16U);
+                        benchAcUID[i][BENCH_NFCA_UID_LEN] ^= benchAcUID[i][j]; /* BCC */
+                    }
+                    if( benchAcUID[i][0] == 0x88U )
+                    {
+                        benchAcUID[i][0] = 0x08U;
+                        benchAcUID[i][BENCH_NFCA_UID_LEN] ^= (0x88U ^ 0x08U);
+                    }
+                    benchAcTagState[i] = BENCH_AC_IDLE;
+                }
+
+                benchAcFrames = 0U;
+                acStart       = st25r95SimGetTimeUs();
+                if( mode == 0U )
+                {
+                    err = rfalNfcaPollerFullCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, BENCH_AC_MAX_TAGS, devList, &devCnt );
+                }
+                else
+                {
+                    err = rfalNfcaPollerFastCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, BENCH_AC_MAX_TAGS, devList, &devCnt );
+                }
+                time[mode]   += (st25r95SimGetTimeUs() - acStart);
+                frames[mode] += benchAcFrames;
+                if( err != ERR_NONE )
+                {
+                    platformLog("Collision resolution failed: %d\r\n", err);
+                    return EXIT_FAILURE;
+                }
+                found[mode] += devCnt;
+                runs[mode]++;
+            }
+        }
+
+        platformLog("%2u cards", (unsigned)benchAcTagNum);
+        for( mode = 0; mode < BENCH_AC_MODE_NUM; mode++ )
+        {
+            platformLog(" | %s: %6u us, %3u frames, %2u found", modeName[mode], (unsigned)(time[mode] / runs[mode]),
+                        (unsigned)(frames[mode] / runs[mode]), (unsigned)(found[mode] / runs[mode]));
+        }
+        platformLog("\r\n");
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchIsoDepBenchmark( uint32_t duration )
+{
+    static const benchIdCard cards[BENCH_ID_CARD_NUM] = {
+        { "reliable up to 424", 0x77U, RFAL_BR_424 },   /* TA: up to 848 kbps in both directions */
+        { "errors above 212  ", 0x77U, RFAL_BR_212 },
+        { "106 only          ", 0x00U, RFAL_BR_106 }
+    };
+    static const char * const modeName[BENCH_ID_MODE_NUM] = { "106", "highest", "adaptive" };
+    static const rfalBitRate  modeBR[BENCH_ID_MODE_NUM]  = { RFAL_BR_KEEP, RFAL_BR_848, RFAL_BR_848 };
+    static const uint16_t     brKbps[]                   = { 106U, 212U, 424U, 848U };
+    uint32_t    start;
+    uint32_t    sessStart;
+    uint32_t    time;
+    uint32_t    sessions;
+    uint32_t    failed;
+    rfalBitRate br;
+    ReturnCode  err;
+    uint8_t     c;
+    uint8_t     mode;
+
+    for( c = 0; c < BENCH_ID_CARD_NUM; c++ )
+    {
+        platformLog("%s", cards[c].name);
+
+        for( mode = 0; mode < BENCH_ID_MODE_NUM; mode++ )
+        {
+            /* Same errors for every mode, nothing learned from the previous card */
+            st25r95SimInitialize();
+            st25r95SimSetTagHandler( 0, benchIdTagHandler );
+            st25r95SimSetTagPresent( 0, true );
+            rfalSelectInstance( 0 );
+            err = rfalInitialize();
+            if( err != ERR_NONE )
+            {
+                platformLog("Reader initialization failed: %d\r\n", err);
+                return EXIT_FAILURE;
+            }
+            rfalIsoDepPollResetLinkAdaptation();
+
+            benchIdCur = &cards[c];
+            benchIdSeed = 1U;
+            time       = 0U;
+            sessions   = 0U;
+            failed     = 0U;
+            br         = RFAL_BR_106;
+
+            start = platformGetSysTick();
+            while( (platformGetSysTick() - start) < duration )
+            {
+                /* Without adaptation every session starts again at the highest bit rate */
+                if( mode != (BENCH_ID_MODE_NUM - 1U) )
+                {
+                    rfalIsoDepPollResetLinkAdaptation();
+                }
+
+                sessStart = st25r95SimGetTimeUs();
+                err       = benchIsoDepSession( modeBR[mode], &br );
+                time     += (st25r95SimGetTimeUs() - sessStart);
+                sessions++;
+                if( err != ERR_NONE )
+                {
+                    failed++;
+                }
+            }
+
+            platformLog(" | %s: %3u kB/s, %5u us, %2u failed, %3u kbps", modeName[mode],
+                        (unsigned)(((uint64_t)(sessions - failed) * BENCH_ID_EXCHANGES * BENCH_ID_RES_DATA_LEN * 1000U) / time),
+                        (unsigned)(time / sessions), (unsigned)failed, (unsigned)brKbps[br]);
+        }
+        platformLog("\r\n");
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchWorkerBenchmark( uint32_t duration )
+{
+    static const uint32_t budget[BENCH_WORKER_BUDGET_NUM] = { 0U, 2000U, 10000U, 50000U };  /* us */
+    static const uint8_t  pop[BENCH_WORKER_POP_NUM]      = { 1U, 4U, 16U };
+    uint32_t   activations;
+    uint32_t   maxTime;
+    uint32_t   maxStep;
+    ReturnCode err;
+    uint8_t    p;
+    uint8_t    b;
+
+    for( p = 0; p < BENCH_WORKER_POP_NUM; p++ )
+    {
+        benchInvTagNum = pop[p];
+        maxStep       = 0U;
+
+        for( b = 0; b < BENCH_WORKER_BUDGET_NUM; b++ )
+        {
+            err = benchWorkerRun( duration, budget[b], &activations, &maxTime );
+            if( err != ERR_NONE )
+            {
+                platformLog("Worker benchmark failed: %d\r\n", err);
+                return EXIT_FAILURE;
+            }
+
+            /* With a budget of 0 every call is a single step */
+            if( budget[b] == 0U )
+            {
+                maxStep = maxTime;
+            }
+
+            platformLog("%2u tags | budget: %5u us | activations/s: %3u | longest rfalNfcWorker(): %5u us, bound: %5u us\r\n", (unsigned)benchInvTagNum, (unsigned)budget[b],
+                        (unsigned)((activations * 1000U) / duration), (unsigned)maxTime, (unsigned)(budget[b] + maxStep));
+
+            if( maxTime > (budget[b] + maxStep) )
+            {
+                platformLog("rfalNfcWorker() exceeded its budget\r\n");
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+int benchIrqBenchmark( uint32_t duration )
+{
+#if ST25R95_IRQ_OUT_INTERRUPT
+    static const uint32_t latency[BENCH_IRQ_LATENCY_NUM] = { 0U, 1U, ST25R95_SIM_DEFAULT_RF_LATENCY, ST25R95_SIM_DEFAULT_TIMEOUT_LATENCY };  /* us */
+    uint32_t   exchanges;
+    uint32_t   edges;
+    uint32_t   maxCall;
+    ReturnCode err;
+    uint8_t    l;
+
+    for( l = 0; l < BENCH_IRQ_LATENCY_NUM; l++ )
+    {
+        st25r95SimInitialize();
+        st25r95SimSetLatency( ST25R95_SIM_DEFAULT_CMD_LATENCY, latency[l], ST25R95_SIM_DEFAULT_TIMEOUT_LATENCY );
+
+        err = benchIrqRun( duration, &exchanges, &edges, &maxCall );
+        if( err != ERR_NONE )
+        {
+            platformLog("nIRQ_OUT interrupt test failed: %d\r\n", err);
+            return EXIT_FAILURE;
+        }
+
+        platformLog("SendRecv latency: %4u us | exchanges: %5u | nIRQ_OUT edges: %5u | longest rfalWorker(): %3u us, bound: %3u us\r\n", (unsigned)latency[l],
+                    (unsigned)exchanges, (unsigned)edges, (unsigned)maxCall, (unsigned)BENCH_IRQ_CALL_BOUND);
+
+        if( maxCall > BENCH_IRQ_CALL_BOUND )
+        {
+            platformLog("rfalWorker() waited for a response\r\n");
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+#else
+    NO_WARNING(duration);
+    platformLog("nIRQ_OUT is polled: build with -DST25R95_IRQ_OUT_INTERRUPT=true\r\n");
+    return EXIT_FAILURE;
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+}
+
+
+#if ST25R95_IRQ_OUT_INTERRUPT
+/*******************************************************************************/
+void benchIrqOutIsr( uint8_t chip )
+{
+    NO_WARNING(chip);
+
+    benchIrqEdges++;
+    st25r95Isr();
+}
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
+
+/*******************************************************************************/
+int benchUartBenchmark( uint32_t duration )
+{
+#if ST25R95_INTERFACE_UART
+    static const uint16_t fragMax[BENCH_UART_FRAG_NUM] = { 1U, 2U, 3U, 5U, 8U, 64U, 0U };  /* 0: whole response at once */
+    uint32_t   exchanges;
+    uint32_t   bytes;
+    ReturnCode err;
+    uint8_t    f;
+
+    for( f = 0; f < BENCH_UART_FRAG_NUM; f++ )
+    {
+        st25r95SimInitialize();
+        st25r95SimSetUartFragment( fragMax[f], (0x5EEDU + f) );
+        benchUartRxEvents = 0U;
+        benchUartTxCplts = 0U;
+
+        err = benchUartRun( duration, &exchanges, &bytes );
+        if( err != ERR_NONE )
+        {
+            platformLog("UART test failed with largest fragment of %u bytes: %d\r\n", (unsigned)fragMax[f], err);
+            return EXIT_FAILURE;
+        }
+
+        platformLog("Largest fragment: %3u bytes | exchanges: %5u | bytes: %7u | reception events: %7u | transmissions complete: %5u\r\n", (unsigned)fragMax[f],
+                    (unsigned)exchanges, (unsigned)bytes, (unsigned)benchUartRxEvents, (unsigned)benchUartTxCplts);
+    }
+    return EXIT_SUCCESS;
+#else
+    NO_WARNING(duration);
+    platformLog("ST25R95 is driven over SPI: build with -DST25R95_INTERFACE_UART=true\r\n");
+    return EXIT_FAILURE;
+#endif /* ST25R95_INTERFACE_UART */
+}
+
+
+#if ST25R95_INTERFACE_UART
+/*******************************************************************************/
+void benchUartRxEvent( void )
+{
+    benchUartRxEvents++;
+    st25r95UartRxEventCallback();
+}
+
+
+/*******************************************************************************/
+void benchUartTxCplt( void )
+{
+    benchUartTxCplts++;
+    st25r95UartTxCpltCallback();
+}
+#endif /* ST25R95_INTERFACE_UART */
+
+
+/*******************************************************************************/
+int benchSpiBenchmark( uint32_t exchanges )
+{
+#if ST25R95_INTERFACE_UART
+    NO_WARNING(exchanges);
+    platformLog("ST25R95 is driven over UART: build without -DST25R95_INTERFACE_UART=true\r\n");
+    return EXIT_FAILURE;
+#else
+    static const uint16_t blocks[BENCH_SPI_LEN_NUM] = { 1U, 8U, 32U, 64U, BENCH_RMB_MAX_BLOCKS };
+    uint8_t    req[] = { 0x02U, BENCH_NFCV_CMD_READ_MULTIPLE_BLOCKS, 0x00U, 0x00U };  /* High data rate, non addressed */
+    uint8_t    res[1U + (BENCH_RMB_MAX_BLOCKS * BENCH_NFCV_BLOCK_LEN) + RFAL_CRC_LEN];
+    uint16_t   rcvdLen;
+    uint32_t   transfers;
+    uint32_t   bytes;
+    uint32_t   minTransfers;
+    uint32_t   maxTransfers;
+    uint32_t   firstTransfers;
+    uint32_t   i;
+    ReturnCode err;
+    uint8_t    l;
+
+    st25r95SimInitialize();
+    st25r95SimSetTagHandler( 0, benchRmbTagHandler );
+    st25r95SimSetTagPresent( 0, true );
+    benchRmbFault = BENCH_RMB_FAULT_NONE;
+    for( i = 0; i < (BENCH_RMB_MAX_BLOCKS * BENCH_NFCV_BLOCK_LEN); i++ )
+    {
+        benchNfcvMem[i / BENCH_NFCV_BLOCK_LEN][i % BENCH_NFCV_BLOCK_LEN] = (uint8_t)i;
+    }
+
+    rfalSelectInstance( 0 );
+    if( (rfalInitialize() != ERR_NONE) || (rfalNfcvPollerInitialize() != ERR_NONE) || (rfalFieldOnAndStartGT() != ERR_NONE) )
+    {
+        platformLog("SPI transfer count failed: RFAL initialization\r\n");
+        return EXIT_FAILURE;
+    }
+
+    exchanges      = MAX( exchanges, 1U );
+    firstTransfers = 0U;
+    for( l = 0; l < BENCH_SPI_LEN_NUM; l++ )
+    {
+        req[3]       = (uint8_t)(blocks[l] - 1U);
+        minTransfers = UINT32_MAX;
+        maxTransfers = 0U;
+        bytes        = 0U;
+        for( i = 0; i < exchanges; i++ )
+        {
+            /* Transfers of a whole transceive: SendRecv, nIRQ_OUT polling and response read */
+            transfers = st25r95SimGetSpiTransferCount();
+            bytes    -= st25r95SimGetSpiByteCount();
+            err = rfalTransceiveBlockingTxRx( req, sizeof(req), res, sizeof(res), &rcvdLen, RFAL_TXRX_FLAGS_DEFAULT, rfalConvMsTo1fc( BENCH_RMB_FWT ) );
+            transfers = (st25r95SimGetSpiTransferCount() - transfers);
+            bytes    += st25r95SimGetSpiByteCount();
+
+            if( (err != ERR_NONE) || (rcvdLen != (1U + (blocks[l] * BENCH_NFCV_BLOCK_LEN))) || (memcmp( &res[1], benchNfcvMem[0], (blocks[l] * BENCH_NFCV_BLOCK_LEN) ) != 0) )
+            {
+                platformLog("SPI transfer count failed: %u blocks, error %d, %u bytes\r\n", (unsigned)blocks[l], err, (unsigned)rcvdLen);
+                return EXIT_FAILURE;
+            }
+            minTransfers = MIN( minTransfers, transfers );
+            maxTransfers = MAX( maxTransfers, transfers );
+        }
+
+        platformLog("%3u blocks | response: %3u bytes | SPI transfers per transceive: %3u to %3u | SPI bytes per transceive: %4u\r\n", (unsigned)blocks[l],
+                    (unsigned)rcvdLen, (unsigned)minTransfers, (unsigned)maxTransfers, (unsigned)(bytes / exchanges));
+
+#if ST25R95_SPI_BURST
+        /* Burst transfers: the count does not depend on the frame length */
+        if( l == 0U )
+        {
+            firstTransfers = maxTransfers;
+        }
+        if( (minTransfers != maxTransfers) || (maxTransfers != firstTransfers) )
+        {
+            platformLog("SPI transfers per transceive depend on the frame length\r\n");
+            return EXIT_FAILURE;
+        }
+#endif /* ST25R95_SPI_BURST */
+    }
+
+    NO_WARNING(firstTransfers);
+    rfalFieldOff();
+    return EXIT_SUCCESS;
+#endif /* ST25R95_INTERFACE_UART */
+}
+
+
+/*******************************************************************************/
+int benchAnalogBenchmark( uint32_t rounds )
+{
+    static const uint16_t tech[BENCH_ANALOG_TECH_NUM] = { RFAL_ANALOG_CONFIG_TECH_NFCA, RFAL_ANALOG_CONFIG_TECH_NFCB, RFAL_ANALOG_CONFIG_TECH_NFCF,
+                                                         RFAL_ANALOG_CONFIG_TECH_AP2P, RFAL_ANALOG_CONFIG_TECH_NFCV };
+    static const uint16_t br[BENCH_ANALOG_BR_NUM]    = { RFAL_ANALOG_CONFIG_BITRATE_COMMON, RFAL_ANALOG_CONFIG_BITRATE_106, RFAL_ANALOG_CONFIG_BITRATE_212,
+                                                         RFAL_ANALOG_CONFIG_BITRATE_424, RFAL_ANALOG_CONFIG_BITRATE_848, RFAL_ANALOG_CONFIG_BITRATE_1695,
+                                                         RFAL_ANALOG_CONFIG_BITRATE_3390, RFAL_ANALOG_CONFIG_BITRATE_6780, RFAL_ANALOG_CONFIG_BITRATE_1OF4,
+                                                         RFAL_ANALOG_CONFIG_BITRATE_1OF256 };
+    static const uint16_t dir[BENCH_ANALOG_DIR_NUM]  = { RFAL_ANALOG_CONFIG_TX, RFAL_ANALOG_CONFIG_RX, RFAL_ANALOG_CONFIG_ANTICOL, RFAL_ANALOG_CONFIG_DPO };
+    static uint16_t ids[BENCH_ANALOG_ID_NUM];
+    static uint16_t tblIds[RFAL_ANALOG_CONFIG_LUT_SIZE];
+    static uint8_t  tbl[RFAL_ANALOG_CONFIG_TBL_SIZE];
+    struct timespec start;
+    struct timespec end;
+    uint64_t        nsIndex;
+    uint64_t        nsScan;
+    uint32_t        found;
+    uint32_t        rnd;
+    uint16_t        tblSize;
+    uint16_t        offset;
+    uint16_t        i;
+    uint16_t        n;
+    uint8_t         idNum;
+    uint8_t         t;
+    uint8_t         b;
+    uint8_t         d;
+    uint8_t         m;
+
+    /* Every Configuration ID: chip events, then Poll and Listen of each technology, bit rate and direction */
+    n = 0;
+    for( i = 0; i < BENCH_ANALOG_CHIP_ID_NUM; i++ )
+    {
+        ids[n++] = (uint16_t)(RFAL_ANALOG_CONFIG_TECH_CHIP | i);
+    }
+    for( m = 0; m < 2U; m++ )
+    {
+        for( t = 0; t < BENCH_ANALOG_TECH_NUM; t++ )
+        {
+            for( b = 0; b < BENCH_ANALOG_BR_NUM; b++ )
+            {
+                for( d = 0; d < BENCH_ANALOG_DIR_NUM; d++ )
+                {
+                    ids[n++] = (uint16_t)(((m == 0U) ? RFAL_ANALOG_CONFIG_POLL : RFAL_ANALOG_CONFIG_LISTEN) | tech[t] | br[b] | dir[d]);
+                }
+            }
+        }
+    }
+
+    rounds = MAX( rounds, 1U );
+    for( t = 0; t < BENCH_ANALOG_TBL_NUM; t++ )
+    {
+        if( t == 0U )
+        {
+            /* IDs of the default table */
+            rfalAnalogConfigInitialize();
+            if( rfalAnalogConfigListReadRaw( tbl, sizeof(tbl), &tblSize ) != ERR_NONE )
+            {
+                platformLog("Default analog configuration cannot be read\r\n");
+                return EXIT_FAILURE;
+            }
+            idNum = 0;
+            for( i = 0; (i < tblSize) && (idNum < RFAL_ANALOG_CONFIG_LUT_SIZE); i += (uint16_t)(BENCH_ANALOG_ENTRY_LEN + (tbl[i + 2U] * BENCH_ANALOG_SET_LEN)) )
+            {
+                tblIds[idNum++] = GETU16( &tbl[i] );
+            }
+        }
+        else
+        {
+            /* Largest table: IDs spread over the whole ID range */
+            for( idNum = 0; idNum < RFAL_ANALOG_CONFIG_LUT_SIZE; idNum++ )
+            {
+                tblIds[idNum] = ids[((uint32_t)idNum * BENCH_ANALOG_ID_NUM) / RFAL_ANALOG_CONFIG_LUT_SIZE];
+            }
+        }
+
+        /* A test register setting makes rfalSetAnalogConfig() stop on the first match: IDs found must be the same */
+        tblSize = benchAnalogTable( tblIds, idNum, true, tbl );
+        if( rfalAnalogConfigListWriteRaw( tbl, tblSize ) != ERR_NONE )
+        {
+            platformLog("Analog configuration of %u IDs cannot be loaded\r\n", (unsigned)idNum);
+            return EXIT_FAILURE;
+        }
+        found = 0U;
+        for( i = 0; i < BENCH_ANALOG_ID_NUM; i++ )
+        {
+            offset = 0U;
+            if( (rfalSetAnalogConfig( ids[i] ) == ERR_NOTSUPP) != (benchAnalogScan( tbl, tblSize, ids[i], &offset ) != RFAL_ANALOG_CONFIG_LUT_NOT_FOUND) )
+            {
+                platformLog("Configuration ID %04X: index and linear scan differ\r\n", (unsigned)ids[i]);
+                return EXIT_FAILURE;
+            }
+            found += ((offset != 0U) ? 1U : 0U);
+        }
+
+        /* Without register settings only the lookups are timed */
+        tblSize = benchAnalogTable( tblIds, idNum, false, tbl );
+        (void)rfalAnalogConfigListWriteRaw( tbl, tblSize );
+
+        (void)clock_gettime( CLOCK_MONOTONIC, &start );
+        for( rnd = 0; rnd < rounds; rnd++ )
+        {
+            for( i = 0; i < BENCH_ANALOG_ID_NUM; i++ )
+            {
+                (void)rfalSetAnalogConfig( ids[i] );
+            }
+        }
+        (void)clock_gettime( CLOCK_MONOTONIC, &end );
+        nsIndex = ((uint64_t)(end.tv_sec - start.tv_sec) * 1000000000U) + (uint64_t)end.tv_nsec - (uint64_t)start.tv_nsec;
+
+        (void)clock_gettime( CLOCK_MONOTONIC, &start );
+        for( rnd = 0; rnd < rounds; rnd++ )
+        {
+            for( i = 0; i < BENCH_ANALOG_ID_NUM; i++ )
+            {
+                offset = 0U;
+                while( benchAnalogScan( tbl, tblSize, ids[i], &offset ) != RFAL_ANALOG_CONFIG_LUT_NOT_FOUND )
+                {
+                    /* All the matching IDs are applied */
+                }
+            }
+        }
+        (void)clock_gettime( CLOCK_MONOTONIC, &end );
+        nsScan = ((uint64_t)(end.tv_sec - start.tv_sec) * 1000000000U) + (uint64_t)end.tv_nsec - (uint64_t)start.tv_nsec;
+
+        platformLog("%2u IDs table | %3u IDs looked up, %3u found | index: %4u ns/lookup | linear scan: %4u ns/lookup\r\n", (unsigned)idNum,
+                    (unsigned)BENCH_ANALOG_ID_NUM, (unsigned)found, (unsigned)(nsIndex / ((uint64_t)rounds * BENCH_ANALOG_ID_NUM)),
+                    (unsigned)(nsScan / ((uint64_t)rounds * BENCH_ANALOG_ID_NUM)));
+    }
+
+    rfalAnalogConfigInitialize();
+    return EXIT_SUCCESS;
+}
+
+
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static int benchMixRun( uint32_t duration, const uint8_t *mix, bool adaptive )
+{
+    rfalNfcDiscoverParam disc;
+    rfalNfcPollStats     stats;
+    ReturnCode           err;
+    uint32_t             tags[BENCH_MIX_TECH_NUM];
+
+    /* Same tag sequence for every run */
+    st25r95SimInitialize();
+    benchMixSeed  = 1U;
+    benchMixCurTag = benchMixNextTag( mix );
+    ST_MEMSET( tags, 0x00, sizeof(tags) );
+
+    st25r95SimSetTagHandler( 0, benchMixTagHandler );
+    st25r95SimSetTagPresent( 0, true );
+
+    benchDiscParam( &disc );
+    rfalSelectInstance( 0 );
+    err = rfalNfcInitialize();
+    if( err == ERR_NONE )
+    {
+        err = rfalNfcSetAdaptivePolling( adaptive );
+    }
+    if( err == ERR_NONE )
+    {
+        err = rfalNfcDiscover( &disc );
+    }
+    if( err != ERR_NONE )
+    {
+        platformLog("Reader initialization failed: %d\r\n", err);
+        return EXIT_FAILURE;
+    }
+
+    /* Each activated tag is replaced by the next one of the mix */
+    while( platformGetSysTick() < duration )
+    {
+        rfalNfcWorker();
+
+        if( rfalNfcIsDevActivated( rfalNfcGetState() ) )
+        {
+            tags[benchMixCurTag]++;
+            benchMixCurTag = benchMixNextTag( mix );
+            rfalNfcDeactivate( true );
+        }
+    }
+
+    rfalNfcGetPollStats( &stats );
+    platformLog("%s polling, %u ms simulated, tags activated A/B/V: %u/%u/%u, tags/s: %u, mean time to first detection: %u ms, ST25R95 commands: %u\r\n",
+                (adaptive ? "Adaptive" : "Fixed   "), (unsigned)platformGetSysTick(), (unsigned)tags[BENCH_MIX_TAG_NFCA], (unsigned)tags[BENCH_MIX_TAG_NFCB], (unsigned)tags[BENCH_MIX_TAG_NFCV],
+                (unsigned)(((tags[BENCH_MIX_TAG_NFCA] + tags[BENCH_MIX_TAG_NFCB] + tags[BENCH_MIX_TAG_NFCV]) * 1000U) / platformGetSysTick()),
+                (unsigned)((stats.detections != 0U) ? (stats.totalDetectionTime / stats.detections) : 0U), (unsigned)st25r95SimGetCommandCount());
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+static benchMixTag benchMixNextTag( const uint8_t *mix )
+{
+    uint32_t draw;
+    uint8_t  i;
+
+    /* Deterministic LCG so that fixed and adaptive polling see the same tags */
+    benchMixSeed = ((benchMixSeed * 1103515245U) + 12345U);
+    draw        = ((benchMixSeed >> 16U) % BENCH_MIX_PERCENT);
+
+    for( i = 0; i < (BENCH_MIX_TECH_NUM - 1U); i++ )
+    {
+        if( draw < mix[i] )
+        {
+            break;
+        }
+        draw -= mix[i];
+    }
+    return (benchMixTag)i;
+}
+
+
+/*******************************************************************************/
+static ReturnCode benchInventoryRun( uint8_t mode, uint8_t popHint, uint8_t *devCnt )
+{
+    static rfalNfcvListenDevice devList[BENCH_INV_MAX_TAGS];
+
+    if( mode == 0U )
+    {
+        return rfalNfcvPollerCollisionResolution( RFAL_COMPLIANCE_MODE_ISO, BENCH_INV_MAX_TAGS, devList, devCnt );
+    }
+    return rfalNfcvPollerAdaptiveCollisionResolution( RFAL_COMPLIANCE_MODE_ISO, BENCH_INV_MAX_TAGS, ((mode == 1U) ? 0U : popHint), devList, devCnt );
+}
+
+
+/*******************************************************************************/
+static void benchInvTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t res[2U + BENCH_NFCV_UID_LEN];
+    uint8_t match;
+    uint8_t tag;
+    uint8_t i;
+
+    NO_WARNING(txFlag);
+
+    if( protocol != ST25R95_PROTOCOL_ISO15693 )
+    {
+        return;
+    }
+
+    if( txLen == 0U )
+    {
+        /* EOF: next slot of a 16 slots inventory */
+        if( (benchInvSlot == BENCH_INV_NO_SLOT) || (benchInvSlot >= 15U) )
+        {
+            return;
+        }
+        benchInvSlot++;
+    }
+    else if( (txLen >= 3U) && (txBuf[1] == BENCH_NFCV_CMD_INVENTORY) && ((txBuf[0] & BENCH_NFCV_FLAG_INVENTORY) != 0U) )
+    {
+        benchInvMaskLen = MIN( txBuf[2], (uint8_t)(BENCH_NFCV_UID_LEN * 8U) );
+        ST_MEMSET( benchInvMask, 0x00, sizeof(benchInvMask) );
+        ST_MEMCPY( benchInvMask, &txBuf[3], MIN( (uint16_t)((benchInvMaskLen + 7U) / 8U), (uint16_t)(txLen - 3U) ) );
+        benchInvSlot = (((txBuf[0] & BENCH_INV_FLAG_1_SLOT) != 0U) ? BENCH_INV_NO_SLOT : 0U);
+    }
+    else
+    {
+        return;
+    }
+
+    /* Tags matching the mask, and the slot number following it in a 16 slots inventory */
+    match = 0U;
+    tag   = 0U;
+    for( i = 0; i < benchInvTagNum; i++ )
+    {
+        if( !benchInvQuiet[i] && benchInvBitsMatch( benchInvUID[i], benchInvMask, 0U, benchInvMaskLen ) &&
+            ((benchInvSlot == BENCH_INV_NO_SLOT) || benchInvBitsMatch( benchInvUID[i], &benchInvSlot, benchInvMaskLen, BENCH_INV_SLOT_BITS )) )
+        {
+            match++;
+            tag = i;
+        }
+    }
+
+    if( match == 0U )
+    {
+        return;
+    }
+
+    res[0] = 0x00U; /* Response flags: no error */
+    res[1] = 0x00U; /* DSFID */
+    ST_MEMCPY( &res[2], benchInvUID[tag], BENCH_NFCV_UID_LEN );
+    st25r95SimSetFrame( rx, res, sizeof(res), true );
+    if( match > 1U )
+    {
+        rx->status = BENCH_NFCV_RES_FLAG_COLLISION;
+    }
+}
+
+
+/*******************************************************************************/
+static bool benchInvBitsMatch( const uint8_t *uid, const uint8_t *mask, uint8_t start, uint8_t len )
+{
+    uint8_t pos;
+    uint8_t i;
+
+    /* Compare len UID bits from bit start with the mask bits from bit 0, LSB first */
+    for( i = 0; i < len; i++ )
+    {
+        pos = (start + i);
+        if( (((uid[pos / 8U] >> (pos % 8U)) ^ (mask[i / 8U] >> (i % 8U))) & 0x01U) != 0U )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*******************************************************************************/
+static void benchBwTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t  res[2U + BENCH_NFCV_BLOCK_LEN];
+    uint16_t idx;
+    uint8_t  secLen;
+    uint8_t  answers;
+    uint8_t  tag;
+    uint8_t  i;
+
+    if( (protocol != ST25R95_PROTOCOL_ISO15693) || (txLen == 0U) || ((txBuf[0] & BENCH_NFCV_FLAG_INVENTORY) != 0U) )
+    {
+        benchInvTagHandler( protocol, txBuf, txLen, txFlag, rx );
+        return;
+    }
+    if( txLen < 2U )
+    {
+        return;
+    }
+
+    res[0] = 0x00U;   /* Response flags: no error */
+
+    /* Non addressed request: every tag not in Quiet state processes it */
+    if( (txBuf[0] & BENCH_NFCV_FLAG_ADDRESS) == 0U )
+    {
+        if( (txBuf[1] != BENCH_NFCV_CMD_WRITE_SINGLE_BLOCK) || (txLen < (3U + BENCH_NFCV_BLOCK_LEN)) || (txBuf[2] != BENCH_BW_BLOCK_NUM) )
+        {
+            return;
+        }
+
+        benchBwWrites++;
+        answers = 0U;
+        for( i = 0; i < benchInvTagNum; i++ )
+        {
+            if( !benchInvQuiet[i] && ((i % BENCH_BW_MISS_MODULO) != (BENCH_BW_MISS_MODULO - 1U)) )
+            {
+                ST_MEMCPY( benchBwMem[i], &txBuf[3], BENCH_NFCV_BLOCK_LEN );
+                answers++;
+            }
+        }
+        if( answers > 0U )
+        {
+            st25r95SimSetFrame( rx, res, 1U, true );
+            rx->latency = BENCH_BW_WRITE_LATENCY;
+            if( answers > 1U )
+            {
+                rx->status = BENCH_NFCV_RES_FLAG_COLLISION;
+            }
+        }
+        return;
+    }
+
+    /* Addressed request: processed by the tag with this UID, whatever its state */
+    idx = (2U + BENCH_NFCV_UID_LEN);
+    if( txLen < idx )
+    {
+        return;
+    }
+    for( tag = 0; tag < benchInvTagNum; tag++ )
+    {
+        if( memcmp( &txBuf[2], benchInvUID[tag], BENCH_NFCV_UID_LEN ) == 0 )
+        {
+            break;
+        }
+    }
+    if( tag == benchInvTagNum )
+    {
+        return;
+    }
+
+    switch( txBuf[1] )
+    {
+        case BENCH_NFCV_CMD_STAY_QUIET:
+            benchInvQuiet[tag] = true;      /* No response */
+            break;
+
+        case BENCH_NFCV_CMD_RESET_TO_READY:
+            benchInvQuiet[tag] = false;
+            st25r95SimSetFrame( rx, res, 1U, true );
+            break;
+
+        case BENCH_NFCV_CMD_READ_SINGLE_BLOCK:
+            if( (txLen < (idx + 1U)) || (txBuf[idx] != BENCH_BW_BLOCK_NUM) )
+            {
+                return;
+            }
+            /* Option flag: block security status (unlocked) before the data */
+            secLen = (((txBuf[0] & BENCH_NFCV_FLAG_OPTION) != 0U) ? 1U : 0U);
+            res[1] = 0x00U;
+            ST_MEMCPY( &res[1U + secLen], benchBwMem[tag], BENCH_NFCV_BLOCK_LEN );
+            st25r95SimSetFrame( rx, res, (1U + secLen + BENCH_NFCV_BLOCK_LEN), true );
+            break;
+
+        case BENCH_NFCV_CMD_WRITE_SINGLE_BLOCK:
+            if( (txLen < (idx + 1U + BENCH_NFCV_BLOCK_LEN)) || (txBuf[idx] != BENCH_BW_BLOCK_NUM) )
+            {
+                return;
+            }
+            ST_MEMCPY( benchBwMem[tag], &txBuf[idx + 1U], BENCH_NFCV_BLOCK_LEN );
+            benchBwWrites++;
+            st25r95SimSetFrame( rx, res, 1U, true );
+            rx->latency = BENCH_BW_WRITE_LATENCY;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/*******************************************************************************/
+static void benchAcTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t res[2];
+    bool    answer;
+    uint8_t i;
+
+    if( (protocol != ST25R95_PROTOCOL_ISO14443A) || (txLen == 0U) )
+    {
+        return;
+    }
+    benchAcFrames++;
+
+    /* SENS_REQ (REQA) wakes up the IDLE cards, ALL_REQ (WUPA) the HALT ones too */
+    if( (txLen == 1U) && ((txFlag & 0x0FU) == BENCH_NFCA_SHORT_FRAME_BITS) )
+    {
+        answer = false;
+        for( i = 0; i < benchAcTagNum; i++ )
+        {
+            if( (benchAcTagState[i] == BENCH_AC_IDLE) || ((benchAcTagState[i] == BENCH_AC_HALT) && (txBuf[0] == RFAL_14443A_SHORTFRAME_CMD_WUPA)) )
+            {
+                benchAcTagState[i] = BENCH_AC_READY;
+                answer = true;
+            }
+            else if( benchAcTagState[i] != BENCH_AC_HALT )
+            {
+                benchAcTagState[i] = BENCH_AC_IDLE;
+            }
+            else
+            {
+                /* MISRA 15.7 - Empty else */
+            }
+        }
+        if( answer )
+        {
+            res[0] = 0x04U;   /* SENS_RES: single size UID, bit frame SDD, same for all cards */
+            res[1] = 0x00U;
+            st25r95SimSetFrame( rx, res, 2U, false );
+        }
+        return;
+    }
+
+    /* SLP_REQ (HLTA): the selected card goes to HALT, without answer */
+    if( (txLen == 2U) && (txBuf[0] == BENCH_NFCA_CMD_SLP) )
+    {
+        for( i = 0; i < benchAcTagNum; i++ )
+        {
+            if( benchAcTagState[i] == BENCH_AC_ACTIVE )
+            {
+                benchAcTagState[i] = BENCH_AC_HALT;
+            }
+            else if( benchAcTagState[i] != BENCH_AC_HALT )
+            {
+                benchAcTagState[i] = BENCH_AC_IDLE;
+            }
+            else
+            {
+                /* MISRA 15.7 - Empty else */
+            }
+        }
+        return;
+    }
+
+    if( (txLen < BENCH_AC_SDD_REQ_LEN) || (txBuf[0] != BENCH_NFCA_SEL_CL1) )
+    {
+        return;
+    }
+
+    /* SEL_REQ: the matching card is selected, the other READY cards go back to IDLE  ISO14443-3 6.3.3 */
+    if( (txBuf[1] == BENCH_NFCA_NVB_SEL) && (txLen >= (BENCH_AC_SDD_REQ_LEN + BENCH_AC_SDD_RES_LEN)) )
+    {
+        answer = false;
+        for( i = 0; i < benchAcTagNum; i++ )
+        {
+            if( benchAcTagState[i] == BENCH_AC_READY )
+            {
+                if( memcmp( &txBuf[BENCH_AC_SDD_REQ_LEN], benchAcUID[i], BENCH_AC_SDD_RES_LEN ) == 0 )
+                {
+                    benchAcTagState[i] = BENCH_AC_ACTIVE;
+                    answer = true;
+                }
+                else
+                {
+                    benchAcTagState[i] = BENCH_AC_IDLE;
+                }
+            }
+        }
+        if( answer )
+        {
+            res[0] = 0x00U;   /* SEL_RES: UID complete, T2T */
+            st25r95SimSetFrame( rx, res, 1U, true );
+        }
+        return;
+    }
+
+    benchAcSdd( txBuf, txLen, rx );
+}
+
+
+/*******************************************************************************/
+static void benchAcSdd( const uint8_t *txBuf, uint16_t txLen, st25r95SimFrame *rx )
+{
+    uint8_t known;
+    uint8_t first;
+    uint8_t match;
+    uint8_t col;
+    uint8_t pos;
+    uint8_t i;
+    uint8_t j;
+
+    /* SDD_REQ: SEL_PAR gives the bytes (SEL_CMD and SEL_PAR included) and bits of the UID already known */
+    known = (uint8_t)(((((uint32_t)txBuf[1] >> 4U) - BENCH_AC_SDD_REQ_LEN) * 8U) + (txBuf[1] & 0x07U));
+    if( (known >= (BENCH_AC_SDD_RES_LEN * 8U)) || (txLen < (BENCH_AC_SDD_REQ_LEN + ((known + 7U) / 8U))) )
+    {
+        return;
+    }
+
+    /* READY cards matching the known bits answer the remaining ones, the first differing bit collides */
+    match = 0U;
+    first = 0U;
+    col   = (BENCH_AC_SDD_RES_LEN * 8U);
+    for( i = 0; i < benchAcTagNum; i++ )
+    {
+        if( (benchAcTagState[i] != BENCH_AC_READY) || !benchInvBitsMatch( benchAcUID[i], &txBuf[BENCH_AC_SDD_REQ_LEN], 0U, known ) )
+        {
+            continue;
+        }
+        if( match == 0U )
+        {
+            first = i;
+        }
+        else
+        {
+            for( pos = known; pos < col; pos++ )
+            {
+                if( (((benchAcUID[i][pos / 8U] ^ benchAcUID[first][pos / 8U]) >> (pos % 8U)) & 0x01U) != 0U )
+                {
+                    col = pos;
+                    break;
+                }
+            }
+        }
+        match++;
+    }
+
+    if( match == 0U )
+    {
+        return;
+    }
+
+    /* Answer from the byte holding the first unknown bit, the reader keeps its own bits of it */
+    j = (known / 8U);
+    st25r95SimSetFrame( rx, &benchAcUID[first][j], (uint16_t)(BENCH_AC_SDD_RES_LEN - j), false );
+    if( col < (BENCH_AC_SDD_RES_LEN * 8U) )
+    {
+        rx->status  = BENCH_NFCA_RES_FLAG_COLLISION;
+        rx->colByte = (uint8_t)((col / 8U) - j);
+        rx->colBit  = (uint8_t)(col % 8U);
+        rx->len     = (uint16_t)(rx->colByte + 1U);
+    }
+}
+
+
+/*******************************************************************************/
+static ReturnCode benchIsoDepSession( rfalBitRate maxBR, rfalBitRate *br )
+{
+    static rfalIsoDepApduBufFormat txApdu;
+    static rfalIsoDepApduBufFormat rxApdu;
+    static rfalIsoDepBufFormat     tmpBuf;
+    static rfalIsoDepDevice        isoDepDev;
+    static const uint8_t readBinary[] = { 0x00U, 0xB0U, 0x00U, 0x00U, (uint8_t)BENCH_ID_RES_DATA_LEN };
+    rfalIsoDepApduTxRxParam param;
+    rfalNfcaSensRes         sensRes;
+    rfalNfcaSelRes          selRes;
+    uint8_t                 nfcId1[RFAL_NFCA_CASCADE_3_UID_LEN];
+    uint8_t                 nfcId1Len;
+    bool                    collPending;
+    uint16_t                rxLen;
+    ReturnCode              err;
+    uint8_t                 i;
+
+    /* Card presented: ISO14443-3 then ISO14443-4 activation */
+    rfalIsoDepInitialize();
+    EXIT_ON_ERR( err, rfalNfcaPollerInitialize() );
+    EXIT_ON_ERR( err, rfalFieldOnAndStartGT() );
+    EXIT_ON_ERR( err, rfalNfcaPollerCheckPresence( RFAL_14443A_SHORTFRAME_CMD_WUPA, &sensRes ) );
+    EXIT_ON_ERR( err, rfalNfcaPollerSingleCollisionResolution( 1U, &collPending, &selRes, nfcId1, &nfcId1Len ) );
+    EXIT_ON_ERR( err, rfalIsoDepPollAHandleActivation( RFAL_ISODEP_FSXI_256, RFAL_ISODEP_NO_DID, maxBR, &isoDepDev ) );
+    (*br) = (rfalBitRate)MAX( (uint8_t)isoDepDev.info.DSI, (uint8_t)isoDepDev.info.DRI );
+
+    ST_MEMCPY( txApdu.apdu, readBinary, sizeof(readBinary) );
+    param.txBuf    = &txApdu;
+    param.txBufLen = (uint16_t)sizeof(readBinary);
+    param.rxBuf    = &rxApdu;
+    param.rxLen    = &rxLen;
+    param.tmpBuf   = &tmpBuf;
+    param.FWT      = isoDepDev.info.FWT;
+    param.dFWT     = isoDepDev.info.dFWT;
+    param.FSx      = isoDepDev.info.FSx;
+    param.ourFSx   = RFAL_ISODEP_FSX_256;
+    param.DID      = isoDepDev.info.DID;
+
+    for( i = 0; i < BENCH_ID_EXCHANGES; i++ )
+    {
+        EXIT_ON_ERR( err, rfalIsoDepStartApduTransceive( param ) );
+        do
+        {
+            rfalWorker();
+            err = rfalIsoDepGetApduTransceiveStatus();
+        }
+        while( err == ERR_BUSY );
+
+        if( err != ERR_NONE )
+        {
+            rfalFieldOff();
+            return err;
+        }
+    }
+
+    err = rfalIsoDepDeselect();
+    rfalFieldOff();
+    return err;
+}
+
+
+/*******************************************************************************/
+static void benchIdTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t  res[5];
+    uint16_t i;
+
+    if( (protocol != ST25R95_PROTOCOL_ISO14443A) || (txLen == 0U) )
+    {
+        return;
+    }
+
+    /* ISO14443-3: single size UID card, ISO14443-4 compliant, back to 106 kbps when woken up */
+    if( ((txLen == 1U) && ((txFlag & 0x0FU) == BENCH_NFCA_SHORT_FRAME_BITS)) || (txBuf[0] == BENCH_NFCA_SEL_CL1) )
+    {
+        benchIdTxBR = RFAL_BR_106;
+        benchIdRxBR = RFAL_BR_106;
+        benchNfcaTag( protocol, txBuf, txLen, txFlag, rx );
+        if( (txLen > 1U) && (txBuf[1] == BENCH_NFCA_NVB_SEL) && (rx->len != 0U) )
+        {
+            res[0] = BENCH_NFCA_SEL_RES_ISODEP;
+            st25r95SimSetFrame( rx, res, 1U, true );
+        }
+        return;
+    }
+
+    if( txBuf[0] == BENCH_ID_CMD_RATS )
+    {
+        res[0] = 0x05U;           /* TL                                   */
+        res[1] = 0x78U;           /* T0: TA, TB and TC present, FSCI 256  */
+        res[2] = benchIdCur->ta;  /* TA: bit rates                        */
+        res[3] = 0x70U;           /* TB: FWI 7, SFGI 0                    */
+        res[4] = 0x00U;           /* TC: no DID nor NAD                   */
+        benchIdRespond( rx, txLen, res, 5U );
+    }
+    else if( ((txBuf[0] & 0xF0U) == BENCH_ID_CMD_PPS) && (txLen >= 3U) )
+    {
+        /* PPS_RES at the current bit rate, PPS1 applies afterwards */
+        res[0] = txBuf[0];
+        benchIdRespond( rx, txLen, res, 1U );
+        benchIdTxBR = (rfalBitRate)((txBuf[2] >> 2U) & 0x03U);
+        benchIdRxBR = (rfalBitRate)(txBuf[2] & 0x03U);
+    }
+    else if( (txBuf[0] & BENCH_ID_PCB_IBLOCK_MASK) == BENCH_ID_PCB_IBLOCK )
+    {
+        /* R-APDU: data and SW 90 00 in an I-block with the same block number */
+        benchIdLastRes[0] = (uint8_t)(BENCH_ID_PCB_IBLOCK | (txBuf[0] & 0x01U));
+        for( i = 0; i < BENCH_ID_RES_DATA_LEN; i++ )
+        {
+            benchIdLastRes[1U + i] = (uint8_t)i;
+        }
+        benchIdLastRes[1U + BENCH_ID_RES_DATA_LEN] = 0x90U;
+        benchIdLastRes[2U + BENCH_ID_RES_DATA_LEN] = 0x00U;
+        benchIdLastResLen = BENCH_ID_RES_MAX_LEN;
+        benchIdRespond( rx, txLen, benchIdLastRes, benchIdLastResLen );
+    }
+    else if( ((txBuf[0] & BENCH_ID_PCB_RNAK_MASK) == BENCH_ID_PCB_RNAK) && (benchIdLastResLen != 0U) )
+    {
+        benchIdRespond( rx, txLen, benchIdLastRes, benchIdLastResLen );
+    }
+    else if( (txBuf[0] & BENCH_ID_PCB_SDSL_MASK) == BENCH_ID_PCB_SDSL )
+    {
+        res[0] = txBuf[0];
+        benchIdRespond( rx, txLen, res, 1U );
+        benchIdLastResLen = 0U;
+    }
+    else
+    {
+        /* No response */
+    }
+}
+
+
+/*******************************************************************************/
+static void benchIdRespond( st25r95SimFrame *rx, uint16_t txLen, const uint8_t *data, uint16_t len )
+{
+    uint8_t rate;
+
+    /* Block processing and air time of both frames, CRC included */
+    st25r95SimSetFrame( rx, data, len, true );
+    rx->latency = (BENCH_ID_BLOCK_LATENCY + ((uint32_t)(txLen + RFAL_CRC_LEN) * (BENCH_ID_BYTE_TIME_106 >> (uint8_t)benchIdRxBR))
+                                         + ((uint32_t)rx->len * (BENCH_ID_BYTE_TIME_106 >> (uint8_t)benchIdTxBR)));
+
+    /* Above the reliable bit rate a share of the blocks is corrupted, growing with each step */
+    rate = MAX( (uint8_t)benchIdTxBR, (uint8_t)benchIdRxBR );
+    if( rate > (uint8_t)benchIdCur->reliableBR )
+    {
+        benchIdSeed = ((benchIdSeed * 1103515245U) + 12345U);
+        if( ((benchIdSeed >> 16U) % 100U) < (BENCH_ID_ERR_PERCENT * (uint32_t)(rate - (uint8_t)benchIdCur->reliableBR)) )
+        {
+            rx->status = BENCH_NFCA_RES_FLAG_CRC;
+        }
+    }
+}
+
+
+/*******************************************************************************/
+static ReturnCode benchWorkerRun( uint32_t duration, uint32_t budget, uint32_t *activations, uint32_t *maxTime )
+{
+    rfalNfcDiscoverParam disc;
+    ReturnCode           err;
+    uint32_t             start;
+    uint32_t             seed;
+    uint8_t              i;
+    uint8_t              j;
+
+    /* Same population for every budget, out of the field until the Wake-Up mode (and its calibration) is running */
+    st25r95SimInitialize();
+    seed = benchInvTagNum;
+    for( i = 0; i < benchInvTagNum; i++ )
+    {
+        for( j = 0; j < (BENCH_NFCV_UID_LEN - 1U); j++ )
+        {
+            seed = ((seed * 1103515245U) + 12345U);
+            benchInvUID[i][j] = (uint8_t)(seed >> 16U);
+        }
+        benchInvUID[i][BENCH_NFCV_UID_LEN - 1U] = 0xE0U;
+        benchInvQuiet[i] = false;
+    }
+    st25r95SimSetTagHandler( 0, benchInvTagHandler );
+    st25r95SimSetTagPresent( 0, false );
+
+    benchDiscParam( &disc );
+    disc.devLimit            = BENCH_WORKER_DEV_LIMIT;
+    disc.wakeupEnabled       = true;
+    disc.wakeupConfigDefault = true;
+
+    rfalSelectInstance( 0 );
+    EXIT_ON_ERR( err, rfalNfcInitialize() );
+    EXIT_ON_ERR( err, rfalNfcSetWorkerBudget( budget ) );
+    EXIT_ON_ERR( err, rfalNfcDiscover( &disc ) );
+    rfalNfcResetWorkerMaxTime();
+
+    *activations = 0U;
+    start        = platformGetSysTick();
+    while( (platformGetSysTick() - start) < duration )
+    {
+        if( (platformGetSysTick() - start) >= BENCH_WORKER_ARRIVAL )
+        {
+            st25r95SimSetTagPresent( 0, true );
+        }
+
+        rfalNfcWorker();
+
+        if( rfalNfcGetState() == RFAL_NFC_STATE_POLL_SELECT )
+        {
+            EXIT_ON_ERR( err, rfalNfcSelect( 0 ) );
+        }
+
+        if( rfalNfcIsDevActivated( rfalNfcGetState() ) )
+        {
+            (*activations)++;
+            rfalNfcDeactivate( true );
+        }
+    }
+
+    return rfalNfcGetWorkerMaxTime( maxTime );
+}
+
+
+#if ST25R95_IRQ_OUT_INTERRUPT
+/*******************************************************************************/
+static ReturnCode benchIrqRun( uint32_t duration, uint32_t *exchanges, uint32_t *edges, uint32_t *maxCall )
+{
+    rfalTransceiveContext ctx;
+    uint8_t    req[] = { 0x02U, BENCH_NFCV_CMD_READ_SINGLE_BLOCK, 0x00U };  /* High data rate, non addressed */
+    uint8_t    res[1U + BENCH_NFCV_BLOCK_LEN + RFAL_CRC_LEN];
+    uint16_t   rcvdLen;
+    uint32_t   edgesStart;
+    uint32_t   callStart;
+    uint32_t   start;
+    ReturnCode err;
+
+    st25r95SimSetTagHandler( 0, benchNfcvTag );
+    st25r95SimSetTagPresent( 0, true );
+
+    rfalSelectInstance( 0 );
+    EXIT_ON_ERR( err, rfalInitialize() );
+    EXIT_ON_ERR( err, rfalNfcvPollerInitialize() );
+    EXIT_ON_ERR( err, rfalFieldOnAndStartGT() );
+
+    *exchanges   = 0U;
+    *maxCall     = 0U;
+    benchIrqEdges = 0U;
+    start        = platformGetSysTick();
+    while( (platformGetSysTick() - start) < duration )
+    {
+        req[2] = (uint8_t)(*exchanges % BENCH_NFCV_BLOCK_NUM);
+        benchNfcvMem[req[2]][0] = (uint8_t)(*exchanges / BENCH_NFCV_BLOCK_NUM);
+
+        edgesStart = benchIrqEdges;
+        rfalCreateByteFlagsTxRxContext( ctx, req, sizeof(req), res, sizeof(res), &rcvdLen, RFAL_TXRX_FLAGS_DEFAULT, rfalConvMsTo1fc( BENCH_IRQ_FWT ) );
+        EXIT_ON_ERR( err, rfalStartTransceive( &ctx ) );
+        for( ;; )
+        {
+            callStart = st25r95SimGetTimeUs();
+            rfalWorker();
+            *maxCall = MAX( *maxCall, (st25r95SimGetTimeUs() - callStart) );
+
+            err = rfalGetTransceiveStatus();
+            if( err != ERR_BUSY )
+            {
+                break;
+            }
+            /* Nothing to do until the next interrupt */
+            platformWaitForInterrupt();
+        }
+        if( err != ERR_NONE )
+        {
+            return err;
+        }
+
+        /* The response is read after its nIRQ_OUT edge, the consumed edge is not reported again */
+        if( (benchIrqEdges == edgesStart) || (st25r95PollRead( ST25R95_CONTROL_POLL_NO_TIMEOUT ) != ERR_TIMEOUT) )
+        {
+            return ERR_SYSTEM;
+        }
+        if( (rfalConvBitsToBytes( rcvdLen ) < (1U + BENCH_NFCV_BLOCK_LEN)) || (memcmp( &res[1], benchNfcvMem[req[2]], BENCH_NFCV_BLOCK_LEN ) != 0) )
+        {
+            return ERR_SYSTEM;
+        }
+        (*exchanges)++;
+    }
+
+    *edges = benchIrqEdges;
+    rfalFieldOff();
+    return ERR_NONE;
+}
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+
+
+#if ST25R95_INTERFACE_UART
+/*******************************************************************************/
+static ReturnCode benchUartRun( uint32_t duration, uint32_t *exchanges, uint32_t *bytes )
+{
+    uint8_t    req[] = { 0x02U, BENCH_NFCV_CMD_READ_MULTIPLE_BLOCKS, 0x00U, 0x00U };  /* High data rate, non addressed */
+    uint8_t    res[1U + (BENCH_RMB_MAX_BLOCKS * BENCH_NFCV_BLOCK_LEN) + RFAL_CRC_LEN];
+    uint16_t   rcvdLen;
+    uint16_t   blockNum;
+    uint16_t   expLen;
+    uint16_t   i;
+    uint32_t   start;
+    ReturnCode expErr;
+    ReturnCode err;
+
+    st25r95SimSetTagHandler( 0, benchRmbTagHandler );
+    st25r95SimSetTagPresent( 0, true );
+
+    EXIT_ON_ERR( err, rfalInitialize() );
+    EXIT_ON_ERR( err, rfalNfcvPollerInitialize() );
+    EXIT_ON_ERR( err, rfalFieldOnAndStartGT() );
+
+    *exchanges = 0U;
+    *bytes     = 0U;
+    start      = platformGetSysTick();
+    while( (platformGetSysTick() - start) < duration )
+    {
+        /* Responses of 1 to 128 blocks: up to 518 bytes, length above 255 carried by the result code */
+        blockNum = (uint16_t)(((*exchanges * 37U) % BENCH_RMB_MAX_BLOCKS) + 1U);
+        req[2]   = (uint8_t)(*exchanges % BENCH_RMB_MAX_BLOCKS);
+        req[3]   = (uint8_t)(blockNum - 1U);
+        for( i = 0; i < blockNum; i++ )
+        {
+            benchNfcvMem[req[2] + i][0] = (uint8_t)(*exchanges + i);
+            benchNfcvMem[req[2] + i][3] = (uint8_t)(*exchanges >> 8U);
+        }
+
+        switch( *exchanges % BENCH_UART_ERR_MODULO )
+        {
+            case (BENCH_UART_ERR_MODULO - 2U):
+                benchRmbFault = BENCH_RMB_FAULT_TIMEOUT;
+                expErr        = ERR_TIMEOUT;
+                break;
+            case (BENCH_UART_ERR_MODULO - 1U):
+                benchRmbFault = BENCH_RMB_FAULT_CRC;
+                expErr        = ERR_CRC;
+                break;
+            default:
+                benchRmbFault = BENCH_RMB_FAULT_NONE;
+                expErr        = ERR_NONE;
+                break;
+        }
+
+        rcvdLen = 0U;
+        err     = rfalTransceiveBlockingTxRx( req, sizeof(req), res, sizeof(res), &rcvdLen, RFAL_TXRX_FLAGS_DEFAULT, rfalConvMsTo1fc( BENCH_RMB_FWT ) );
+        if( err != expErr )
+        {
+            platformLog("exchange %u, %u blocks: error %d instead of %d\r\n", (unsigned)*exchanges, (unsigned)blockNum, err, expErr);
+            return ERR_SYSTEM;
+        }
+
+        if( benchRmbFault == BENCH_RMB_FAULT_NONE )
+        {
+            expLen = (uint16_t)(1U + (blockNum * BENCH_NFCV_BLOCK_LEN));
+            if( rcvdLen != expLen )
+            {
+                platformLog("exchange %u, %u blocks: %u bytes instead of %u\r\n", (unsigned)*exchanges, (unsigned)blockNum, (unsigned)rcvdLen, (unsigned)expLen);
+                return ERR_SYSTEM;
+            }
+            if( memcmp( &res[1], benchNfcvMem[req[2]], (blockNum * BENCH_NFCV_BLOCK_LEN) ) != 0 )
+            {
+                platformLog("exchange %u, %u blocks: data mismatch\r\n", (unsigned)*exchanges, (unsigned)blockNum);
+                return ERR_SYSTEM;
+            }
+            *bytes += rcvdLen;
+        }
+        (*exchanges)++;
+    }
+
+    rfalFieldOff();
+    return ERR_NONE;
+}
+#endif /* ST25R95_INTERFACE_UART */
+
+
+/*******************************************************************************/
+static uint16_t benchAnalogTable( const uint16_t *ids, uint8_t idNum, bool testReg, uint8_t *tbl )
+{
+    uint16_t len;
+    uint8_t  i;
+
+    /* Packed table: ID (MSB first), number of sets, sets. The test register set is never applied on ST25R95 */
+    len = 0;
+    for( i = 0; i < idNum; i++ )
+    {
+        tbl[len++] = (uint8_t)(ids[i] >> 8U);
+        tbl[len++] = (uint8_t)ids[i];
+        tbl[len++] = (testReg ? 1U : 0U);
+        if( testReg )
+        {
+            tbl[len++] = 0x00U;
+            tbl[len++] = 0x80U;    /* Test register indicator */
+            tbl[len++] = 0xFFU;
+            tbl[len++] = 0x00U;
+        }
+    }
+    return len;
+}
+
+
+/*******************************************************************************/
+static uint8_t benchAnalogScan( const uint8_t *tbl, uint16_t tblSize, uint16_t configId, uint16_t *configOffset )
+{
+    uint16_t maskVal;
+    uint16_t i;
+
+    /* Linear scan of the packed table, as rfalAnalogConfigSearch() did before the index */
+    maskVal = (uint16_t)((RFAL_ANALOG_CONFIG_POLL_LISTEN_MODE_MASK | RFAL_ANALOG_CONFIG_BITRATE_MASK)
+                         | ((RFAL_ANALOG_CONFIG_TECH_CHIP == RFAL_ANALOG_CONFIG_ID_GET_TECH(configId)) ? (RFAL_ANALOG_CONFIG_TECH_MASK | RFAL_ANALOG_CONFIG_CHIP_SPECIFIC_MASK) : configId)
+                         | ((RFAL_ANALOG_CONFIG_NO_DIRECTION == RFAL_ANALOG_CONFIG_ID_GET_DIRECTION(configId)) ? RFAL_ANALOG_CONFIG_DIRECTION_MASK : configId));
+    if( RFAL_ANALOG_CONFIG_ID_GET_DIRECTION(configId) == RFAL_ANALOG_CONFIG_DPO )
+    {
+        maskVal = (RFAL_ANALOG_CONFIG_POLL_LISTEN_MODE_MASK | RFAL_ANALOG_CONFIG_TECH_MASK | RFAL_ANALOG_CONFIG_BITRATE_MASK | RFAL_ANALOG_CONFIG_DIRECTION_MASK);
+    }
+
+    for( i = *configOffset; i < tblSize; i += (uint16_t)(BENCH_ANALOG_ENTRY_LEN + (tbl[i + 2U] * BENCH_ANALOG_SET_LEN)) )
+    {
+        if( configId == (GETU16( &tbl[i] ) & maskVal) )
+        {
+            *configOffset = (uint16_t)(i + BENCH_ANALOG_ENTRY_LEN + (tbl[i + 2U] * BENCH_ANALOG_SET_LEN));
+            return tbl[i + 2U];
+        }
+    }
+    return RFAL_ANALOG_CONFIG_LUT_NOT_FOUND;
+}
+
+
+/*******************************************************************************/
+static void benchRmbTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t  res[1U + (BENCH_RMB_MAX_BLOCKS * BENCH_NFCV_BLOCK_LEN)];
+    uint16_t blockNum;
+
+    NO_WARNING(txFlag);
+
+    if( (protocol != ST25R95_PROTOCOL_ISO15693) || (txLen < 4U) || (txBuf[1] != BENCH_NFCV_CMD_READ_MULTIPLE_BLOCKS) || (benchRmbFault == BENCH_RMB_FAULT_TIMEOUT) )
+    {
+        return;
+    }
+
+    blockNum = (uint16_t)(txBuf[3] + 1U);
+    res[0]   = 0x00U;   /* Response flags: no error */
+    ST_MEMCPY( &res[1], benchNfcvMem[txBuf[2]], (blockNum * BENCH_NFCV_BLOCK_LEN) );
+    st25r95SimSetFrame( rx, res, (uint16_t)(1U + (blockNum * BENCH_NFCV_BLOCK_LEN)), true );
+    if( benchRmbFault == BENCH_RMB_FAULT_CRC )
+    {
+        rx->status = BENCH_NFCV_RES_FLAG_CRC;
+    }
+}
+
+
+/*******************************************************************************/
+static void benchMixTagHandler( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    switch( benchMixCurTag )
+    {
+        case BENCH_MIX_TAG_NFCA:
+            benchNfcaTag( protocol, txBuf, txLen, txFlag, rx );
+            break;
+
+        case BENCH_MIX_TAG_NFCB:
+            benchNfcbTag( protocol, txBuf, txLen, txFlag, rx );
+            break;
+
+        default:
+            benchNfcvTag( protocol, txBuf, txLen, txFlag, rx );
+            break;
+    }
+}
@@ -0,0 +1,590 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_tags.c
+ *
+ *  \author
+ *
+ *  \brief Simulated tags of the ST25R95 simulator benchmarks
+ *
+ *  Tag handlers shared by the benchmarks: an ISO15693 tag (Inventory,
+ *  Read/Write Single Block, Read/Write Multiple Blocks, (Extended) Get
+ *  System Information), an NFC-A Type 2 Tag of two sectors (READ, FAST_READ,
+ *  SECTOR SELECT) and an NFC-B tag without ISO-DEP, plus the discovery and
+ *  NDEF detection steps run on them.
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <string.h>
+#include "bench.h"
+#include "utils.h"
+#include "st25r95_com.h"
+#include "rfal_nfca.h"
+#include "rfal_nfcv.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define BENCH_DISC_DURATION              1000U   /*!< Benchmark discovery duration (ms)    */
+
+#define BENCH_NFCV_CMD_WRITE_MULTIPLE_BLOCKS 0x24U /*!< Write Multiple Blocks command       */
+#define BENCH_NFCV_CMD_SELECT            0x25U   /*!< Select command                       */
+#define BENCH_NFCV_CMD_GET_SYS_INFO      0x2BU   /*!< Get System Information command       */
+#define BENCH_NFCV_CMD_EXT_WRITE_MULTIPLE_BLOCKS 0x34U /*!< Extended Write Multiple Blocks command */
+#define BENCH_NFCV_CMD_EXT_GET_SYS_INFO  0x3BU   /*!< Extended Get System Information command */
+#define BENCH_NFCV_RES_FLAG_ERROR        0x01U   /*!< Response flag: error                 */
+#define BENCH_NFCV_ERR_NOT_SUPPORTED     0x01U   /*!< Error code: command not supported    */
+#define BENCH_NFCV_ERR_BLOCK_NOT_AVAIL   0x10U   /*!< Error code: block not available      */
+#define BENCH_NFCV_MAX_MULTIPLE_BLOCKS   32U     /*!< Largest Read Multiple Blocks of the simulated tag */
+#define BENCH_NFCV_RES_MAX_LEN           (1U + (BENCH_NFCV_MAX_MULTIPLE_BLOCKS * BENCH_NFCV_BLOCK_LEN)) /*!< Longest response of the simulated tag */
+#define BENCH_NFCV_SYS_INFO_FLAGS        0x0FU   /*!< System info: DSFID, AFI, memory size and IC reference */
+#define BENCH_NFCV_SYS_INFO_LEN          (2U + BENCH_NFCV_UID_LEN + 5U) /*!< Get System Information response length */
+#define BENCH_NFCV_EXT_SYS_INFO_FLAGS    0x2FU   /*!< Extended system info: DSFID, AFI, memory size, IC reference and command list */
+#define BENCH_NFCV_CMD_LIST_WR_MULTIPLE  0x10U   /*!< Command list byte 0 and 2: (Extended) Write Multiple Blocks */
+
+#define BENCH_NFCA_NVB_SDD               0x20U   /*!< NVB of SDD_REQ: no UID bits sent     */
+#define BENCH_T2T_SECTOR_PAGES           256U    /*!< Pages per sector                     */
+#define BENCH_T2T_READ_PAGES             4U      /*!< Pages per READ response              */
+#define BENCH_T2T_FAST_READ_MAX_PAGES    64U     /*!< Largest FAST_READ of the simulated T2T */
+#define BENCH_T2T_CMD_READ               0x30U   /*!< READ command                         */
+#define BENCH_T2T_CMD_FAST_READ          0x3AU   /*!< FAST_READ command                    */
+#define BENCH_T2T_CMD_SECTOR_SELECT      0xC2U   /*!< SECTOR SELECT command packet 1       */
+#define BENCH_T2T_SECTOR_SELECT_P1       0xFFU   /*!< SECTOR SELECT packet 1 second byte   */
+#define BENCH_T2T_SECTOR_SELECT_P2_LEN   4U      /*!< SECTOR SELECT packet 2: sector number and 3 RFU bytes */
+#define BENCH_T2T_ACK                    0x0AU   /*!< 4-bit ACK                            */
+#define BENCH_T2T_NAK                    0x00U   /*!< 4-bit NAK: invalid argument          */
+#define BENCH_T2T_ACK_NAK_BITS           4U      /*!< ACK/NAK length (bits)                */
+
+#define BENCH_NFCB_CMD_SENSB_REQ         0x05U   /*!< SENSB_REQ/ALLB_REQ command           */
+#define BENCH_NFCB_CMD_SLPB_REQ          0x50U   /*!< SLPB_REQ command                     */
+
+/*
+******************************************************************************
+* GLOBAL VARIABLES
+******************************************************************************
+*/
+
+const uint8_t benchNfcvUID[BENCH_NFCV_UID_LEN] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x02, 0xE0}; /* LSB first */
+uint8_t benchNfcvMem[BENCH_NFCV_BLOCK_NUM][BENCH_NFCV_BLOCK_LEN];
+uint16_t benchNfcvWriteCnt[BENCH_NFCV_BLOCK_NUM]; /* Writes of each block of the simulated tag */
+uint32_t benchNfcvReadCnt;                               /* Blocks read from the simulated tag        */
+uint8_t  benchNfcvChunkFail;                             /* Multiple blocks requests until the one rejected, 0: none */
+bool     benchNfcvWrMultiple = true;                     /* (Extended) Write Multiple Blocks supported by the simulated tag */
+
+const uint8_t benchNfcaUID[BENCH_NFCA_UID_LEN] = {0x08, 0x12, 0x34, 0x56};
+uint8_t  benchNfcaMem[BENCH_T2T_PAGE_NUM][BENCH_T2T_PAGE_LEN];
+bool     benchNfcaFastRead = true;                       /* FAST_READ supported by the simulated NFC-A tag     */
+uint32_t benchNfcaReadCnt;                               /* READ commands answered                             */
+uint32_t benchNfcaFastReadCnt;                           /* FAST_READ commands answered                        */
+uint32_t benchNfcaNakCnt;                                /* NAKs sent                                          */
+uint32_t benchNfcaSelCnt;                                /* Selections (SEL_REQ answered)                      */
+uint32_t benchNfcaSectorCnt;                             /* Sectors selected                                   */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+
+static bool     benchNfcaActive;                         /* Simulated NFC-A tag selected (ACTIVE state)        */
+static bool     benchNfcaSectorSelect;                   /* SECTOR SELECT packet 2 expected                    */
+static uint8_t  benchNfcaSector;                         /* Current sector of the simulated NFC-A tag          */
+static const uint8_t benchNfcbPUPI[RFAL_NFCB_NFCID0_LEN] = {0x11, 0x22, 0x33, 0x44};
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static void benchT2TCommand( const uint8_t *txBuf, uint16_t txLen, st25r95SimFrame *rx );
+static void benchT2TAckNak( st25r95SimFrame *rx, bool ack );
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+void benchDiscParam( rfalNfcDiscoverParam *disc )
+{
+    ST_MEMSET( disc, 0x00, sizeof(rfalNfcDiscoverParam) );
+    disc->compMode      = RFAL_COMPLIANCE_MODE_NFC;
+    disc->devLimit      = 1U;
+    disc->nfcfBR        = RFAL_BR_212;
+    disc->ap2pBR        = RFAL_BR_424;
+    disc->maxBR         = RFAL_BR_KEEP;
+    disc->totalDuration = BENCH_DISC_DURATION;
+    disc->techs2Find    = (RFAL_NFC_POLL_TECH_A | RFAL_NFC_POLL_TECH_B | RFAL_NFC_POLL_TECH_F | RFAL_NFC_POLL_TECH_V);
+}
+
+
+/*******************************************************************************/
+ReturnCode benchNdefDetect( ndefContext *ctx, st25r95SimTagHandler handler )
+{
+    rfalNfcDiscoverParam disc;
+    rfalNfcDevice       *dev;
+    ndefInfo             info;
+    ReturnCode           err;
+
+    st25r95SimSetTagHandler( 0, handler );
+    st25r95SimSetTagPresent( 0, true );
+
+    benchDiscParam( &disc );
+    err = rfalNfcInitialize();
+    if( err == ERR_NONE )
+    {
+        err = rfalNfcDiscover( &disc );
+    }
+    while( (err == ERR_NONE) && !rfalNfcIsDevActivated( rfalNfcGetState() ) && (platformGetSysTick() < BENCH_DISC_DURATION) )
+    {
+        rfalNfcWorker();
+    }
+    if( err != ERR_NONE )
+    {
+        return err;
+    }
+    if( !rfalNfcIsDevActivated( rfalNfcGetState() ) )
+    {
+        return ERR_TIMEOUT;
+    }
+
+    err = rfalNfcGetActiveDevice( &dev );
+    if( err == ERR_NONE )
+    {
+        err = ndefPollerContextInitialization( ctx, dev );
+    }
+    if( err == ERR_NONE )
+    {
+        err = ndefPollerNdefDetect( ctx, &info );
+    }
+    return err;
+}
+
+
+/*******************************************************************************/
+void benchNfcaTag( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t res[BENCH_NFCA_UID_LEN + 1U];
+    uint8_t i;
+
+    /* Single size UID T2T: SENS_RES, SDD and SEL of cascade level 1, T2T commands once selected, SLP_REQ is not answered */
+    if( (protocol != ST25R95_PROTOCOL_ISO14443A) || (txLen == 0U) )
+    {
+        return;
+    }
+
+    if( (txLen == 1U) && ((txFlag & 0x0FU) == BENCH_NFCA_SHORT_FRAME_BITS) )
+    {
+        if( (txBuf[0] == RFAL_14443A_SHORTFRAME_CMD_REQA) || (txBuf[0] == RFAL_14443A_SHORTFRAME_CMD_WUPA) )
+        {
+            benchNfcaActive = false;
+            res[0] = 0x04U;   /* SENS_RES: single size UID, bit frame SDD */
+            res[1] = 0x00U;
+            st25r95SimSetFrame( rx, res, 2U, false );
+        }
+        return;
+    }
+
+    if( benchNfcaActive )
+    {
+        benchT2TCommand( txBuf, txLen, rx );
+        return;
+    }
+
+    if( (txLen < 2U) || (txBuf[0] != BENCH_NFCA_SEL_CL1) )
+    {
+        return;
+    }
+
+    if( txBuf[1] == BENCH_NFCA_NVB_SDD )
+    {
+        ST_MEMCPY( res, benchNfcaUID, BENCH_NFCA_UID_LEN );
+        res[BENCH_NFCA_UID_LEN] = 0U;
+        for( i = 0; i < BENCH_NFCA_UID_LEN; i++ )
+        {
+            res[BENCH_NFCA_UID_LEN] ^= benchNfcaUID[i]; /* BCC */
+        }
+        st25r95SimSetFrame( rx, res, (BENCH_NFCA_UID_LEN + 1U), false );
+    }
+    else if( (txBuf[1] == BENCH_NFCA_NVB_SEL) && (txLen >= (2U + BENCH_NFCA_UID_LEN)) && (memcmp( &txBuf[2], benchNfcaUID, BENCH_NFCA_UID_LEN ) == 0) )
+    {
+        benchNfcaActive      = true;
+        benchNfcaSector      = 0U;
+        benchNfcaSectorSelect = false;
+        benchNfcaSelCnt++;
+        res[0] = 0x00U;   /* SEL_RES: UID complete, T2T */
+        st25r95SimSetFrame( rx, res, 1U, true );
+    }
+    else
+    {
+        /* No response */
+    }
+}
+
+
+/*******************************************************************************/
+void benchNfcbTag( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t res[RFAL_NFCB_SENSB_RES_LEN];
+
+    NO_WARNING(txFlag);
+
+    /* NFC-B tag not supporting ISO-DEP: SENSB_RES and SLPB_RES */
+    if( (protocol != ST25R95_PROTOCOL_ISO14443B) || (txLen == 0U) )
+    {
+        return;
+    }
+
+    if( txBuf[0] == BENCH_NFCB_CMD_SENSB_REQ )
+    {
+        res[0]  = 0x50U;  /* SENSB_RES */
+        ST_MEMCPY( &res[1], benchNfcbPUPI, RFAL_NFCB_NFCID0_LEN );
+        ST_MEMSET( &res[5], 0x00, 4U );  /* Application Data */
+        res[9]  = 0x00U;  /* Bit Rate Capability: 106 kbps only */
+        res[10] = 0x80U;  /* FSCI 256 bytes, not ISO14443-4 compliant */
+        res[11] = 0x70U;  /* FWI 7 */
+        st25r95SimSetFrame( rx, res, RFAL_NFCB_SENSB_RES_LEN, true );
+    }
+    else if( txBuf[0] == BENCH_NFCB_CMD_SLPB_REQ )
+    {
+        res[0] = 0x00U;   /* SLPB_RES */
+        st25r95SimSetFrame( rx, res, 1U, true );
+    }
+    else
+    {
+        /* No response */
+    }
+}
+
+
+/*******************************************************************************/
+void benchNfcvTag( uint8_t protocol, const uint8_t *txBuf, uint16_t txLen, uint8_t txFlag, st25r95SimFrame *rx )
+{
+    uint8_t  res[BENCH_NFCV_RES_MAX_LEN];
+    uint16_t idx;
+    uint16_t blockCnt;
+    uint16_t blockNum;
+    uint16_t pos;
+    bool     rejected;
+
+    NO_WARNING(txFlag);
+
+    /* Only an ISO15693 tag is in the field: other technologies time out */
+    if( (protocol != ST25R95_PROTOCOL_ISO15693) || (txLen < 2U) )
+    {
+        return;
+    }
+
+    /* Extended Get System Information carries its request field before the UID */
+    idx = ((txBuf[1] == BENCH_NFCV_CMD_EXT_GET_SYS_INFO) ? 3U : 2U);
+    if( txLen < idx )
+    {
+        return;
+    }
+    if( (txBuf[0] & (BENCH_NFCV_FLAG_INVENTORY | BENCH_NFCV_FLAG_ADDRESS)) == BENCH_NFCV_FLAG_ADDRESS )
+    {
+        if( (txLen < (idx + BENCH_NFCV_UID_LEN)) || (memcmp( &txBuf[idx], benchNfcvUID, BENCH_NFCV_UID_LEN ) != 0) )
+        {
+            return;
+        }
+        idx += BENCH_NFCV_UID_LEN;
+    }
+
+    res[0] = 0x00U;   /* Response flags: no error */
+
+    switch( txBuf[1] )
+    {
+        case BENCH_NFCV_CMD_INVENTORY:
+            res[1] = 0x00U; /* DSFID */
+            ST_MEMCPY( &res[2], benchNfcvUID, BENCH_NFCV_UID_LEN );
+            st25r95SimSetFrame( rx, res, (2U + BENCH_NFCV_UID_LEN), true );
+            break;
+
+        case BENCH_NFCV_CMD_READ_SINGLE_BLOCK:
+            if( txLen < (idx + 1U) )
+            {
+                return;
+            }
+            blockNum = (txBuf[idx] % BENCH_NFCV_BLOCK_NUM);
+            benchNfcvReadCnt++;
+            ST_MEMCPY( &res[1], benchNfcvMem[blockNum], BENCH_NFCV_BLOCK_LEN );
+            st25r95SimSetFrame( rx, res, (1U + BENCH_NFCV_BLOCK_LEN), true );
+            break;
+
+        case BENCH_NFCV_CMD_WRITE_SINGLE_BLOCK:
+            if( txLen < (idx + 1U + BENCH_NFCV_BLOCK_LEN) )
+            {
+                return;
+            }
+            blockNum = (txBuf[idx] % BENCH_NFCV_BLOCK_NUM);
+            benchNfcvWriteCnt[blockNum]++;
+            ST_MEMCPY( benchNfcvMem[blockNum], &txBuf[idx + 1U], BENCH_NFCV_BLOCK_LEN );
+            st25r95SimSetFrame( rx, res, 1U, true );
+            break;
+
+        case BENCH_NFCV_CMD_READ_MULTIPLE_BLOCKS:
+            if( txLen < (idx + 2U) )
+            {
+                return;
+            }
+            blockNum = txBuf[idx];
+            blockCnt = (uint16_t)(txBuf[idx + 1U] + 1U);
+
+            /* Chunk rejected on purpose, or beyond the tag limits */
+            rejected = false;
+            if( (blockCnt > 1U) && (benchNfcvChunkFail > 0U) )
+            {
+                benchNfcvChunkFail--;
+                rejected = (benchNfcvChunkFail == 0U);
+            }
+            if( rejected || (blockCnt > BENCH_NFCV_MAX_MULTIPLE_BLOCKS) || ((blockNum + blockCnt) > BENCH_NFCV_BLOCK_NUM) )
+            {
+                res[0] = BENCH_NFCV_RES_FLAG_ERROR;
+                res[1] = BENCH_NFCV_ERR_BLOCK_NOT_AVAIL;
+                st25r95SimSetFrame( rx, res, 2U, true );
+                return;
+            }
+            benchNfcvReadCnt += blockCnt;
+            ST_MEMCPY( &res[1], benchNfcvMem[blockNum], (blockCnt * BENCH_NFCV_BLOCK_LEN) );
+            st25r95SimSetFrame( rx, res, (uint16_t)(1U + (blockCnt * BENCH_NFCV_BLOCK_LEN)), true );
+            break;
+
+        case BENCH_NFCV_CMD_WRITE_MULTIPLE_BLOCKS:
+        case BENCH_NFCV_CMD_EXT_WRITE_MULTIPLE_BLOCKS:
+            if( !benchNfcvWrMultiple )
+            {
+                res[0] = BENCH_NFCV_RES_FLAG_ERROR;
+                res[1] = BENCH_NFCV_ERR_NOT_SUPPORTED;
+                st25r95SimSetFrame( rx, res, 2U, true );
+                return;
+            }
+            if( txBuf[1] == BENCH_NFCV_CMD_WRITE_MULTIPLE_BLOCKS )
+            {
+                if( txLen < (idx + 2U) )
+                {
+                    return;
+                }
+                blockNum = txBuf[idx];
+                blockCnt = (uint16_t)(txBuf[idx + 1U] + 1U);
+                idx     += 2U;
+            }
+            else
+            {
+                if( txLen < (idx + 4U) )
+                {
+                    return;
+                }
+                blockNum = (uint16_t)(txBuf[idx] | ((uint16_t)txBuf[idx + 1U] << 8U));
+                blockCnt = (uint16_t)((txBuf[idx + 2U] | ((uint16_t)txBuf[idx + 3U] << 8U)) + 1U);
+                idx     += 4U;
+            }
+            if( txLen < (idx + (blockCnt * BENCH_NFCV_BLOCK_LEN)) )
+            {
+                return;
+            }
+
+            /* Chunk rejected on purpose, or beyond the tag limits */
+            rejected = false;
+            if( (blockCnt > 1U) && (benchNfcvChunkFail > 0U) )
+            {
+                benchNfcvChunkFail--;
+                rejected = (benchNfcvChunkFail == 0U);
+            }
+            if( rejected || (blockCnt > BENCH_NFCV_MAX_MULTIPLE_BLOCKS) || ((blockNum + blockCnt) > BENCH_NFCV_BLOCK_NUM) )
+            {
+                res[0] = BENCH_NFCV_RES_FLAG_ERROR;
+                res[1] = BENCH_NFCV_ERR_BLOCK_NOT_AVAIL;
+                st25r95SimSetFrame( rx, res, 2U, true );
+                return;
+            }
+            for( pos = 0; pos < blockCnt; pos++ )
+            {
+                benchNfcvWriteCnt[blockNum + pos]++;
+            }
+            ST_MEMCPY( benchNfcvMem[blockNum], &txBuf[idx], (blockCnt * BENCH_NFCV_BLOCK_LEN) );
+            st25r95SimSetFrame( rx, res, 1U, true );
+            break;
+
+        case BENCH_NFCV_CMD_SELECT:
+            st25r95SimSetFrame( rx, res, 1U, true );
+            break;
+
+        case BENCH_NFCV_CMD_GET_SYS_INFO:
+            res[1]  = BENCH_NFCV_SYS_INFO_FLAGS;
+            ST_MEMCPY( &res[2], benchNfcvUID, BENCH_NFCV_UID_LEN );
+            res[10] = 0x00U;                                  /* DSFID              */
+            res[11] = 0x00U;                                  /* AFI                */
+            res[12] = (uint8_t)(BENCH_NFCV_BLOCK_NUM - 1U);   /* Number of blocks   */
+            res[13] = (uint8_t)(BENCH_NFCV_BLOCK_LEN - 1U);   /* Block size         */
+            res[14] = 0x00U;                                  /* IC reference       */
+            st25r95SimSetFrame( rx, res, BENCH_NFCV_SYS_INFO_LEN, true );
+            break;
+
+        case BENCH_NFCV_CMD_EXT_GET_SYS_INFO:
+            /* Only the requested supported fields are returned, in the order of the information flags */
+            res[1] = (uint8_t)(txBuf[2] & BENCH_NFCV_EXT_SYS_INFO_FLAGS);
+            ST_MEMCPY( &res[2], benchNfcvUID, BENCH_NFCV_UID_LEN );
+            pos = (2U + BENCH_NFCV_UID_LEN);
+            if( (res[1] & 0x01U) != 0U )
+            {
+                res[pos++] = 0x00U;                                  /* DSFID              */
+            }
+            if( (res[1] & 0x02U) != 0U )
+            {
+                res[pos++] = 0x00U;                                  /* AFI                */
+            }
+            if( (res[1] & 0x04U) != 0U )
+            {
+                res[pos++] = (uint8_t)(BENCH_NFCV_BLOCK_NUM - 1U);   /* Number of blocks LSB */
+                res[pos++] = (uint8_t)((BENCH_NFCV_BLOCK_NUM - 1U) >> 8U);
+                res[pos++] = (uint8_t)(BENCH_NFCV_BLOCK_LEN - 1U);   /* Block size         */
+            }
+            if( (res[1] & 0x08U) != 0U )
+            {
+                res[pos++] = 0x00U;                                  /* IC reference       */
+            }
+            if( (res[1] & 0x20U) != 0U )
+            {
+                /* Command list: Read/Write Single Block, Read Multiple Blocks, Select, Get System Information, (Extended) Write Multiple Blocks if supported */
+                res[pos++] = (uint8_t)(0x2BU | (benchNfcvWrMultiple ? BENCH_NFCV_CMD_LIST_WR_MULTIPLE : 0x00U));
+                res[pos++] = 0x10U;
+                res[pos++] = (benchNfcvWrMultiple ? BENCH_NFCV_CMD_LIST_WR_MULTIPLE : 0x00U);
+                res[pos++] = 0x00U;
+            }
+            st25r95SimSetFrame( rx, res, pos, true );
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static void benchT2TCommand( const uint8_t *txBuf, uint16_t txLen, st25r95SimFrame *rx )
+{
+    uint8_t  res[BENCH_T2T_FAST_READ_MAX_PAGES * BENCH_T2T_PAGE_LEN];
+    uint16_t sectorPage;
+    uint16_t pageCnt;
+    uint16_t i;
+
+    sectorPage = (uint16_t)((uint16_t)benchNfcaSector * BENCH_T2T_SECTOR_PAGES);
+
+    /* SECTOR SELECT packet 2 is acknowledged passively: no response */
+    if( benchNfcaSectorSelect )
+    {
+        benchNfcaSectorSelect = false;
+        if( (txLen >= BENCH_T2T_SECTOR_SELECT_P2_LEN) && (((uint32_t)txBuf[0] * BENCH_T2T_SECTOR_PAGES) < BENCH_T2T_PAGE_NUM) )
+        {
+            benchNfcaSector = txBuf[0];
+            benchNfcaSectorCnt++;
+        }
+        return;
+    }
+
+    switch( txBuf[0] )
+    {
+        case BENCH_T2T_CMD_READ:
+            if( txLen < 2U )
+            {
+                return;
+            }
+            if( (sectorPage + txBuf[1]) >= BENCH_T2T_PAGE_NUM )
+            {
+                benchT2TAckNak( rx, false );
+                return;
+            }
+            /* Pages past the end of the sector roll over to its first page */
+            for( i = 0; i < BENCH_T2T_READ_PAGES; i++ )
+            {
+                ST_MEMCPY( &res[i * BENCH_T2T_PAGE_LEN], benchNfcaMem[sectorPage + (uint8_t)(txBuf[1] + i)], BENCH_T2T_PAGE_LEN );
+            }
+            benchNfcaReadCnt++;
+            st25r95SimSetFrame( rx, res, (BENCH_T2T_READ_PAGES * BENCH_T2T_PAGE_LEN), true );
+            break;
+
+        case BENCH_T2T_CMD_FAST_READ:
+            if( txLen < 3U )
+            {
+                return;
+            }
+            pageCnt = (uint16_t)((txBuf[2] - txBuf[1]) + 1);
+            if( !benchNfcaFastRead || (txBuf[2] < txBuf[1]) || (pageCnt > BENCH_T2T_FAST_READ_MAX_PAGES) || ((sectorPage + txBuf[2]) >= BENCH_T2T_PAGE_NUM) )
+            {
+                benchT2TAckNak( rx, false );
+                return;
+            }
+            benchNfcaFastReadCnt++;
+            ST_MEMCPY( res, benchNfcaMem[sectorPage + txBuf[1]], (pageCnt * BENCH_T2T_PAGE_LEN) );
+            st25r95SimSetFrame( rx, res, (uint16_t)(pageCnt * BENCH_T2T_PAGE_LEN), true );
+            break;
+
+        case BENCH_T2T_CMD_SECTOR_SELECT:
+            if( (txLen < 2U) || (txBuf[1] != BENCH_T2T_SECTOR_SELECT_P1) )
+            {
+                benchT2TAckNak( rx, false );
+                return;
+            }
+            benchNfcaSectorSelect = true;
+            benchT2TAckNak( rx, true );
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/*******************************************************************************/
+static void benchT2TAckNak( st25r95SimFrame *rx, bool ack )
+{
+    uint8_t res;
+
+    /* 4-bit frame, reported by the ST25R95 with its residual bits. After a NAK the tag goes back to IDLE */
+    res = (ack ? BENCH_T2T_ACK : BENCH_T2T_NAK);
+    st25r95SimSetFrame( rx, &res, 1U, false );
+    rx->result = ST25R95_ERRCODE_RESULTSRESIDUAL;
+    rx->status = BENCH_T2T_ACK_NAK_BITS;
+    if( !ack )
+    {
+        benchNfcaActive = false;
+        benchNfcaNakCnt++;
+    }
+}
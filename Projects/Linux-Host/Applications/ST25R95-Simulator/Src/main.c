@@ -0,0 +1,250 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file main.c
+ *
+ *  \author
+ *
+ *  \brief Linux host application running the polling demo on the ST25R95 simulator
+ *
+ *  A simulated ISO15693 tag (Inventory, Read/Write Single Block, Read/Write
+ *  Multiple Blocks, (Extended) Get System Information) is placed in the
+ *  field and the polling demo (Common/Src/demo_polling.c) is run for the
+ *  given simulated duration:
+ *
+ *      st25r95_sim [duration ms] [benchmark]
+ *
+ *  At the end the number of demo cycles and of ST25R95 commands are reported.
+ *
+ *  When a second argument is given, the demo is replaced by one of the
+ *  benchmarks declared in bench.h: the number of readers or a tag mix (see
+ *  bench_rf.c) or the benchmark name, e.g. "retap" or "read" (see
+ *  bench_rf.c, bench_ndef_message.c and bench_ndef_poller.c).
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <string.h>
+#include "platform.h"
+#include "demo.h"
+#include "utils.h"
+#include "bench.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define MAIN_DEFAULT_DURATION            5000U   /*!< Default simulated duration (ms)      */
+
+#define MAIN_HEX_STR_NUM                 4U      /*!< Number of hex2Str() buffers          */
+#define MAIN_HEX_STR_LEN                 128U    /*!< Length of each hex2Str() buffer      */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+
+static char    hexStr[MAIN_HEX_STR_NUM][MAIN_HEX_STR_LEN];
+static uint8_t hexStrIdx;
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+int main( int argc, char *argv[] )
+{
+    uint32_t duration = MAIN_DEFAULT_DURATION;
+    uint32_t cycles;
+
+    if( argc > 1 )
+    {
+        duration = (uint32_t)strtoul( argv[1], NULL, 0 );
+    }
+
+    st25r95SimInitialize();
+#if ST25R95_IRQ_OUT_INTERRUPT
+    st25r95SimSetIrqOutHandler( benchIrqOutIsr );
+#endif /* ST25R95_IRQ_OUT_INTERRUPT */
+#if ST25R95_INTERFACE_UART
+    st25r95SimSetUartHandlers( benchUartRxEvent, benchUartTxCplt );
+#endif /* ST25R95_INTERFACE_UART */
+
+    if( argc > 3 )
+    {
+        if( strtoul( argv[2], NULL, 0 ) != 1U )
+        {
+            platformLog("The tag mix benchmark runs on a single reader\r\n");
+            return EXIT_FAILURE;
+        }
+        return benchMixBenchmark( duration, argv[3] );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "retap" ) == 0) )
+    {
+        return benchRetapBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "inventory" ) == 0) )
+    {
+        return benchInventoryBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "broadcast" ) == 0) )
+    {
+        return benchBroadcastBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "anticoll" ) == 0) )
+    {
+        return benchAnticollBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "isodep" ) == 0) )
+    {
+        return benchIsoDepBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "arena" ) == 0) )
+    {
+        return benchArenaBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "append" ) == 0) )
+    {
+        return benchAppendBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "stream" ) == 0) )
+    {
+        return benchStreamBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "read" ) == 0) )
+    {
+        return benchReadBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "multiwrite" ) == 0) )
+    {
+        return benchMultiWriteBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "t2tread" ) == 0) )
+    {
+        return benchT2TReadBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "write" ) == 0) )
+    {
+        return benchWriteBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "rewrite" ) == 0) )
+    {
+        return benchRewriteBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "worker" ) == 0) )
+    {
+        return benchWorkerBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "irq" ) == 0) )
+    {
+        return benchIrqBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "uart" ) == 0) )
+    {
+        return benchUartBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "spi" ) == 0) )
+    {
+        return benchSpiBenchmark( duration );
+    }
+
+    if( (argc > 2) && (strcmp( argv[2], "analog" ) == 0) )
+    {
+        return benchAnalogBenchmark( duration );
+    }
+
+    if( argc > 2 )
+    {
+        return benchReaderBenchmark( duration, (uint8_t)strtoul( argv[2], NULL, 0 ) );
+    }
+
+    st25r95SimSetTagHandler( 0, benchNfcvTag );
+    st25r95SimSetTagPresent( 0, true );
+
+    platformLog("Welcome to the ST25R95 simulator\r\n");
+
+    /* Initalize RFAL */
+    if( !demoIni() )
+    {
+        platformLog("Initialization failed..\r\n");
+        return EXIT_FAILURE;
+    }
+    platformLog("RFAL Initialization succeeded..\r\n");
+
+    for( cycles = 0; platformGetSysTick() < duration; cycles++ )
+    {
+        /* Run Demo Application */
+        demoCycle();
+    }
+
+    platformLog("%u ms simulated, demo cycles: %u, ST25R95 commands: %u\r\n", (unsigned)platformGetSysTick(), (unsigned)cycles, (unsigned)st25r95SimGetCommandCount());
+    return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************/
+char* hex2Str( unsigned char * data, size_t dataLen )
+{
+    const char *hex  = "0123456789ABCDEF";
+    char       *pout = hexStr[hexStrIdx];
+    char       *ret  = pout;
+    size_t      i;
+
+    dataLen = MIN( dataLen, (size_t)((MAIN_HEX_STR_LEN - 1U) / 2U) );
+
+    for( i = 0; i < dataLen; i++ )
+    {
+        *pout++ = hex[(data[i] >> 4) & 0xFU];
+        *pout++ = hex[data[i] & 0xFU];
+    }
+    *pout = '\0';
+
+    hexStrIdx = (uint8_t)((hexStrIdx + 1U) % MAIN_HEX_STR_NUM);
+    return ret;
+}
+
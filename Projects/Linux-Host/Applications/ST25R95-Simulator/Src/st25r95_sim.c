@@ -0,0 +1,1034 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2018 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT: ST25R95
+ *      $Revision: $
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file st25r95_sim.c
+ *
+ *  \author
+ *
+ *  \brief ST25R95 host simulator
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "st25r95_sim.h"
+#include "st25r95_com.h"
+#include "rfal_crc.h"
+#include "utils.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#ifndef ST25R95_SIM_TRACE
+    #define ST25R95_SIM_TRACE           false   /*!< Trace configuration missing. Disabled by default: no command/response trace */
+#endif /* ST25R95_SIM_TRACE */
+
+#define ST25R95_SIM_CONTROL_NONE        0xFFU   /*!< No control byte received yet in the current SPI frame */
+
+#define ST25R95_SIM_SPI_BYTE_TIME       1U      /*!< SPI byte duration (us)                                */
+#define ST25R95_SIM_UART_BYTE_TIME      ST25R95_SIM_SPI_BYTE_TIME /*!< UART byte duration (us)                  */
+#define ST25R95_SIM_UART_NULL_CHAR      0x00U   /*!< UART null character: nIRQ_IN low pulse                */
+#define ST25R95_SIM_POLL_STEP           1U      /*!< Simulated time spent per nIRQ_OUT, timer or worker time check (us) */
+
+#define ST25R95_SIM_CMD_MAX_LEN         (ST25R95_SIM_FRAME_MAX_LEN + 2U)                          /*!< Max command length: CMD + LEN + data              */
+#define ST25R95_SIM_RESP_MAX_LEN        (ST25R95_SIM_FRAME_MAX_LEN + ST25R95_SENDRECV_TAIL_MAXLEN) /*!< Max response length: Result + LEN + data + tail */
+
+#define ST25R95_SIM_ANALOG_REG          0x68U   /*!< WrReg address of the analog registers (ARC_B, ACC_A)  */
+#define ST25R95_SIM_ANALOG_REG_RD       0x69U   /*!< RdReg address of the analog registers                 */
+#define ST25R95_SIM_ANALOG_REG_NUM      8U      /*!< Number of analog registers                            */
+#define ST25R95_SIM_ANALOG_REG_INC      0x01U   /*!< WrReg flag: index followed by a value                 */
+
+#define ST25R95_SIM_IDLE_WUSRC_OFFSET   0x02U   /*!< WU source offset in Idle command                      */
+#define ST25R95_SIM_WUSRC_TIMEOUT       0x01U   /*!< Idle wake up source: timeout                          */
+#define ST25R95_SIM_WUSRC_TAGDETECT     0x02U   /*!< Idle wake up source: tag detection                    */
+#define ST25R95_SIM_WUSRC_IRQIN         0x08U   /*!< Idle wake up source: low pulse on nIRQ_IN             */
+
+#define ST25R95_SIM_ISO14443A_RX_BR_MASK  0x30U /*!< ISO14443A ProtocolSelect parameter: reception bit rate */
+
+/*
+******************************************************************************
+* GLOBAL MACROS
+******************************************************************************
+*/
+
+#define st25r95SimTimeReached(t)        ((int32_t)(gSimTime - (t)) >= 0)  /*!< Checks if the simulated clock reached the given time */
+
+/*
+******************************************************************************
+* LOCAL DATA TYPES
+******************************************************************************
+*/
+
+/*! Simulated ST25R95 context */
+typedef struct
+{
+    st25r95SimTagHandler handler;                                /*!< Tag handler                                  */
+    uint32_t             cmdLatency;                             /*!< Non RF command latency (us)                  */
+    uint32_t             rfLatency;                              /*!< SendRecv response latency (us)               */
+    uint32_t             timeoutLatency;                         /*!< SendRecv latency when no tag answers (us)    */
+    uint32_t             cmdCnt;                                 /*!< Number of processed commands                 */
+    uint32_t             spiCnt;                                 /*!< Number of SPI transfers                      */
+    uint32_t             spiBytes;                               /*!< Number of bytes exchanged over SPI           */
+
+    bool                 nSS;                                    /*!< nSS level                                    */
+    bool                 nIrqIn;                                 /*!< nIRQ_IN level                                */
+    bool                 powered;                                /*!< Chip started up (nIRQ_IN pulse after reset)  */
+    uint8_t              control;                                /*!< Control byte of the current SPI frame        */
+
+    uint8_t              cmd[ST25R95_SIM_CMD_MAX_LEN];           /*!< Command being received                       */
+    uint16_t             cmdLen;                                 /*!< Command length received                      */
+
+    uint8_t              resp[ST25R95_SIM_RESP_MAX_LEN];         /*!< Pending response                             */
+    uint16_t             respLen;                                /*!< Pending response length                      */
+    uint16_t             respIdx;                                /*!< Pending response bytes already read          */
+    bool                 respPending;                            /*!< A response is pending                        */
+    bool                 respEdge;                               /*!< nIRQ_OUT edge of the pending response raised */
+    uint32_t             respTime;                               /*!< Time at which the response becomes available */
+
+    uint8_t              protocol;                               /*!< Selected protocol                            */
+    uint8_t              protocolParam;                          /*!< First ProtocolSelect parameter (bit rates)   */
+    uint8_t              analogReg[ST25R95_SIM_ANALOG_REG_NUM];  /*!< Analog registers                             */
+    uint8_t              analogRegIdx;                           /*!< Analog register index                        */
+
+    bool                 idle;                                   /*!< Idle command in progress                     */
+    uint8_t              idleWuSrc;                              /*!< Idle wake up sources                         */
+    uint8_t              idleDacL;                               /*!< Idle tag detection low threshold             */
+    uint8_t              idleDacH;                               /*!< Idle tag detection high threshold            */
+    bool                 tagPresent;                             /*!< A tag is in the field                        */
+} st25r95SimContext;
+
+/*! Simulated UART link of chip 0, reception by circular DMA */
+typedef struct
+{
+    st25r95SimUartHandler rxEvent;                               /*!< Reception event handler                      */
+    st25r95SimUartHandler txCplt;                                /*!< Interrupt transmission complete handler      */
+    uint8_t              *ring;                                  /*!< Circular DMA buffer, NULL: reception stopped */
+    uint16_t             ringLen;                                /*!< Circular DMA buffer length                   */
+    uint16_t             wrIdx;                                  /*!< Next byte written by the DMA                 */
+    uint16_t             fragMax;                                /*!< Largest fragment per event, 0: whole response */
+    uint32_t             seed;                                   /*!< Fragment length pseudo random generator state */
+} st25r95SimUart;
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+
+static st25r95SimContext gSimChips[ST25R95_SIM_MAX_CHIPS];   /*!< Simulated chips                              */
+static uint8_t           gSimChip;                            /*!< Chip addressed by the current GPIO/SPI access */
+static uint32_t          gSimTime;                            /*!< Simulated clock shared by all chips (us)      */
+static st25r95SimIrqOutHandler gSimIrqOutHandler;             /*!< nIRQ_OUT interrupt handler, NULL: polled      */
+static st25r95SimUart    gSimUart;                            /*!< UART link of chip 0                           */
+#define gSim             (gSimChips[gSimChip])                /*!< Chip addressed by the current GPIO/SPI access */
+
+static const uint8_t st25r95SimIDN[] = {'N', 'F', 'C', ' ', 'F', 'S', '2', 'J', 'A', 'S', 'T', '4', '\0'};
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static void st25r95SimReset( void );
+static uint8_t st25r95SimSpiByte( uint8_t txByte );
+static void st25r95SimProcessCommand( void );
+static void st25r95SimSendRecv( void );
+static void st25r95SimIdle( void );
+static void st25r95SimIdleCheck( void );
+static void st25r95SimRespond( uint8_t result, const uint8_t *data, uint16_t len, uint32_t latency );
+static bool st25r95SimIrqOut( void );
+static void st25r95SimIrqOutEdges( void );
+static void st25r95SimIrqInPulse( void );
+static void st25r95SimEvents( void );
+#if ST25R95_INTERFACE_UART
+static void st25r95SimUartRxEvent( void );
+#endif /* ST25R95_INTERFACE_UART */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+void st25r95SimInitialize( void )
+{
+    ST_MEMSET( gSimChips, 0x00, sizeof(gSimChips) );
+    gSimTime = 0;
+
+    for( gSimChip = 0; gSimChip < ST25R95_SIM_MAX_CHIPS; gSimChip++ )
+    {
+        gSim.cmdLatency     = ST25R95_SIM_DEFAULT_CMD_LATENCY;
+        gSim.rfLatency      = ST25R95_SIM_DEFAULT_RF_LATENCY;
+        gSim.timeoutLatency = ST25R95_SIM_DEFAULT_TIMEOUT_LATENCY;
+        gSim.nSS            = true;
+        gSim.nIrqIn         = true;
+
+        st25r95SimReset();
+    }
+    gSimChip = 0;
+}
+
+
+/*******************************************************************************/
+void st25r95SimSetTagHandler( uint8_t chip, st25r95SimTagHandler handler )
+{
+    if( chip < ST25R95_SIM_MAX_CHIPS )
+    {
+        gSimChips[chip].handler = handler;
+    }
+}
+
+
+/*******************************************************************************/
+void st25r95SimSetTagPresent( uint8_t chip, bool present )
+{
+    if( chip < ST25R95_SIM_MAX_CHIPS )
+    {
+        gSimChips[chip].tagPresent = present;
+    }
+}
+
+
+/*******************************************************************************/
+void st25r95SimSetLatency( uint32_t cmdLatency, uint32_t rfLatency, uint32_t timeoutLatency )
+{
+    uint8_t i;
+
+    for( i = 0; i < ST25R95_SIM_MAX_CHIPS; i++ )
+    {
+        gSimChips[i].cmdLatency     = cmdLatency;
+        gSimChips[i].rfLatency      = rfLatency;
+        gSimChips[i].timeoutLatency = timeoutLatency;
+    }
+}
+
+
+/*******************************************************************************/
+void st25r95SimSetIrqOutHandler( st25r95SimIrqOutHandler handler )
+{
+    gSimIrqOutHandler = handler;
+}
+
+
+/*******************************************************************************/
+void st25r95SimSetFrame( st25r95SimFrame *rx, const uint8_t *data, uint16_t len, bool appendCrc )
+{
+    uint16_t crc;
+
+    len = MIN( len, (uint16_t)(ST25R95_SIM_FRAME_MAX_LEN - RFAL_CRC_LEN) );
+
+    ST_MEMCPY( rx->data, data, len );
+    rx->len     = len;
+    rx->result  = ST25R95_ERRCODE_FRAMEOKADDITIONALINFO;
+    rx->latency = gSim.rfLatency;
+
+    if( appendCrc )
+    {
+        if( gSim.protocol == ST25R95_PROTOCOL_ISO14443A )
+        {
+            crc = rfalCrcCalculateCcitt( 0x6363U, data, len );
+        }
+        else
+        {
+            crc = (uint16_t)~rfalCrcCalculateCcitt( 0xFFFFU, data, len );
+        }
+        rx->data[rx->len++] = (uint8_t)(crc & 0xFFU);
+        rx->data[rx->len++] = (uint8_t)(crc >> 8U);
+    }
+}
+
+
+/*******************************************************************************/
+uint32_t st25r95SimGetCommandCount( void )
+{
+    uint32_t cnt;
+    uint8_t  i;
+
+    cnt = 0;
+    for( i = 0; i < ST25R95_SIM_MAX_CHIPS; i++ )
+    {
+        cnt += gSimChips[i].cmdCnt;
+    }
+    return cnt;
+}
+
+
+/*******************************************************************************/
+uint32_t st25r95SimGetSpiTransferCount( void )
+{
+    uint32_t cnt;
+    uint8_t  i;
+
+    cnt = 0;
+    for( i = 0; i < ST25R95_SIM_MAX_CHIPS; i++ )
+    {
+        cnt += gSimChips[i].spiCnt;
+    }
+    return cnt;
+}
+
+
+/*******************************************************************************/
+uint32_t st25r95SimGetSpiByteCount( void )
+{
+    uint32_t cnt;
+    uint8_t  i;
+
+    cnt = 0;
+    for( i = 0; i < ST25R95_SIM_MAX_CHIPS; i++ )
+    {
+        cnt += gSimChips[i].spiBytes;
+    }
+    return cnt;
+}
+
+
+/*******************************************************************************/
+void st25r95SimSpiTxRx( const uint8_t *txBuf, uint8_t *rxBuf, uint16_t len )
+{
+    uint16_t i;
+    uint8_t  rxByte;
+
+    /* Shared bus: the chip with nSS low gets the bytes */
+    for( gSimChip = 0; gSimChip < (ST25R95_SIM_MAX_CHIPS - 1U); gSimChip++ )
+    {
+        if( !gSim.nSS )
+        {
+            break;
+        }
+    }
+
+    gSim.spiCnt++;
+    gSim.spiBytes += len;
+    for( i = 0; i < len; i++ )
+    {
+        rxByte = st25r95SimSpiByte( txBuf[i] );
+        if( rxBuf != NULL )
+        {
+            rxBuf[i] = rxByte;
+        }
+    }
+    st25r95SimEvents();
+}
+
+
+/*******************************************************************************/
+void st25r95SimGpioWrite( uint32_t port, uint32_t pin, bool level )
+{
+    if( (port < ST25R95_SIM_PORT) || (port >= (ST25R95_SIM_PORT + ST25R95_SIM_MAX_CHIPS)) )
+    {
+        return;
+    }
+    gSimChip = (uint8_t)(port - ST25R95_SIM_PORT);
+
+#if ST25R95_INTERFACE_UART
+    /* UART link: the nSS GPIO drives nIRQ_IN, used to kill the Idle command */
+    if( pin == ST25R95_SIM_PIN_N_SS )
+    {
+        pin = ST25R95_SIM_PIN_N_IRQ_IN;
+    }
+#endif /* ST25R95_INTERFACE_UART */
+
+    switch( pin )
+    {
+        case ST25R95_SIM_PIN_N_SS:
+            if( !gSim.nSS && level )
+            {
+                /* End of SPI frame: a SEND frame carries a command, a READ frame consumes the response */
+                if( gSim.control == ST25R95_CONTROL_SEND )
+                {
+                    st25r95SimProcessCommand();
+                }
+                else if( (gSim.control == ST25R95_CONTROL_READ) && (gSim.respIdx != 0U) )
+                {
+                    gSim.respPending = false;
+                }
+                else
+                {
+                    /* MISRA 15.7 - Empty else */
+                }
+            }
+            gSim.nSS     = level;
+            gSim.control = ST25R95_SIM_CONTROL_NONE;
+            gSim.cmdLen  = 0;
+            break;
+
+        case ST25R95_SIM_PIN_N_IRQ_IN:
+            if( !gSim.nIrqIn && level )
+            {
+                st25r95SimIrqInPulse();
+            }
+            gSim.nIrqIn = level;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/*******************************************************************************/
+bool st25r95SimGpioRead( uint32_t port, uint32_t pin )
+{
+    if( (port < ST25R95_SIM_PORT) || (port >= (ST25R95_SIM_PORT + ST25R95_SIM_MAX_CHIPS)) )
+    {
+        return false;
+    }
+    gSimChip = (uint8_t)(port - ST25R95_SIM_PORT);
+
+    switch( pin )
+    {
+        case ST25R95_SIM_PIN_N_SS:
+            return gSim.nSS;
+
+        case ST25R95_SIM_PIN_N_IRQ_IN:
+            return gSim.nIrqIn;
+
+        case ST25R95_SIM_PIN_N_IRQ_OUT:
+            gSimTime += ST25R95_SIM_POLL_STEP;
+            st25r95SimEvents();
+            return !st25r95SimIrqOut();
+
+        default:
+            return false;
+    }
+}
+
+
+/*******************************************************************************/
+uint32_t st25r95SimGetTimeUs( void )
+{
+    return gSimTime;
+}
+
+
+/*******************************************************************************/
+uint32_t st25r95SimGetTick( void )
+{
+    return (gSimTime / 1000U);
+}
+
+
+/*******************************************************************************/
+void st25r95SimDelay( uint32_t ms )
+{
+    gSimTime += (ms * 1000U);
+    st25r95SimEvents();
+}
+
+
+/*******************************************************************************/
+void st25r95SimWaitForInterrupt( void )
+{
+    uint32_t wakeUp;
+    uint8_t  chip;
+
+    /* Next SysTick, or the earliest response whose edge is still to come */
+    wakeUp = (((gSimTime / 1000U) + 1U) * 1000U);
+    for( chip = 0; chip < ST25R95_SIM_MAX_CHIPS; chip++ )
+    {
+        if( gSimChips[chip].respPending && !gSimChips[chip].respEdge && ((int32_t)(gSimChips[chip].respTime - wakeUp) < 0) )
+        {
+            wakeUp = gSimChips[chip].respTime;
+        }
+    }
+
+    if( !st25r95SimTimeReached( wakeUp ) )
+    {
+        gSimTime = wakeUp;
+    }
+    st25r95SimEvents();
+}
+
+
+/*******************************************************************************/
+uint32_t st25r95SimGetWorkerTime( void )
+{
+    gSimTime += ST25R95_SIM_POLL_STEP;
+    st25r95SimEvents();
+    return gSimTime;
+}
+
+
+/*******************************************************************************/
+void st25r95SimSetUartHandlers( st25r95SimUartHandler rxEvent, st25r95SimUartHandler txCplt )
+{
+    gSimUart.rxEvent = rxEvent;
+    gSimUart.txCplt  = txCplt;
+}
+
+
+/*******************************************************************************/
+void st25r95SimSetUartFragment( uint16_t fragMax, uint32_t seed )
+{
+    gSimUart.fragMax = fragMax;
+    gSimUart.seed    = seed;
+}
+
+
+/*******************************************************************************/
+void st25r95SimUartTx( const uint8_t *txBuf, uint16_t len )
+{
+    uint16_t i;
+
+    gSimChip = 0;
+    for( i = 0; i < len; i++ )
+    {
+        gSimTime += ST25R95_SIM_UART_BYTE_TIME;
+
+        /* A null character out of a command holds nIRQ_IN/UART_RX low: start up or wake up */
+        if( (gSim.cmdLen == 0U) && (txBuf[i] == ST25R95_SIM_UART_NULL_CHAR) )
+        {
+            st25r95SimIrqInPulse();
+            continue;
+        }
+
+        if( gSim.cmdLen < ST25R95_SIM_CMD_MAX_LEN )
+        {
+            gSim.cmd[gSim.cmdLen++] = txBuf[i];
+        }
+
+        /* Commands are delimited by their length byte, Echo has none */
+        if( (gSim.cmd[ST25R95_CMD_COMMAND_OFFSET] == ST25R95_COMMAND_ECHO) ||
+            ((gSim.cmdLen >= ST25R95_CMD_DATA_OFFSET) && (gSim.cmdLen >= (gSim.cmd[ST25R95_CMD_LENGTH_OFFSET] + ST25R95_CMD_DATA_OFFSET))) )
+        {
+            st25r95SimProcessCommand();
+            gSim.cmdLen = 0;
+        }
+    }
+    st25r95SimEvents();
+}
+
+
+/*******************************************************************************/
+void st25r95SimUartTxIT( const uint8_t *txBuf, uint16_t len )
+{
+    st25r95SimUartTx( txBuf, len );
+    if( gSimUart.txCplt != NULL )
+    {
+        gSimUart.txCplt();
+    }
+}
+
+
+/*******************************************************************************/
+void st25r95SimUartReset( void )
+{
+    /* Abort stops the circular DMA: bytes received meanwhile are lost */
+    gSimUart.ring = NULL;
+}
+
+
+/*******************************************************************************/
+void st25r95SimUartRxDmaStart( uint8_t *ring, uint16_t len )
+{
+    gSimUart.ring    = ring;
+    gSimUart.ringLen = len;
+    gSimUart.wrIdx   = 0;
+}
+
+
+/*******************************************************************************/
+uint16_t st25r95SimUartRxDmaRemaining( void )
+{
+    return (uint16_t)(gSimUart.ringLen - gSimUart.wrIdx);
+}
+
+
+/*******************************************************************************/
+uint32_t st25r95SimTimerCreate( uint32_t ms )
+{
+    return (gSimTime + (ms * 1000U));
+}
+
+
+/*******************************************************************************/
+bool st25r95SimTimerIsExpired( uint32_t timer )
+{
+    gSimTime += ST25R95_SIM_POLL_STEP;
+    st25r95SimEvents();
+    return st25r95SimTimeReached( timer );
+}
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static void st25r95SimReset( void )
+{
+    gSim.powered       = false;
+    gSim.control       = ST25R95_SIM_CONTROL_NONE;
+    gSim.cmdLen        = 0;
+    gSim.respPending   = false;
+    gSim.respLen       = 0;
+    gSim.respIdx       = 0;
+    gSim.protocol      = ST25R95_PROTOCOL_FIELDOFF;
+    gSim.protocolParam = 0;
+    gSim.analogRegIdx  = 0;
+    gSim.idle          = false;
+    ST_MEMSET( gSim.analogReg, 0x00, sizeof(gSim.analogReg) );
+}
+
+
+/*******************************************************************************/
+static bool st25r95SimIrqOut( void )
+{
+    st25r95SimIdleCheck();
+    return (gSim.respPending && st25r95SimTimeReached( gSim.respTime ));
+}
+
+
+/*******************************************************************************/
+static void st25r95SimIrqOutEdges( void )
+{
+    uint8_t chip;
+
+    if( gSimIrqOutHandler == NULL )
+    {
+        return;
+    }
+
+    /* nIRQ_OUT falls once per response, when the response becomes available */
+    chip = gSimChip;
+    for( gSimChip = 0; gSimChip < ST25R95_SIM_MAX_CHIPS; gSimChip++ )
+    {
+        if( st25r95SimIrqOut() && !gSim.respEdge )
+        {
+            gSim.respEdge = true;
+            gSimIrqOutHandler( gSimChip );
+        }
+    }
+    gSimChip = chip;
+}
+
+
+/*******************************************************************************/
+static void st25r95SimIrqInPulse( void )
+{
+    /* End of nIRQ_IN low pulse: starts the chip up or wakes it up from Idle */
+    if( !gSim.powered )
+    {
+        gSim.powered = true;
+    }
+    else if( gSim.idle && (gSim.idleWuSrc & ST25R95_SIM_WUSRC_IRQIN) != 0U )
+    {
+        uint8_t wuSrc = ST25R95_SIM_WUSRC_IRQIN;
+
+        gSim.idle = false;
+        st25r95SimRespond( ST25R95_ERRCODE_NONE, &wuSrc, 1, gSim.cmdLatency );
+    }
+    else
+    {
+        /* MISRA 15.7 - Empty else */
+    }
+}
+
+
+/*******************************************************************************/
+static void st25r95SimEvents( void )
+{
+    /* Interrupts raised by the chips while the simulated clock advanced */
+    st25r95SimIrqOutEdges();
+#if ST25R95_INTERFACE_UART
+    st25r95SimUartRxEvent();
+#endif /* ST25R95_INTERFACE_UART */
+}
+
+
+#if ST25R95_INTERFACE_UART
+/*******************************************************************************/
+static void st25r95SimUartRxEvent( void )
+{
+    uint16_t len;
+    uint16_t i;
+    uint8_t  chip;
+
+    chip     = gSimChip;
+    gSimChip = 0;
+    if( !st25r95SimIrqOut() )
+    {
+        gSimChip = chip;
+        return;
+    }
+
+    /* The response is sent as soon as available, one fragment per event */
+    len = (uint16_t)(gSim.respLen - gSim.respIdx);
+    if( gSimUart.fragMax != 0U )
+    {
+        gSimUart.seed = ((gSimUart.seed * 1103515245U) + 12345U);
+        len = MIN( len, (uint16_t)(1U + ((gSimUart.seed >> 16U) % gSimUart.fragMax)) );
+    }
+
+    for( i = 0; i < len; i++ )
+    {
+        if( gSimUart.ring != NULL )
+        {
+            gSimUart.ring[gSimUart.wrIdx] = gSim.resp[gSim.respIdx];
+            gSimUart.wrIdx = (uint16_t)((gSimUart.wrIdx + 1U) % gSimUart.ringLen);
+        }
+        gSim.respIdx++;
+    }
+    if( gSim.respIdx >= gSim.respLen )
+    {
+        gSim.respPending = false;
+    }
+    gSimChip = chip;
+
+    /* Idle line (or DMA half/complete transfer) event */
+    if( (gSimUart.ring != NULL) && (gSimUart.rxEvent != NULL) )
+    {
+        gSimUart.rxEvent();
+    }
+}
+#endif /* ST25R95_INTERFACE_UART */
+
+
+/*******************************************************************************/
+static uint8_t st25r95SimSpiByte( uint8_t txByte )
+{
+    uint8_t rxByte = ST25R95_SPI_DUMMY_BYTE;
+
+    gSimTime += ST25R95_SIM_SPI_BYTE_TIME;
+
+    if( gSim.nSS )
+    {
+        /* Chip not selected */
+        return rxByte;
+    }
+
+    if( gSim.control == ST25R95_SIM_CONTROL_NONE )
+    {
+        /* First byte of the SPI frame is the control byte */
+        gSim.control = txByte;
+        if( gSim.control == ST25R95_CONTROL_RESET )
+        {
+            st25r95SimReset();
+            gSim.control = ST25R95_CONTROL_RESET;
+        }
+        return rxByte;
+    }
+
+    switch( gSim.control )
+    {
+        case ST25R95_CONTROL_SEND:
+            if( gSim.cmdLen < ST25R95_SIM_CMD_MAX_LEN )
+            {
+                gSim.cmd[gSim.cmdLen++] = txByte;
+            }
+            break;
+
+        case ST25R95_CONTROL_READ:
+            if( st25r95SimIrqOut() )
+            {
+                /* Dummy bytes are returned when reading beyond the response (flush) */
+                if( gSim.respIdx < gSim.respLen )
+                {
+                    rxByte = gSim.resp[gSim.respIdx];
+                }
+                gSim.respIdx++;
+            }
+            break;
+
+        case ST25R95_CONTROL_POLL:
+            if( st25r95SimIrqOut() )
+            {
+                rxByte |= 0x08U;
+            }
+            if( gSim.powered && !gSim.respPending && !gSim.idle )
+            {
+                rxByte |= 0x04U;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return rxByte;
+}
+
+
+/*******************************************************************************/
+static void st25r95SimProcessCommand( void )
+{
+    uint8_t  data[ST25R95_SIM_FRAME_MAX_LEN];
+    uint16_t len;
+
+    if( !gSim.powered || (gSim.cmdLen == 0U) )
+    {
+        /* Chip not started up: command ignored */
+        return;
+    }
+
+    gSim.cmdCnt++;
+#if ST25R95_SIM_TRACE
+    platformLog("[%10u] >>>> %s\r\n", (unsigned)gSimTime, hex2Str(gSim.cmd, gSim.cmdLen));
+#endif /* ST25R95_SIM_TRACE */
+    gSim.respPending = false;
+    gSim.idle        = false;
+
+    /* Echo has no length byte */
+    if( gSim.cmd[ST25R95_CMD_COMMAND_OFFSET] == ST25R95_COMMAND_ECHO )
+    {
+        gSim.resp[0]     = ST25R95_COMMAND_ECHO;
+        gSim.respLen     = 1;
+        gSim.respIdx     = 0;
+        gSim.respTime    = gSimTime + gSim.cmdLatency;
+        gSim.respPending = true;
+        gSim.respEdge    = false;
+        return;
+    }
+
+    if( (gSim.cmdLen < ST25R95_CMD_DATA_OFFSET) || (gSim.cmdLen != (gSim.cmd[ST25R95_CMD_LENGTH_OFFSET] + ST25R95_CMD_DATA_OFFSET)) )
+    {
+        st25r95SimRespond( ST25R95_ERRCODE_INVALIDCMDLENGHT, NULL, 0, gSim.cmdLatency );
+        return;
+    }
+
+    switch( gSim.cmd[ST25R95_CMD_COMMAND_OFFSET] )
+    {
+        /*******************************************************************************/
+        case ST25R95_COMMAND_IDN:
+            {
+                uint16_t crc;
+
+                len = sizeof(st25r95SimIDN);
+                ST_MEMCPY( data, st25r95SimIDN, len );
+                crc = (uint16_t)~rfalCrcCalculateCcitt( 0xFFFFU, data, len );
+                data[len++] = (uint8_t)(crc & 0xFFU);
+                data[len++] = (uint8_t)(crc >> 8U);
+                st25r95SimRespond( ST25R95_ERRCODE_NONE, data, len, gSim.cmdLatency );
+            }
+            break;
+
+        /*******************************************************************************/
+        case ST25R95_COMMAND_PROTOCOLSELECT:
+            if( (gSim.cmdLen < (ST25R95_CMD_DATA_OFFSET + 1U)) || (gSim.cmd[ST25R95_CMD_DATA_OFFSET] > ST25R95_PROTOCOL_MAX) )
+            {
+                st25r95SimRespond( ST25R95_ERRCODE_INVALIDPROTOCOL, NULL, 0, gSim.cmdLatency );
+                break;
+            }
+            gSim.protocol      = gSim.cmd[ST25R95_CMD_DATA_OFFSET];
+            gSim.protocolParam = (gSim.cmdLen > ST25R95_PROTOCOLSELECT_BR_OFFSET) ? gSim.cmd[ST25R95_PROTOCOLSELECT_BR_OFFSET] : 0U;
+            st25r95SimRespond( ST25R95_ERRCODE_NONE, NULL, 0, gSim.cmdLatency );
+            break;
+
+        /*******************************************************************************/
+        case ST25R95_COMMAND_SENDRECV:
+            st25r95SimSendRecv();
+            break;
+
+        /*******************************************************************************/
+        case ST25R95_COMMAND_IDLE:
+            st25r95SimIdle();
+            break;
+
+        /*******************************************************************************/
+        case ST25R95_COMMAND_WRREG:
+            /* Analog registers: [addr][flags][index]([value]) */
+            if( (gSim.cmdLen >= 5U) && (gSim.cmd[2] == ST25R95_SIM_ANALOG_REG) )
+            {
+                gSim.analogRegIdx = (gSim.cmd[4] % ST25R95_SIM_ANALOG_REG_NUM);
+                if( ((gSim.cmd[3] & ST25R95_SIM_ANALOG_REG_INC) != 0U) && (gSim.cmdLen >= 6U) )
+                {
+                    gSim.analogReg[gSim.analogRegIdx] = gSim.cmd[5];
+                }
+            }
+            st25r95SimRespond( ST25R95_ERRCODE_NONE, NULL, 0, gSim.cmdLatency );
+            break;
+
+        /*******************************************************************************/
+        case ST25R95_COMMAND_RDREG:
+            data[0] = (gSim.cmd[2] == ST25R95_SIM_ANALOG_REG_RD) ? gSim.analogReg[gSim.analogRegIdx] : 0x00U;
+            st25r95SimRespond( ST25R95_ERRCODE_NONE, data, 1, gSim.cmdLatency );
+            break;
+
+        /*******************************************************************************/
+        case ST25R95_COMMAND_POLLFIED:
+            data[0] = 0x00U;   /* No external field */
+            st25r95SimRespond( ST25R95_ERRCODE_NONE, data, 1, gSim.cmdLatency );
+            break;
+
+        /*******************************************************************************/
+        case ST25R95_COMMAND_ACFILTER:
+            data[0] = ST25R95_ACSTATE_IDLE;
+            st25r95SimRespond( ST25R95_ERRCODE_NONE, data, ((gSim.cmdLen == ST25R95_CMD_DATA_OFFSET) ? 1U : 0U), gSim.cmdLatency );
+            break;
+
+        /*******************************************************************************/
+        default:
+            /* Card Emulation and UART commands are not simulated */
+            st25r95SimRespond( ST25R95_ERRCODE_INVALIDCCMDCODE, NULL, 0, gSim.cmdLatency );
+            break;
+    }
+}
+
+
+/*******************************************************************************/
+static void st25r95SimSendRecv( void )
+{
+    static st25r95SimFrame rx;
+    uint16_t               txLen;
+    uint8_t                txFlag;
+    uint16_t               len;
+
+    if( (gSim.protocol == ST25R95_PROTOCOL_FIELDOFF) || (gSim.protocol == ST25R95_PROTOCOL_CE_ISO14443A) )
+    {
+        st25r95SimRespond( ST25R95_ERRCODE_INVALIDPROTOCOL, NULL, 0, gSim.cmdLatency );
+        return;
+    }
+
+    txLen  = (gSim.cmdLen - ST25R95_CMD_DATA_OFFSET);
+    txFlag = 0U;
+
+    /* ISO14443A frames are followed by the transmission flag */
+    if( (gSim.protocol == ST25R95_PROTOCOL_ISO14443A) && (txLen != 0U) )
+    {
+        txFlag = gSim.cmd[gSim.cmdLen - 1U];
+        txLen--;
+    }
+
+    ST_MEMSET( &rx, 0x00, sizeof(rx) );
+    rx.result  = ST25R95_ERRCODE_FRAMEWAITTIMEOUT;
+    rx.latency = gSim.timeoutLatency;
+
+    if( gSim.handler != NULL )
+    {
+        gSim.handler( gSim.protocol, &gSim.cmd[ST25R95_CMD_DATA_OFFSET], txLen, txFlag, &rx );
+    }
+
+    if( (rx.result != ST25R95_ERRCODE_FRAMEOKADDITIONALINFO) && (rx.result != ST25R95_ERRCODE_RESULTSRESIDUAL) )
+    {
+        st25r95SimRespond( rx.result, NULL, 0, rx.latency );
+        return;
+    }
+
+    /* Frame followed by the additional bytes: status, plus collision position for ISO14443A 106kbps */
+    len = MIN( rx.len, (uint16_t)ST25R95_SIM_FRAME_MAX_LEN );
+    ST_MEMMOVE( &gSim.resp[ST25R95_CMD_DATA_OFFSET], rx.data, len );
+    gSim.resp[ST25R95_CMD_DATA_OFFSET + len++] = rx.status;
+    if( (gSim.protocol == ST25R95_PROTOCOL_ISO14443A) && ((gSim.protocolParam & ST25R95_SIM_ISO14443A_RX_BR_MASK) == 0U) )
+    {
+        gSim.resp[ST25R95_CMD_DATA_OFFSET + len++] = rx.colByte;
+        gSim.resp[ST25R95_CMD_DATA_OFFSET + len++] = rx.colBit;
+    }
+
+    st25r95SimRespond( rx.result, NULL, len, rx.latency );
+}
+
+
+/*******************************************************************************/
+static void st25r95SimIdle( void )
+{
+    if( gSim.cmdLen <= ST25R95_IDLE_DACDATAH_OFFSET )
+    {
+        st25r95SimRespond( ST25R95_ERRCODE_INVALIDCMDLENGHT, NULL, 0, gSim.cmdLatency );
+        return;
+    }
+
+    gSim.idle      = true;
+    gSim.idleWuSrc = gSim.cmd[ST25R95_SIM_IDLE_WUSRC_OFFSET];
+    gSim.idleDacL  = gSim.cmd[ST25R95_IDLE_DACDATAL_OFFSET];
+    gSim.idleDacH  = gSim.cmd[ST25R95_IDLE_DACDATAH_OFFSET];
+    gSim.protocol  = ST25R95_PROTOCOL_FIELDOFF;
+
+    st25r95SimIdleCheck();
+
+    /* Neither tag detected nor timeout enabled: wait for a nIRQ_IN pulse */
+}
+
+
+/*******************************************************************************/
+static void st25r95SimIdleCheck( void )
+{
+    uint8_t level;
+    uint8_t wuSrc;
+
+    if( !gSim.idle )
+    {
+        return;
+    }
+
+    level = ST25R95_SIM_DEFAULT_DAC_LEVEL;
+    if( gSim.tagPresent )
+    {
+        level -= ST25R95_SIM_TAG_DAC_DROP;
+    }
+
+    /* Tag detected when the measurement is outside [DacDataL; DacDataH] */
+    if( ((gSim.idleWuSrc & ST25R95_SIM_WUSRC_TAGDETECT) != 0U) && ((level < gSim.idleDacL) || (level > gSim.idleDacH)) )
+    {
+        wuSrc = ST25R95_SIM_WUSRC_TAGDETECT;
+    }
+    else if( (gSim.idleWuSrc & ST25R95_SIM_WUSRC_TIMEOUT) != 0U )
+    {
+        wuSrc = ST25R95_SIM_WUSRC_TIMEOUT;
+    }
+    else
+    {
+        return;
+    }
+
+    gSim.idle = false;
+    st25r95SimRespond( ST25R95_ERRCODE_NONE, &wuSrc, 1, ST25R95_SIM_DEFAULT_IDLE_LATENCY );
+}
+
+
+/*******************************************************************************/
+static void st25r95SimRespond( uint8_t result, const uint8_t *data, uint16_t len, uint32_t latency )
+{
+    len = MIN( len, (uint16_t)(ST25R95_SIM_RESP_MAX_LEN - ST25R95_CMD_DATA_OFFSET) );
+
+    if( (data != NULL) && (len != 0U) )
+    {
+        ST_MEMCPY( &gSim.resp[ST25R95_CMD_DATA_OFFSET], data, len );
+    }
+
+    /* Length above 255 is carried in bits 6:5 of the result code. See CR95HF DS 4.4 */
+    if( (result & 0x8FU) == 0x80U )
+    {
+        result |= (uint8_t)((len >> 3U) & 0x60U);
+    }
+
+    gSim.resp[ST25R95_CMD_RESULT_OFFSET] = result;
+    gSim.resp[ST25R95_CMD_LENGTH_OFFSET] = (uint8_t)(len & 0xFFU);
+    gSim.respLen     = (len + ST25R95_CMD_DATA_OFFSET);
+    gSim.respIdx     = 0;
+    gSim.respTime    = gSimTime + latency;
+    gSim.respPending = true;
+    gSim.respEdge    = false;
+#if ST25R95_SIM_TRACE
+    platformLog("[%10u] <<<< %s\r\n", (unsigned)gSim.respTime, hex2Str(gSim.resp, gSim.respLen));
+#endif /* ST25R95_SIM_TRACE */
+}
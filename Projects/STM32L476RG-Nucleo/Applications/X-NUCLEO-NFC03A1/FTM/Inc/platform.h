@@ -92,6 +92,9 @@
 
 #define ST25R95_TAGDETECT_DEF_CALIBRATION 0x7C             /*!< Tag Detection Calibration default value                    */
 #define ST25R95_TAGDETECT_CALIBRATE       true             /*!< False: use default value, True: call calibration procedure */
+#define ST25R95_SPI_BURST                 true             /*!< False: one SPI transfer per byte, True: multi-byte SPI transfers   */
+#define ST25R95_IRQ_OUT_INTERRUPT         false            /*!< False: nIRQ_OUT GPIO polled, True: nIRQ_OUT falling edge routed (EXTI) to st25r95Isr() */
+#define ST25R95_UART_DMA_RX               false            /*!< False: UART Rx interrupt per response segment, True: UART circular DMA Rx with idle line events routed to st25r95UartRxEventCallback() */
 /*
 ******************************************************************************
 * GLOBAL MACROS
@@ -134,6 +137,7 @@
 #define platformDelay(t)                              HAL_Delay(t)                                                       /*!< Performs a delay for the given time (ms)    */
 
 #define platformGetSysTick()                          HAL_GetTick()                                                      /*!< Get System Tick ( 1 tick = 1 ms)            */
+#define platformWaitForInterrupt()                    __WFI()                                                            /*!< Wait (sleep) until next interrupt           */
 
 #define platformErrorHandle()                         _Error_Handler(__FILE__,__LINE__)             /*!< Global error handler or trap                 */
 
@@ -141,17 +145,22 @@
 #define platformSpiSelect()                           platformGpioClear(ST25R95_N_SS_PORT, ST25R95_N_SS_PIN)             /*!< SPI SS\CS: Chip|Slave Select                */
 #define platformSpiDeselect()                         platformGpioSet(ST25R95_N_SS_PORT, ST25R95_N_SS_PIN)               /*!< SPI SS\CS: Chip|Slave Deselect              */
 #define platformSpiTxRx(txBuf, rxBuf, len)            HAL_SPI_TransmitReceive((&hspi1), (txBuf), (rxBuf), (len), 1000)   /*!< SPI transceive                              */
+#define platformSpiTx(txBuf, len)                     HAL_SPI_Transmit((&hspi1), (txBuf), (len), 1000)                   /*!< SPI transmit only, received bytes discarded */
 #define platformUartTx(TxBuf, len)                                                                                       /*!< UART transceive                             */
 #define platformUartRx(RxBuf, len)                                                                                       /*!< UART transceive                             */
 #else /* !ST25R95_INTERFACE_SPI */
 #define platformSpiSelect()                                                                                              /*!< SPI SS\CS: Chip|Slave Select                */
 #define platformSpiDeselect()                                                                                            /*!< SPI SS\CS: Chip|Slave Deselect              */
 #define platformSpiTxRx(txBuf, rxBuf, len)                                                                               /*!< SPI transceive                              */
+#define platformSpiTx(txBuf, len)                                                                                        /*!< SPI transmit only, received bytes discarded */
 #define platformUartTx(TxBuf, len)                     HAL_UART_Transmit(&huart1, (TxBuf), (len), 50)                    /*!< UART transceive                             */
 #define platformUartRx(RxBuf, len)                     HAL_UART_Receive(&huart1, (RxBuf), (len), 50)                     /*!< UART transceive                             */
 #define platformUartTxIT(TxBuf, len)                   HAL_UART_Transmit_IT(&huart1, (TxBuf), (len))                     /*!< UART transceive                             */
 #define platformUartRxIT(RxBuf, len)                   HAL_UART_Receive_IT(&huart1, (RxBuf), (len))                      /*!< UART transceive                             */
 #define platformUartReset()                            HAL_UART_Abort(&huart1)                                           /*!< UART abort Tx/Rx and reset uart             */
+#define platformUartRxDmaStart(RxBuf, len)             HAL_UARTEx_ReceiveToIdle_DMA(&huart1, (RxBuf), (len))             /*!< UART circular DMA reception start           */
+#define platformUartRxDmaRemaining()                   __HAL_DMA_GET_COUNTER(huart1.hdmarx)                              /*!< UART DMA reception remaining count          */
+#define platformUartSetBaudRate(baudRate)              do{ huart1.Init.BaudRate = (baudRate); (void)HAL_UART_Init(&huart1); }while(0) /*!< UART baud rate change                 */
 #endif /* ST25R95_INTERFACE_SPI */
 
 #define platformLog(...)                              logUsart(__VA_ARGS__)                                              /*!< Log  method                                 */
@@ -172,6 +181,12 @@ extern uint8_t globalCommProtectCnt;                      /* Global Protection C
 #define RFAL_FEATURE_LISTEN_MODE               false      /*!< Enable/Disable RFAL support for Listen Mode                               */
 #define RFAL_FEATURE_WAKEUP_MODE               true       /*!< Enable/Disable RFAL support for the Wake-Up mode                          */
 #define RFAL_FEATURE_LOWPOWER_MODE             false      /*!< Enable/Disable RFAL support for the Low Power mode                        */
+#define RFAL_FEATURE_BOUNDED_WORKER            false      /*!< Enable/Disable one chip access per rfalWorker() call and worker time stats */
+#define RFAL_FEATURE_ASYNC_TRANSCEIVE          false      /*!< Enable/Disable RFAL support for asynchronous/queued transceives           */
+#define RFAL_FEATURE_NFC_ADAPTIVE_POLL         false      /*!< Enable/Disable adaptive technology ordering of the NFC discovery loop     */
+#define RFAL_FEATURE_NFCV_ADAPTIVE_INVENTORY   false      /*!< Enable/Disable adaptive slot count of the NFC-V inventory                 */
+#define RFAL_FEATURE_NFCA_FAST_COLLISION_RESOLUTION false /*!< Enable/Disable NFC-A collision resolution resuming from recorded NFCID1 prefixes */
+#define RFAL_FEATURE_ISO_DEP_LINK_ADAPTATION        false /*!< Enable/Disable ISO-DEP bit rate selection from the errors seen on previous exchanges */
 #define RFAL_FEATURE_NFCA                      false      /*!< Enable/Disable RFAL support for NFC-A (ISO14443A)                         */
 #define RFAL_FEATURE_NFCB                      false      /*!< Enable/Disable RFAL support for NFC-B (ISO14443B)                         */
 #define RFAL_FEATURE_NFCF                      false      /*!< Enable/Disable RFAL support for NFC-F (FeliCa)                            */